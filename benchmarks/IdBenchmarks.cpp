@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <graphqlservice/GraphQLService.h>
+
+using namespace graphql;
+
+namespace {
+
+// Typical IDs range from a 64-bit key to a couple of GUIDs.
+void IdSizes(benchmark::internal::Benchmark* benchmark)
+{
+	for (const int size : { 8, 12, 16, 24, 32, 64 })
+	{
+		benchmark->Arg(size);
+	}
+}
+
+response::IdType makeId(size_t size)
+{
+	response::IdType id(size);
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		id[i] = static_cast<uint8_t>(i * 37 + 11);
+	}
+
+	return id;
+}
+
+void BM_CopyIdType(benchmark::State& state)
+{
+	const auto id = makeId(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		response::IdType copy(id);
+
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+BENCHMARK(BM_CopyIdType)->Apply(IdSizes);
+
+void BM_CopyByteVector(benchmark::State& state)
+{
+	const auto id = makeId(static_cast<size_t>(state.range(0)));
+	const std::vector<uint8_t> bytes(id.cbegin(), id.cend());
+
+	for (auto _ : state)
+	{
+		std::vector<uint8_t> copy(bytes);
+
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+BENCHMARK(BM_CopyByteVector)->Apply(IdSizes);
+
+void BM_ToBase64(benchmark::State& state)
+{
+	const auto id = makeId(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(service::Base64::toBase64(id));
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ToBase64)->Apply(IdSizes);
+
+void BM_FromBase64(benchmark::State& state)
+{
+	const auto encoded = service::Base64::toBase64(makeId(static_cast<size_t>(state.range(0))));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(service::Base64::fromBase64(encoded.data(), encoded.size()));
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FromBase64)->Apply(IdSizes);
+
+} /* namespace */
@@ -0,0 +1,372 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include "UnifiedToday.h"
+
+#include <graphqlservice/JSONResponse.h>
+
+#include <sstream>
+
+using namespace graphql;
+
+namespace {
+
+response::IdType makeId(size_t index)
+{
+	response::IdType id(sizeof(uint64_t));
+
+	for (size_t i = 0; i < id.size(); ++i)
+	{
+		id[i] = static_cast<uint8_t>(index >> (i * 8));
+	}
+
+	return id;
+}
+
+// The Query caches the appointments it loads, so each service only calls the loader once and the rest of
+// the iterations only measure the execution.
+std::shared_ptr<today::Operations> makeService(size_t appointmentCount)
+{
+	auto query = std::make_shared<today::Query>(
+		[appointmentCount]() -> std::vector<std::shared_ptr<today::Appointment>>
+		{
+			std::vector<std::shared_ptr<today::Appointment>> appointments(appointmentCount);
+
+			for (size_t i = 0; i < appointmentCount; ++i)
+			{
+				appointments[i] = std::make_shared<today::Appointment>(makeId(i), "tomorrow", "Lunch?", false);
+			}
+
+			return appointments;
+		}, []() -> std::vector<std::shared_ptr<today::Task>>
+		{
+			return { std::make_shared<today::Task>(makeId(0), "Don't forget", true) };
+		}, []() -> std::vector<std::shared_ptr<today::Folder>>
+		{
+			return { std::make_shared<today::Folder>(makeId(0), "\"Fake\" Inbox", 3) };
+		});
+	auto mutation = std::make_shared<today::Mutation>(
+		[](today::CompleteTaskInput&& input) -> std::shared_ptr<today::CompleteTaskPayload>
+		{
+			return std::make_shared<today::CompleteTaskPayload>(
+				std::make_shared<today::Task>(std::move(input.id), "Mutated Task!", *(input.isComplete)),
+				std::move(input.clientMutationId));
+		});
+	auto subscription = std::make_shared<today::NextAppointmentChange>(
+		[](const std::shared_ptr<service::RequestState>&) -> std::shared_ptr<today::Appointment>
+		{
+			return std::make_shared<today::Appointment>(makeId(0), "tomorrow", "Lunch?", true);
+		});
+
+	return std::make_shared<today::Operations>(query, mutation, subscription);
+}
+
+constexpr auto c_appointmentsQuery = R"gql(query Appointments {
+	appointments {
+		pageInfo {
+			hasNextPage
+		}
+		edges {
+			cursor
+			node {
+				id
+				subject
+				when
+				isNow
+				__typename
+			}
+		}
+	}
+})gql";
+
+std::string makeNestedQuery(size_t depth)
+{
+	std::ostringstream query;
+
+	query << "query Nested {\n";
+
+	for (size_t i = 0; i < depth; ++i)
+	{
+		query << "nested { depth\n";
+	}
+
+	for (size_t i = 0; i < depth; ++i)
+	{
+		query << "}\n";
+	}
+
+	query << "}\n";
+
+	return query.str();
+}
+
+// Each fragment selects one more field on the Appointment with its own alias, and they're all spread in the
+// same node.
+std::string makeFragmentQuery(size_t fragmentCount)
+{
+	std::ostringstream query;
+
+	query << "query Fragments {\n\tappointments {\n\t\tedges {\n\t\t\tnode {\n";
+
+	for (size_t i = 0; i < fragmentCount; ++i)
+	{
+		query << "\t\t\t\t...Fragment" << i << "\n";
+	}
+
+	query << "\t\t\t}\n\t\t}\n\t}\n}\n";
+
+	for (size_t i = 0; i < fragmentCount; ++i)
+	{
+		query << "\nfragment Fragment" << i << " on Appointment {\n\tf" << i << ": subject\n}\n";
+	}
+
+	return query.str();
+}
+
+void ListSizes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(10)->Range(10, 100000)->Complexity(benchmark::oN);
+}
+
+void NestingDepths(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(4)->Range(1, 256)->Complexity(benchmark::oN);
+}
+
+void FragmentCounts(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(4)->Range(1, 1024)->Complexity(benchmark::oN);
+}
+
+void SubscriberCounts(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(10)->Range(1, 10000)->Complexity(benchmark::oN);
+}
+
+// Parse
+
+void BM_ParseNested(benchmark::State& state)
+{
+	const auto depth = static_cast<size_t>(state.range(0));
+	const auto query = makeNestedQuery(depth);
+
+	for (auto _ : state)
+	{
+		// The operation's selection set adds one more level on top of the nested fields.
+		auto ast = peg::parseString(query, depth + 1);
+
+		benchmark::DoNotOptimize(ast.root.get());
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * query.size()));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParseNested)->Apply(NestingDepths);
+
+void BM_ParseFragments(benchmark::State& state)
+{
+	const auto query = makeFragmentQuery(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		auto ast = peg::parseString(query);
+
+		benchmark::DoNotOptimize(ast.root.get());
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * query.size()));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParseFragments)->Apply(FragmentCounts);
+
+// Execute
+
+// Stop the benchmark if the query failed, since the errors would make it measure something else.
+bool checkErrors(benchmark::State& state, const response::Value& result)
+{
+	const auto itrErrors = result.find("errors");
+
+	if (itrErrors == result.end())
+	{
+		return true;
+	}
+
+	state.SkipWithError(response::toJSON(response::Value(itrErrors->second)).c_str());
+
+	return false;
+}
+
+void executeQuery(benchmark::State& state, const today::Operations& service, const peg::ast& ast, const std::string& operationName, std::launch launch)
+{
+	for (auto _ : state)
+	{
+		auto result = service.resolve(launch, std::make_shared<today::RequestState>(1), *ast.root, operationName, response::Value(response::Type::Map)).get();
+
+		if (!checkErrors(state, result))
+		{
+			break;
+		}
+
+		benchmark::DoNotOptimize(&result);
+	}
+}
+
+void BM_ExecuteList(benchmark::State& state, std::launch launch)
+{
+	const auto appointmentCount = static_cast<size_t>(state.range(0));
+	const auto service = makeService(appointmentCount);
+	const auto ast = peg::parseString(c_appointmentsQuery);
+
+	executeQuery(state, *service, ast, "Appointments", launch);
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * appointmentCount));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK_CAPTURE(BM_ExecuteList, deferred, std::launch::deferred)->Apply(ListSizes);
+BENCHMARK_CAPTURE(BM_ExecuteList, async, std::launch::async)->Apply(ListSizes);
+
+void BM_ExecuteNested(benchmark::State& state, std::launch launch)
+{
+	const auto depth = static_cast<size_t>(state.range(0));
+	const auto service = makeService(1);
+	const auto ast = peg::parseString(makeNestedQuery(depth), depth + 1);
+
+	// The depth field at the bottom adds one more level of fields.
+	service->setMaxDepth(depth + 1);
+
+	for (auto _ : state)
+	{
+		auto result = service->resolve(launch, std::make_shared<today::RequestState>(1), *ast.root, "Nested", response::Value(response::Type::Map)).get();
+
+		if (!checkErrors(state, result))
+		{
+			break;
+		}
+
+		benchmark::DoNotOptimize(&result);
+
+		// The NestedType in the sample keeps the params for each level, so release them every iteration.
+		auto capturedParams = today::NestedType::getCapturedParams();
+
+		benchmark::DoNotOptimize(&capturedParams);
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK_CAPTURE(BM_ExecuteNested, deferred, std::launch::deferred)->Apply(NestingDepths);
+BENCHMARK_CAPTURE(BM_ExecuteNested, async, std::launch::async)->Apply(NestingDepths);
+
+void BM_ExecuteFragments(benchmark::State& state, std::launch launch)
+{
+	const auto service = makeService(100);
+	const auto ast = peg::parseString(makeFragmentQuery(static_cast<size_t>(state.range(0))));
+
+	executeQuery(state, *service, ast, "Fragments", launch);
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK_CAPTURE(BM_ExecuteFragments, deferred, std::launch::deferred)->Apply(FragmentCounts);
+BENCHMARK_CAPTURE(BM_ExecuteFragments, async, std::launch::async)->Apply(FragmentCounts);
+
+// Serialize
+
+void BM_SerializeList(benchmark::State& state)
+{
+	const auto appointmentCount = static_cast<size_t>(state.range(0));
+	const auto service = makeService(appointmentCount);
+	const auto ast = peg::parseString(c_appointmentsQuery);
+	const auto result = service->resolve(std::make_shared<today::RequestState>(1), *ast.root, "Appointments", response::Value(response::Type::Map)).get();
+	size_t bytes = 0;
+
+	for (auto _ : state)
+	{
+		// toJSON consumes the response, so don't count the copy.
+		state.PauseTiming();
+		response::Value copy(result);
+		state.ResumeTiming();
+
+		const auto json = response::toJSON(std::move(copy));
+
+		bytes += json.size();
+		benchmark::DoNotOptimize(json.data());
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SerializeList)->Apply(ListSizes);
+
+// Stream the same response to a JSONWriter while it's resolved, which includes the execution.
+void BM_ExecuteAndStreamList(benchmark::State& state)
+{
+	const auto appointmentCount = static_cast<size_t>(state.range(0));
+	const auto service = makeService(appointmentCount);
+	const auto ast = peg::parseString(c_appointmentsQuery);
+	size_t bytes = 0;
+
+	for (auto _ : state)
+	{
+		response::JSONWriter writer;
+
+		service->resolve(std::launch::deferred, std::make_shared<today::RequestState>(1), *ast.root, "Appointments", response::Value(response::Type::Map), writer).get();
+
+		const auto json = writer.get_json();
+
+		bytes += json.size();
+		benchmark::DoNotOptimize(json.data());
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ExecuteAndStreamList)->Apply(ListSizes);
+
+// Subscriptions
+
+void BM_DeliverSubscription(benchmark::State& state)
+{
+	const auto subscriberCount = static_cast<size_t>(state.range(0));
+	const auto service = makeService(1);
+	std::vector<service::SubscriptionKey> keys(subscriberCount);
+	size_t delivered = 0;
+
+	for (auto& key : keys)
+	{
+		key = service->subscribe(service::SubscriptionParams {
+				std::make_shared<today::RequestState>(1),
+				peg::parseString(R"gql(subscription Changes {
+					nextAppointmentChange {
+						id
+						subject
+						when
+						isNow
+					}
+				})gql"),
+				"Changes",
+				response::Value(response::Type::Map)
+			},
+			[&delivered](std::future<response::Value> payload)
+			{
+				auto value = payload.get();
+
+				benchmark::DoNotOptimize(&value);
+				++delivered;
+			});
+	}
+
+	for (auto _ : state)
+	{
+		service->deliver("nextAppointmentChange", nullptr);
+	}
+
+	for (const auto key : keys)
+	{
+		service->unsubscribe(key);
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(delivered));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DeliverSubscription)->Apply(SubscriberCounts);
+
+} /* namespace */
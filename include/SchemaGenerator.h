@@ -7,6 +7,7 @@
 #include <graphqlservice/GraphQLGrammar.h>
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 
 namespace graphql::schema {
@@ -171,6 +172,7 @@ struct OutputField
 	std::optional<tao::graphqlpeg::position> position;
 	bool interfaceField = false;
 	bool inheritedField = false;
+	bool batch = false;
 	std::string_view accessor{ strGet };
 };
 
@@ -213,6 +215,30 @@ struct OperationType
 
 using OperationTypeList = std::vector<OperationType>;
 
+// Client operations select a subset of the fields on the output types, the response types we
+// generate for them only have the selected fields, named after the response key (or alias).
+struct ResponseField
+{
+	std::string type;
+	std::string name;
+	std::string cppName;
+	OutputFieldType fieldType = OutputFieldType::Builtin;
+	TypeModifierStack modifiers;
+	std::vector<ResponseField> children;
+};
+
+using ResponseFieldList = std::vector<ResponseField>;
+
+struct ClientOperation
+{
+	std::string name;
+	std::string operation;
+	InputFieldList variables;
+	ResponseFieldList responseFields;
+};
+
+using ClientOperationList = std::vector<ClientOperation>;
+
 struct GeneratorSchema
 {
 	const std::string schemaFilename;
@@ -226,13 +252,17 @@ struct GeneratorPaths
 	const std::string sourcePath;
 };
 
+// The Generator keeps a const copy of the options, so they can be set one at a time before it's constructed.
 struct GeneratorOptions
 {
-	const std::optional<GeneratorSchema> customSchema;
-	const std::optional<GeneratorPaths> paths;
-	const bool verbose = false;
-	const bool separateFiles = false;
-	const bool noStubs = false;
+	std::optional<GeneratorSchema> customSchema;
+	std::optional<GeneratorPaths> paths;
+	bool verbose = false;
+	bool separateFiles = false;
+	bool noStubs = false;
+	bool timing = false;
+	bool noIntrospection = false;
+	std::optional<std::string> operationsFilename;
 };
 
 // RAII object to help with emitting matching namespace begin and end statements
@@ -252,6 +282,29 @@ private:
 	std::string_view _cppNamespace;
 };
 
+// RAII object to report how long each phase of code generation takes, and how the memory usage of the
+// process changed during that phase
+class PhaseTimer
+{
+public:
+	explicit PhaseTimer(bool enabled, std::string_view phase) noexcept;
+	~PhaseTimer() noexcept;
+
+	// Returns the resident memory of the whole process right now, or 0 if it's not available.
+	static size_t getResidentMemoryKB() noexcept;
+
+	// Returns the peak memory usage of the whole process so far, or 0 if it's not available. It never
+	// goes down, so a phase only reports a new peak if it was higher than any of the phases before it.
+	static size_t getPeakMemoryKB() noexcept;
+
+private:
+	const bool _enabled;
+	const std::string_view _phase;
+	const size_t _startMemoryKB;
+	const size_t _startPeakMemoryKB;
+	const std::chrono::steady_clock::time_point _start;
+};
+
 class Generator
 {
 public:
@@ -259,7 +312,7 @@ public:
 	explicit Generator(GeneratorOptions&& options);
 
 	// Run the generator and return a list of filenames that were output.
-	std::vector<std::string> Build() const noexcept;
+	std::vector<std::string> Build() const;
 
 private:
 	void visitDefinition(const peg::ast_node& definition);
@@ -325,6 +378,10 @@ private:
 	};
 
 	void validateSchema();
+	void visitClientOperations();
+	void addResponseFields(ResponseFieldList& fields, const std::string& type, const peg::ast_node& selectionSet, const std::unordered_map<std::string, const peg::ast_node*>& fragments, std::vector<std::string>& fragmentPath, bool conditional) const;
+	bool matchesTypeCondition(const std::string& type, const std::string& typeCondition) const noexcept;
+	static bool hasConditionalDirective(const peg::ast_node& selection) noexcept;
 	void fixupOutputFieldList(OutputFieldList& fields, const std::optional<std::unordered_set<std::string>>& interfaceFields, const std::optional<std::string_view>& accessor);
 	void fixupInputFieldList(InputFieldList& fields);
 
@@ -333,12 +390,15 @@ private:
 	std::string getOutputCppType(const OutputField& field) const noexcept;
 
 	bool outputHeader() const noexcept;
+	void outputHeader(std::ostream& headerFile) const noexcept;
 	void outputObjectDeclaration(std::ostream& headerFile, const ObjectType& objectType, bool isQueryType) const;
 	std::string getFieldDeclaration(const InputField& inputField) const noexcept;
 	std::string getFieldDeclaration(const OutputField& outputField) const noexcept;
+	std::string getBatchFieldDeclaration(const ObjectType& objectType, const OutputField& outputField) const noexcept;
 	std::string getResolverDeclaration(const OutputField& outputField) const noexcept;
 
 	bool outputSource() const noexcept;
+	void outputSource(std::ostream& sourceFile) const noexcept;
 	void outputObjectImplementation(std::ostream& sourceFile, const ObjectType& objectType, bool isQueryType) const;
 	void outputObjectIntrospection(std::ostream& sourceFile, const ObjectType& objectType) const;
 	std::string getArgumentDefaultValue(size_t level, const response::Value& defaultValue) const noexcept;
@@ -346,9 +406,26 @@ private:
 	std::string getArgumentAccessType(const InputField& argument) const noexcept;
 	std::string getResultAccessType(const OutputField& result) const noexcept;
 	std::string getTypeModifiers(const TypeModifierStack& modifiers) const noexcept;
+	std::vector<std::string> getExplicitInstantiations() const noexcept;
 	std::string getIntrospectionType(const std::string& type, const TypeModifierStack& modifiers) const noexcept;
 
-	std::vector<std::string> outputSeparateFiles() const noexcept;
+	bool outputClientHeader() const noexcept;
+	void outputClientHeader(std::ostream& headerFile) const noexcept;
+	void outputResponseFields(std::ostream& headerFile, const ResponseFieldList& fields, const std::string& indent) const noexcept;
+	bool outputClientSource() const noexcept;
+	void outputClientSource(std::ostream& sourceFile) const noexcept;
+	void outputResponseMembers(std::ostream& sourceFile, const std::string& cppType, const ResponseFieldList& fields) const noexcept;
+	std::string getClientNamespace(const ClientOperation& operation) const noexcept;
+	std::string getClientInputCppType(const InputField& field) const noexcept;
+	std::unordered_set<std::string> getClientUsedTypes() const noexcept;
+	std::string getResponseCppType(const ResponseField& field) const noexcept;
+	static std::string getResponseStructName(const ResponseField& field) noexcept;
+
+	std::vector<std::string> outputSeparateFiles() const;
+	void outputSeparateHeader(std::ostream& headerFile, const ObjectType& objectType, bool isQueryType) const;
+	void outputSeparateSource(std::ostream& sourceFile, const ObjectType& objectType, bool isQueryType) const;
+
+	static bool writeIfChanged(const std::string& path, const std::string& content) noexcept;
 
 	static const std::string s_introspectionNamespace;
 	static const BuiltinTypeMap s_builtinTypes;
@@ -364,6 +441,8 @@ private:
 	const std::string _headerPath;
 	const std::string _objectHeaderPath;
 	const std::string _sourcePath;
+	const std::string _clientHeaderPath;
+	const std::string _clientSourcePath;
 
 	SchemaTypeMap _schemaTypes;
 	PositionMap _typePositions;
@@ -382,6 +461,8 @@ private:
 	DirectiveList _directives;
 	PositionMap _directivePositions;
 	OperationTypeList _operationTypes;
+	std::string _requestText;
+	ClientOperationList _clientOperations;
 };
 
 } /* namespace graphql::schema */
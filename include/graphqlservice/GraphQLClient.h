@@ -0,0 +1,606 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <graphqlservice/GraphQLService.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace graphql::client {
+
+// Read the values at one level of nesting in a response, i.e. the members of an object or the elements
+// of a list, and store them directly in the typed result. By default every value is unexpected.
+class Reader
+{
+public:
+	virtual ~Reader() = default;
+
+	virtual void add_member_key(std::string_view key);
+
+	// Return the reader for the members or elements of the nested object or list.
+	virtual std::unique_ptr<Reader> start_object();
+	virtual std::unique_ptr<Reader> start_array();
+
+	// Called at the end of the object or list, right before the reader is discarded.
+	virtual void end();
+
+	virtual void add_null();
+	virtual void add_string(std::string_view value);
+	virtual void add_bool(response::BooleanType value);
+	virtual void add_int(response::IntType value);
+	virtual void add_float(response::FloatType value);
+};
+
+// Ignore a value which the typed result did not select, including any nested objects or lists.
+class SkipReader : public Reader
+{
+public:
+	void add_member_key(std::string_view key) override;
+
+	std::unique_ptr<Reader> start_object() override;
+	std::unique_ptr<Reader> start_array() override;
+
+	void add_null() override;
+	void add_string(std::string_view value) override;
+	void add_bool(response::BooleanType value) override;
+	void add_int(response::IntType value) override;
+	void add_float(response::FloatType value) override;
+};
+
+// Build a response::Value for custom scalars and for the errors in a response.
+class ValueBuilder : public Reader
+{
+public:
+	// Build an object or a list and store it in the target at the end.
+	explicit ValueBuilder(response::Value& target, response::Type type);
+
+	// Build a nested object or list and add it to the parent at the end.
+	explicit ValueBuilder(ValueBuilder& parent, response::Type type);
+
+	void add_member_key(std::string_view key) override;
+
+	std::unique_ptr<Reader> start_object() override;
+	std::unique_ptr<Reader> start_array() override;
+	void end() override;
+
+	void add_null() override;
+	void add_string(std::string_view value) override;
+	void add_bool(response::BooleanType value) override;
+	void add_int(response::IntType value) override;
+	void add_float(response::FloatType value) override;
+
+private:
+	void addValue(response::Value&& value);
+
+	response::Value* const _target = nullptr;
+	ValueBuilder* const _parent = nullptr;
+	response::Value _value;
+	std::string _key;
+};
+
+// Each of the ValueReader specializations hides the events it accepts, the rest of them are errors.
+template <typename Type>
+struct UnexpectedValue
+{
+	static void add_null(Type&)
+	{
+		throw service::schema_exception({ "unexpected null value" });
+	}
+
+	static void add_string(Type&, std::string_view)
+	{
+		throw service::schema_exception({ "unexpected String value" });
+	}
+
+	static void add_bool(Type&, response::BooleanType)
+	{
+		throw service::schema_exception({ "unexpected Boolean value" });
+	}
+
+	static void add_int(Type&, response::IntType)
+	{
+		throw service::schema_exception({ "unexpected Int value" });
+	}
+
+	static void add_float(Type&, response::FloatType)
+	{
+		throw service::schema_exception({ "unexpected Float value" });
+	}
+
+	static std::unique_ptr<Reader> start_object(Type&)
+	{
+		throw service::schema_exception({ "unexpected object value" });
+	}
+
+	static std::unique_ptr<Reader> start_array(Type&)
+	{
+		throw service::schema_exception({ "unexpected list value" });
+	}
+};
+
+// The generated client code specializes this for each of the response types with a sorted array of the
+// response keys, a matching array which flags the non-null members, and a visit function which calls the
+// visitor with the member at that index.
+template <typename Object>
+struct ResponseMembers;
+
+// Read the members of one of the generated response types.
+template <typename Object>
+class ObjectReader;
+
+// Convert the events for a single value to the C++ type in the typed result. The generated client code
+// specializes this for each of the enum types, and the default reads one of the response types.
+template <typename Type>
+struct ValueReader : UnexpectedValue<Type>
+{
+	static std::unique_ptr<Reader> start_object(Type& value)
+	{
+		return std::make_unique<ObjectReader<Type>>(value);
+	}
+};
+
+template <>
+struct ValueReader<response::IntType> : UnexpectedValue<response::IntType>
+{
+	static void add_int(response::IntType& value, response::IntType input)
+	{
+		value = input;
+	}
+};
+
+template <>
+struct ValueReader<response::FloatType> : UnexpectedValue<response::FloatType>
+{
+	static void add_int(response::FloatType& value, response::IntType input)
+	{
+		value = static_cast<response::FloatType>(input);
+	}
+
+	static void add_float(response::FloatType& value, response::FloatType input)
+	{
+		value = input;
+	}
+};
+
+template <>
+struct ValueReader<response::StringType> : UnexpectedValue<response::StringType>
+{
+	static void add_string(response::StringType& value, std::string_view input)
+	{
+		value.assign(input.cbegin(), input.cend());
+	}
+};
+
+template <>
+struct ValueReader<response::BooleanType> : UnexpectedValue<response::BooleanType>
+{
+	static void add_bool(response::BooleanType& value, response::BooleanType input)
+	{
+		value = input;
+	}
+};
+
+template <>
+struct ValueReader<response::IdType> : UnexpectedValue<response::IdType>
+{
+	static void add_string(response::IdType& value, std::string_view input)
+	{
+		value = service::Base64::fromBase64(input.data(), input.size());
+	}
+};
+
+// Custom scalars are left as a response::Value.
+template <>
+struct ValueReader<response::Value>
+{
+	static void add_null(response::Value& value)
+	{
+		value = response::Value();
+	}
+
+	static void add_string(response::Value& value, std::string_view input)
+	{
+		value = response::Value(response::StringType{ input }).from_json();
+	}
+
+	static void add_bool(response::Value& value, response::BooleanType input)
+	{
+		value = response::Value(input);
+	}
+
+	static void add_int(response::Value& value, response::IntType input)
+	{
+		value = response::Value(input);
+	}
+
+	static void add_float(response::Value& value, response::FloatType input)
+	{
+		value = response::Value(input);
+	}
+
+	static std::unique_ptr<Reader> start_object(response::Value& value)
+	{
+		return std::make_unique<ValueBuilder>(value, response::Type::Map);
+	}
+
+	static std::unique_ptr<Reader> start_array(response::Value& value)
+	{
+		return std::make_unique<ValueBuilder>(value, response::Type::List);
+	}
+};
+
+template <typename Type>
+struct ValueReader<std::optional<Type>>
+{
+	static void add_null(std::optional<Type>& value)
+	{
+		value.reset();
+	}
+
+	static void add_string(std::optional<Type>& value, std::string_view input)
+	{
+		ValueReader<Type>::add_string(value.emplace(), input);
+	}
+
+	static void add_bool(std::optional<Type>& value, response::BooleanType input)
+	{
+		ValueReader<Type>::add_bool(value.emplace(), input);
+	}
+
+	static void add_int(std::optional<Type>& value, response::IntType input)
+	{
+		ValueReader<Type>::add_int(value.emplace(), input);
+	}
+
+	static void add_float(std::optional<Type>& value, response::FloatType input)
+	{
+		ValueReader<Type>::add_float(value.emplace(), input);
+	}
+
+	static std::unique_ptr<Reader> start_object(std::optional<Type>& value)
+	{
+		return ValueReader<Type>::start_object(value.emplace());
+	}
+
+	static std::unique_ptr<Reader> start_array(std::optional<Type>& value)
+	{
+		return ValueReader<Type>::start_array(value.emplace());
+	}
+};
+
+// Read the elements of a list.
+template <typename Type>
+class ListReader : public Reader
+{
+public:
+	explicit ListReader(std::vector<Type>& value) noexcept
+		: _value(value)
+	{
+	}
+
+	std::unique_ptr<Reader> start_object() override
+	{
+		// std::vector<bool> can't return a reference to a single element.
+		if constexpr (std::is_same_v<Type, response::BooleanType>)
+		{
+			return Reader::start_object();
+		}
+		else
+		{
+			return ValueReader<Type>::start_object(_value.emplace_back());
+		}
+	}
+
+	std::unique_ptr<Reader> start_array() override
+	{
+		if constexpr (std::is_same_v<Type, response::BooleanType>)
+		{
+			return Reader::start_array();
+		}
+		else
+		{
+			return ValueReader<Type>::start_array(_value.emplace_back());
+		}
+	}
+
+	void add_null() override
+	{
+		addElement([](Type& element) {
+			ValueReader<Type>::add_null(element);
+		});
+	}
+
+	void add_string(std::string_view value) override
+	{
+		addElement([value](Type& element) {
+			ValueReader<Type>::add_string(element, value);
+		});
+	}
+
+	void add_bool(response::BooleanType value) override
+	{
+		addElement([value](Type& element) {
+			ValueReader<Type>::add_bool(element, value);
+		});
+	}
+
+	void add_int(response::IntType value) override
+	{
+		addElement([value](Type& element) {
+			ValueReader<Type>::add_int(element, value);
+		});
+	}
+
+	void add_float(response::FloatType value) override
+	{
+		addElement([value](Type& element) {
+			ValueReader<Type>::add_float(element, value);
+		});
+	}
+
+private:
+	template <typename AddValue>
+	void addElement(AddValue&& addValue)
+	{
+		Type element{};
+
+		addValue(element);
+		_value.push_back(std::move(element));
+	}
+
+	std::vector<Type>& _value;
+};
+
+template <typename Type>
+struct ValueReader<std::vector<Type>> : UnexpectedValue<std::vector<Type>>
+{
+	static std::unique_ptr<Reader> start_array(std::vector<Type>& value)
+	{
+		value.clear();
+
+		return std::make_unique<ListReader<Type>>(value);
+	}
+};
+
+template <typename Object>
+class ObjectReader : public Reader
+{
+public:
+	explicit ObjectReader(Object& value) noexcept
+		: _value(value)
+	{
+	}
+
+	void add_member_key(std::string_view key) override
+	{
+		const auto& keys = ResponseMembers<Object>::keys;
+		const auto itr = std::lower_bound(keys.cbegin(), keys.cend(), key);
+
+		// Any other index is skipped by ResponseMembers<Object>::visit.
+		_member = (itr != keys.cend() && *itr == key)
+			? static_cast<size_t>(itr - keys.cbegin())
+			: keys.size();
+
+		if (_member < keys.size())
+		{
+			_present[_member] = true;
+		}
+	}
+
+	// The non-null members must all be in the response, even though the typed result has a default value.
+	void end() override
+	{
+		const auto& keys = ResponseMembers<Object>::keys;
+		const auto& required = ResponseMembers<Object>::required;
+
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			if (required[i] && !_present[i])
+			{
+				throw service::schema_exception({ "missing non-null field: " + std::string { keys[i] } });
+			}
+		}
+	}
+
+	std::unique_ptr<Reader> start_object() override
+	{
+		std::unique_ptr<Reader> result;
+
+		ResponseMembers<Object>::visit(_value, _member, [&result](auto& member) {
+			result = ValueReader<std::decay_t<decltype(member)>>::start_object(member);
+		});
+
+		return result ? std::move(result) : std::make_unique<SkipReader>();
+	}
+
+	std::unique_ptr<Reader> start_array() override
+	{
+		std::unique_ptr<Reader> result;
+
+		ResponseMembers<Object>::visit(_value, _member, [&result](auto& member) {
+			result = ValueReader<std::decay_t<decltype(member)>>::start_array(member);
+		});
+
+		return result ? std::move(result) : std::make_unique<SkipReader>();
+	}
+
+	void add_null() override
+	{
+		ResponseMembers<Object>::visit(_value, _member, [](auto& member) {
+			ValueReader<std::decay_t<decltype(member)>>::add_null(member);
+		});
+	}
+
+	void add_string(std::string_view value) override
+	{
+		ResponseMembers<Object>::visit(_value, _member, [value](auto& member) {
+			ValueReader<std::decay_t<decltype(member)>>::add_string(member, value);
+		});
+	}
+
+	void add_bool(response::BooleanType value) override
+	{
+		ResponseMembers<Object>::visit(_value, _member, [value](auto& member) {
+			ValueReader<std::decay_t<decltype(member)>>::add_bool(member, value);
+		});
+	}
+
+	void add_int(response::IntType value) override
+	{
+		ResponseMembers<Object>::visit(_value, _member, [value](auto& member) {
+			ValueReader<std::decay_t<decltype(member)>>::add_int(member, value);
+		});
+	}
+
+	void add_float(response::FloatType value) override
+	{
+		ResponseMembers<Object>::visit(_value, _member, [value](auto& member) {
+			ValueReader<std::decay_t<decltype(member)>>::add_float(member, value);
+		});
+	}
+
+private:
+	Object& _value;
+	size_t _member = 0;
+	std::decay_t<decltype(ResponseMembers<Object>::required)> _present {};
+};
+
+// Read the response to a client request directly into the typed Response for the operation, e.g. by
+// passing this to response::parseJSON. Any errors in the response are collected in a response::Value.
+class ResponseReader : public response::Writer
+{
+public:
+	explicit ResponseReader(std::unique_ptr<Reader> data) noexcept;
+
+	void start_object() override;
+	void add_member_key(std::string_view key) override;
+	void end_object() override;
+
+	void start_array() override;
+	void end_array() override;
+
+	void add_null() override;
+	void add_string(std::string_view value) override;
+	void add_enum(std::string_view value) override;
+	void add_bool(response::BooleanType value) override;
+	void add_int(response::IntType value) override;
+	void add_float(response::FloatType value) override;
+
+	// Replay a response which was already parsed into a response::Value.
+	void add_value(response::Value&& value) override;
+
+	// Return the errors list from the response, or null if there were no errors.
+	response::Value getErrors() noexcept;
+
+private:
+	Reader& top();
+
+	std::unique_ptr<Reader> _data;
+	response::Value _errors;
+	std::vector<std::unique_ptr<Reader>> _readers;
+};
+
+// Convert the typed variables for an operation to a response::Value. The generated client code
+// specializes this for each of the enum and input types.
+template <typename Type>
+struct Variable;
+
+template <>
+struct Variable<response::IntType>
+{
+	static response::Value serialize(response::IntType&& value)
+	{
+		return response::Value(value);
+	}
+};
+
+template <>
+struct Variable<response::FloatType>
+{
+	static response::Value serialize(response::FloatType&& value)
+	{
+		return response::Value(value);
+	}
+};
+
+template <>
+struct Variable<response::StringType>
+{
+	static response::Value serialize(response::StringType&& value)
+	{
+		return response::Value(std::move(value));
+	}
+};
+
+template <>
+struct Variable<response::BooleanType>
+{
+	static response::Value serialize(response::BooleanType&& value)
+	{
+		return response::Value(value);
+	}
+};
+
+template <>
+struct Variable<response::IdType>
+{
+	static response::Value serialize(response::IdType&& value)
+	{
+		return response::Value(service::Base64::toBase64(value));
+	}
+};
+
+template <>
+struct Variable<response::Value>
+{
+	static response::Value serialize(response::Value&& value)
+	{
+		return std::move(value);
+	}
+};
+
+template <typename Type>
+struct Variable<std::optional<Type>>
+{
+	static response::Value serialize(std::optional<Type>&& value)
+	{
+		if (!value)
+		{
+			return {};
+		}
+
+		return Variable<Type>::serialize(std::move(*value));
+	}
+};
+
+template <typename Type>
+struct Variable<std::vector<Type>>
+{
+	static response::Value serialize(std::vector<Type>&& value)
+	{
+		response::Value result(response::Type::List);
+
+		result.reserve(value.size());
+
+		// Use a forwarding reference for the std::vector<bool> element proxies.
+		for (auto&& entry : value)
+		{
+			result.emplace_back(Variable<Type>::serialize(std::move(entry)));
+		}
+
+		return result;
+	}
+};
+
+// Build the request object with the query, operationName, and variables members.
+response::Value buildRequest(std::string_view requestText, std::string_view operationName, response::Value&& variables);
+
+} /* namespace graphql::client */
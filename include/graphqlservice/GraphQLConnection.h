@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <graphqlservice/GraphQLService.h>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace graphql::service {
+
+// The Relay connection arguments: https://facebook.github.io/relay/graphql/connections.htm#sec-Arguments
+struct ConnectionArguments
+{
+	std::optional<response::IntType> first;
+	std::optional<response::Value> after;
+	std::optional<response::IntType> last;
+	std::optional<response::Value> before;
+};
+
+// Cursors are opaque Base64 strings. Offset and key cursors start with a tag for the kind of cursor, so
+// a cursor from an offset connection can't be mistaken for a key in a sorted connection or vice versa.
+class Cursor
+{
+public:
+	// Sources which look up each element by its ID use the Base64 encoded ID without a tag.
+	static response::Value fromId(const response::IdType& id);
+	static response::IdType toId(const response::Value& cursor);
+
+	// Random access sources use the offset of each element as its cursor.
+	static response::Value fromOffset(size_t offset);
+	static size_t toOffset(const response::Value& cursor);
+
+	// Sorted sources use the key of each element as its cursor.
+	static response::Value fromKey(const response::IdType& key);
+	static response::IdType toKey(const response::Value& cursor);
+
+private:
+	static constexpr uint8_t offsetTag = 'o';
+	static constexpr uint8_t keyTag = 'k';
+
+	static response::IdType decode(const response::Value& cursor, uint8_t tag);
+};
+
+// The half-open range [begin, end) of a source which is selected by the connection arguments.
+struct ConnectionSlice
+{
+	size_t begin = 0;
+	size_t end = 0;
+	bool hasPreviousPage = false;
+	bool hasNextPage = false;
+
+	// Apply first and last to the range between the after and before cursors. Like the Relay spec,
+	// hasNextPage is only set if first removed elements, and hasPreviousPage is only set if last removed
+	// elements. They don't say whether there are any elements outside of the after and before cursors.
+	static ConnectionSlice limit(size_t count, size_t begin, size_t end, const ConnectionArguments& arguments);
+};
+
+// Select the page of a random access source with count elements. The after and before cursors are
+// decoded straight to offsets, so this does not need to look at any of the elements.
+ConnectionSlice sliceByOffset(size_t count, const ConnectionArguments& arguments);
+
+// Select the page of a source which is sorted by the keys that projection returns for each element.
+// The after and before cursors are found with a binary search.
+template <typename RandomIt, typename Projection>
+ConnectionSlice sliceByKey(RandomIt first, RandomIt last, Projection&& projection, const ConnectionArguments& arguments)
+{
+	const auto count = static_cast<size_t>(std::distance(first, last));
+	auto itrBegin = first;
+	auto itrEnd = last;
+
+	if (arguments.after)
+	{
+		const auto afterKey = Cursor::toKey(*arguments.after);
+
+		itrBegin = std::upper_bound(first, last, afterKey,
+			[&projection](const response::IdType& key, const auto& element)
+			{
+				return key < projection(element);
+			});
+	}
+
+	if (arguments.before)
+	{
+		const auto beforeKey = Cursor::toKey(*arguments.before);
+
+		itrEnd = std::lower_bound(itrBegin, last, beforeKey,
+			[&projection](const auto& element, const response::IdType& key)
+			{
+				return projection(element) < key;
+			});
+	}
+
+	return ConnectionSlice::limit(count,
+		static_cast<size_t>(std::distance(first, itrBegin)),
+		static_cast<size_t>(std::distance(first, itrEnd)),
+		arguments);
+}
+
+// Select the page of a source with count elements using ID cursors. The indexOf function returns the
+// offset of the element with that ID, or std::nullopt if there isn't one, in which case the cursor is
+// ignored.
+template <typename IndexOf>
+ConnectionSlice sliceById(size_t count, IndexOf&& indexOf, const ConnectionArguments& arguments)
+{
+	size_t begin = 0;
+	size_t end = count;
+
+	if (arguments.after)
+	{
+		const std::optional<size_t> after = indexOf(Cursor::toId(*arguments.after));
+
+		if (after && *after < count)
+		{
+			begin = *after + 1;
+		}
+	}
+
+	if (arguments.before)
+	{
+		const std::optional<size_t> before = indexOf(Cursor::toId(*arguments.before));
+
+		if (before && *before < count)
+		{
+			end = std::max(begin, *before);
+		}
+	}
+
+	return ConnectionSlice::limit(count, begin, end, arguments);
+}
+
+// Build the edges of a slice as they are resolved, so only the elements in the requested page are
+// visited. The factory takes the offset of each element in the source and returns its edge.
+template <typename Edge, typename Factory>
+ListGenerator<Edge> makeEdges(const ConnectionSlice& slice, Factory&& factory)
+{
+	return ListGenerator<Edge>(
+		[factory = std::forward<Factory>(factory), index = slice.begin, end = slice.end]() mutable -> std::optional<Edge>
+		{
+			if (index >= end)
+			{
+				return std::nullopt;
+			}
+
+			return std::make_optional<Edge>(factory(index++));
+		});
+}
+
+} /* namespace graphql::service */
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <graphqlservice/GraphQLService.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace graphql::service {
+
+// A latency histogram with log-linear buckets in the style of HdrHistogram. Each power of two
+// microseconds is split into 2 buckets, so the upper bound of every bucket is within 50% of the values
+// in it. Anything over the last bound (about 134 seconds) is only counted in the total.
+struct MetricsHistogram
+{
+	static constexpr size_t subBucketBits = 1;
+	static constexpr size_t subBucketCount = size_t(1) << subBucketBits;
+	static constexpr size_t bucketCount = 54;
+
+	// Get the bucket for a value in microseconds, or bucketCount if it's over the last bound.
+	static size_t getBucket(uint64_t microseconds) noexcept;
+
+	// Get the exclusive upper bound of a bucket in microseconds.
+	static uint64_t getUpperBound(size_t bucket) noexcept;
+
+	std::vector<uint64_t> buckets = std::vector<uint64_t>(bucketCount);
+	uint64_t count = 0;
+	uint64_t sumMicroseconds = 0;
+};
+
+// The counters for a single series, identified by 2 labels. Fields are labeled with their parent type and
+// field name, and operations are labeled with their operation type and name. If the operation has a
+// QuerySignature, the name is followed by # and the hash, so different queries with the same name are
+// counted separately and formatting or literal values don't split them up.
+struct MetricsSeries
+{
+	std::string first;
+	std::string second;
+	uint64_t calls = 0;
+	uint64_t errors = 0;
+	MetricsHistogram latency;
+};
+
+// A copy of the counters merged from every shard, sorted by their labels.
+struct MetricsSnapshot
+{
+	std::vector<MetricsSeries> fields;
+	std::vector<MetricsSeries> operations;
+
+	// The number of calls which weren't counted because the table in a shard was full.
+	uint64_t dropped = 0;
+};
+
+// Aggregate the number of calls, errors, and latency of every field and operation across all of the
+// requests which use it. Install it with Request::setInstrumentation. Each thread updates its own
+// shard with relaxed atomic operations, and new series are added to a shard without taking a lock.
+class Metrics : public Instrumentation
+{
+public:
+	// The shardCount defaults to std::thread::hardware_concurrency(). Each shard can hold up to
+	// capacity distinct fields and operations, which is rounded up to a power of 2.
+	explicit Metrics(size_t shardCount = 0, size_t capacity = 1024);
+	~Metrics() override;
+
+	std::shared_ptr<OperationListener> beginOperation(const std::shared_ptr<RequestState>& state,
+		std::string_view operationType, std::string_view operationName, const peg::QuerySignature* signature) override;
+
+	void recordField(std::string_view parentType, std::string_view fieldName,
+		std::chrono::steady_clock::duration duration, bool error);
+	void recordOperation(std::string_view operationType, std::string_view operationName,
+		std::chrono::steady_clock::duration duration, size_t errors);
+
+	// Read the counters. The shards are updated concurrently, so a snapshot isn't an atomic cut of all of
+	// them, but each counter is only ever counted once if it's reset.
+	MetricsSnapshot snapshot(bool reset = false);
+
+private:
+	struct Entry;
+	struct Shard;
+
+	Shard& getShard() const noexcept;
+
+	const std::vector<std::unique_ptr<Shard>> _shards;
+	std::atomic<uint64_t> _dropped = 0;
+};
+
+// Render a snapshot in the Prometheus text exposition format, with the metric names starting with
+// prefix, e.g. graphql_field_calls_total{type="Query",field="appointments"}.
+std::string toPrometheus(const MetricsSnapshot& snapshot, std::string_view prefix = "graphql");
+
+} /* namespace graphql::service */
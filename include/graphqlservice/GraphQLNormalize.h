@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace graphql::peg {
+
+struct ast_node;
+
+// A 128-bit hash of the canonical text of a query.
+struct QueryHash
+{
+	uint64_t high = 0;
+	uint64_t low = 0;
+
+	bool operator==(const QueryHash& rhs) const noexcept
+	{
+		return high == rhs.high && low == rhs.low;
+	}
+
+	bool operator!=(const QueryHash& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	// Format the hash as 32 lowercase hex digits.
+	std::string toString() const;
+};
+
+// The identity of a query which doesn't depend on how it was formatted. Compute it once for each
+// parsed document you cache and reuse it as a cache key, or with hideLiterals as a metrics label.
+struct QuerySignature
+{
+	std::string text;
+	QueryHash hash;
+};
+
+// Print the canonical text of the operation with the matching name, or of every operation if the
+// name is empty, followed by the fragment definitions which they use:
+// - Whitespace, commas and comments are normalized and the shorthand query form gets its operation type.
+// - Arguments, object fields, directives and variable definitions are sorted, but selections keep their
+//   order because that's the order of the fields in the response.
+// - Fragment definitions which aren't used are dropped and the rest are sorted by name.
+// - With hideLiterals, numbers become 0, strings become "", and lists and objects become [] and {}.
+//   Variables, booleans, null and enum values are kept. Queries which only differ in those literals
+//   get the same text, so only hide them to group queries, never to pick a cached document.
+std::string normalizeQuery(const ast_node& root, std::string_view operationName = {}, bool hideLiterals = false);
+
+// Hash the canonical text with the 128-bit version of MurmurHash3.
+QueryHash hashQuery(std::string_view text) noexcept;
+
+QuerySignature getQuerySignature(const ast_node& root, std::string_view operationName = {}, bool hideLiterals = false);
+
+} /* namespace graphql::peg */
+
+namespace std {
+
+template <>
+struct hash<graphql::peg::QueryHash>
+{
+	size_t operator()(const graphql::peg::QueryHash& queryHash) const noexcept
+	{
+		// The bits are already well mixed, so just fold them together.
+		return static_cast<size_t>(queryHash.high ^ queryHash.low);
+	}
+};
+
+} /* namespace std */
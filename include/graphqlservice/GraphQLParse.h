@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace graphql {
 namespace peg {
@@ -12,14 +15,40 @@ namespace peg {
 struct ast_node;
 struct ast_input;
 
+// The operation definitions in a document, indexed once when it's parsed so picking one operation
+// by name doesn't need to scan the rest of them. The views point into the document, so the index
+// is only valid while the ast which owns it is still alive.
+struct OperationIndex
+{
+	struct Operation
+	{
+		std::string_view type;
+		std::string_view name;
+		const ast_node* definition = nullptr;
+	};
+
+	// Every operation in document order.
+	std::vector<Operation> operations;
+
+	// The positions of each named operation in operations. More than one position is a duplicate name.
+	std::unordered_map<std::string_view, std::vector<size_t>> names;
+};
+
 struct ast
 {
 	std::shared_ptr<ast_input> input;
 	std::shared_ptr<ast_node> root;
+	std::shared_ptr<const OperationIndex> operations;
 };
 
-ast parseString(std::string_view input);
-ast parseFile(std::string_view filename);
+std::shared_ptr<const OperationIndex> indexOperations(const ast_node& root);
+
+// The parser recurses once for each nested selection set, list, or input object, so it stops with a
+// parse_error instead of running out of stack when a document is nested deeper than the limit.
+constexpr size_t defaultDepthLimit = 256;
+
+ast parseString(std::string_view input, size_t depthLimit = defaultDepthLimit);
+ast parseFile(std::string_view filename, size_t depthLimit = defaultDepthLimit);
 
 } /* namespace peg */
 
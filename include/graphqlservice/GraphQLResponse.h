@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 
@@ -35,7 +39,156 @@ using BooleanType = bool;
 using IntType = int;
 using FloatType = double;
 using ScalarType = Value;
-using IdType = std::vector<uint8_t>;
+
+// IDs are opaque byte strings which are usually only a few bytes long, so IdType stores up to
+// inline_capacity bytes in place and only allocates for longer values.
+class IdType
+{
+public:
+	using value_type = uint8_t;
+	using size_type = size_t;
+	using reference = uint8_t&;
+	using const_reference = const uint8_t&;
+	using pointer = uint8_t*;
+	using const_pointer = const uint8_t*;
+	using iterator = uint8_t*;
+	using const_iterator = const uint8_t*;
+
+	static constexpr size_t inline_capacity = 24;
+
+	IdType() noexcept = default;
+	explicit IdType(size_t count, uint8_t value = 0);
+	IdType(std::initializer_list<uint8_t> values);
+	IdType(const uint8_t* data, size_t count);
+
+	template <class InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	IdType(InputIt first, InputIt last)
+	{
+		for (; first != last; ++first)
+		{
+			push_back(static_cast<uint8_t>(*first));
+		}
+	}
+
+	IdType(const IdType& other);
+	IdType(IdType&& other) noexcept;
+	~IdType();
+
+	IdType& operator=(const IdType& rhs);
+	IdType& operator=(IdType&& rhs) noexcept;
+
+	size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	size_t capacity() const noexcept
+	{
+		return isInline() ? inline_capacity : _heap.capacity;
+	}
+
+	uint8_t* data() noexcept
+	{
+		return isInline() ? _inline : _heap.data;
+	}
+
+	const uint8_t* data() const noexcept
+	{
+		return isInline() ? _inline : _heap.data;
+	}
+
+	iterator begin() noexcept
+	{
+		return data();
+	}
+
+	iterator end() noexcept
+	{
+		return data() + _size;
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return data();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return data() + _size;
+	}
+
+	const_iterator cbegin() const noexcept
+	{
+		return data();
+	}
+
+	const_iterator cend() const noexcept
+	{
+		return data() + _size;
+	}
+
+	uint8_t& operator[](size_t pos) noexcept
+	{
+		return data()[pos];
+	}
+
+	const uint8_t& operator[](size_t pos) const noexcept
+	{
+		return data()[pos];
+	}
+
+	void reserve(size_t count);
+	void resize(size_t count, uint8_t value = 0);
+	void clear() noexcept;
+
+	void push_back(uint8_t value)
+	{
+		if (_size == capacity())
+		{
+			reserve(_size * 2);
+		}
+
+		data()[_size++] = value;
+	}
+
+	uint8_t& emplace_back(uint8_t value)
+	{
+		push_back(value);
+		return data()[_size - 1];
+	}
+
+	bool operator==(const IdType& rhs) const noexcept;
+	bool operator!=(const IdType& rhs) const noexcept;
+	bool operator<(const IdType& rhs) const noexcept;
+
+private:
+	bool isInline() const noexcept
+	{
+		return !_allocated;
+	}
+
+	void release() noexcept;
+
+	struct HeapData
+	{
+		uint8_t* data;
+		size_t capacity;
+	};
+
+	size_t _size = 0;
+	bool _allocated = false;
+
+	union
+	{
+		uint8_t _inline[inline_capacity];
+		HeapData _heap;
+	};
+};
 
 struct TypedData;
 
@@ -97,8 +250,36 @@ struct Value
 	ValueType release();
 
 private:
+	TypedData& mutableData();
+
 	const Type _type;
-	std::unique_ptr<TypedData> _data;
+	std::shared_ptr<TypedData> _data;
+};
+
+// Write a response in a serialization format like JSON directly from the typed results instead of
+// building a Value first. Each of the add_* methods writes a single value, either as the next element
+// of an array or as the value of the last key added to an object.
+class Writer
+{
+public:
+	virtual ~Writer() = default;
+
+	virtual void start_object() = 0;
+	virtual void add_member_key(std::string_view key) = 0;
+	virtual void end_object() = 0;
+
+	virtual void start_array() = 0;
+	virtual void end_array() = 0;
+
+	virtual void add_null() = 0;
+	virtual void add_string(std::string_view value) = 0;
+	virtual void add_enum(std::string_view value) = 0;
+	virtual void add_bool(BooleanType value) = 0;
+	virtual void add_int(IntType value) = 0;
+	virtual void add_float(FloatType value) = 0;
+
+	// Write a complete Value, e.g. a custom scalar or the errors collected while resolving.
+	virtual void add_value(Value&& value) = 0;
 };
 
 } /* namespace graphql::response */
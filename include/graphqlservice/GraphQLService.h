@@ -3,9 +3,14 @@
 
 #pragma once
 
+#include <graphqlservice/GraphQLNormalize.h>
 #include <graphqlservice/GraphQLParse.h>
 #include <graphqlservice/GraphQLResponse.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <variant>
@@ -14,11 +19,14 @@
 #include <sstream>
 #include <vector>
 #include <functional>
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
 #include <type_traits>
 #include <future>
+#include <mutex>
+#include <new>
 #include <queue>
 #include <map>
 #include <set>
@@ -36,16 +44,103 @@ public:
 	const response::Value& getErrors() const noexcept;
 	response::Value getErrors() noexcept;
 
+	// Wrap the errors list from a response, e.g. in the generated client code.
+	static schema_exception fromErrors(response::Value&& errors) noexcept;
+
 private:
+	schema_exception() = default;
+
 	response::Value _errors;
 };
 
+// Field errors use the first message from a schema_exception, since its what() doesn't include any of
+// them, or what() for any other exception.
+const char* getErrorMessage(const std::exception& ex) noexcept;
+
+// Account for the memory used by a single request, split between the parse tree, the execution state of
+// each field (parameters, futures, and response paths), and the result. The sizes are estimated from the
+// data structures rather than measured in the allocator, so they're meant for attributing memory spikes to
+// requests and enforcing a budget, not for exact totals.
+class MemoryBudget
+{
+public:
+	enum class Category : uint8_t
+	{
+		Parse,
+		Execution,
+		Result,
+	};
+
+	// A limit of 0 bytes means the request is unlimited.
+	explicit MemoryBudget(size_t limit = 0) noexcept;
+
+	void charge(Category category, size_t bytes, size_t allocations) noexcept;
+	void chargeParseTree(const peg::ast_node& root) noexcept;
+	void chargeField(bool trackPath) noexcept;
+	void chargeResult(std::string_view name, const response::Value& value) noexcept;
+
+	// Throw a schema_exception if the request is over its limit.
+	void check() const;
+
+	bool exceeded() const noexcept;
+	size_t getLimit() const noexcept;
+	size_t getBytes() const noexcept;
+	size_t getBytes(Category category) const noexcept;
+	size_t getAllocations(Category category) const noexcept;
+
+private:
+	static constexpr size_t categoryCount = 3;
+
+	const size_t _limit;
+	std::atomic<size_t> _total {};
+	std::array<std::atomic<size_t>, categoryCount> _bytes {};
+	std::array<std::atomic<size_t>, categoryCount> _allocations {};
+};
+
+// Stop resolving a request once it's cancelled or its deadline passes. The service checks it before it
+// calls each resolver or converts each element of a list of objects, and the fields it skips have a
+// "Request cancelled" or "Request deadline exceeded" error. Long running resolvers can check it too.
+class CancellationToken
+{
+public:
+	CancellationToken() noexcept;
+	explicit CancellationToken(std::chrono::steady_clock::time_point deadline) noexcept;
+	explicit CancellationToken(std::chrono::steady_clock::duration timeout) noexcept;
+
+	// Cancel the request, e.g. when the client disconnects. This is safe to call from any thread.
+	void cancel() noexcept;
+
+	bool isCancelled() const noexcept;
+	const std::optional<std::chrono::steady_clock::time_point>& getDeadline() const noexcept;
+
+	// Throw a schema_exception if the request was cancelled or the deadline has passed.
+	void check() const;
+
+private:
+	const std::optional<std::chrono::steady_clock::time_point> _deadline;
+	std::atomic_bool _cancelled { false };
+
+	// Once the deadline has passed, skip reading the clock again.
+	mutable std::atomic_bool _expired { false };
+};
+
 // The RequestState is nullable, but if you have multiple threads processing requests and there's any
 // per-request state that you want to maintain throughout the request (e.g. optimizing or batching
 // backend requests), you can inherit from RequestState and pass it to Request::resolve to correlate the
 // asynchronous/recursive callbacks and accumulate state in it.
 struct RequestState : std::enable_shared_from_this<RequestState>
 {
+	// Set a MemoryBudget before calling Request::resolve to account for the memory used by the request.
+	// If it exceeds the limit, the rest of the fields are skipped and the result only has an error. A
+	// subscription charges its parse tree and every delivery to the same budget.
+	std::shared_ptr<MemoryBudget> memory;
+
+	// Set a CancellationToken before calling Request::resolve or Request::subscribe to be able to stop it.
+	std::shared_ptr<CancellationToken> cancellation;
+
+	// Set the QuerySignature of a cached document to pass it to the Instrumentation. Request::deliver
+	// computes it once for each subscription if it's not set and there is an Instrumentation.
+	std::shared_ptr<const peg::QuerySignature> signature;
 };
 
 namespace {
@@ -54,6 +149,7 @@ using namespace std::literals;
 
 constexpr std::string_view strData{ "data"sv };
 constexpr std::string_view strErrors{ "errors"sv };
+constexpr std::string_view strExtensions{ "extensions"sv };
 constexpr std::string_view strMessage{ "message"sv };
 constexpr std::string_view strQuery{ "query"sv };
 constexpr std::string_view strMutation{ "mutation"sv };
@@ -61,6 +157,123 @@ constexpr std::string_view strSubscription{ "subscription"sv };
 
 }
 
+class BatchScope;
+
+// Objects which are only needed while resolving a single operation, like the edges of a connection,
+// can be allocated together in a ResultArena instead of making a separate allocation and control block
+// for each of them. The objects share ownership of the arena, so the blocks are freed all at once after
+// the operation is done and the last of those objects is released. That also means they can't use
+// shared_from_this. The arena itself must be owned by a std::shared_ptr.
+class ResultArena : public std::enable_shared_from_this<ResultArena>
+{
+public:
+	explicit ResultArena(size_t blockSize = 4096) noexcept;
+	~ResultArena();
+
+	ResultArena(const ResultArena&) = delete;
+	ResultArena& operator=(const ResultArena&) = delete;
+
+	template <typename T, typename... Args>
+	std::shared_ptr<T> make(Args&&... args)
+	{
+		auto [destructor, memory] = allocate(sizeof(T), alignof(T));
+		auto object = new (memory) T(std::forward<Args>(args)...);
+
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			addDestructor(destructor, object, [](void* destroyed) noexcept {
+				static_cast<T*>(destroyed)->~T();
+			});
+		}
+
+		return std::shared_ptr<T>(shared_from_this(), object);
+	}
+
+private:
+	struct Destructor
+	{
+		Destructor* previous;
+		void* object;
+		void (*destroy)(void* object) noexcept;
+	};
+
+	std::pair<Destructor*, void*> allocate(size_t size, size_t alignment);
+	void* reserve(size_t size, size_t alignment);
+	void addDestructor(Destructor* destructor, void* object, void (*destroy)(void* object) noexcept) noexcept;
+
+	const size_t _blockSize;
+	std::mutex _mutex;
+	std::vector<std::unique_ptr<std::byte[]>> _blocks;
+	void* _next = nullptr;
+	size_t _remaining = 0;
+	Destructor* _last = nullptr;
+};
+
+// Use the ResultArena if there is one, otherwise fall back to std::make_shared.
+template <typename T, typename... Args>
+std::shared_ptr<T> makeResult(ResultArena* arena, Args&&... args)
+{
+	return (arena
+		? arena->make<T>(std::forward<Args>(args)...)
+		: std::make_shared<T>(std::forward<Args>(args)...));
+}
+
+// The location of a value in the response is a chain of field names (or aliases) and list indices.
+// It's only tracked while there is an OperationListener which wants it, so it's shared instead of copied
+// at each level.
+struct PathSegment;
+
+using ResponsePath = std::shared_ptr<const PathSegment>;
+
+struct PathSegment
+{
+	ResponsePath parent;
+	std::variant<std::string, size_t> key;
+};
+
+// Convert the path to a list of field names and indices, starting from the root of the response.
+response::Value getPathValue(const ResponsePath& path);
+
+// Receive the callbacks for a single operation. The fields in an operation may resolve in parallel, so
+// the callbacks need to be thread-safe. Each field ends once its value and all of its children have
+// been resolved, which may be long after the resolver returned its future.
+class OperationListener
+{
+public:
+	// Listeners which only aggregate by type and field name can skip building the response path.
+	explicit OperationListener(bool trackPath = true) noexcept;
+	virtual ~OperationListener() = default;
+
+	bool trackPath() const noexcept;
+
+	virtual void beginField(const ResponsePath& path, std::string_view parentType, std::string_view fieldName);
+
+	// The duration is measured from the call to beginField, and error is set if the field threw an exception.
+	virtual void endField(const ResponsePath& path, std::string_view parentType, std::string_view fieldName,
+		std::chrono::steady_clock::duration duration, bool error);
+
+	virtual void beginList(const ResponsePath& path);
+	virtual void endList(const ResponsePath& path, size_t count);
+
+	// Add any members to the extensions of the response, which are only included if it isn't empty.
+	virtual void endOperation(response::Value& extensions);
+
+private:
+	const bool _trackPath;
+};
+
+// Register an Instrumentation with Request::setInstrumentation to observe each operation it resolves.
+class Instrumentation
+{
+public:
+	virtual ~Instrumentation() = default;
+
+	// Return the listener for a new operation, or nullptr to skip the rest of the callbacks for it. The
+	// signature is nullptr unless the RequestState has one or it's a subscription.
+	virtual std::shared_ptr<OperationListener> beginOperation(const std::shared_ptr<RequestState>& state,
+		std::string_view operationType, std::string_view operationName, const peg::QuerySignature* signature) = 0;
+};
+
 // Pass a common bundle of parameters to all of the generated Object::getField accessors in a SelectionSet
 struct SelectionSetParams
 {
@@ -75,6 +288,29 @@ struct SelectionSetParams
 	// you'll need to explicitly copy them into other instances of response::Value.
 	const response::Value& fragmentSpreadDirectives;
 	const response::Value& inlineFragmentDirectives;
+
+	// If this SelectionSet belongs to one of several objects returned in the same list, the batch
+	// scope is shared with the sibling objects and batchIndex is the position of this object in it.
+	const BatchScope* batch = nullptr;
+	size_t batchIndex = 0;
+
+	// When the request is streamed, each resolver writes its value directly to the writer and the
+	// response::Value it returns only contains the errors. A field or list element which fails must throw
+	// before it writes anything, so it's left out of the streamed response just like the response::Value.
+	response::Writer* writer = nullptr;
+
+	// If the RequestState has a CancellationToken, it's owned by the OperationData. Resolvers which do a
+	// lot of work or wait on other services can check it to stop early.
+	const CancellationToken* cancellation = nullptr;
+
+	// If the Request has an Instrumentation, the listener is owned by the OperationData and path is the
+	// location of this SelectionSet in the response. Otherwise they are both empty.
+	OperationListener* listener = nullptr;
+	ResponsePath path;
+
+	// Each operation or subscription delivery has a ResultArena for the objects which are only needed
+	// while it's resolved. It's null if the SelectionSet is resolved outside of a Request.
+	ResultArena* arena = nullptr;
 };
 
 // Pass a common bundle of parameters to all of the generated Object::getField accessors.
@@ -113,6 +349,107 @@ private:
 	std::variant<T, std::future<T>> _value;
 };
 
+// List field accessors may also return a ListGenerator, which produces the elements one at a time instead
+// of materializing the whole std::vector, e.g. while reading rows from a database cursor. The generator
+// returns std::nullopt after the last element. Objects in a generated list don't share a BatchScope, so
+// their @batch fields are resolved one object at a time; return a std::vector if you need batching.
+template <typename T>
+class ListGenerator
+{
+public:
+	using generator_type = std::function<std::optional<T>()>;
+
+	explicit ListGenerator(generator_type&& generator) noexcept
+		: _generator(std::move(generator))
+	{
+	}
+
+	// Read the elements from a pair of input iterators, which must stay valid until the list is resolved.
+	template <typename Iterator>
+	explicit ListGenerator(Iterator first, Iterator last)
+		: _generator([first, last]() mutable -> std::optional<T>
+			{
+				if (first == last)
+				{
+					return std::nullopt;
+				}
+
+				return std::make_optional<T>(*first++);
+			})
+	{
+	}
+
+	std::optional<T> next()
+	{
+		return _generator();
+	}
+
+private:
+	generator_type _generator;
+};
+
+// Implement FieldResult for list types, which may also be returned as a ListGenerator of elements.
+template <typename T, typename U>
+class GeneratorFieldResult
+{
+public:
+	template <typename V>
+	GeneratorFieldResult(V&& value)
+		: _value{ std::forward<V>(value) }
+	{
+	}
+
+	// Materialize the whole list, even if the accessor returned a ListGenerator.
+	T get()
+	{
+		if (std::holds_alternative<std::future<T>>(_value))
+		{
+			return std::get<std::future<T>>(std::move(_value)).get();
+		}
+		else if (std::holds_alternative<ListGenerator<U>>(_value))
+		{
+			auto generator = std::get<ListGenerator<U>>(std::move(_value));
+			std::vector<U> result;
+
+			while (auto entry = generator.next())
+			{
+				result.push_back(std::move(*entry));
+			}
+
+			return T(std::move(result));
+		}
+
+		return std::get<T>(std::move(_value));
+	}
+
+	bool isGenerator() const noexcept
+	{
+		return std::holds_alternative<ListGenerator<U>>(_value);
+	}
+
+	ListGenerator<U> getGenerator()
+	{
+		return std::get<ListGenerator<U>>(std::move(_value));
+	}
+
+private:
+	std::variant<T, std::future<T>, ListGenerator<U>> _value;
+};
+
+template <typename T>
+class FieldResult<std::vector<T>> : public GeneratorFieldResult<std::vector<T>, T>
+{
+public:
+	using GeneratorFieldResult<std::vector<T>, T>::GeneratorFieldResult;
+};
+
+template <typename T>
+class FieldResult<std::optional<std::vector<T>>> : public GeneratorFieldResult<std::optional<std::vector<T>>, T>
+{
+public:
+	using GeneratorFieldResult<std::optional<std::vector<T>>, T>::GeneratorFieldResult;
+};
+
 // Fragments are referenced by name and have a single type condition (except for inline
 // fragments, where the type condition is common but optional). They contain a set of fields
 // (with optional aliases and sub-selections) and potentially references to other fragments.
@@ -159,44 +496,59 @@ struct ResolverParams : SelectionSetParams
 using Resolver = std::function<std::future<response::Value>(ResolverParams&&)>;
 using ResolverMap = std::unordered_map<std::string, Resolver>;
 
+class Object;
+
+// Object resolvers take the object they belong to, so every instance of a type can share the same
+// ObjectResolverMap instead of binding a new set of resolvers to each object (e.g. each edge in a
+// connection). The generated types use these.
+using ObjectResolver = std::future<response::Value> (*)(const Object& object, ResolverParams&& params);
+using ObjectResolverMap = std::unordered_map<std::string, ObjectResolver>;
+
 // Binary data and opaque strings like IDs are encoded in Base64.
 class Base64
 {
 public:
-	// Map a single Base64-encoded character to its 6-bit integer value.
+	// Map a single Base64-encoded character to its 6-bit integer value, or 0xFF if it's not valid.
 	static constexpr uint8_t fromBase64(char ch) noexcept
 	{
-		return (ch >= 'A' && ch <= 'Z' ? ch - 'A'
-			: (ch >= 'a' && ch <= 'z' ? ch - 'a' + 26
-				: (ch >= '0' && ch <= '9' ? ch - '0' + 52
-					: (ch == '+' ? 62
-						: (ch == '/' ? 63 : 0xFF)))));
+		return s_decode[static_cast<uint8_t>(ch)];
 	}
 
 	// Convert a Base64-encoded string to a vector of bytes.
-	static std::vector<uint8_t> fromBase64(const char* encoded, size_t count);
+	static response::IdType fromBase64(const char* encoded, size_t count);
 
 	// Map a single 6-bit integer value to its Base64-encoded character.
 	static constexpr char toBase64(uint8_t i) noexcept
 	{
-		return (i < 26 ? static_cast<char>(i + static_cast<uint8_t>('A'))
-			: (i < 52 ? static_cast<char>(i - 26 + static_cast<uint8_t>('a'))
-				: (i < 62 ? static_cast<char>(i - 52 + static_cast<uint8_t>('0'))
-					: (i == 62 ? '+'
-						: (i == 63 ? '/' : padding)))));
+		return (i < 64 ? s_encode[i] : padding);
 	}
 
 	// Convert a set of bytes to Base64.
-	static std::string toBase64(const std::vector<uint8_t> & bytes);
+	static std::string toBase64(const uint8_t* data, size_t count);
+	static std::string toBase64(const response::IdType& bytes);
 
 private:
 	static constexpr char padding = '=';
 
-	// Throw a schema_exception if the character is out of range.
-	static uint8_t verifyFromBase64(char ch);
+	static constexpr char s_encode[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	// Every byte which is not in the alphabet maps to 0xFF, so a whole segment can be validated by
+	// checking the high bits of all of its characters at once.
+	static constexpr std::array<uint8_t, 256> s_decode = []() noexcept {
+		std::array<uint8_t, 256> decode {};
+
+		for (auto& entry : decode)
+		{
+			entry = 0xFF;
+		}
+
+		for (uint8_t i = 0; i < 64; ++i)
+		{
+			decode[static_cast<uint8_t>(s_encode[i])] = i;
+		}
 
-	// Throw a logic_error if the integer is out of range.
-	static char verifyToBase64(uint8_t i);
+		return decode;
+	}();
 };
 
 // GraphQL types are nullable by default, but they may be wrapped with non-null or list types.
@@ -365,9 +717,20 @@ using TypeNames = std::unordered_set<std::string>;
 class Object : public std::enable_shared_from_this<Object>
 {
 public:
+	// Each object owns a copy of its type names and resolvers, which are usually bound to the object.
 	explicit Object(TypeNames&& typeNames, ResolverMap&& resolvers);
+
+	// The type name, type names and resolvers are static tables shared by all of the instances of a
+	// type, and they must outlive the object, so temporaries are rejected.
+	explicit Object(std::string_view typeName, const TypeNames& typeNames, const ObjectResolverMap& resolvers) noexcept;
+	Object(std::string_view typeName, TypeNames&& typeNames, const ObjectResolverMap& resolvers) = delete;
+	Object(std::string_view typeName, const TypeNames& typeNames, ObjectResolverMap&& resolvers) = delete;
+	Object(std::string_view typeName, TypeNames&& typeNames, ObjectResolverMap&& resolvers) = delete;
 	virtual ~Object() = default;
 
+	// The generated types with @batch fields hide this, so only lists of those types share a BatchScope.
+	static constexpr bool hasBatchResolvers = false;
+
 	std::future<response::Value> resolve(const SelectionSetParams& selectionSetParams, const peg::ast_node& selection, const FragmentMap& fragments, const response::Value& variables) const;
 
 	bool matchesType(const std::string& typeName) const;
@@ -382,10 +745,129 @@ protected:
 	virtual void endSelectionSet(const SelectionSetParams& params) const;
 
 private:
-	TypeNames _typeNames;
-	ResolverMap _resolvers;
+	struct OwnedTables
+	{
+		TypeNames typeNames;
+		ResolverMap resolvers;
+	};
+
+	// Only the constructor which takes ownership of the tables sets _ownedTables and _resolvers, the
+	// constructor for shared tables sets _objectResolvers instead.
+	const std::unique_ptr<const OwnedTables> _ownedTables;
+	const std::string_view _typeName;
+	const TypeNames& _typeNames;
+	const ObjectResolverMap* const _objectResolvers = nullptr;
+	const ResolverMap* const _resolvers = nullptr;
+};
+
+// BatchScope is shared by all of the objects in a list result while their SelectionSets are resolved.
+// The first sibling to resolve a batched field calls the batch resolver once for all of the siblings,
+// and the rest of the siblings pick their own result out of the shared batch.
+class BatchScope
+{
+public:
+	explicit BatchScope(std::vector<std::shared_ptr<Object>>&& siblings);
+
+	template <typename Type>
+	std::vector<std::shared_ptr<Type>> getSiblings() const
+	{
+		std::vector<std::shared_ptr<Type>> siblings(_siblings.size());
+
+		std::transform(_siblings.cbegin(), _siblings.cend(), siblings.begin(),
+			[](const std::shared_ptr<Object>& sibling)
+			{
+				return std::static_pointer_cast<Type>(sibling);
+			});
+
+		return siblings;
+	}
+
+	// The results are shared by the selections with the same response key and arguments.
+	template <typename ResultType, typename BatchFunction>
+	FieldResult<ResultType> getResult(size_t index, const std::string& responseKey, const response::Value& arguments, BatchFunction&& batch) const
+	{
+		using batch_type = std::shared_future<std::vector<ResultType>>;
+
+		const auto entry = getEntry(responseKey, arguments);
+
+		// The first sibling calls the batch resolver without holding the lock on the whole scope, and
+		// any others which get here at the same time wait for it.
+		std::call_once(entry->once,
+			[&entry, &batch]()
+			{
+				batch_type results;
+
+				try
+				{
+					results = std::async(std::launch::deferred,
+						[](FieldResult<std::vector<ResultType>>&& batchResult)
+						{
+							return batchResult.get();
+						}, batch()).share();
+				}
+				catch (...)
+				{
+					std::promise<std::vector<ResultType>> promise;
+
+					promise.set_exception(std::current_exception());
+					results = promise.get_future().share();
+				}
+
+				entry->results = std::make_shared<batch_type>(std::move(results));
+			});
+
+		return std::async(std::launch::deferred,
+			[index, siblingCount = _siblings.size(), responseKey](batch_type&& batchResults)
+			{
+				const auto& values = batchResults.get();
+
+				if (values.size() != siblingCount)
+				{
+					std::ostringstream error;
+
+					error << "Batch field name: " << responseKey
+						<< " expected results: " << siblingCount
+						<< " actual results: " << values.size();
+
+					throw schema_exception({ error.str() });
+				}
+
+				return values[index];
+			}, batch_type(*std::static_pointer_cast<batch_type>(entry->results)));
+	}
+
+private:
+	struct BatchEntry
+	{
+		explicit BatchEntry(const response::Value& arguments);
+
+		const response::Value arguments;
+		std::once_flag once;
+		std::shared_ptr<void> results;
+	};
+
+	std::shared_ptr<BatchEntry> getEntry(const std::string& responseKey, const response::Value& arguments) const;
+
+	const std::vector<std::shared_ptr<Object>> _siblings;
+
+	mutable std::mutex _mutex;
+	mutable std::unordered_map<std::string, std::vector<std::shared_ptr<BatchEntry>>> _entries;
 };
 
+// Only lists of object types with @batch fields need a BatchScope.
+template <typename Type>
+constexpr bool usesBatchScope() noexcept
+{
+	if constexpr (std::is_base_of_v<Object, Type> && !std::is_same_v<Object, Type>)
+	{
+		return Type::hasBatchResolvers;
+	}
+	else
+	{
+		return false;
+	}
+}
+
 // Convert the result of a resolver function with chained type modifiers that add nullable or
 // list wrappers. This is the inverse of ModifiedArgument for output types instead of input types.
 template <typename Type>
@@ -424,6 +906,11 @@ struct ModifiedResult
 	// Convert a single value of the specified type to JSON.
 	static std::future<response::Value> convert(typename ResultTraits<Type>::future_type result, ResolverParams&& params);
 
+	// Convert a single scalar or enum value without a std::future. These are specialized for the built-in
+	// types in the GraphQLService library, and schemagen generates them for each of the enum types.
+	static response::Value convertValue(typename ResultTraits<Type>::type&& value);
+	static void writeValue(typename ResultTraits<Type>::type&& value, response::Writer& writer);
+
 	// Peel off the none modifier. If it's included, it should always be last in the list.
 	template <TypeModifier Modifier = TypeModifier::None, TypeModifier... Other>
 	static typename std::enable_if_t<TypeModifier::None == Modifier && sizeof...(Other) == 0 && !std::is_same_v<Object, Type> && std::is_base_of_v<Object, Type>,
@@ -463,7 +950,14 @@ struct ModifiedResult
 				{
 					response::Value document(response::Type::Map);
 
-					document.emplace_back(std::string{ strData }, response::Value());
+					if (wrappedParams.writer)
+					{
+						wrappedParams.writer->add_null();
+					}
+					else
+					{
+						document.emplace_back(std::string{ strData }, response::Value());
+					}
 
 					return document;
 				}
@@ -487,13 +981,29 @@ struct ModifiedResult
 		return std::async(std::launch::deferred,
 			[](auto && wrappedFuture, ResolverParams && wrappedParams)
 			{
+				if constexpr (isListModifier<Other...>())
+				{
+					// A nullable list returned as a ListGenerator is never null.
+					if (wrappedFuture.isGenerator())
+					{
+						return convert<Other...>(wrappedFuture.getGenerator(), std::move(wrappedParams)).get();
+					}
+				}
+
 				auto wrappedResult = wrappedFuture.get();
 
 				if (!wrappedResult)
 				{
 					response::Value document(response::Type::Map);
 
-					document.emplace_back(std::string{ strData }, response::Value());
+					if (wrappedParams.writer)
+					{
+						wrappedParams.writer->add_null();
+					}
+					else
+					{
+						document.emplace_back(std::string{ strData }, response::Value());
+					}
 
 					return document;
 				}
@@ -511,15 +1021,123 @@ struct ModifiedResult
 	static typename std::enable_if_t<TypeModifier::List == Modifier,
 		std::future<response::Value>> convert(typename ResultTraits<Type, Modifier, Other...>::future_type result, ResolverParams && params)
 	{
+		if constexpr (isNoThrowValueType)
+		{
+			// Lists of these types can't have any field errors, so convert the whole list in one pass.
+			return std::async(std::launch::deferred,
+				[](auto && wrappedFuture, ResolverParams && wrappedParams)
+				{
+					if (wrappedFuture.isGenerator())
+					{
+						return convertGenerator<Other...>(wrappedFuture.getGenerator(), std::move(wrappedParams));
+					}
+
+					auto wrappedResult = wrappedFuture.get();
+					const size_t count = wrappedResult.size();
+					response::Value document(response::Type::Map);
+
+					if (wrappedParams.listener)
+					{
+						wrappedParams.listener->beginList(wrappedParams.path);
+					}
+
+					if (wrappedParams.writer)
+					{
+						writeValues<Modifier, Other...>(std::move(wrappedResult), *wrappedParams.writer);
+					}
+					else
+					{
+						document.emplace_back(std::string{ strData }, convertValues<Modifier, Other...>(std::move(wrappedResult)));
+					}
+
+					if (wrappedParams.listener)
+					{
+						wrappedParams.listener->endList(wrappedParams.path, count);
+					}
+
+					return document;
+				}, std::move(result), std::move(params));
+		}
+
 		return std::async(std::launch::deferred,
 			[](auto && wrappedFuture, ResolverParams && wrappedParams)
 			{
+				if (wrappedFuture.isGenerator())
+				{
+					return convertGenerator<Other...>(wrappedFuture.getGenerator(), std::move(wrappedParams));
+				}
+
 				auto wrappedResult = wrappedFuture.get();
 				std::queue<std::future<response::Value>> children;
+				std::unique_ptr<BatchScope> batch;
+
+				if constexpr (usesBatchScope<Type>()
+					&& std::is_same_v<std::shared_ptr<Type>, typename ResultTraits<Type, Other...>::type>)
+				{
+					if (wrappedParams.selection)
+					{
+						std::vector<std::shared_ptr<Object>> siblings;
+
+						siblings.reserve(wrappedResult.size());
+
+						for (const auto& entry : wrappedResult)
+						{
+							if (entry)
+							{
+								siblings.push_back(entry);
+							}
+						}
+
+						batch = std::make_unique<BatchScope>(std::move(siblings));
+					}
+				}
+
+				size_t batchIndex = 0;
+				size_t elementIndex = 0;
+
+				if (wrappedParams.listener)
+				{
+					wrappedParams.listener->beginList(wrappedParams.path);
+				}
+
+				if (wrappedParams.writer)
+				{
+					wrappedParams.writer->start_array();
+				}
 
 				for (auto& entry : wrappedResult)
 				{
-					children.push(convert<Other...>(std::move(entry), ResolverParams(wrappedParams)));
+					// End the list early once the request is cancelled, the rest of it would be discarded.
+					if (wrappedParams.cancellation && wrappedParams.cancellation->isCancelled())
+					{
+						std::promise<response::Value> promise;
+
+						try
+						{
+							wrappedParams.cancellation->check();
+						}
+						catch (const std::exception&)
+						{
+							promise.set_exception(std::current_exception());
+						}
+
+						children.push(promise.get_future());
+						break;
+					}
+
+					auto elementParams = getElementParams(wrappedParams, elementIndex++);
+
+					if constexpr (usesBatchScope<Type>()
+						&& std::is_same_v<std::shared_ptr<Type>, typename ResultTraits<Type, Other...>::type>)
+					{
+						if (batch && entry)
+						{
+							children.push(resolveSibling(std::move(entry), std::move(elementParams), *batch, batchIndex++));
+							continue;
+						}
+					}
+
+					children.push(convert<Other...>(std::move(entry), std::move(elementParams)));
 				}
 
 				response::Value data(response::Type::List);
@@ -530,39 +1148,12 @@ struct ModifiedResult
 				{
 					try
 					{
-						auto value = children.front().get();
-						auto members = value.release<response::MapType>();
-
-						for (auto& entry : members)
-						{
-							if (entry.second.type() == response::Type::List
-								&& entry.first == strErrors)
-							{
-								auto errorEntries = entry.second.release<response::ListType>();
-
-								for (auto& errorEntry : errorEntries)
-								{
-									errors.emplace_back(std::move(errorEntry));
-								}
-							}
-							else if (entry.first == strData)
-							{
-								data.emplace_back(std::move(entry.second));
-							}
-						}
+						addListElement(children.front().get(), data, errors);
 					}
 					catch (const std::exception & ex)
 					{
-						std::ostringstream message;
-
-						message << "Field error name: " << wrappedParams.fieldName
-							<< "[" << index << "] "
-							<< " unknown error: " << ex.what();
-
-						response::Value error(response::Type::Map);
-
-						error.emplace_back(std::string{ strMessage }, response::Value(message.str()));
-						errors.emplace_back(std::move(error));
+						// The element didn't write anything, so it's left out of the list either way.
+						addListError(wrappedParams.fieldName, index, ex, errors);
 					}
 
 					children.pop();
@@ -571,7 +1162,19 @@ struct ModifiedResult
 
 				response::Value document(response::Type::Map);
 
-				document.emplace_back(std::string{ strData }, std::move(data));
+				if (wrappedParams.writer)
+				{
+					wrappedParams.writer->end_array();
+				}
+				else
+				{
+					document.emplace_back(std::string{ strData }, std::move(data));
+				}
+
+				if (wrappedParams.listener)
+				{
+					wrappedParams.listener->endList(wrappedParams.path, index);
+				}
 
 				if (errors.size() > 0)
 				{
@@ -582,27 +1185,284 @@ struct ModifiedResult
 			}, std::move(result), std::move(params));
 	}
 
+private:
+	template <TypeModifier Modifier = TypeModifier::None, TypeModifier... Other>
+	static constexpr bool isListModifier() noexcept
+	{
+		return TypeModifier::List == Modifier;
+	}
+
+	// Converting or writing numbers and Boolean values can't fail on a single element. Strings, IDs,
+	// enums, and custom scalars may be rejected by the Writer or a specialization of convertValue, so
+	// each of those elements still gets its own field error.
+	static constexpr bool isNoThrowValueType = std::is_same_v<response::IntType, Type>
+		|| std::is_same_v<response::FloatType, Type>
+		|| std::is_same_v<response::BooleanType, Type>;
+
+	// Pull the elements from a ListGenerator one at a time, so only the current element is kept alive
+	// while it's converted. Objects in the list do not share a BatchScope, and they are resolved in order.
+	template <TypeModifier... Other>
+	static response::Value convertGenerator(ListGenerator<typename ResultTraits<Type, Other...>::type>&& generator, ResolverParams&& params)
+	{
+		response::Value data(response::Type::List);
+		response::Value errors(response::Type::List);
+		size_t index = 0;
+
+		if (params.listener)
+		{
+			params.listener->beginList(params.path);
+		}
+
+		if (params.writer)
+		{
+			params.writer->start_array();
+		}
+
+		while (true)
+		{
+			std::optional<typename ResultTraits<Type, Other...>::type> entry;
+
+			try
+			{
+				if (params.cancellation)
+				{
+					params.cancellation->check();
+				}
+
+				entry = generator.next();
+			}
+			catch (const std::exception & ex)
+			{
+				// End the list early, we can't tell how many elements are missing.
+				addListError(params.fieldName, index, ex, errors);
+				break;
+			}
+
+			if (!entry)
+			{
+				break;
+			}
+
+			try
+			{
+				if constexpr (isNoThrowValueType)
+				{
+					if (params.writer)
+					{
+						writeValues<Other...>(std::move(*entry), *params.writer);
+					}
+					else
+					{
+						data.emplace_back(convertValues<Other...>(std::move(*entry)));
+					}
+				}
+				else
+				{
+					addListElement(convert<Other...>(std::move(*entry), getElementParams(params, index)).get(), data, errors);
+				}
+			}
+			catch (const std::exception & ex)
+			{
+				addListError(params.fieldName, index, ex, errors);
+			}
+
+			++index;
+		}
+
+		response::Value document(response::Type::Map);
+
+		if (params.writer)
+		{
+			params.writer->end_array();
+		}
+		else
+		{
+			document.emplace_back(std::string{ strData }, std::move(data));
+		}
+
+		if (params.listener)
+		{
+			params.listener->endList(params.path, index);
+		}
+
+		if (errors.size() > 0)
+		{
+			document.emplace_back(std::string{ strErrors }, std::move(errors));
+		}
+
+		return document;
+	}
+
+	// Extend the path with the index of each element in a list while there's an OperationListener.
+	static ResolverParams getElementParams(const ResolverParams& params, size_t index)
+	{
+		ResolverParams elementParams(params);
+
+		if (params.listener && params.listener->trackPath())
+		{
+			elementParams.path = std::make_shared<const PathSegment>(PathSegment { params.path, index });
+		}
+
+		return elementParams;
+	}
+
+	// Merge the data and errors from the document for a single element into the list result.
+	static void addListElement(response::Value&& value, response::Value& data, response::Value& errors)
+	{
+		auto members = value.release<response::MapType>();
+
+		for (auto& entry : members)
+		{
+			if (entry.second.type() == response::Type::List
+				&& entry.first == strErrors)
+			{
+				auto errorEntries = entry.second.release<response::ListType>();
+
+				for (auto& errorEntry : errorEntries)
+				{
+					errors.emplace_back(std::move(errorEntry));
+				}
+			}
+			else if (entry.first == strData)
+			{
+				data.emplace_back(std::move(entry.second));
+			}
+		}
+	}
+
+	static void addListError(const std::string& fieldName, size_t index, const std::exception& ex, response::Value& errors)
+	{
+		std::ostringstream message;
+
+		message << "Field error name: " << fieldName
+			<< "[" << index << "] "
+			<< " unknown error: " << getErrorMessage(ex);
+
+		response::Value error(response::Type::Map);
+
+		error.emplace_back(std::string{ strMessage }, response::Value(message.str()));
+		errors.emplace_back(std::move(error));
+	}
+
+	// Convert a (possibly nested) list of scalar or enum values into a preallocated response::Value.
+	template <TypeModifier Modifier = TypeModifier::None, TypeModifier... Other>
+	static response::Value convertValues(typename ResultTraits<Type, Modifier, Other...>::type&& value)
+	{
+		if constexpr (TypeModifier::Nullable == Modifier)
+		{
+			if (!value)
+			{
+				return {};
+			}
+
+			return convertValues<Other...>(std::move(*value));
+		}
+		else if constexpr (TypeModifier::List == Modifier)
+		{
+			response::Value result(response::Type::List);
+
+			result.reserve(value.size());
+
+			// Use a forwarding reference for the std::vector<bool> element proxies.
+			for (auto&& entry : value)
+			{
+				result.emplace_back(convertValues<Other...>(std::move(entry)));
+			}
+
+			return result;
+		}
+		else
+		{
+			return convertValue(std::move(value));
+		}
+	}
+
+	// Stream a (possibly nested) list of scalar or enum values directly to the writer.
+	template <TypeModifier Modifier = TypeModifier::None, TypeModifier... Other>
+	static void writeValues(typename ResultTraits<Type, Modifier, Other...>::type&& value, response::Writer& writer)
+	{
+		if constexpr (TypeModifier::Nullable == Modifier)
+		{
+			if (!value)
+			{
+				writer.add_null();
+				return;
+			}
+
+			writeValues<Other...>(std::move(*value), writer);
+		}
+		else if constexpr (TypeModifier::List == Modifier)
+		{
+			writer.start_array();
+
+			for (auto&& entry : value)
+			{
+				writeValues<Other...>(std::move(entry), writer);
+			}
+
+			writer.end_array();
+		}
+		else
+		{
+			writeValue(std::move(value), writer);
+		}
+	}
+
+private:
+	// Resolve the SelectionSet on an object in a list with a BatchScope shared by all of its siblings.
+	static std::future<response::Value> resolveSibling(std::shared_ptr<Type>&& object, ResolverParams&& params, const BatchScope& batch, size_t batchIndex)
+	{
+		return std::async(std::launch::deferred,
+			[&batch, batchIndex](std::shared_ptr<Type>&& objectFuture, ResolverParams&& paramsFuture)
+			{
+				paramsFuture.batch = &batch;
+				paramsFuture.batchIndex = batchIndex;
+
+				return objectFuture->resolve(paramsFuture, *paramsFuture.selection, paramsFuture.fragments, paramsFuture.variables).get();
+			}, std::move(object), std::move(params));
+	}
+
 private:
 	using ResolverCallback = std::function<response::Value(typename ResultTraits<Type>::type&&, const ResolverParams&)>;
+	using WriterCallback = std::function<void(typename ResultTraits<Type>::type&&, const ResolverParams&, response::Writer&)>;
 
 	static std::future<response::Value> resolve(typename ResultTraits<Type>::future_type result, ResolverParams&& params, ResolverCallback&& resolver)
+	{
+		return resolve(std::move(result), std::move(params), std::move(resolver), WriterCallback{});
+	}
+
+	// The writer callback lets a streamed request skip the response::Value for the result. If it's
+	// empty, the streamed value is converted with the resolver callback and written as a response::Value.
+	static std::future<response::Value> resolve(typename ResultTraits<Type>::future_type result, ResolverParams&& params, ResolverCallback&& resolver, WriterCallback&& writer)
 	{
 		static_assert(!std::is_base_of_v<Object, Type>, "ModfiedResult<Object> needs special handling");
 		return std::async(std::launch::deferred,
-			[](auto && resultFuture, ResolverParams && paramsFuture, ResolverCallback && resolverFuture) noexcept
+			[](auto && resultFuture, ResolverParams && paramsFuture, ResolverCallback && resolverFuture, WriterCallback && writerFuture) noexcept
 			{
 				response::Value document(response::Type::Map);
 
 				try
 				{
-					document.emplace_back(std::string{ strData }, resolverFuture(resultFuture.get(), paramsFuture));
+					if (!paramsFuture.writer)
+					{
+						document.emplace_back(std::string{ strData }, resolverFuture(resultFuture.get(), paramsFuture));
+					}
+					else if (writerFuture)
+					{
+						writerFuture(resultFuture.get(), paramsFuture, *paramsFuture.writer);
+					}
+					else
+					{
+						paramsFuture.writer->add_value(resolverFuture(resultFuture.get(), paramsFuture));
+					}
 				}
 				catch (const std::exception & ex)
 				{
+					// Nothing was written, so a streamed field is left out just like the data.
 					std::ostringstream message;
 
 					message << "Field name: " << paramsFuture.fieldName
-						<< " unknown error: " << ex.what();
+						<< " unknown error: " << getErrorMessage(ex);
 
 					response::Value errors(response::Type::List);
 					response::Value error(response::Type::Map);
@@ -613,7 +1473,7 @@ private:
 				}
 
 				return document;
-			}, std::move(result), std::move(params), std::move(resolver));
+			}, std::move(result), std::move(params), std::move(resolver), std::move(writer));
 	}
 };
 
@@ -628,6 +1488,137 @@ using IdResult = ModifiedResult<response::IdType>;
 using ScalarResult = ModifiedResult<response::Value>;
 using ObjectResult = ModifiedResult<Object>;
 
+// The most common combinations of type modifiers for the built-in types are explicitly instantiated
+// in the GraphQLService library, so every translation unit which uses them does not need to
+// instantiate them again. ModifiedResult<Object>::convert<TypeModifier::Nullable> has the same
+// signature as the ModifiedResult<Object>::convert specialization, and lists of non-nullable
+// Boolean values can't be converted from std::vector<bool>, so they are left out.
+extern template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::List>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::List>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::List>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::BooleanType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::BooleanType>::ResultTraits<response::BooleanType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::BooleanType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::BooleanType>::ResultTraits<response::BooleanType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::BooleanType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::BooleanType>::ResultTraits<response::BooleanType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::List>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::List>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::List>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+
+extern template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::Nullable>::type ModifiedArgument<response::IntType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::List>::type ModifiedArgument<response::IntType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::IntType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IntType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IntType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::Nullable>::type ModifiedArgument<response::FloatType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::List>::type ModifiedArgument<response::FloatType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::FloatType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::FloatType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::FloatType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::Nullable>::type ModifiedArgument<response::StringType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::List>::type ModifiedArgument<response::StringType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::StringType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::StringType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::StringType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::Nullable>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::List>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::Nullable>::type ModifiedArgument<response::IdType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::List>::type ModifiedArgument<response::IdType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::IdType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IdType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IdType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::Nullable>::type ModifiedArgument<response::Value>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::List>::type ModifiedArgument<response::Value>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::Value>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::Value>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+extern template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::Value>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+
 using TypeMap = std::unordered_map<std::string, std::shared_ptr<Object>>;
 
 // You can still sub-class RequestState and use that in the state parameter to Request::subscribe
@@ -656,6 +1647,10 @@ struct OperationData : std::enable_shared_from_this<OperationData>
 	response::Value variables;
 	response::Value directives;
 	FragmentMap fragments;
+
+	// Keep the CancellationToken alive even if the RequestState drops it in the middle of the operation.
+	std::shared_ptr<const CancellationToken> cancellation;
+	std::shared_ptr<const peg::QuerySignature> signature;
 };
 
 // Subscription callbacks receive the response::Value representing the result of evaluating the
@@ -694,9 +1689,22 @@ public:
 
 	std::pair<std::string, const peg::ast_node*> findOperationDefinition(const peg::ast_node& root, const std::string& operationName) const;
 
+	// Look up the operation in the peg::OperationIndex which was built when the query was parsed instead
+	// of scanning the document, which matters for documents with lots of named operations.
+	std::pair<std::string, const peg::ast_node*> findOperationDefinition(const peg::ast& query, const std::string& operationName) const;
+
 	std::future<response::Value> resolve(const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const std::string& operationName, response::Value&& variables) const;
 	std::future<response::Value> resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const std::string& operationName, response::Value&& variables) const;
 
+	// Stream the complete response, including the errors, to the writer instead of returning a response::Value.
+	// The writer must stay alive until the returned future is resolved.
+	std::future<void> resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const std::string& operationName, response::Value&& variables, response::Writer& writer) const;
+
+	// Same as above, but they use the peg::OperationIndex in the query if it has one.
+	std::future<response::Value> resolve(const std::shared_ptr<RequestState>& state, const peg::ast& query, const std::string& operationName, response::Value&& variables) const;
+	std::future<response::Value> resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast& query, const std::string& operationName, response::Value&& variables) const;
+	std::future<void> resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast& query, const std::string& operationName, response::Value&& variables, response::Writer& writer) const;
+
 	SubscriptionKey subscribe(SubscriptionParams&& params, SubscriptionCallback&& callback);
 	void unsubscribe(SubscriptionKey key);
 
@@ -704,8 +1712,28 @@ public:
 	void deliver(const SubscriptionName& name, const SubscriptionArguments& arguments, const std::shared_ptr<Object>& subscriptionObject) const;
 	void deliver(const SubscriptionName& name, const SubscriptionFilterCallback& apply, const std::shared_ptr<Object>& subscriptionObject) const;
 
+	// Install or remove (with nullptr) the Instrumentation for the operations which start after this call.
+	void setInstrumentation(std::shared_ptr<Instrumentation> instrumentation);
+
+	// Each level of nested fields adds a few frames to the stack while it's resolved, so operations which
+	// nest fields deeper than this, including the fields in fragments, get an error before any resolvers
+	// are called. Setting it to 0 removes the limit. Only the fragment expansion and this check use an
+	// explicit stack; Object::resolve and the deferred futures still recurse once per level, so the
+	// native stack is bounded by this limit rather than by the query.
+	static constexpr size_t defaultMaxDepth = 128;
+
+	void setMaxDepth(size_t maxDepth);
+
 private:
+	std::pair<std::string, const peg::ast_node*> findOperationDefinition(const peg::OperationIndex& operations, const std::string& operationName) const;
+	void validateOperation(const std::string& operationName, std::string_view operationType, std::string_view name, const peg::ast_node& operationDefinition, bool duplicate) const;
+	void validateDepth(const peg::ast_node& operationDefinition, const FragmentMap& fragments) const;
+
+	std::future<response::Value> resolveOperation(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const peg::OperationIndex* operations, const std::string& operationName, response::Value&& variables, response::Writer* writer) const;
+
 	TypeMap _operations;
+	std::shared_ptr<Instrumentation> _instrumentation;
+	std::atomic<size_t> _maxDepth { defaultMaxDepth };
 	std::map<SubscriptionKey, std::shared_ptr<SubscriptionData>> _subscriptions;
 	std::unordered_map<SubscriptionName, std::set<SubscriptionKey>> _listeners;
 	SubscriptionKey _nextKey = 0;
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <graphqlservice/GraphQLService.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace graphql::service {
+
+// Collect the timing of each resolver in an operation and add them to the response extensions in the
+// Apollo tracing format: https://github.com/apollographql/apollo-tracing
+class ApolloTracing : public Instrumentation
+{
+public:
+	std::shared_ptr<OperationListener> beginOperation(const std::shared_ptr<RequestState>& state,
+		std::string_view operationType, std::string_view operationName, const peg::QuerySignature* signature) override;
+};
+
+class ApolloTracingListener : public OperationListener
+{
+public:
+	ApolloTracingListener();
+
+	void beginField(const ResponsePath& path, std::string_view parentType, std::string_view fieldName) override;
+	void endField(const ResponsePath& path, std::string_view parentType, std::string_view fieldName,
+		std::chrono::steady_clock::duration duration, bool error) override;
+
+	void endOperation(response::Value& extensions) override;
+
+private:
+	struct ResolverTiming
+	{
+		ResponsePath path;
+		// The views passed to beginField don't outlive the field, so keep a copy of the names.
+		std::string parentType;
+		std::string fieldName;
+		std::chrono::steady_clock::duration startOffset;
+		std::chrono::steady_clock::duration duration;
+	};
+
+	const std::chrono::system_clock::time_point _startTime;
+	const std::chrono::steady_clock::time_point _start;
+
+	std::mutex _mutex;
+	std::vector<ResolverTiming> _resolvers;
+
+	// The path of each field is unique in the response, so it identifies the pending timing.
+	std::unordered_map<const PathSegment*, size_t> _pending;
+};
+
+} /* namespace graphql::service */
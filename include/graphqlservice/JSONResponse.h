@@ -9,6 +9,41 @@ namespace graphql::response {
 
 std::string toJSON(Value&& response);
 
+// Stream a response to a JSON string without building a Value.
+class JSONWriter : public Writer
+{
+public:
+	JSONWriter();
+	~JSONWriter() override;
+
+	void start_object() override;
+	void add_member_key(std::string_view key) override;
+	void end_object() override;
+
+	void start_array() override;
+	void end_array() override;
+
+	void add_null() override;
+	void add_string(std::string_view value) override;
+	void add_enum(std::string_view value) override;
+	void add_bool(BooleanType value) override;
+	void add_int(IntType value) override;
+	void add_float(FloatType value) override;
+
+	void add_value(Value&& value) override;
+
+	std::string get_json() const;
+
+private:
+	struct Impl;
+
+	std::unique_ptr<Impl> _impl;
+};
+
 Value parseJSON(const std::string& json);
 
+// Parse a JSON string and send each of the values straight to a Writer without building a Value,
+// e.g. to read a response with a client::ResponseReader. Throws std::runtime_error if the JSON is invalid.
+void parseJSON(const std::string& json, Writer& writer);
+
 } /* namespace graphql::response */
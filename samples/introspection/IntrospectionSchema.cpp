@@ -24,6 +24,17 @@ static const std::array<std::string_view, 8> s_namesTypeKind = {
 	"NON_NULL"
 };
 
+static const std::array<std::pair<std::string_view, introspection::TypeKind>, 8> s_sortedTypeKind = { {
+	{ "ENUM", introspection::TypeKind::ENUM },
+	{ "INPUT_OBJECT", introspection::TypeKind::INPUT_OBJECT },
+	{ "INTERFACE", introspection::TypeKind::INTERFACE },
+	{ "LIST", introspection::TypeKind::LIST },
+	{ "NON_NULL", introspection::TypeKind::NON_NULL },
+	{ "OBJECT", introspection::TypeKind::OBJECT },
+	{ "SCALAR", introspection::TypeKind::SCALAR },
+	{ "UNION", introspection::TypeKind::UNION }
+} };
+
 template <>
 introspection::TypeKind ModifiedArgument<introspection::TypeKind>::convert(const response::Value& value)
 {
@@ -32,14 +43,47 @@ introspection::TypeKind ModifiedArgument<introspection::TypeKind>::convert(const
 		throw service::schema_exception({ "not a valid __TypeKind value" });
 	}
 
-	auto itr = std::find(s_namesTypeKind.cbegin(), s_namesTypeKind.cend(), value.get<const response::StringType&>());
+	const std::string_view name = value.get<const response::StringType&>();
+	auto itr = std::lower_bound(s_sortedTypeKind.cbegin(), s_sortedTypeKind.cend(), name,
+		[](const auto& entry, std::string_view key) noexcept
+		{
+			return entry.first < key;
+		});
 
-	if (itr == s_namesTypeKind.cend())
+	if (itr == s_sortedTypeKind.cend() || itr->first != name)
 	{
 		throw service::schema_exception({ "not a valid __TypeKind value" });
 	}
 
-	return static_cast<introspection::TypeKind>(itr - s_namesTypeKind.cbegin());
+	return itr->second;
+}
+
+template <>
+response::Value ModifiedResult<introspection::TypeKind>::convertValue(introspection::TypeKind&& value)
+{
+	// Build each of the enum values once, copying one of them just shares its data.
+	static const auto s_values = []()
+	{
+		std::array<response::Value, 8> values;
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			response::Value entry(response::Type::EnumValue);
+
+			entry.set<response::StringType>(std::string(s_namesTypeKind[i]));
+			values[i] = std::move(entry);
+		}
+
+		return values;
+	}();
+
+	return response::Value(s_values[static_cast<size_t>(value)]);
+}
+
+template <>
+void ModifiedResult<introspection::TypeKind>::writeValue(introspection::TypeKind&& value, response::Writer& writer)
+{
+	writer.add_enum(s_namesTypeKind[static_cast<size_t>(value)]);
 }
 
 template <>
@@ -48,11 +92,11 @@ std::future<response::Value> ModifiedResult<introspection::TypeKind>::convert(se
 	return resolve(std::move(result), std::move(params),
 		[](introspection::TypeKind&& value, const ResolverParams&)
 		{
-			response::Value result(response::Type::EnumValue);
-
-			result.set<response::StringType>(std::string(s_namesTypeKind[static_cast<size_t>(value)]));
-
-			return result;
+			return convertValue(std::move(value));
+		},
+		[](introspection::TypeKind&& value, const ResolverParams&, response::Writer& writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
@@ -77,6 +121,27 @@ static const std::array<std::string_view, 18> s_namesDirectiveLocation = {
 	"INPUT_FIELD_DEFINITION"
 };
 
+static const std::array<std::pair<std::string_view, introspection::DirectiveLocation>, 18> s_sortedDirectiveLocation = { {
+	{ "ARGUMENT_DEFINITION", introspection::DirectiveLocation::ARGUMENT_DEFINITION },
+	{ "ENUM", introspection::DirectiveLocation::ENUM },
+	{ "ENUM_VALUE", introspection::DirectiveLocation::ENUM_VALUE },
+	{ "FIELD", introspection::DirectiveLocation::FIELD },
+	{ "FIELD_DEFINITION", introspection::DirectiveLocation::FIELD_DEFINITION },
+	{ "FRAGMENT_DEFINITION", introspection::DirectiveLocation::FRAGMENT_DEFINITION },
+	{ "FRAGMENT_SPREAD", introspection::DirectiveLocation::FRAGMENT_SPREAD },
+	{ "INLINE_FRAGMENT", introspection::DirectiveLocation::INLINE_FRAGMENT },
+	{ "INPUT_FIELD_DEFINITION", introspection::DirectiveLocation::INPUT_FIELD_DEFINITION },
+	{ "INPUT_OBJECT", introspection::DirectiveLocation::INPUT_OBJECT },
+	{ "INTERFACE", introspection::DirectiveLocation::INTERFACE },
+	{ "MUTATION", introspection::DirectiveLocation::MUTATION },
+	{ "OBJECT", introspection::DirectiveLocation::OBJECT },
+	{ "QUERY", introspection::DirectiveLocation::QUERY },
+	{ "SCALAR", introspection::DirectiveLocation::SCALAR },
+	{ "SCHEMA", introspection::DirectiveLocation::SCHEMA },
+	{ "SUBSCRIPTION", introspection::DirectiveLocation::SUBSCRIPTION },
+	{ "UNION", introspection::DirectiveLocation::UNION }
+} };
+
 template <>
 introspection::DirectiveLocation ModifiedArgument<introspection::DirectiveLocation>::convert(const response::Value& value)
 {
@@ -85,14 +150,47 @@ introspection::DirectiveLocation ModifiedArgument<introspection::DirectiveLocati
 		throw service::schema_exception({ "not a valid __DirectiveLocation value" });
 	}
 
-	auto itr = std::find(s_namesDirectiveLocation.cbegin(), s_namesDirectiveLocation.cend(), value.get<const response::StringType&>());
+	const std::string_view name = value.get<const response::StringType&>();
+	auto itr = std::lower_bound(s_sortedDirectiveLocation.cbegin(), s_sortedDirectiveLocation.cend(), name,
+		[](const auto& entry, std::string_view key) noexcept
+		{
+			return entry.first < key;
+		});
 
-	if (itr == s_namesDirectiveLocation.cend())
+	if (itr == s_sortedDirectiveLocation.cend() || itr->first != name)
 	{
 		throw service::schema_exception({ "not a valid __DirectiveLocation value" });
 	}
 
-	return static_cast<introspection::DirectiveLocation>(itr - s_namesDirectiveLocation.cbegin());
+	return itr->second;
+}
+
+template <>
+response::Value ModifiedResult<introspection::DirectiveLocation>::convertValue(introspection::DirectiveLocation&& value)
+{
+	// Build each of the enum values once, copying one of them just shares its data.
+	static const auto s_values = []()
+	{
+		std::array<response::Value, 18> values;
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			response::Value entry(response::Type::EnumValue);
+
+			entry.set<response::StringType>(std::string(s_namesDirectiveLocation[i]));
+			values[i] = std::move(entry);
+		}
+
+		return values;
+	}();
+
+	return response::Value(s_values[static_cast<size_t>(value)]);
+}
+
+template <>
+void ModifiedResult<introspection::DirectiveLocation>::writeValue(introspection::DirectiveLocation&& value, response::Writer& writer)
+{
+	writer.add_enum(s_namesDirectiveLocation[static_cast<size_t>(value)]);
 }
 
 template <>
@@ -101,11 +199,11 @@ std::future<response::Value> ModifiedResult<introspection::DirectiveLocation>::c
 	return resolve(std::move(result), std::move(params),
 		[](introspection::DirectiveLocation&& value, const ResolverParams&)
 		{
-			response::Value result(response::Type::EnumValue);
-
-			result.set<response::StringType>(std::string(s_namesDirectiveLocation[static_cast<size_t>(value)]));
-
-			return result;
+			return convertValue(std::move(value));
+		},
+		[](introspection::DirectiveLocation&& value, const ResolverParams&, response::Writer& writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
@@ -115,101 +213,131 @@ namespace introspection {
 namespace object {
 
 Schema::Schema()
-	: service::Object({
+	: service::Object("__Schema", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Schema::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"__Schema"
-	}, {
-		{ "types", [this](service::ResolverParams&& params) { return resolveTypes(std::move(params)); } },
-		{ "queryType", [this](service::ResolverParams&& params) { return resolveQueryType(std::move(params)); } },
-		{ "mutationType", [this](service::ResolverParams&& params) { return resolveMutationType(std::move(params)); } },
-		{ "subscriptionType", [this](service::ResolverParams&& params) { return resolveSubscriptionType(std::move(params)); } },
-		{ "directives", [this](service::ResolverParams&& params) { return resolveDirectives(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Schema::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "types", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Schema&>(object).resolveTypes(std::move(params)); } },
+		{ "queryType", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Schema&>(object).resolveQueryType(std::move(params)); } },
+		{ "mutationType", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Schema&>(object).resolveMutationType(std::move(params)); } },
+		{ "subscriptionType", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Schema&>(object).resolveSubscriptionType(std::move(params)); } },
+		{ "directives", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Schema&>(object).resolveDirectives(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Schema&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
-std::future<response::Value> Schema::resolveTypes(service::ResolverParams&& params)
+std::future<response::Value> Schema::resolveTypes(service::ResolverParams&& params) const
 {
 	auto result = getTypes(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Schema::resolveQueryType(service::ResolverParams&& params)
+std::future<response::Value> Schema::resolveQueryType(service::ResolverParams&& params) const
 {
 	auto result = getQueryType(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Schema::resolveMutationType(service::ResolverParams&& params)
+std::future<response::Value> Schema::resolveMutationType(service::ResolverParams&& params) const
 {
 	auto result = getMutationType(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Schema::resolveSubscriptionType(service::ResolverParams&& params)
+std::future<response::Value> Schema::resolveSubscriptionType(service::ResolverParams&& params) const
 {
 	auto result = getSubscriptionType(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Schema::resolveDirectives(service::ResolverParams&& params)
+std::future<response::Value> Schema::resolveDirectives(service::ResolverParams&& params) const
 {
 	auto result = getDirectives(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Directive>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Schema::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Schema::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(__Schema)gql" }, std::move(params));
 }
 
 Type::Type()
-	: service::Object({
+	: service::Object("__Type", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Type::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"__Type"
-	}, {
-		{ "kind", [this](service::ResolverParams&& params) { return resolveKind(std::move(params)); } },
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "fields", [this](service::ResolverParams&& params) { return resolveFields(std::move(params)); } },
-		{ "interfaces", [this](service::ResolverParams&& params) { return resolveInterfaces(std::move(params)); } },
-		{ "possibleTypes", [this](service::ResolverParams&& params) { return resolvePossibleTypes(std::move(params)); } },
-		{ "enumValues", [this](service::ResolverParams&& params) { return resolveEnumValues(std::move(params)); } },
-		{ "inputFields", [this](service::ResolverParams&& params) { return resolveInputFields(std::move(params)); } },
-		{ "ofType", [this](service::ResolverParams&& params) { return resolveOfType(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Type::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "kind", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveKind(std::move(params)); } },
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveName(std::move(params)); } },
+		{ "description", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveDescription(std::move(params)); } },
+		{ "fields", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveFields(std::move(params)); } },
+		{ "interfaces", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveInterfaces(std::move(params)); } },
+		{ "possibleTypes", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolvePossibleTypes(std::move(params)); } },
+		{ "enumValues", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveEnumValues(std::move(params)); } },
+		{ "inputFields", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveInputFields(std::move(params)); } },
+		{ "ofType", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolveOfType(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Type&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
-std::future<response::Value> Type::resolveKind(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveKind(service::ResolverParams&& params) const
 {
 	auto result = getKind(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<TypeKind>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveName(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveName(service::ResolverParams&& params) const
 {
 	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveDescription(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveDescription(service::ResolverParams&& params) const
 {
 	auto result = getDescription(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveFields(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveFields(service::ResolverParams&& params) const
 {
-	const auto defaultArguments = []()
+	static const auto defaultArguments = []()
 	{
 		response::Value values(response::Type::Map);
 		response::Value entry;
@@ -229,23 +357,23 @@ std::future<response::Value> Type::resolveFields(service::ResolverParams&& param
 	return service::ModifiedResult<Field>::convert<service::TypeModifier::Nullable, service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveInterfaces(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveInterfaces(service::ResolverParams&& params) const
 {
 	auto result = getInterfaces(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert<service::TypeModifier::Nullable, service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolvePossibleTypes(service::ResolverParams&& params)
+std::future<response::Value> Type::resolvePossibleTypes(service::ResolverParams&& params) const
 {
 	auto result = getPossibleTypes(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert<service::TypeModifier::Nullable, service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveEnumValues(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveEnumValues(service::ResolverParams&& params) const
 {
-	const auto defaultArguments = []()
+	static const auto defaultArguments = []()
 	{
 		response::Value values(response::Type::Map);
 		response::Value entry;
@@ -265,221 +393,281 @@ std::future<response::Value> Type::resolveEnumValues(service::ResolverParams&& p
 	return service::ModifiedResult<EnumValue>::convert<service::TypeModifier::Nullable, service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveInputFields(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveInputFields(service::ResolverParams&& params) const
 {
 	auto result = getInputFields(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<InputValue>::convert<service::TypeModifier::Nullable, service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolveOfType(service::ResolverParams&& params)
+std::future<response::Value> Type::resolveOfType(service::ResolverParams&& params) const
 {
 	auto result = getOfType(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Type::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Type::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(__Type)gql" }, std::move(params));
 }
 
 Field::Field()
-	: service::Object({
+	: service::Object("__Field", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Field::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"__Field"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "args", [this](service::ResolverParams&& params) { return resolveArgs(std::move(params)); } },
-		{ "type", [this](service::ResolverParams&& params) { return resolveType(std::move(params)); } },
-		{ "isDeprecated", [this](service::ResolverParams&& params) { return resolveIsDeprecated(std::move(params)); } },
-		{ "deprecationReason", [this](service::ResolverParams&& params) { return resolveDeprecationReason(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Field::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolveName(std::move(params)); } },
+		{ "description", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolveDescription(std::move(params)); } },
+		{ "args", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolveArgs(std::move(params)); } },
+		{ "type", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolveType(std::move(params)); } },
+		{ "isDeprecated", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolveIsDeprecated(std::move(params)); } },
+		{ "deprecationReason", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolveDeprecationReason(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Field&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
-std::future<response::Value> Field::resolveName(service::ResolverParams&& params)
+std::future<response::Value> Field::resolveName(service::ResolverParams&& params) const
 {
 	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Field::resolveDescription(service::ResolverParams&& params)
+std::future<response::Value> Field::resolveDescription(service::ResolverParams&& params) const
 {
 	auto result = getDescription(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Field::resolveArgs(service::ResolverParams&& params)
+std::future<response::Value> Field::resolveArgs(service::ResolverParams&& params) const
 {
 	auto result = getArgs(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<InputValue>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Field::resolveType(service::ResolverParams&& params)
+std::future<response::Value> Field::resolveType(service::ResolverParams&& params) const
 {
 	auto result = getType(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Field::resolveIsDeprecated(service::ResolverParams&& params)
+std::future<response::Value> Field::resolveIsDeprecated(service::ResolverParams&& params) const
 {
 	auto result = getIsDeprecated(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Field::resolveDeprecationReason(service::ResolverParams&& params)
+std::future<response::Value> Field::resolveDeprecationReason(service::ResolverParams&& params) const
 {
 	auto result = getDeprecationReason(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Field::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Field::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(__Field)gql" }, std::move(params));
 }
 
 InputValue::InputValue()
-	: service::Object({
+	: service::Object("__InputValue", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& InputValue::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"__InputValue"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "type", [this](service::ResolverParams&& params) { return resolveType(std::move(params)); } },
-		{ "defaultValue", [this](service::ResolverParams&& params) { return resolveDefaultValue(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& InputValue::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const InputValue&>(object).resolveName(std::move(params)); } },
+		{ "description", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const InputValue&>(object).resolveDescription(std::move(params)); } },
+		{ "type", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const InputValue&>(object).resolveType(std::move(params)); } },
+		{ "defaultValue", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const InputValue&>(object).resolveDefaultValue(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const InputValue&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
-std::future<response::Value> InputValue::resolveName(service::ResolverParams&& params)
+std::future<response::Value> InputValue::resolveName(service::ResolverParams&& params) const
 {
 	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> InputValue::resolveDescription(service::ResolverParams&& params)
+std::future<response::Value> InputValue::resolveDescription(service::ResolverParams&& params) const
 {
 	auto result = getDescription(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> InputValue::resolveType(service::ResolverParams&& params)
+std::future<response::Value> InputValue::resolveType(service::ResolverParams&& params) const
 {
 	auto result = getType(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<Type>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> InputValue::resolveDefaultValue(service::ResolverParams&& params)
+std::future<response::Value> InputValue::resolveDefaultValue(service::ResolverParams&& params) const
 {
 	auto result = getDefaultValue(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> InputValue::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> InputValue::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(__InputValue)gql" }, std::move(params));
 }
 
 EnumValue::EnumValue()
-	: service::Object({
+	: service::Object("__EnumValue", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& EnumValue::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"__EnumValue"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "isDeprecated", [this](service::ResolverParams&& params) { return resolveIsDeprecated(std::move(params)); } },
-		{ "deprecationReason", [this](service::ResolverParams&& params) { return resolveDeprecationReason(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& EnumValue::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const EnumValue&>(object).resolveName(std::move(params)); } },
+		{ "description", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const EnumValue&>(object).resolveDescription(std::move(params)); } },
+		{ "isDeprecated", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const EnumValue&>(object).resolveIsDeprecated(std::move(params)); } },
+		{ "deprecationReason", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const EnumValue&>(object).resolveDeprecationReason(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const EnumValue&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
-std::future<response::Value> EnumValue::resolveName(service::ResolverParams&& params)
+std::future<response::Value> EnumValue::resolveName(service::ResolverParams&& params) const
 {
 	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> EnumValue::resolveDescription(service::ResolverParams&& params)
+std::future<response::Value> EnumValue::resolveDescription(service::ResolverParams&& params) const
 {
 	auto result = getDescription(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> EnumValue::resolveIsDeprecated(service::ResolverParams&& params)
+std::future<response::Value> EnumValue::resolveIsDeprecated(service::ResolverParams&& params) const
 {
 	auto result = getIsDeprecated(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> EnumValue::resolveDeprecationReason(service::ResolverParams&& params)
+std::future<response::Value> EnumValue::resolveDeprecationReason(service::ResolverParams&& params) const
 {
 	auto result = getDeprecationReason(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> EnumValue::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> EnumValue::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(__EnumValue)gql" }, std::move(params));
 }
 
 Directive::Directive()
-	: service::Object({
+	: service::Object("__Directive", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Directive::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"__Directive"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "locations", [this](service::ResolverParams&& params) { return resolveLocations(std::move(params)); } },
-		{ "args", [this](service::ResolverParams&& params) { return resolveArgs(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Directive::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Directive&>(object).resolveName(std::move(params)); } },
+		{ "description", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Directive&>(object).resolveDescription(std::move(params)); } },
+		{ "locations", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Directive&>(object).resolveLocations(std::move(params)); } },
+		{ "args", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Directive&>(object).resolveArgs(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Directive&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
-std::future<response::Value> Directive::resolveName(service::ResolverParams&& params)
+std::future<response::Value> Directive::resolveName(service::ResolverParams&& params) const
 {
 	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Directive::resolveDescription(service::ResolverParams&& params)
+std::future<response::Value> Directive::resolveDescription(service::ResolverParams&& params) const
 {
 	auto result = getDescription(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Directive::resolveLocations(service::ResolverParams&& params)
+std::future<response::Value> Directive::resolveLocations(service::ResolverParams&& params) const
 {
 	auto result = getLocations(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<DirectiveLocation>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Directive::resolveArgs(service::ResolverParams&& params)
+std::future<response::Value> Directive::resolveArgs(service::ResolverParams&& params) const
 {
 	auto result = getArgs(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<InputValue>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Directive::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Directive::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(__Directive)gql" }, std::move(params));
 }
@@ -71,13 +71,16 @@ public:
 	virtual service::FieldResult<std::vector<std::shared_ptr<Directive>>> getDirectives(service::FieldParams&& params) const = 0;
 
 private:
-	std::future<response::Value> resolveTypes(service::ResolverParams&& params);
-	std::future<response::Value> resolveQueryType(service::ResolverParams&& params);
-	std::future<response::Value> resolveMutationType(service::ResolverParams&& params);
-	std::future<response::Value> resolveSubscriptionType(service::ResolverParams&& params);
-	std::future<response::Value> resolveDirectives(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveTypes(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveQueryType(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveMutationType(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveSubscriptionType(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDirectives(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Type
@@ -98,17 +101,20 @@ public:
 	virtual service::FieldResult<std::shared_ptr<Type>> getOfType(service::FieldParams&& params) const = 0;
 
 private:
-	std::future<response::Value> resolveKind(service::ResolverParams&& params);
-	std::future<response::Value> resolveName(service::ResolverParams&& params);
-	std::future<response::Value> resolveDescription(service::ResolverParams&& params);
-	std::future<response::Value> resolveFields(service::ResolverParams&& params);
-	std::future<response::Value> resolveInterfaces(service::ResolverParams&& params);
-	std::future<response::Value> resolvePossibleTypes(service::ResolverParams&& params);
-	std::future<response::Value> resolveEnumValues(service::ResolverParams&& params);
-	std::future<response::Value> resolveInputFields(service::ResolverParams&& params);
-	std::future<response::Value> resolveOfType(service::ResolverParams&& params);
-
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveKind(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveName(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveFields(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveInterfaces(service::ResolverParams&& params) const;
+	std::future<response::Value> resolvePossibleTypes(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveEnumValues(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveInputFields(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveOfType(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Field
@@ -126,14 +132,17 @@ public:
 	virtual service::FieldResult<std::optional<response::StringType>> getDeprecationReason(service::FieldParams&& params) const = 0;
 
 private:
-	std::future<response::Value> resolveName(service::ResolverParams&& params);
-	std::future<response::Value> resolveDescription(service::ResolverParams&& params);
-	std::future<response::Value> resolveArgs(service::ResolverParams&& params);
-	std::future<response::Value> resolveType(service::ResolverParams&& params);
-	std::future<response::Value> resolveIsDeprecated(service::ResolverParams&& params);
-	std::future<response::Value> resolveDeprecationReason(service::ResolverParams&& params);
-
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveName(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveArgs(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveType(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveIsDeprecated(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDeprecationReason(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class InputValue
@@ -149,12 +158,15 @@ public:
 	virtual service::FieldResult<std::optional<response::StringType>> getDefaultValue(service::FieldParams&& params) const = 0;
 
 private:
-	std::future<response::Value> resolveName(service::ResolverParams&& params);
-	std::future<response::Value> resolveDescription(service::ResolverParams&& params);
-	std::future<response::Value> resolveType(service::ResolverParams&& params);
-	std::future<response::Value> resolveDefaultValue(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveName(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveType(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDefaultValue(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class EnumValue
@@ -170,12 +182,15 @@ public:
 	virtual service::FieldResult<std::optional<response::StringType>> getDeprecationReason(service::FieldParams&& params) const = 0;
 
 private:
-	std::future<response::Value> resolveName(service::ResolverParams&& params);
-	std::future<response::Value> resolveDescription(service::ResolverParams&& params);
-	std::future<response::Value> resolveIsDeprecated(service::ResolverParams&& params);
-	std::future<response::Value> resolveDeprecationReason(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveName(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveIsDeprecated(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDeprecationReason(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Directive
@@ -191,12 +206,15 @@ public:
 	virtual service::FieldResult<std::vector<std::shared_ptr<InputValue>>> getArgs(service::FieldParams&& params) const = 0;
 
 private:
-	std::future<response::Value> resolveName(service::ResolverParams&& params);
-	std::future<response::Value> resolveDescription(service::ResolverParams&& params);
-	std::future<response::Value> resolveLocations(service::ResolverParams&& params);
-	std::future<response::Value> resolveArgs(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveName(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveLocations(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveArgs(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace object */
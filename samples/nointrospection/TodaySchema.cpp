@@ -0,0 +1,1204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+#include <array>
+
+namespace graphql {
+namespace service {
+
+static const std::array<std::string_view, 4> s_namesTaskState = {
+	"New",
+	"Started",
+	"Complete",
+	"Unassigned"
+};
+
+static const std::array<std::pair<std::string_view, today::TaskState>, 4> s_sortedTaskState = { {
+	{ "Complete", today::TaskState::Complete },
+	{ "New", today::TaskState::New },
+	{ "Started", today::TaskState::Started },
+	{ "Unassigned", today::TaskState::Unassigned }
+} };
+
+template <>
+today::TaskState ModifiedArgument<today::TaskState>::convert(const response::Value& value)
+{
+	if (!value.maybe_enum())
+	{
+		throw service::schema_exception({ "not a valid TaskState value" });
+	}
+
+	const std::string_view name = value.get<const response::StringType&>();
+	auto itr = std::lower_bound(s_sortedTaskState.cbegin(), s_sortedTaskState.cend(), name,
+		[](const auto& entry, std::string_view key) noexcept
+		{
+			return entry.first < key;
+		});
+
+	if (itr == s_sortedTaskState.cend() || itr->first != name)
+	{
+		throw service::schema_exception({ "not a valid TaskState value" });
+	}
+
+	return itr->second;
+}
+
+template <>
+response::Value ModifiedResult<today::TaskState>::convertValue(today::TaskState&& value)
+{
+	// Build each of the enum values once, copying one of them just shares its data.
+	static const auto s_values = []()
+	{
+		std::array<response::Value, 4> values;
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			response::Value entry(response::Type::EnumValue);
+
+			entry.set<response::StringType>(std::string(s_namesTaskState[i]));
+			values[i] = std::move(entry);
+		}
+
+		return values;
+	}();
+
+	return response::Value(s_values[static_cast<size_t>(value)]);
+}
+
+template <>
+void ModifiedResult<today::TaskState>::writeValue(today::TaskState&& value, response::Writer& writer)
+{
+	writer.add_enum(s_namesTaskState[static_cast<size_t>(value)]);
+}
+
+template <>
+std::future<response::Value> ModifiedResult<today::TaskState>::convert(service::FieldResult<today::TaskState>&& result, ResolverParams&& params)
+{
+	return resolve(std::move(result), std::move(params),
+		[](today::TaskState&& value, const ResolverParams&)
+		{
+			return convertValue(std::move(value));
+		},
+		[](today::TaskState&& value, const ResolverParams&, response::Writer& writer)
+		{
+			writeValue(std::move(value), writer);
+		});
+}
+
+template <>
+today::CompleteTaskInput ModifiedArgument<today::CompleteTaskInput>::convert(const response::Value& value)
+{
+	static const auto defaultValue = []()
+	{
+		response::Value values(response::Type::Map);
+		response::Value entry;
+
+		entry = response::Value(true);
+		values.emplace_back("isComplete", std::move(entry));
+
+		return values;
+	}();
+
+	auto valueId = service::ModifiedArgument<response::IdType>::require("id", value);
+	auto pairIsComplete = service::ModifiedArgument<response::BooleanType>::find<service::TypeModifier::Nullable>("isComplete", value);
+	auto valueIsComplete = (pairIsComplete.second
+		? std::move(pairIsComplete.first)
+		: service::ModifiedArgument<response::BooleanType>::require<service::TypeModifier::Nullable>("isComplete", defaultValue));
+	auto valueClientMutationId = service::ModifiedArgument<response::StringType>::require<service::TypeModifier::Nullable>("clientMutationId", value);
+
+	return {
+		std::move(valueId),
+		std::move(valueIsComplete),
+		std::move(valueClientMutationId)
+	};
+}
+
+} /* namespace service */
+
+namespace today {
+namespace object {
+
+Query::Query()
+	: service::Object("Query", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Query::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Query"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Query::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "node", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveNode(std::move(params)); } },
+		{ "appointments", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveAppointments(std::move(params)); } },
+		{ "tasks", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveTasks(std::move(params)); } },
+		{ "unreadCounts", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveUnreadCounts(std::move(params)); } },
+		{ "appointmentsById", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveAppointmentsById(std::move(params)); } },
+		{ "tasksById", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveTasksById(std::move(params)); } },
+		{ "unreadCountsById", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveUnreadCountsById(std::move(params)); } },
+		{ "nested", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveNested(std::move(params)); } },
+		{ "unimplemented", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveUnimplemented(std::move(params)); } },
+		{ "stringList", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveStringList(std::move(params)); } },
+		{ "nestedIntList", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveNestedIntList(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<service::Object>> Query::getNode(service::FieldParams&&, response::IdType&&) const
+{
+	throw std::runtime_error(R"ex(Query::getNode is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveNode(service::ResolverParams&& params) const
+{
+	auto argId = service::ModifiedArgument<response::IdType>::require("id", params.arguments);
+	auto result = getNode(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argId));
+
+	return service::ModifiedResult<service::Object>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::shared_ptr<AppointmentConnection>> Query::getAppointments(service::FieldParams&&, std::optional<response::IntType>&&, std::optional<response::Value>&&, std::optional<response::IntType>&&, std::optional<response::Value>&&) const
+{
+	throw std::runtime_error(R"ex(Query::getAppointments is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveAppointments(service::ResolverParams&& params) const
+{
+	auto argFirst = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("first", params.arguments);
+	auto argAfter = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("after", params.arguments);
+	auto argLast = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("last", params.arguments);
+	auto argBefore = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("before", params.arguments);
+	auto result = getAppointments(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
+
+	return service::ModifiedResult<AppointmentConnection>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::shared_ptr<TaskConnection>> Query::getTasks(service::FieldParams&&, std::optional<response::IntType>&&, std::optional<response::Value>&&, std::optional<response::IntType>&&, std::optional<response::Value>&&) const
+{
+	throw std::runtime_error(R"ex(Query::getTasks is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveTasks(service::ResolverParams&& params) const
+{
+	auto argFirst = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("first", params.arguments);
+	auto argAfter = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("after", params.arguments);
+	auto argLast = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("last", params.arguments);
+	auto argBefore = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("before", params.arguments);
+	auto result = getTasks(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
+
+	return service::ModifiedResult<TaskConnection>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::shared_ptr<FolderConnection>> Query::getUnreadCounts(service::FieldParams&&, std::optional<response::IntType>&&, std::optional<response::Value>&&, std::optional<response::IntType>&&, std::optional<response::Value>&&) const
+{
+	throw std::runtime_error(R"ex(Query::getUnreadCounts is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveUnreadCounts(service::ResolverParams&& params) const
+{
+	auto argFirst = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("first", params.arguments);
+	auto argAfter = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("after", params.arguments);
+	auto argLast = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("last", params.arguments);
+	auto argBefore = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("before", params.arguments);
+	auto result = getUnreadCounts(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
+
+	return service::ModifiedResult<FolderConnection>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::vector<std::shared_ptr<Appointment>>> Query::getAppointmentsById(service::FieldParams&&, std::vector<response::IdType>&&) const
+{
+	throw std::runtime_error(R"ex(Query::getAppointmentsById is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveAppointmentsById(service::ResolverParams&& params) const
+{
+	static const auto defaultArguments = []()
+	{
+		response::Value values(response::Type::Map);
+		response::Value entry;
+
+		entry = []()
+		{
+			response::Value elements(response::Type::List);
+			response::Value entry;
+
+			entry = response::Value(std::string(R"gql(ZmFrZUFwcG9pbnRtZW50SWQ=)gql"));
+			elements.emplace_back(std::move(entry));
+			return elements;
+		}();
+		values.emplace_back("ids", std::move(entry));
+
+		return values;
+	}();
+
+	auto pairIds = service::ModifiedArgument<response::IdType>::find<service::TypeModifier::List>("ids", params.arguments);
+	auto argIds = (pairIds.second
+		? std::move(pairIds.first)
+		: service::ModifiedArgument<response::IdType>::require<service::TypeModifier::List>("ids", defaultArguments));
+	auto result = getAppointmentsById(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argIds));
+
+	return service::ModifiedResult<Appointment>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::vector<std::shared_ptr<Task>>> Query::getTasksById(service::FieldParams&&, std::vector<response::IdType>&&) const
+{
+	throw std::runtime_error(R"ex(Query::getTasksById is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveTasksById(service::ResolverParams&& params) const
+{
+	auto argIds = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::List>("ids", params.arguments);
+	auto result = getTasksById(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argIds));
+
+	return service::ModifiedResult<Task>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::vector<std::shared_ptr<Folder>>> Query::getUnreadCountsById(service::FieldParams&&, std::vector<response::IdType>&&) const
+{
+	throw std::runtime_error(R"ex(Query::getUnreadCountsById is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveUnreadCountsById(service::ResolverParams&& params) const
+{
+	auto argIds = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::List>("ids", params.arguments);
+	auto result = getUnreadCountsById(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argIds));
+
+	return service::ModifiedResult<Folder>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::shared_ptr<NestedType>> Query::getNested(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Query::getNested is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveNested(service::ResolverParams&& params) const
+{
+	auto result = getNested(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<NestedType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::StringType> Query::getUnimplemented(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Query::getUnimplemented is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveUnimplemented(service::ResolverParams&& params) const
+{
+	auto result = getUnimplemented(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::vector<response::StringType>> Query::getStringList(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Query::getStringList is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveStringList(service::ResolverParams&& params) const
+{
+	auto result = getStringList(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>> Query::getNestedIntList(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Query::getNestedIntList is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveNestedIntList(service::ResolverParams&& params) const
+{
+	auto result = getNestedIntList(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IntType>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Query::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Query)gql" }, std::move(params));
+}
+
+PageInfo::PageInfo()
+	: service::Object("PageInfo", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& PageInfo::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"PageInfo"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& PageInfo::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "hasNextPage", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const PageInfo&>(object).resolveHasNextPage(std::move(params)); } },
+		{ "hasPreviousPage", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const PageInfo&>(object).resolveHasPreviousPage(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const PageInfo&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<response::BooleanType> PageInfo::getHasNextPage(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(PageInfo::getHasNextPage is not implemented)ex");
+}
+
+std::future<response::Value> PageInfo::resolveHasNextPage(service::ResolverParams&& params) const
+{
+	auto result = getHasNextPage(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::BooleanType> PageInfo::getHasPreviousPage(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(PageInfo::getHasPreviousPage is not implemented)ex");
+}
+
+std::future<response::Value> PageInfo::resolveHasPreviousPage(service::ResolverParams&& params) const
+{
+	auto result = getHasPreviousPage(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> PageInfo::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(PageInfo)gql" }, std::move(params));
+}
+
+AppointmentEdge::AppointmentEdge()
+	: service::Object("AppointmentEdge", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& AppointmentEdge::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"AppointmentEdge"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& AppointmentEdge::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "node", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentEdge&>(object).resolveNode(std::move(params)); } },
+		{ "cursor", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentEdge&>(object).resolveCursor(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentEdge&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<Appointment>> AppointmentEdge::getNode(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(AppointmentEdge::getNode is not implemented)ex");
+}
+
+std::future<response::Value> AppointmentEdge::resolveNode(service::ResolverParams&& params) const
+{
+	auto result = getNode(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<Appointment>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::Value> AppointmentEdge::getCursor(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(AppointmentEdge::getCursor is not implemented)ex");
+}
+
+std::future<response::Value> AppointmentEdge::resolveCursor(service::ResolverParams&& params) const
+{
+	auto result = getCursor(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::Value>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> AppointmentEdge::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(AppointmentEdge)gql" }, std::move(params));
+}
+
+AppointmentConnection::AppointmentConnection()
+	: service::Object("AppointmentConnection", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& AppointmentConnection::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"AppointmentConnection"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& AppointmentConnection::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "pageInfo", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentConnection&>(object).resolvePageInfo(std::move(params)); } },
+		{ "edges", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentConnection&>(object).resolveEdges(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentConnection&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<PageInfo>> AppointmentConnection::getPageInfo(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(AppointmentConnection::getPageInfo is not implemented)ex");
+}
+
+std::future<response::Value> AppointmentConnection::resolvePageInfo(service::ResolverParams&& params) const
+{
+	auto result = getPageInfo(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<PageInfo>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<std::vector<std::shared_ptr<AppointmentEdge>>>> AppointmentConnection::getEdges(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(AppointmentConnection::getEdges is not implemented)ex");
+}
+
+std::future<response::Value> AppointmentConnection::resolveEdges(service::ResolverParams&& params) const
+{
+	auto result = getEdges(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<AppointmentEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+std::future<response::Value> AppointmentConnection::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(AppointmentConnection)gql" }, std::move(params));
+}
+
+TaskEdge::TaskEdge()
+	: service::Object("TaskEdge", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& TaskEdge::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"TaskEdge"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& TaskEdge::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "node", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskEdge&>(object).resolveNode(std::move(params)); } },
+		{ "cursor", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskEdge&>(object).resolveCursor(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskEdge&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<Task>> TaskEdge::getNode(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(TaskEdge::getNode is not implemented)ex");
+}
+
+std::future<response::Value> TaskEdge::resolveNode(service::ResolverParams&& params) const
+{
+	auto result = getNode(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<Task>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::Value> TaskEdge::getCursor(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(TaskEdge::getCursor is not implemented)ex");
+}
+
+std::future<response::Value> TaskEdge::resolveCursor(service::ResolverParams&& params) const
+{
+	auto result = getCursor(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::Value>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> TaskEdge::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(TaskEdge)gql" }, std::move(params));
+}
+
+TaskConnection::TaskConnection()
+	: service::Object("TaskConnection", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& TaskConnection::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"TaskConnection"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& TaskConnection::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "pageInfo", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskConnection&>(object).resolvePageInfo(std::move(params)); } },
+		{ "edges", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskConnection&>(object).resolveEdges(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskConnection&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<PageInfo>> TaskConnection::getPageInfo(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(TaskConnection::getPageInfo is not implemented)ex");
+}
+
+std::future<response::Value> TaskConnection::resolvePageInfo(service::ResolverParams&& params) const
+{
+	auto result = getPageInfo(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<PageInfo>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<std::vector<std::shared_ptr<TaskEdge>>>> TaskConnection::getEdges(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(TaskConnection::getEdges is not implemented)ex");
+}
+
+std::future<response::Value> TaskConnection::resolveEdges(service::ResolverParams&& params) const
+{
+	auto result = getEdges(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<TaskEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+std::future<response::Value> TaskConnection::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(TaskConnection)gql" }, std::move(params));
+}
+
+FolderEdge::FolderEdge()
+	: service::Object("FolderEdge", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& FolderEdge::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"FolderEdge"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& FolderEdge::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "node", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const FolderEdge&>(object).resolveNode(std::move(params)); } },
+		{ "cursor", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const FolderEdge&>(object).resolveCursor(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const FolderEdge&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<Folder>> FolderEdge::getNode(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(FolderEdge::getNode is not implemented)ex");
+}
+
+std::future<response::Value> FolderEdge::resolveNode(service::ResolverParams&& params) const
+{
+	auto result = getNode(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<Folder>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::Value> FolderEdge::getCursor(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(FolderEdge::getCursor is not implemented)ex");
+}
+
+std::future<response::Value> FolderEdge::resolveCursor(service::ResolverParams&& params) const
+{
+	auto result = getCursor(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::Value>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> FolderEdge::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(FolderEdge)gql" }, std::move(params));
+}
+
+FolderConnection::FolderConnection()
+	: service::Object("FolderConnection", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& FolderConnection::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"FolderConnection"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& FolderConnection::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "pageInfo", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const FolderConnection&>(object).resolvePageInfo(std::move(params)); } },
+		{ "edges", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const FolderConnection&>(object).resolveEdges(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const FolderConnection&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<PageInfo>> FolderConnection::getPageInfo(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(FolderConnection::getPageInfo is not implemented)ex");
+}
+
+std::future<response::Value> FolderConnection::resolvePageInfo(service::ResolverParams&& params) const
+{
+	auto result = getPageInfo(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<PageInfo>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<std::vector<std::shared_ptr<FolderEdge>>>> FolderConnection::getEdges(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(FolderConnection::getEdges is not implemented)ex");
+}
+
+std::future<response::Value> FolderConnection::resolveEdges(service::ResolverParams&& params) const
+{
+	auto result = getEdges(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<FolderEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+std::future<response::Value> FolderConnection::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(FolderConnection)gql" }, std::move(params));
+}
+
+CompleteTaskPayload::CompleteTaskPayload()
+	: service::Object("CompleteTaskPayload", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& CompleteTaskPayload::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"CompleteTaskPayload"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& CompleteTaskPayload::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "task", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const CompleteTaskPayload&>(object).resolveTask(std::move(params)); } },
+		{ "clientMutationId", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const CompleteTaskPayload&>(object).resolveClientMutationId(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const CompleteTaskPayload&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<Task>> CompleteTaskPayload::getTask(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(CompleteTaskPayload::getTask is not implemented)ex");
+}
+
+std::future<response::Value> CompleteTaskPayload::resolveTask(service::ResolverParams&& params) const
+{
+	auto result = getTask(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<Task>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<response::StringType>> CompleteTaskPayload::getClientMutationId(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(CompleteTaskPayload::getClientMutationId is not implemented)ex");
+}
+
+std::future<response::Value> CompleteTaskPayload::resolveClientMutationId(service::ResolverParams&& params) const
+{
+	auto result = getClientMutationId(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+std::future<response::Value> CompleteTaskPayload::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(CompleteTaskPayload)gql" }, std::move(params));
+}
+
+Mutation::Mutation()
+	: service::Object("Mutation", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Mutation::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Mutation"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Mutation::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "completeTask", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Mutation&>(object).resolveCompleteTask(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Mutation&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<CompleteTaskPayload>> Mutation::applyCompleteTask(service::FieldParams&&, CompleteTaskInput&&) const
+{
+	throw std::runtime_error(R"ex(Mutation::applyCompleteTask is not implemented)ex");
+}
+
+std::future<response::Value> Mutation::resolveCompleteTask(service::ResolverParams&& params) const
+{
+	auto argInput = service::ModifiedArgument<CompleteTaskInput>::require("input", params.arguments);
+	auto result = applyCompleteTask(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argInput));
+
+	return service::ModifiedResult<CompleteTaskPayload>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Mutation::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Mutation)gql" }, std::move(params));
+}
+
+Subscription::Subscription()
+	: service::Object("Subscription", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Subscription::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Subscription"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Subscription::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "nextAppointmentChange", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Subscription&>(object).resolveNextAppointmentChange(std::move(params)); } },
+		{ "nodeChange", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Subscription&>(object).resolveNodeChange(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Subscription&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<std::shared_ptr<Appointment>> Subscription::getNextAppointmentChange(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Subscription::getNextAppointmentChange is not implemented)ex");
+}
+
+std::future<response::Value> Subscription::resolveNextAppointmentChange(service::ResolverParams&& params) const
+{
+	auto result = getNextAppointmentChange(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<Appointment>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::shared_ptr<service::Object>> Subscription::getNodeChange(service::FieldParams&&, response::IdType&&) const
+{
+	throw std::runtime_error(R"ex(Subscription::getNodeChange is not implemented)ex");
+}
+
+std::future<response::Value> Subscription::resolveNodeChange(service::ResolverParams&& params) const
+{
+	auto argId = service::ModifiedArgument<response::IdType>::require("id", params.arguments);
+	auto result = getNodeChange(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argId));
+
+	return service::ModifiedResult<service::Object>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Subscription::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Subscription)gql" }, std::move(params));
+}
+
+Appointment::Appointment()
+	: service::Object("Appointment", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Appointment::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Node",
+		"Appointment"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Appointment::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "id", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveId(std::move(params)); } },
+		{ "when", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveWhen(std::move(params)); } },
+		{ "subject", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveSubject(std::move(params)); } },
+		{ "isNow", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveIsNow(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<response::IdType> Appointment::getId(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Appointment::getId is not implemented)ex");
+}
+
+std::future<response::Value> Appointment::resolveId(service::ResolverParams&& params) const
+{
+	auto result = getId(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IdType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<response::Value>> Appointment::getWhen(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Appointment::getWhen is not implemented)ex");
+}
+
+std::future<response::Value> Appointment::resolveWhen(service::ResolverParams&& params) const
+{
+	auto result = getWhen(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::Value>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<response::StringType>> Appointment::getSubject(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Appointment::getSubject is not implemented)ex");
+}
+
+std::future<response::Value> Appointment::resolveSubject(service::ResolverParams&& params) const
+{
+	auto result = getSubject(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::BooleanType> Appointment::getIsNow(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Appointment::getIsNow is not implemented)ex");
+}
+
+std::future<response::Value> Appointment::resolveIsNow(service::ResolverParams&& params) const
+{
+	auto result = getIsNow(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Appointment::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Appointment)gql" }, std::move(params));
+}
+
+Task::Task()
+	: service::Object("Task", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Task::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Node",
+		"Task"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Task::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "id", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolveId(std::move(params)); } },
+		{ "title", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolveTitle(std::move(params)); } },
+		{ "isComplete", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolveIsComplete(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<response::IdType> Task::getId(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Task::getId is not implemented)ex");
+}
+
+std::future<response::Value> Task::resolveId(service::ResolverParams&& params) const
+{
+	auto result = getId(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IdType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<response::StringType>> Task::getTitle(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Task::getTitle is not implemented)ex");
+}
+
+service::FieldResult<std::vector<std::optional<response::StringType>>> Task::getTitleBatch(service::FieldParams&& params, const std::vector<std::shared_ptr<Task>>& parents) const
+{
+	std::queue<service::FieldResult<std::optional<response::StringType>>> results;
+
+	for (const auto& parent : parents)
+	{
+		results.push(parent->getTitle(service::FieldParams(params, response::Value(params.fieldDirectives))));
+	}
+
+	return std::async(std::launch::deferred,
+		[](std::queue<service::FieldResult<std::optional<response::StringType>>>&& wrappedResults)
+		{
+			std::vector<std::optional<response::StringType>> values;
+
+			values.reserve(wrappedResults.size());
+
+			while (!wrappedResults.empty())
+			{
+				values.push_back(wrappedResults.front().get());
+				wrappedResults.pop();
+			}
+
+			return values;
+		}, std::move(results));
+}
+
+std::future<response::Value> Task::resolveTitle(service::ResolverParams&& params) const
+{
+	if (params.batch)
+	{
+		auto result = params.batch->getResult<std::optional<response::StringType>>(params.batchIndex, params.fieldName, params.arguments,
+			[this, &params]()
+			{
+				return getTitleBatch(service::FieldParams(params, response::Value(params.fieldDirectives)), params.batch->getSiblings<Task>());
+			});
+
+		return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+	}
+
+	auto result = getTitle(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::BooleanType> Task::getIsComplete(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Task::getIsComplete is not implemented)ex");
+}
+
+std::future<response::Value> Task::resolveIsComplete(service::ResolverParams&& params) const
+{
+	auto result = getIsComplete(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Task::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Task)gql" }, std::move(params));
+}
+
+Folder::Folder()
+	: service::Object("Folder", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Folder::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Node",
+		"Folder"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Folder::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "id", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolveId(std::move(params)); } },
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolveName(std::move(params)); } },
+		{ "unreadCount", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolveUnreadCount(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<response::IdType> Folder::getId(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Folder::getId is not implemented)ex");
+}
+
+std::future<response::Value> Folder::resolveId(service::ResolverParams&& params) const
+{
+	auto result = getId(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IdType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<response::StringType>> Folder::getName(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Folder::getName is not implemented)ex");
+}
+
+std::future<response::Value> Folder::resolveName(service::ResolverParams&& params) const
+{
+	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::FieldResult<response::IntType> Folder::getUnreadCount(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Folder::getUnreadCount is not implemented)ex");
+}
+
+std::future<response::Value> Folder::resolveUnreadCount(service::ResolverParams&& params) const
+{
+	auto result = getUnreadCount(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IntType>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Folder::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Folder)gql" }, std::move(params));
+}
+
+NestedType::NestedType()
+	: service::Object("NestedType", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& NestedType::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"NestedType"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& NestedType::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "depth", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const NestedType&>(object).resolveDepth(std::move(params)); } },
+		{ "nested", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const NestedType&>(object).resolveNested(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const NestedType&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
+service::FieldResult<response::IntType> NestedType::getDepth(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(NestedType::getDepth is not implemented)ex");
+}
+
+std::future<response::Value> NestedType::resolveDepth(service::ResolverParams&& params) const
+{
+	auto result = getDepth(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IntType>::convert(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::shared_ptr<NestedType>> NestedType::getNested(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(NestedType::getNested is not implemented)ex");
+}
+
+std::future<response::Value> NestedType::resolveNested(service::ResolverParams&& params) const
+{
+	auto result = getNested(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<NestedType>::convert(std::move(result), std::move(params));
+}
+
+std::future<response::Value> NestedType::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(NestedType)gql" }, std::move(params));
+}
+
+} /* namespace object */
+
+Operations::Operations(std::shared_ptr<object::Query> query, std::shared_ptr<object::Mutation> mutation, std::shared_ptr<object::Subscription> subscription)
+	: service::Request({
+		{ "query", query },
+		{ "mutation", mutation },
+		{ "subscription", subscription }
+	})
+	, _query(std::move(query))
+	, _mutation(std::move(mutation))
+	, _subscription(std::move(subscription))
+{
+}
+
+} /* namespace today */
+} /* namespace graphql */
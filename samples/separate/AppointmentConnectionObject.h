@@ -18,10 +18,13 @@ public:
 	virtual service::FieldResult<std::optional<std::vector<std::shared_ptr<AppointmentEdge>>>> getEdges(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params);
-	std::future<response::Value> resolveEdges(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveEdges(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace graphql::today::object */
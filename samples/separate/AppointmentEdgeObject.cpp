@@ -15,14 +15,29 @@ namespace graphql::today {
 namespace object {
 
 AppointmentEdge::AppointmentEdge()
-	: service::Object({
+	: service::Object("AppointmentEdge", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& AppointmentEdge::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"AppointmentEdge"
-	}, {
-		{ "node", [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
-		{ "cursor", [this](service::ResolverParams&& params) { return resolveCursor(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& AppointmentEdge::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "node", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentEdge&>(object).resolveNode(std::move(params)); } },
+		{ "cursor", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentEdge&>(object).resolveCursor(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const AppointmentEdge&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<std::shared_ptr<Appointment>> AppointmentEdge::getNode(service::FieldParams&&) const
@@ -30,7 +45,7 @@ service::FieldResult<std::shared_ptr<Appointment>> AppointmentEdge::getNode(serv
 	throw std::runtime_error(R"ex(AppointmentEdge::getNode is not implemented)ex");
 }
 
-std::future<response::Value> AppointmentEdge::resolveNode(service::ResolverParams&& params)
+std::future<response::Value> AppointmentEdge::resolveNode(service::ResolverParams&& params) const
 {
 	auto result = getNode(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -42,14 +57,14 @@ service::FieldResult<response::Value> AppointmentEdge::getCursor(service::FieldP
 	throw std::runtime_error(R"ex(AppointmentEdge::getCursor is not implemented)ex");
 }
 
-std::future<response::Value> AppointmentEdge::resolveCursor(service::ResolverParams&& params)
+std::future<response::Value> AppointmentEdge::resolveCursor(service::ResolverParams&& params) const
 {
 	auto result = getCursor(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::Value>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> AppointmentEdge::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> AppointmentEdge::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(AppointmentEdge)gql" }, std::move(params));
 }
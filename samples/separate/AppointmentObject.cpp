@@ -15,17 +15,32 @@ namespace graphql::today {
 namespace object {
 
 Appointment::Appointment()
-	: service::Object({
+	: service::Object("Appointment", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Appointment::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"Node",
 		"Appointment"
-	}, {
-		{ "id", [this](service::ResolverParams&& params) { return resolveId(std::move(params)); } },
-		{ "when", [this](service::ResolverParams&& params) { return resolveWhen(std::move(params)); } },
-		{ "subject", [this](service::ResolverParams&& params) { return resolveSubject(std::move(params)); } },
-		{ "isNow", [this](service::ResolverParams&& params) { return resolveIsNow(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Appointment::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "id", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveId(std::move(params)); } },
+		{ "when", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveWhen(std::move(params)); } },
+		{ "subject", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveSubject(std::move(params)); } },
+		{ "isNow", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolveIsNow(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Appointment&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<response::IdType> Appointment::getId(service::FieldParams&&) const
@@ -33,7 +48,7 @@ service::FieldResult<response::IdType> Appointment::getId(service::FieldParams&&
 	throw std::runtime_error(R"ex(Appointment::getId is not implemented)ex");
 }
 
-std::future<response::Value> Appointment::resolveId(service::ResolverParams&& params)
+std::future<response::Value> Appointment::resolveId(service::ResolverParams&& params) const
 {
 	auto result = getId(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -45,7 +60,7 @@ service::FieldResult<std::optional<response::Value>> Appointment::getWhen(servic
 	throw std::runtime_error(R"ex(Appointment::getWhen is not implemented)ex");
 }
 
-std::future<response::Value> Appointment::resolveWhen(service::ResolverParams&& params)
+std::future<response::Value> Appointment::resolveWhen(service::ResolverParams&& params) const
 {
 	auto result = getWhen(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -57,7 +72,7 @@ service::FieldResult<std::optional<response::StringType>> Appointment::getSubjec
 	throw std::runtime_error(R"ex(Appointment::getSubject is not implemented)ex");
 }
 
-std::future<response::Value> Appointment::resolveSubject(service::ResolverParams&& params)
+std::future<response::Value> Appointment::resolveSubject(service::ResolverParams&& params) const
 {
 	auto result = getSubject(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -69,14 +84,14 @@ service::FieldResult<response::BooleanType> Appointment::getIsNow(service::Field
 	throw std::runtime_error(R"ex(Appointment::getIsNow is not implemented)ex");
 }
 
-std::future<response::Value> Appointment::resolveIsNow(service::ResolverParams&& params)
+std::future<response::Value> Appointment::resolveIsNow(service::ResolverParams&& params) const
 {
 	auto result = getIsNow(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Appointment::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Appointment::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Appointment)gql" }, std::move(params));
 }
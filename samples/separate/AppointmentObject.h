@@ -21,12 +21,15 @@ public:
 	virtual service::FieldResult<response::BooleanType> getIsNow(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveId(service::ResolverParams&& params);
-	std::future<response::Value> resolveWhen(service::ResolverParams&& params);
-	std::future<response::Value> resolveSubject(service::ResolverParams&& params);
-	std::future<response::Value> resolveIsNow(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveId(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveWhen(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveSubject(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveIsNow(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace graphql::today::object */
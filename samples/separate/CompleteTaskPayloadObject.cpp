@@ -15,14 +15,29 @@ namespace graphql::today {
 namespace object {
 
 CompleteTaskPayload::CompleteTaskPayload()
-	: service::Object({
+	: service::Object("CompleteTaskPayload", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& CompleteTaskPayload::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"CompleteTaskPayload"
-	}, {
-		{ "task", [this](service::ResolverParams&& params) { return resolveTask(std::move(params)); } },
-		{ "clientMutationId", [this](service::ResolverParams&& params) { return resolveClientMutationId(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& CompleteTaskPayload::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "task", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const CompleteTaskPayload&>(object).resolveTask(std::move(params)); } },
+		{ "clientMutationId", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const CompleteTaskPayload&>(object).resolveClientMutationId(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const CompleteTaskPayload&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<std::shared_ptr<Task>> CompleteTaskPayload::getTask(service::FieldParams&&) const
@@ -30,7 +45,7 @@ service::FieldResult<std::shared_ptr<Task>> CompleteTaskPayload::getTask(service
 	throw std::runtime_error(R"ex(CompleteTaskPayload::getTask is not implemented)ex");
 }
 
-std::future<response::Value> CompleteTaskPayload::resolveTask(service::ResolverParams&& params)
+std::future<response::Value> CompleteTaskPayload::resolveTask(service::ResolverParams&& params) const
 {
 	auto result = getTask(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -42,14 +57,14 @@ service::FieldResult<std::optional<response::StringType>> CompleteTaskPayload::g
 	throw std::runtime_error(R"ex(CompleteTaskPayload::getClientMutationId is not implemented)ex");
 }
 
-std::future<response::Value> CompleteTaskPayload::resolveClientMutationId(service::ResolverParams&& params)
+std::future<response::Value> CompleteTaskPayload::resolveClientMutationId(service::ResolverParams&& params) const
 {
 	auto result = getClientMutationId(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> CompleteTaskPayload::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> CompleteTaskPayload::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(CompleteTaskPayload)gql" }, std::move(params));
 }
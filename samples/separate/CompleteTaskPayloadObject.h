@@ -18,10 +18,13 @@ public:
 	virtual service::FieldResult<std::optional<response::StringType>> getClientMutationId(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveTask(service::ResolverParams&& params);
-	std::future<response::Value> resolveClientMutationId(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveTask(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveClientMutationId(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace graphql::today::object */
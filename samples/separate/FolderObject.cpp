@@ -15,16 +15,31 @@ namespace graphql::today {
 namespace object {
 
 Folder::Folder()
-	: service::Object({
+	: service::Object("Folder", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Folder::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"Node",
 		"Folder"
-	}, {
-		{ "id", [this](service::ResolverParams&& params) { return resolveId(std::move(params)); } },
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "unreadCount", [this](service::ResolverParams&& params) { return resolveUnreadCount(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Folder::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "id", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolveId(std::move(params)); } },
+		{ "name", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolveName(std::move(params)); } },
+		{ "unreadCount", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolveUnreadCount(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Folder&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<response::IdType> Folder::getId(service::FieldParams&&) const
@@ -32,7 +47,7 @@ service::FieldResult<response::IdType> Folder::getId(service::FieldParams&&) con
 	throw std::runtime_error(R"ex(Folder::getId is not implemented)ex");
 }
 
-std::future<response::Value> Folder::resolveId(service::ResolverParams&& params)
+std::future<response::Value> Folder::resolveId(service::ResolverParams&& params) const
 {
 	auto result = getId(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -44,7 +59,7 @@ service::FieldResult<std::optional<response::StringType>> Folder::getName(servic
 	throw std::runtime_error(R"ex(Folder::getName is not implemented)ex");
 }
 
-std::future<response::Value> Folder::resolveName(service::ResolverParams&& params)
+std::future<response::Value> Folder::resolveName(service::ResolverParams&& params) const
 {
 	auto result = getName(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -56,14 +71,14 @@ service::FieldResult<response::IntType> Folder::getUnreadCount(service::FieldPar
 	throw std::runtime_error(R"ex(Folder::getUnreadCount is not implemented)ex");
 }
 
-std::future<response::Value> Folder::resolveUnreadCount(service::ResolverParams&& params)
+std::future<response::Value> Folder::resolveUnreadCount(service::ResolverParams&& params) const
 {
 	auto result = getUnreadCount(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::IntType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Folder::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Folder::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Folder)gql" }, std::move(params));
 }
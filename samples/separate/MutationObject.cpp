@@ -15,13 +15,28 @@ namespace graphql::today {
 namespace object {
 
 Mutation::Mutation()
-	: service::Object({
+	: service::Object("Mutation", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Mutation::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"Mutation"
-	}, {
-		{ "completeTask", [this](service::ResolverParams&& params) { return resolveCompleteTask(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Mutation::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "completeTask", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Mutation&>(object).resolveCompleteTask(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Mutation&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<std::shared_ptr<CompleteTaskPayload>> Mutation::applyCompleteTask(service::FieldParams&&, CompleteTaskInput&&) const
@@ -29,7 +44,7 @@ service::FieldResult<std::shared_ptr<CompleteTaskPayload>> Mutation::applyComple
 	throw std::runtime_error(R"ex(Mutation::applyCompleteTask is not implemented)ex");
 }
 
-std::future<response::Value> Mutation::resolveCompleteTask(service::ResolverParams&& params)
+std::future<response::Value> Mutation::resolveCompleteTask(service::ResolverParams&& params) const
 {
 	auto argInput = service::ModifiedArgument<CompleteTaskInput>::require("input", params.arguments);
 	auto result = applyCompleteTask(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argInput));
@@ -37,7 +52,7 @@ std::future<response::Value> Mutation::resolveCompleteTask(service::ResolverPara
 	return service::ModifiedResult<CompleteTaskPayload>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Mutation::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Mutation::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Mutation)gql" }, std::move(params));
 }
@@ -15,14 +15,29 @@ namespace graphql::today {
 namespace object {
 
 NestedType::NestedType()
-	: service::Object({
+	: service::Object("NestedType", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& NestedType::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"NestedType"
-	}, {
-		{ "depth", [this](service::ResolverParams&& params) { return resolveDepth(std::move(params)); } },
-		{ "nested", [this](service::ResolverParams&& params) { return resolveNested(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& NestedType::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "depth", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const NestedType&>(object).resolveDepth(std::move(params)); } },
+		{ "nested", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const NestedType&>(object).resolveNested(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const NestedType&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<response::IntType> NestedType::getDepth(service::FieldParams&&) const
@@ -30,7 +45,7 @@ service::FieldResult<response::IntType> NestedType::getDepth(service::FieldParam
 	throw std::runtime_error(R"ex(NestedType::getDepth is not implemented)ex");
 }
 
-std::future<response::Value> NestedType::resolveDepth(service::ResolverParams&& params)
+std::future<response::Value> NestedType::resolveDepth(service::ResolverParams&& params) const
 {
 	auto result = getDepth(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -42,14 +57,14 @@ service::FieldResult<std::shared_ptr<NestedType>> NestedType::getNested(service:
 	throw std::runtime_error(R"ex(NestedType::getNested is not implemented)ex");
 }
 
-std::future<response::Value> NestedType::resolveNested(service::ResolverParams&& params)
+std::future<response::Value> NestedType::resolveNested(service::ResolverParams&& params) const
 {
 	auto result = getNested(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<NestedType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> NestedType::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> NestedType::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(NestedType)gql" }, std::move(params));
 }
@@ -15,14 +15,29 @@ namespace graphql::today {
 namespace object {
 
 PageInfo::PageInfo()
-	: service::Object({
+	: service::Object("PageInfo", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& PageInfo::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"PageInfo"
-	}, {
-		{ "hasNextPage", [this](service::ResolverParams&& params) { return resolveHasNextPage(std::move(params)); } },
-		{ "hasPreviousPage", [this](service::ResolverParams&& params) { return resolveHasPreviousPage(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& PageInfo::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "hasNextPage", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const PageInfo&>(object).resolveHasNextPage(std::move(params)); } },
+		{ "hasPreviousPage", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const PageInfo&>(object).resolveHasPreviousPage(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const PageInfo&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<response::BooleanType> PageInfo::getHasNextPage(service::FieldParams&&) const
@@ -30,7 +45,7 @@ service::FieldResult<response::BooleanType> PageInfo::getHasNextPage(service::Fi
 	throw std::runtime_error(R"ex(PageInfo::getHasNextPage is not implemented)ex");
 }
 
-std::future<response::Value> PageInfo::resolveHasNextPage(service::ResolverParams&& params)
+std::future<response::Value> PageInfo::resolveHasNextPage(service::ResolverParams&& params) const
 {
 	auto result = getHasNextPage(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -42,14 +57,14 @@ service::FieldResult<response::BooleanType> PageInfo::getHasPreviousPage(service
 	throw std::runtime_error(R"ex(PageInfo::getHasPreviousPage is not implemented)ex");
 }
 
-std::future<response::Value> PageInfo::resolveHasPreviousPage(service::ResolverParams&& params)
+std::future<response::Value> PageInfo::resolveHasPreviousPage(service::ResolverParams&& params) const
 {
 	auto result = getHasPreviousPage(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> PageInfo::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> PageInfo::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(PageInfo)gql" }, std::move(params));
 }
@@ -15,34 +15,51 @@ namespace graphql::today {
 namespace object {
 
 Query::Query()
-	: service::Object({
-		"Query"
-	}, {
-		{ "node", [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
-		{ "appointments", [this](service::ResolverParams&& params) { return resolveAppointments(std::move(params)); } },
-		{ "tasks", [this](service::ResolverParams&& params) { return resolveTasks(std::move(params)); } },
-		{ "unreadCounts", [this](service::ResolverParams&& params) { return resolveUnreadCounts(std::move(params)); } },
-		{ "appointmentsById", [this](service::ResolverParams&& params) { return resolveAppointmentsById(std::move(params)); } },
-		{ "tasksById", [this](service::ResolverParams&& params) { return resolveTasksById(std::move(params)); } },
-		{ "unreadCountsById", [this](service::ResolverParams&& params) { return resolveUnreadCountsById(std::move(params)); } },
-		{ "nested", [this](service::ResolverParams&& params) { return resolveNested(std::move(params)); } },
-		{ "unimplemented", [this](service::ResolverParams&& params) { return resolveUnimplemented(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } },
-		{ "__schema", [this](service::ResolverParams&& params) { return resolve_schema(std::move(params)); } },
-		{ "__type", [this](service::ResolverParams&& params) { return resolve_type(std::move(params)); } }
-	})
+	: service::Object("Query", getTypeNames(), getResolvers())
 	, _schema(std::make_shared<introspection::Schema>())
 {
 	introspection::AddTypesToSchema(_schema);
 	today::AddTypesToSchema(_schema);
 }
 
+const service::TypeNames& Query::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+		"Query"
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Query::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "node", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveNode(std::move(params)); } },
+		{ "appointments", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveAppointments(std::move(params)); } },
+		{ "tasks", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveTasks(std::move(params)); } },
+		{ "unreadCounts", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveUnreadCounts(std::move(params)); } },
+		{ "appointmentsById", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveAppointmentsById(std::move(params)); } },
+		{ "tasksById", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveTasksById(std::move(params)); } },
+		{ "unreadCountsById", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveUnreadCountsById(std::move(params)); } },
+		{ "nested", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveNested(std::move(params)); } },
+		{ "unimplemented", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveUnimplemented(std::move(params)); } },
+		{ "stringList", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveStringList(std::move(params)); } },
+		{ "nestedIntList", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolveNestedIntList(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolve_typename(std::move(params)); } },
+		{ "__schema", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolve_schema(std::move(params)); } },
+		{ "__type", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Query&>(object).resolve_type(std::move(params)); } }
+	};
+
+	return resolvers;
+}
+
 service::FieldResult<std::shared_ptr<service::Object>> Query::getNode(service::FieldParams&&, response::IdType&&) const
 {
 	throw std::runtime_error(R"ex(Query::getNode is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveNode(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveNode(service::ResolverParams&& params) const
 {
 	auto argId = service::ModifiedArgument<response::IdType>::require("id", params.arguments);
 	auto result = getNode(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argId));
@@ -55,7 +72,7 @@ service::FieldResult<std::shared_ptr<AppointmentConnection>> Query::getAppointme
 	throw std::runtime_error(R"ex(Query::getAppointments is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveAppointments(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveAppointments(service::ResolverParams&& params) const
 {
 	auto argFirst = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("first", params.arguments);
 	auto argAfter = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("after", params.arguments);
@@ -71,7 +88,7 @@ service::FieldResult<std::shared_ptr<TaskConnection>> Query::getTasks(service::F
 	throw std::runtime_error(R"ex(Query::getTasks is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveTasks(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveTasks(service::ResolverParams&& params) const
 {
 	auto argFirst = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("first", params.arguments);
 	auto argAfter = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("after", params.arguments);
@@ -87,7 +104,7 @@ service::FieldResult<std::shared_ptr<FolderConnection>> Query::getUnreadCounts(s
 	throw std::runtime_error(R"ex(Query::getUnreadCounts is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveUnreadCounts(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveUnreadCounts(service::ResolverParams&& params) const
 {
 	auto argFirst = service::ModifiedArgument<response::IntType>::require<service::TypeModifier::Nullable>("first", params.arguments);
 	auto argAfter = service::ModifiedArgument<response::Value>::require<service::TypeModifier::Nullable>("after", params.arguments);
@@ -103,9 +120,9 @@ service::FieldResult<std::vector<std::shared_ptr<Appointment>>> Query::getAppoin
 	throw std::runtime_error(R"ex(Query::getAppointmentsById is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveAppointmentsById(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveAppointmentsById(service::ResolverParams&& params) const
 {
-	const auto defaultArguments = []()
+	static const auto defaultArguments = []()
 	{
 		response::Value values(response::Type::Map);
 		response::Value entry;
@@ -138,7 +155,7 @@ service::FieldResult<std::vector<std::shared_ptr<Task>>> Query::getTasksById(ser
 	throw std::runtime_error(R"ex(Query::getTasksById is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveTasksById(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveTasksById(service::ResolverParams&& params) const
 {
 	auto argIds = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::List>("ids", params.arguments);
 	auto result = getTasksById(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argIds));
@@ -151,7 +168,7 @@ service::FieldResult<std::vector<std::shared_ptr<Folder>>> Query::getUnreadCount
 	throw std::runtime_error(R"ex(Query::getUnreadCountsById is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveUnreadCountsById(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveUnreadCountsById(service::ResolverParams&& params) const
 {
 	auto argIds = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::List>("ids", params.arguments);
 	auto result = getUnreadCountsById(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argIds));
@@ -164,7 +181,7 @@ service::FieldResult<std::shared_ptr<NestedType>> Query::getNested(service::Fiel
 	throw std::runtime_error(R"ex(Query::getNested is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveNested(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveNested(service::ResolverParams&& params) const
 {
 	auto result = getNested(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -176,24 +193,48 @@ service::FieldResult<response::StringType> Query::getUnimplemented(service::Fiel
 	throw std::runtime_error(R"ex(Query::getUnimplemented is not implemented)ex");
 }
 
-std::future<response::Value> Query::resolveUnimplemented(service::ResolverParams&& params)
+std::future<response::Value> Query::resolveUnimplemented(service::ResolverParams&& params) const
 {
 	auto result = getUnimplemented(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Query::resolve_typename(service::ResolverParams&& params)
+service::FieldResult<std::vector<response::StringType>> Query::getStringList(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Query::getStringList is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveStringList(service::ResolverParams&& params) const
+{
+	auto result = getStringList(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
+}
+
+service::FieldResult<std::optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>> Query::getNestedIntList(service::FieldParams&&) const
+{
+	throw std::runtime_error(R"ex(Query::getNestedIntList is not implemented)ex");
+}
+
+std::future<response::Value> Query::resolveNestedIntList(service::ResolverParams&& params) const
+{
+	auto result = getNestedIntList(service::FieldParams(params, std::move(params.fieldDirectives)));
+
+	return service::ModifiedResult<response::IntType>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+std::future<response::Value> Query::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Query)gql" }, std::move(params));
 }
 
-std::future<response::Value> Query::resolve_schema(service::ResolverParams&& params)
+std::future<response::Value> Query::resolve_schema(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<service::Object>::convert(std::static_pointer_cast<service::Object>(_schema), std::move(params));
 }
 
-std::future<response::Value> Query::resolve_type(service::ResolverParams&& params)
+std::future<response::Value> Query::resolve_type(service::ResolverParams&& params) const
 {
 	auto argName = service::ModifiedArgument<response::StringType>::require("name", params.arguments);
 
@@ -236,7 +277,9 @@ void AddQueryDetails(std::shared_ptr<introspection::ObjectType> typeQuery, std::
 			std::make_shared<introspection::InputValue>("ids", R"md()md", schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType("ID")))), R"gql()gql")
 		}), schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->LookupType("Folder")))),
 		std::make_shared<introspection::Field>("nested", R"md()md", std::nullopt, std::vector<std::shared_ptr<introspection::InputValue>>(), schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType("NestedType"))),
-		std::make_shared<introspection::Field>("unimplemented", R"md()md", std::nullopt, std::vector<std::shared_ptr<introspection::InputValue>>(), schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType("String")))
+		std::make_shared<introspection::Field>("unimplemented", R"md()md", std::nullopt, std::vector<std::shared_ptr<introspection::InputValue>>(), schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType("String"))),
+		std::make_shared<introspection::Field>("stringList", R"md()md", std::nullopt, std::vector<std::shared_ptr<introspection::InputValue>>(), schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType("String"))))),
+		std::make_shared<introspection::Field>("nestedIntList", R"md()md", std::nullopt, std::vector<std::shared_ptr<introspection::InputValue>>(), schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::LIST, schema->LookupType("Int"))))
 	});
 }
 
@@ -23,21 +23,28 @@ public:
 	virtual service::FieldResult<std::vector<std::shared_ptr<Folder>>> getUnreadCountsById(service::FieldParams&& params, std::vector<response::IdType>&& idsArg) const;
 	virtual service::FieldResult<std::shared_ptr<NestedType>> getNested(service::FieldParams&& params) const;
 	virtual service::FieldResult<response::StringType> getUnimplemented(service::FieldParams&& params) const;
+	virtual service::FieldResult<std::vector<response::StringType>> getStringList(service::FieldParams&& params) const;
+	virtual service::FieldResult<std::optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>> getNestedIntList(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveNode(service::ResolverParams&& params);
-	std::future<response::Value> resolveAppointments(service::ResolverParams&& params);
-	std::future<response::Value> resolveTasks(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnreadCounts(service::ResolverParams&& params);
-	std::future<response::Value> resolveAppointmentsById(service::ResolverParams&& params);
-	std::future<response::Value> resolveTasksById(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnreadCountsById(service::ResolverParams&& params);
-	std::future<response::Value> resolveNested(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnimplemented(service::ResolverParams&& params);
-
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
-	std::future<response::Value> resolve_schema(service::ResolverParams&& params);
-	std::future<response::Value> resolve_type(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveNode(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveAppointments(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveTasks(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnreadCounts(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveAppointmentsById(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveTasksById(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnreadCountsById(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNested(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnimplemented(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveStringList(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNestedIntList(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
+	std::future<response::Value> resolve_schema(service::ResolverParams&& params) const;
+	std::future<response::Value> resolve_type(service::ResolverParams&& params) const;
 
 	std::shared_ptr<introspection::Schema> _schema;
 };
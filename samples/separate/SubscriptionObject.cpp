@@ -15,14 +15,29 @@ namespace graphql::today {
 namespace object {
 
 Subscription::Subscription()
-	: service::Object({
+	: service::Object("Subscription", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Subscription::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"Subscription"
-	}, {
-		{ "nextAppointmentChange", [this](service::ResolverParams&& params) { return resolveNextAppointmentChange(std::move(params)); } },
-		{ "nodeChange", [this](service::ResolverParams&& params) { return resolveNodeChange(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Subscription::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "nextAppointmentChange", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Subscription&>(object).resolveNextAppointmentChange(std::move(params)); } },
+		{ "nodeChange", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Subscription&>(object).resolveNodeChange(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Subscription&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<std::shared_ptr<Appointment>> Subscription::getNextAppointmentChange(service::FieldParams&&) const
@@ -30,7 +45,7 @@ service::FieldResult<std::shared_ptr<Appointment>> Subscription::getNextAppointm
 	throw std::runtime_error(R"ex(Subscription::getNextAppointmentChange is not implemented)ex");
 }
 
-std::future<response::Value> Subscription::resolveNextAppointmentChange(service::ResolverParams&& params)
+std::future<response::Value> Subscription::resolveNextAppointmentChange(service::ResolverParams&& params) const
 {
 	auto result = getNextAppointmentChange(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -42,7 +57,7 @@ service::FieldResult<std::shared_ptr<service::Object>> Subscription::getNodeChan
 	throw std::runtime_error(R"ex(Subscription::getNodeChange is not implemented)ex");
 }
 
-std::future<response::Value> Subscription::resolveNodeChange(service::ResolverParams&& params)
+std::future<response::Value> Subscription::resolveNodeChange(service::ResolverParams&& params) const
 {
 	auto argId = service::ModifiedArgument<response::IdType>::require("id", params.arguments);
 	auto result = getNodeChange(service::FieldParams(params, std::move(params.fieldDirectives)), std::move(argId));
@@ -50,7 +65,7 @@ std::future<response::Value> Subscription::resolveNodeChange(service::ResolverPa
 	return service::ModifiedResult<service::Object>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Subscription::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Subscription::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Subscription)gql" }, std::move(params));
 }
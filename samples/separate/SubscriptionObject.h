@@ -18,10 +18,13 @@ public:
 	virtual service::FieldResult<std::shared_ptr<service::Object>> getNodeChange(service::FieldParams&& params, response::IdType&& idArg) const;
 
 private:
-	std::future<response::Value> resolveNextAppointmentChange(service::ResolverParams&& params);
-	std::future<response::Value> resolveNodeChange(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveNextAppointmentChange(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNodeChange(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace graphql::today::object */
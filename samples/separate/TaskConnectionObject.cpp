@@ -15,14 +15,29 @@ namespace graphql::today {
 namespace object {
 
 TaskConnection::TaskConnection()
-	: service::Object({
+	: service::Object("TaskConnection", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& TaskConnection::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"TaskConnection"
-	}, {
-		{ "pageInfo", [this](service::ResolverParams&& params) { return resolvePageInfo(std::move(params)); } },
-		{ "edges", [this](service::ResolverParams&& params) { return resolveEdges(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& TaskConnection::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "pageInfo", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskConnection&>(object).resolvePageInfo(std::move(params)); } },
+		{ "edges", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskConnection&>(object).resolveEdges(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const TaskConnection&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<std::shared_ptr<PageInfo>> TaskConnection::getPageInfo(service::FieldParams&&) const
@@ -30,7 +45,7 @@ service::FieldResult<std::shared_ptr<PageInfo>> TaskConnection::getPageInfo(serv
 	throw std::runtime_error(R"ex(TaskConnection::getPageInfo is not implemented)ex");
 }
 
-std::future<response::Value> TaskConnection::resolvePageInfo(service::ResolverParams&& params)
+std::future<response::Value> TaskConnection::resolvePageInfo(service::ResolverParams&& params) const
 {
 	auto result = getPageInfo(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -42,14 +57,14 @@ service::FieldResult<std::optional<std::vector<std::shared_ptr<TaskEdge>>>> Task
 	throw std::runtime_error(R"ex(TaskConnection::getEdges is not implemented)ex");
 }
 
-std::future<response::Value> TaskConnection::resolveEdges(service::ResolverParams&& params)
+std::future<response::Value> TaskConnection::resolveEdges(service::ResolverParams&& params) const
 {
 	auto result = getEdges(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<TaskEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(std::move(result), std::move(params));
 }
 
-std::future<response::Value> TaskConnection::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> TaskConnection::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(TaskConnection)gql" }, std::move(params));
 }
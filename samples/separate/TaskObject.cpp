@@ -15,16 +15,31 @@ namespace graphql::today {
 namespace object {
 
 Task::Task()
-	: service::Object({
+	: service::Object("Task", getTypeNames(), getResolvers())
+{
+}
+
+const service::TypeNames& Task::getTypeNames()
+{
+	static const service::TypeNames typeNames {
 		"Node",
 		"Task"
-	}, {
-		{ "id", [this](service::ResolverParams&& params) { return resolveId(std::move(params)); } },
-		{ "title", [this](service::ResolverParams&& params) { return resolveTitle(std::move(params)); } },
-		{ "isComplete", [this](service::ResolverParams&& params) { return resolveIsComplete(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
-	})
+	};
+
+	return typeNames;
+}
+
+const service::ObjectResolverMap& Task::getResolvers()
 {
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+		{ "id", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolveId(std::move(params)); } },
+		{ "title", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolveTitle(std::move(params)); } },
+		{ "isComplete", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolveIsComplete(std::move(params)); } },
+		{ "__typename", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const Task&>(object).resolve_typename(std::move(params)); } }
+	};
+
+	return resolvers;
 }
 
 service::FieldResult<response::IdType> Task::getId(service::FieldParams&&) const
@@ -32,7 +47,7 @@ service::FieldResult<response::IdType> Task::getId(service::FieldParams&&) const
 	throw std::runtime_error(R"ex(Task::getId is not implemented)ex");
 }
 
-std::future<response::Value> Task::resolveId(service::ResolverParams&& params)
+std::future<response::Value> Task::resolveId(service::ResolverParams&& params) const
 {
 	auto result = getId(service::FieldParams(params, std::move(params.fieldDirectives)));
 
@@ -44,8 +59,45 @@ service::FieldResult<std::optional<response::StringType>> Task::getTitle(service
 	throw std::runtime_error(R"ex(Task::getTitle is not implemented)ex");
 }
 
-std::future<response::Value> Task::resolveTitle(service::ResolverParams&& params)
+service::FieldResult<std::vector<std::optional<response::StringType>>> Task::getTitleBatch(service::FieldParams&& params, const std::vector<std::shared_ptr<Task>>& parents) const
 {
+	std::queue<service::FieldResult<std::optional<response::StringType>>> results;
+
+	for (const auto& parent : parents)
+	{
+		results.push(parent->getTitle(service::FieldParams(params, response::Value(params.fieldDirectives))));
+	}
+
+	return std::async(std::launch::deferred,
+		[](std::queue<service::FieldResult<std::optional<response::StringType>>>&& wrappedResults)
+		{
+			std::vector<std::optional<response::StringType>> values;
+
+			values.reserve(wrappedResults.size());
+
+			while (!wrappedResults.empty())
+			{
+				values.push_back(wrappedResults.front().get());
+				wrappedResults.pop();
+			}
+
+			return values;
+		}, std::move(results));
+}
+
+std::future<response::Value> Task::resolveTitle(service::ResolverParams&& params) const
+{
+	if (params.batch)
+	{
+		auto result = params.batch->getResult<std::optional<response::StringType>>(params.batchIndex, params.fieldName, params.arguments,
+			[this, &params]()
+			{
+				return getTitleBatch(service::FieldParams(params, response::Value(params.fieldDirectives)), params.batch->getSiblings<Task>());
+			});
+
+		return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+	}
+
 	auto result = getTitle(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::StringType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
@@ -56,14 +108,14 @@ service::FieldResult<response::BooleanType> Task::getIsComplete(service::FieldPa
 	throw std::runtime_error(R"ex(Task::getIsComplete is not implemented)ex");
 }
 
-std::future<response::Value> Task::resolveIsComplete(service::ResolverParams&& params)
+std::future<response::Value> Task::resolveIsComplete(service::ResolverParams&& params) const
 {
 	auto result = getIsComplete(service::FieldParams(params, std::move(params.fieldDirectives)));
 
 	return service::ModifiedResult<response::BooleanType>::convert(std::move(result), std::move(params));
 }
 
-std::future<response::Value> Task::resolve_typename(service::ResolverParams&& params)
+std::future<response::Value> Task::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql(Task)gql" }, std::move(params));
 }
@@ -17,14 +17,20 @@ protected:
 public:
 	virtual service::FieldResult<response::IdType> getId(service::FieldParams&& params) const override;
 	virtual service::FieldResult<std::optional<response::StringType>> getTitle(service::FieldParams&& params) const;
+	virtual service::FieldResult<std::vector<std::optional<response::StringType>>> getTitleBatch(service::FieldParams&& params, const std::vector<std::shared_ptr<Task>>& parents) const;
 	virtual service::FieldResult<response::BooleanType> getIsComplete(service::FieldParams&& params) const;
 
+	static constexpr bool hasBatchResolvers = true;
+
 private:
-	std::future<response::Value> resolveId(service::ResolverParams&& params);
-	std::future<response::Value> resolveTitle(service::ResolverParams&& params);
-	std::future<response::Value> resolveIsComplete(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveId(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveTitle(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveIsComplete(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace graphql::today::object */
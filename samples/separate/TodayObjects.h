@@ -20,3 +20,29 @@
 #include "TaskObject.h"
 #include "FolderObject.h"
 #include "NestedTypeObject.h"
+
+namespace graphql {
+namespace service {
+
+// These are instantiated once in TodaySchema.cpp instead of in every source file which resolves them.
+extern template std::future<response::Value> ModifiedResult<today::object::Appointment>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Appointment>::ResultTraits<today::object::Appointment, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::Task>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Task>::ResultTraits<today::object::Task, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::Folder>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Folder>::ResultTraits<today::object::Folder, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::Appointment>::convert<service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Appointment>::ResultTraits<today::object::Appointment, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::AppointmentEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::AppointmentEdge>::ResultTraits<today::object::AppointmentEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::Task>::convert<service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Task>::ResultTraits<today::object::Task, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::TaskEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::TaskEdge>::ResultTraits<today::object::TaskEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::Folder>::convert<service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Folder>::ResultTraits<today::object::Folder, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+extern template std::future<response::Value> ModifiedResult<today::object::FolderEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::FolderEdge>::ResultTraits<today::object::FolderEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+
+} /* namespace service */
+} /* namespace graphql */
@@ -22,6 +22,13 @@ static const std::array<std::string_view, 4> s_namesTaskState = {
 	"Unassigned"
 };
 
+static const std::array<std::pair<std::string_view, today::TaskState>, 4> s_sortedTaskState = { {
+	{ "Complete", today::TaskState::Complete },
+	{ "New", today::TaskState::New },
+	{ "Started", today::TaskState::Started },
+	{ "Unassigned", today::TaskState::Unassigned }
+} };
+
 template <>
 today::TaskState ModifiedArgument<today::TaskState>::convert(const response::Value& value)
 {
@@ -30,14 +37,47 @@ today::TaskState ModifiedArgument<today::TaskState>::convert(const response::Val
 		throw service::schema_exception({ "not a valid TaskState value" });
 	}
 
-	auto itr = std::find(s_namesTaskState.cbegin(), s_namesTaskState.cend(), value.get<const response::StringType&>());
+	const std::string_view name = value.get<const response::StringType&>();
+	auto itr = std::lower_bound(s_sortedTaskState.cbegin(), s_sortedTaskState.cend(), name,
+		[](const auto& entry, std::string_view key) noexcept
+		{
+			return entry.first < key;
+		});
 
-	if (itr == s_namesTaskState.cend())
+	if (itr == s_sortedTaskState.cend() || itr->first != name)
 	{
 		throw service::schema_exception({ "not a valid TaskState value" });
 	}
 
-	return static_cast<today::TaskState>(itr - s_namesTaskState.cbegin());
+	return itr->second;
+}
+
+template <>
+response::Value ModifiedResult<today::TaskState>::convertValue(today::TaskState&& value)
+{
+	// Build each of the enum values once, copying one of them just shares its data.
+	static const auto s_values = []()
+	{
+		std::array<response::Value, 4> values;
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			response::Value entry(response::Type::EnumValue);
+
+			entry.set<response::StringType>(std::string(s_namesTaskState[i]));
+			values[i] = std::move(entry);
+		}
+
+		return values;
+	}();
+
+	return response::Value(s_values[static_cast<size_t>(value)]);
+}
+
+template <>
+void ModifiedResult<today::TaskState>::writeValue(today::TaskState&& value, response::Writer& writer)
+{
+	writer.add_enum(s_namesTaskState[static_cast<size_t>(value)]);
 }
 
 template <>
@@ -46,18 +86,18 @@ std::future<response::Value> ModifiedResult<today::TaskState>::convert(service::
 	return resolve(std::move(result), std::move(params),
 		[](today::TaskState&& value, const ResolverParams&)
 		{
-			response::Value result(response::Type::EnumValue);
-
-			result.set<response::StringType>(std::string(s_namesTaskState[static_cast<size_t>(value)]));
-
-			return result;
+			return convertValue(std::move(value));
+		},
+		[](today::TaskState&& value, const ResolverParams&, response::Writer& writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
 template <>
 today::CompleteTaskInput ModifiedArgument<today::CompleteTaskInput>::convert(const response::Value& value)
 {
-	const auto defaultValue = []()
+	static const auto defaultValue = []()
 	{
 		response::Value values(response::Type::Map);
 		response::Value entry;
@@ -82,6 +122,26 @@ today::CompleteTaskInput ModifiedArgument<today::CompleteTaskInput>::convert(con
 	};
 }
 
+// Explicit instantiations for the extern template declarations in TodayObjects.h.
+template std::future<response::Value> ModifiedResult<today::object::Appointment>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Appointment>::ResultTraits<today::object::Appointment, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::Task>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Task>::ResultTraits<today::object::Task, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::Folder>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Folder>::ResultTraits<today::object::Folder, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::Appointment>::convert<service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Appointment>::ResultTraits<today::object::Appointment, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::AppointmentEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::AppointmentEdge>::ResultTraits<today::object::AppointmentEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::Task>::convert<service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Task>::ResultTraits<today::object::Task, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::TaskEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::TaskEdge>::ResultTraits<today::object::TaskEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::Folder>::convert<service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::Folder>::ResultTraits<today::object::Folder, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<today::object::FolderEdge>::convert<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>(
+	ModifiedResult<today::object::FolderEdge>::ResultTraits<today::object::FolderEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::future_type, ResolverParams&&);
+
 } /* namespace service */
 
 namespace today {
@@ -210,6 +270,9 @@ void AddTypesToSchema(std::shared_ptr<introspection::Schema> schema)
 	}), std::vector<std::shared_ptr<introspection::InputValue>>({
 		std::make_shared<introspection::InputValue>("inlineFragment", R"md()md", schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType("String")), R"gql()gql")
 	})));
+	schema->AddDirective(std::make_shared<introspection::Directive>("batch", R"md()md", std::vector<response::StringType>({
+		R"gql(FIELD_DEFINITION)gql"
+	}), std::vector<std::shared_ptr<introspection::InputValue>>()));
 
 	schema->AddQueryType(typeQuery);
 	schema->AddMutationType(typeMutation);
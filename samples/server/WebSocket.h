@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <graphqlservice/GraphQLService.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Just enough of RFC 6455 for the subscription sample and its benchmark: the opening handshake and
+// encoding or decoding single frames. Everything is inline so the server and the client can share it.
+namespace graphql::websocket {
+
+// The graphql-ws library calls its protocol graphql-transport-ws.
+constexpr std::string_view c_subprotocol = "graphql-transport-ws";
+constexpr std::string_view c_handshakeGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+enum class Opcode : uint8_t
+{
+	Continuation = 0x0,
+	Text = 0x1,
+	Binary = 0x2,
+	Close = 0x8,
+	Ping = 0x9,
+	Pong = 0xA,
+};
+
+// Close codes which graphql-transport-ws uses for protocol errors.
+enum class CloseCode : uint16_t
+{
+	Normal = 1000,
+	ProtocolError = 1002,
+	TooBig = 1009,
+	BadRequest = 4400,
+	Unauthorized = 4401,
+	SubscriberAlreadyExists = 4409,
+	TooManyInitialisationRequests = 4429,
+};
+
+// The handshake only needs SHA-1 to compute Sec-WebSocket-Accept, it's not used for anything else.
+inline std::array<uint8_t, 20> sha1(std::string_view input)
+{
+	uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+	std::string message(input);
+	const uint64_t bitLength = static_cast<uint64_t>(input.size()) * 8;
+
+	message.push_back(static_cast<char>(0x80));
+
+	while (message.size() % 64 != 56)
+	{
+		message.push_back('\0');
+	}
+
+	for (int shift = 56; shift >= 0; shift -= 8)
+	{
+		message.push_back(static_cast<char>(bitLength >> shift));
+	}
+
+	const auto rotate = [](uint32_t value, int bits) noexcept {
+		return (value << bits) | (value >> (32 - bits));
+	};
+
+	for (size_t offset = 0; offset < message.size(); offset += 64)
+	{
+		uint32_t w[80];
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			const auto bytes = reinterpret_cast<const uint8_t*>(message.data() + offset + i * 4);
+
+			w[i] = (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | bytes[3];
+		}
+
+		for (size_t i = 16; i < 80; ++i)
+		{
+			w[i] = rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+		}
+
+		uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+		for (size_t i = 0; i < 80; ++i)
+		{
+			uint32_t f;
+			uint32_t k;
+
+			if (i < 20)
+			{
+				f = (b & c) | (~b & d);
+				k = 0x5A827999;
+			}
+			else if (i < 40)
+			{
+				f = b ^ c ^ d;
+				k = 0x6ED9EBA1;
+			}
+			else if (i < 60)
+			{
+				f = (b & c) | (b & d) | (c & d);
+				k = 0x8F1BBCDC;
+			}
+			else
+			{
+				f = b ^ c ^ d;
+				k = 0xCA62C1D6;
+			}
+
+			const uint32_t temp = rotate(a, 5) + f + e + k + w[i];
+
+			e = d;
+			d = c;
+			c = rotate(b, 30);
+			b = a;
+			a = temp;
+		}
+
+		h[0] += a;
+		h[1] += b;
+		h[2] += c;
+		h[3] += d;
+		h[4] += e;
+	}
+
+	std::array<uint8_t, 20> digest;
+
+	for (size_t i = 0; i < digest.size(); ++i)
+	{
+		digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - (i % 4) * 8));
+	}
+
+	return digest;
+}
+
+// Compute the Sec-WebSocket-Accept header value for the client's Sec-WebSocket-Key.
+inline std::string getAcceptKey(std::string_view key)
+{
+	std::string input(key);
+
+	input.append(c_handshakeGuid);
+
+	const auto digest = sha1(input);
+
+	return service::Base64::toBase64(digest.data(), digest.size());
+}
+
+// Append a single frame with the whole payload to the output. Clients must mask their frames and
+// servers must not.
+inline void appendFrame(std::string& output, Opcode opcode, std::string_view payload, const uint8_t* mask = nullptr)
+{
+	const uint8_t maskBit = (mask ? 0x80 : 0);
+
+	output.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+
+	if (payload.size() < 126)
+	{
+		output.push_back(static_cast<char>(maskBit | payload.size()));
+	}
+	else if (payload.size() <= 0xFFFF)
+	{
+		output.push_back(static_cast<char>(maskBit | 126));
+		output.push_back(static_cast<char>(payload.size() >> 8));
+		output.push_back(static_cast<char>(payload.size()));
+	}
+	else
+	{
+		output.push_back(static_cast<char>(maskBit | 127));
+
+		for (int shift = 56; shift >= 0; shift -= 8)
+		{
+			output.push_back(static_cast<char>(static_cast<uint64_t>(payload.size()) >> shift));
+		}
+	}
+
+	if (!mask)
+	{
+		output.append(payload);
+		return;
+	}
+
+	output.append(reinterpret_cast<const char*>(mask), 4);
+
+	const auto offset = output.size();
+
+	output.append(payload);
+
+	for (size_t i = 0; i < payload.size(); ++i)
+	{
+		output[offset + i] ^= static_cast<char>(mask[i % 4]);
+	}
+}
+
+inline void appendClose(std::string& output, CloseCode code, std::string_view reason, const uint8_t* mask = nullptr)
+{
+	std::string payload;
+
+	payload.push_back(static_cast<char>(static_cast<uint16_t>(code) >> 8));
+	payload.push_back(static_cast<char>(static_cast<uint16_t>(code)));
+	payload.append(reason.substr(0, 123));
+
+	appendFrame(output, Opcode::Close, payload, mask);
+}
+
+struct Frame
+{
+	bool final = true;
+	Opcode opcode = Opcode::Text;
+	std::string payload;
+};
+
+enum class ParseResult
+{
+	Incomplete,
+	Complete,
+	TooBig,
+};
+
+// Decode the frame at the beginning of the input, unmasking the payload if necessary. If it's complete,
+// it sets consumed to the size of the frame so the caller can erase it from the input.
+inline ParseResult parseFrame(std::string_view input, size_t maxPayload, Frame& frame, size_t& consumed)
+{
+	if (input.size() < 2)
+	{
+		return ParseResult::Incomplete;
+	}
+
+	const auto bytes = reinterpret_cast<const uint8_t*>(input.data());
+	const bool masked = (bytes[1] & 0x80) != 0;
+	uint64_t payloadSize = bytes[1] & 0x7F;
+	size_t headerSize = 2;
+
+	if (payloadSize == 126)
+	{
+		headerSize += 2;
+
+		if (input.size() < headerSize)
+		{
+			return ParseResult::Incomplete;
+		}
+
+		payloadSize = (uint64_t(bytes[2]) << 8) | bytes[3];
+	}
+	else if (payloadSize == 127)
+	{
+		headerSize += 8;
+
+		if (input.size() < headerSize)
+		{
+			return ParseResult::Incomplete;
+		}
+
+		payloadSize = 0;
+
+		for (size_t i = 2; i < 10; ++i)
+		{
+			payloadSize = (payloadSize << 8) | bytes[i];
+		}
+	}
+
+	if (payloadSize > maxPayload)
+	{
+		return ParseResult::TooBig;
+	}
+
+	const size_t maskOffset = headerSize;
+
+	if (masked)
+	{
+		headerSize += 4;
+	}
+
+	if (input.size() < headerSize + payloadSize)
+	{
+		return ParseResult::Incomplete;
+	}
+
+	frame.final = (bytes[0] & 0x80) != 0;
+	frame.opcode = static_cast<Opcode>(bytes[0] & 0x0F);
+	frame.payload.assign(input.substr(headerSize, static_cast<size_t>(payloadSize)));
+
+	if (masked)
+	{
+		for (size_t i = 0; i < frame.payload.size(); ++i)
+		{
+			frame.payload[i] ^= static_cast<char>(bytes[maskOffset + (i % 4)]);
+		}
+	}
+
+	consumed = headerSize + static_cast<size_t>(payloadSize);
+
+	return ParseResult::Complete;
+}
+
+} /* namespace graphql::websocket */
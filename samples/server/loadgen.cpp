@@ -0,0 +1,381 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// A closed-loop load generator for the sample server. Each client thread keeps one connection open and
+// sends its next request as soon as it reads the previous response. It runs every combination of the
+// thread counts and launch policies, and prints one line of CSV with the throughput and latency
+// percentiles for each of them.
+
+#include <graphqlservice/JSONResponse.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace graphql;
+
+namespace {
+
+constexpr auto c_defaultQuery = R"gql(query Everything {
+	appointments {
+		edges {
+			node {
+				id
+				subject
+				when
+				isNow
+			}
+		}
+	}
+	tasks {
+		edges {
+			node {
+				id
+				title
+				isComplete
+			}
+		}
+	}
+	unreadCounts {
+		edges {
+			node {
+				id
+				name
+				unreadCount
+			}
+		}
+	}
+})gql";
+
+struct Options
+{
+	uint16_t port = 8080;
+	std::vector<size_t> threadCounts { 1, 2, 4, 8 };
+	std::vector<std::string> launchPolicies { "deferred", "async" };
+	std::chrono::seconds warmup { 1 };
+	std::chrono::seconds duration { 5 };
+	std::string query = c_defaultQuery;
+};
+
+struct ClientResults
+{
+	std::vector<uint32_t> latencies;
+	size_t errors = 0;
+};
+
+template <typename Value, typename Parse>
+std::vector<Value> splitList(std::string_view list, Parse&& parse)
+{
+	std::vector<Value> values;
+
+	while (!list.empty())
+	{
+		const auto end = std::min(list.find(','), list.size());
+
+		values.push_back(parse(std::string(list.substr(0, end))));
+		list.remove_prefix(std::min(end + 1, list.size()));
+	}
+
+	return values;
+}
+
+int connectToServer(uint16_t port)
+{
+	const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (fd < 0)
+	{
+		return -1;
+	}
+
+	sockaddr_in address {};
+
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+	{
+		::close(fd);
+		return -1;
+	}
+
+	const int enable = 1;
+
+	::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+	return fd;
+}
+
+bool sendAll(int fd, std::string_view data)
+{
+	while (!data.empty())
+	{
+		const auto sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+
+		if (sent <= 0)
+		{
+			return false;
+		}
+
+		data.remove_prefix(static_cast<size_t>(sent));
+	}
+
+	return true;
+}
+
+// Read a single response and return its status code, or 0 if the connection failed. Anything after the
+// end of the response stays in the buffer.
+int readResponse(int fd, std::string& buffer)
+{
+	size_t headerEnd = std::string::npos;
+	size_t responseSize = 0;
+	int status = 0;
+	char chunk[16 * 1024];
+
+	while (true)
+	{
+		if (headerEnd == std::string::npos)
+		{
+			headerEnd = buffer.find("\r\n\r\n");
+
+			if (headerEnd != std::string::npos)
+			{
+				const auto statusStart = buffer.find(' ');
+				const auto lengthHeader = buffer.find("Content-Length:");
+
+				status = std::atoi(buffer.c_str() + statusStart + 1);
+				responseSize = headerEnd + 4
+					+ (lengthHeader < headerEnd ? std::strtoul(buffer.c_str() + lengthHeader + 15, nullptr, 10) : 0);
+			}
+		}
+
+		if (headerEnd != std::string::npos && buffer.size() >= responseSize)
+		{
+			buffer.erase(0, responseSize);
+			return status;
+		}
+
+		const auto received = ::recv(fd, chunk, sizeof(chunk), 0);
+
+		if (received <= 0)
+		{
+			return 0;
+		}
+
+		buffer.append(chunk, static_cast<size_t>(received));
+	}
+}
+
+ClientResults runClient(const Options& options, const std::string& request,
+	std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	ClientResults results;
+	std::string buffer;
+	int fd = -1;
+
+	while (true)
+	{
+		if (fd < 0)
+		{
+			fd = connectToServer(options.port);
+
+			if (fd < 0)
+			{
+				++results.errors;
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+				if (std::chrono::steady_clock::now() >= end)
+				{
+					break;
+				}
+
+				continue;
+			}
+
+			buffer.clear();
+		}
+
+		const auto requestStart = std::chrono::steady_clock::now();
+
+		if (requestStart >= end)
+		{
+			break;
+		}
+
+		const int status = (sendAll(fd, request) ? readResponse(fd, buffer) : 0);
+		const auto requestEnd = std::chrono::steady_clock::now();
+
+		if (status == 0)
+		{
+			::close(fd);
+			fd = -1;
+		}
+
+		// Only count the requests which start after the warmup.
+		if (requestStart < start)
+		{
+			continue;
+		}
+
+		if (status != 200)
+		{
+			++results.errors;
+			continue;
+		}
+
+		results.latencies.push_back(static_cast<uint32_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(requestEnd - requestStart).count()));
+	}
+
+	if (fd >= 0)
+	{
+		::close(fd);
+	}
+
+	return results;
+}
+
+std::string makeRequest(const Options& options, std::string_view launch)
+{
+	response::Value payload(response::Type::Map);
+
+	payload.emplace_back("query", response::Value(std::string(options.query)));
+
+	const auto body = response::toJSON(std::move(payload));
+	std::ostringstream request;
+
+	request << "POST /graphql?launch=" << launch << " HTTP/1.1\r\n"
+		<< "Host: 127.0.0.1:" << options.port << "\r\n"
+		<< "Content-Type: application/json\r\n"
+		<< "Content-Length: " << body.size() << "\r\n"
+		<< "\r\n"
+		<< body;
+
+	return request.str();
+}
+
+uint32_t getPercentile(const std::vector<uint32_t>& sorted, double percentile)
+{
+	if (sorted.empty())
+	{
+		return 0;
+	}
+
+	return sorted[std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()))];
+}
+
+} /* namespace */
+
+int main(int argc, char** argv)
+{
+	Options options;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string_view option(argv[i]);
+		const std::string value(argv[i + 1]);
+
+		if (option == "--port")
+		{
+			options.port = static_cast<uint16_t>(std::stoul(value));
+		}
+		else if (option == "--threads")
+		{
+			options.threadCounts = splitList<size_t>(value, [](const std::string& count) {
+				return std::max<size_t>(1, std::stoul(count));
+			});
+		}
+		else if (option == "--launch")
+		{
+			options.launchPolicies = splitList<std::string>(value, [](std::string&& launch) {
+				return std::move(launch);
+			});
+		}
+		else if (option == "--warmup")
+		{
+			options.warmup = std::chrono::seconds(std::stoul(value));
+		}
+		else if (option == "--duration")
+		{
+			options.duration = std::chrono::seconds(std::stoul(value));
+		}
+		else if (option == "--query")
+		{
+			std::ifstream file(value);
+			std::ostringstream query;
+
+			query << file.rdbuf();
+			options.query = query.str();
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0]
+				<< " [--port 8080] [--threads 1,2,4,8] [--launch deferred,async] [--warmup 1] [--duration 5] [--query file.graphql]"
+				<< std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "launch,threads,requests,errors,requests_per_second,p50_us,p99_us,p999_us" << std::endl;
+
+	for (const auto& launch : options.launchPolicies)
+	{
+		const auto request = makeRequest(options, launch);
+
+		for (const auto threadCount : options.threadCounts)
+		{
+			const auto start = std::chrono::steady_clock::now() + options.warmup;
+			const auto end = start + options.duration;
+			std::vector<ClientResults> results(threadCount);
+			std::vector<std::thread> threads;
+
+			for (size_t i = 0; i < threadCount; ++i)
+			{
+				threads.emplace_back([&options, &request, &results, i, start, end]()
+				{
+					results[i] = runClient(options, request, start, end);
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			std::vector<uint32_t> latencies;
+			size_t errors = 0;
+
+			for (auto& result : results)
+			{
+				latencies.insert(latencies.end(), result.latencies.cbegin(), result.latencies.cend());
+				errors += result.errors;
+			}
+
+			std::sort(latencies.begin(), latencies.end());
+
+			const auto seconds = std::chrono::duration<double>(options.duration).count();
+
+			std::cout << launch << ',' << threadCount << ',' << latencies.size() << ',' << errors << ','
+				<< static_cast<uint64_t>(latencies.size() / seconds) << ','
+				<< getPercentile(latencies, 0.5) << ','
+				<< getPercentile(latencies, 0.99) << ','
+				<< getPercentile(latencies, 0.999) << std::endl;
+		}
+	}
+
+	return 0;
+}
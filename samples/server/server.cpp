@@ -0,0 +1,656 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// A minimal HTTP/1.1 server for the today sample, which accepts POST requests to /graphql on localhost.
+// Each worker thread runs its own epoll loop with its own listening socket (SO_REUSEPORT spreads the
+// connections between them) and its own instance of the service, so the workers don't share any state.
+// Add ?launch=async to the path to resolve the request with std::launch::async instead of deferred.
+
+#include "SeparateToday.h"
+
+#include <graphqlservice/JSONResponse.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace graphql;
+
+namespace {
+
+constexpr size_t c_maxRequestSize = 1024 * 1024;
+constexpr size_t c_maxCachedQueries = 1024;
+constexpr int c_maxEvents = 256;
+
+std::atomic_bool s_stopping { false };
+
+void stop(int)
+{
+	s_stopping = true;
+}
+
+response::IdType makeId(std::string_view name)
+{
+	response::IdType id(name.size());
+
+	std::copy(name.cbegin(), name.cend(), id.begin());
+
+	return id;
+}
+
+std::shared_ptr<today::Operations> makeService()
+{
+	auto query = std::make_shared<today::Query>(
+		[]() -> std::vector<std::shared_ptr<today::Appointment>>
+	{
+		return { std::make_shared<today::Appointment>(makeId("fakeAppointmentId"), "tomorrow", "Lunch?", false) };
+	}, []() -> std::vector<std::shared_ptr<today::Task>>
+	{
+		return { std::make_shared<today::Task>(makeId("fakeTaskId"), "Don't forget", true) };
+	}, []() -> std::vector<std::shared_ptr<today::Folder>>
+	{
+		return { std::make_shared<today::Folder>(makeId("fakeFolderId"), "\"Fake\" Inbox", 3) };
+	});
+	auto mutation = std::make_shared<today::Mutation>(
+		[](today::CompleteTaskInput&& input) -> std::shared_ptr<today::CompleteTaskPayload>
+	{
+		return std::make_shared<today::CompleteTaskPayload>(
+			std::make_shared<today::Task>(std::move(input.id), "Mutated Task!", *(input.isComplete)),
+			std::move(input.clientMutationId)
+		);
+	});
+	auto subscription = std::make_shared<today::Subscription>();
+
+	return std::make_shared<today::Operations>(query, mutation, subscription);
+}
+
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs)
+{
+	return lhs.size() == rhs.size()
+		&& std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(),
+			[](char a, char b) noexcept
+			{
+				return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+			});
+}
+
+std::string_view trim(std::string_view value)
+{
+	const auto first = value.find_first_not_of(" \t");
+
+	if (first == std::string_view::npos)
+	{
+		return {};
+	}
+
+	return value.substr(first, value.find_last_not_of(" \t") - first + 1);
+}
+
+struct HttpRequest
+{
+	std::string_view method;
+	std::string_view target;
+	std::string_view body;
+	bool keepAlive = true;
+};
+
+struct Connection
+{
+	std::string input;
+	std::string output;
+	size_t written = 0;
+	bool closeAfterWrite = false;
+	bool waitingForWrite = false;
+};
+
+class Worker
+{
+public:
+	explicit Worker(uint16_t port);
+	~Worker();
+
+	void run();
+
+private:
+	void accept();
+	void read(int fd, Connection& connection);
+	bool write(int fd, Connection& connection);
+	void close(int fd);
+
+	// Returns the number of bytes in the request, or 0 if it isn't complete yet.
+	size_t parseRequest(Connection& connection, HttpRequest& request);
+	void respond(Connection& connection, int status, std::string_view reason, std::string&& body, bool keepAlive);
+	std::string execute(const HttpRequest& request);
+
+	const std::shared_ptr<today::Operations> _service;
+	std::unordered_map<std::string, peg::ast> _queries;
+	std::unordered_map<int, Connection> _connections;
+	int _listener = -1;
+	int _epoll = -1;
+};
+
+Worker::Worker(uint16_t port)
+	: _service(makeService())
+{
+	_listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if (_listener < 0)
+	{
+		throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+	}
+
+	const int enable = 1;
+
+	::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+	::setsockopt(_listener, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+
+	sockaddr_in address {};
+
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (::bind(_listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+		|| ::listen(_listener, SOMAXCONN) < 0)
+	{
+		throw std::runtime_error(std::string("bind/listen: ") + std::strerror(errno));
+	}
+
+	_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+	if (_epoll < 0)
+	{
+		throw std::runtime_error(std::string("epoll_create1: ") + std::strerror(errno));
+	}
+
+	epoll_event event {};
+
+	event.events = EPOLLIN | EPOLLET;
+	event.data.fd = _listener;
+	::epoll_ctl(_epoll, EPOLL_CTL_ADD, _listener, &event);
+}
+
+Worker::~Worker()
+{
+	for (const auto& entry : _connections)
+	{
+		::close(entry.first);
+	}
+
+	if (_epoll >= 0)
+	{
+		::close(_epoll);
+	}
+
+	if (_listener >= 0)
+	{
+		::close(_listener);
+	}
+}
+
+void Worker::run()
+{
+	epoll_event events[c_maxEvents];
+
+	while (!s_stopping)
+	{
+		// Wake up periodically to check if we should stop.
+		const int count = ::epoll_wait(_epoll, events, c_maxEvents, 100);
+
+		for (int i = 0; i < count; ++i)
+		{
+			const int fd = events[i].data.fd;
+
+			if (fd == _listener)
+			{
+				accept();
+				continue;
+			}
+
+			auto itr = _connections.find(fd);
+
+			if (itr == _connections.end())
+			{
+				continue;
+			}
+
+			if (events[i].events & (EPOLLERR | EPOLLHUP))
+			{
+				close(fd);
+				continue;
+			}
+
+			if ((events[i].events & EPOLLOUT) && !write(fd, itr->second))
+			{
+				continue;
+			}
+
+			if (events[i].events & (EPOLLIN | EPOLLRDHUP))
+			{
+				read(fd, itr->second);
+			}
+		}
+	}
+}
+
+void Worker::accept()
+{
+	while (true)
+	{
+		const int fd = ::accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+		if (fd < 0)
+		{
+			// EAGAIN means we accepted everything that was pending.
+			return;
+		}
+
+		const int enable = 1;
+
+		::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+		epoll_event event {};
+
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+		event.data.fd = fd;
+		::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event);
+		_connections.emplace(fd, Connection {});
+	}
+}
+
+void Worker::read(int fd, Connection& connection)
+{
+	char buffer[16 * 1024];
+	bool peerClosed = false;
+
+	// The socket is edge-triggered, so read until it would block.
+	while (true)
+	{
+		const auto received = ::recv(fd, buffer, sizeof(buffer), 0);
+
+		if (received > 0)
+		{
+			connection.input.append(buffer, static_cast<size_t>(received));
+			continue;
+		}
+
+		if (received == 0)
+		{
+			peerClosed = true;
+		}
+		else if (errno == EINTR)
+		{
+			continue;
+		}
+		else if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			close(fd);
+			return;
+		}
+
+		break;
+	}
+
+	// Handle every complete request, clients may pipeline them.
+	while (!connection.closeAfterWrite)
+	{
+		HttpRequest request;
+		const auto size = parseRequest(connection, request);
+
+		if (size == 0)
+		{
+			break;
+		}
+
+		if (request.target != "/graphql" && request.target.substr(0, 9) != "/graphql?")
+		{
+			respond(connection, 404, "Not Found", R"({"errors":[{"message":"Not found"}]})", request.keepAlive);
+		}
+		else if (request.method != "POST")
+		{
+			respond(connection, 405, "Method Not Allowed", R"({"errors":[{"message":"Only POST is supported"}]})", request.keepAlive);
+		}
+		else
+		{
+			respond(connection, 200, "OK", execute(request), request.keepAlive);
+		}
+
+		connection.input.erase(0, size);
+	}
+
+	if (!write(fd, connection))
+	{
+		return;
+	}
+
+	if (peerClosed && connection.output.empty())
+	{
+		close(fd);
+	}
+}
+
+bool Worker::write(int fd, Connection& connection)
+{
+	while (connection.written < connection.output.size())
+	{
+		const auto sent = ::send(fd, connection.output.data() + connection.written,
+			connection.output.size() - connection.written, MSG_NOSIGNAL);
+
+		if (sent > 0)
+		{
+			connection.written += static_cast<size_t>(sent);
+			continue;
+		}
+
+		if (sent < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			// Wait for the socket to drain before writing the rest.
+			if (!connection.waitingForWrite)
+			{
+				epoll_event event {};
+
+				event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+				event.data.fd = fd;
+				::epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &event);
+				connection.waitingForWrite = true;
+			}
+
+			return true;
+		}
+
+		close(fd);
+		return false;
+	}
+
+	connection.output.clear();
+	connection.written = 0;
+
+	if (connection.waitingForWrite)
+	{
+		epoll_event event {};
+
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+		event.data.fd = fd;
+		::epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &event);
+		connection.waitingForWrite = false;
+	}
+
+	if (connection.closeAfterWrite)
+	{
+		close(fd);
+		return false;
+	}
+
+	return true;
+}
+
+void Worker::close(int fd)
+{
+	::epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+	::close(fd);
+	_connections.erase(fd);
+}
+
+size_t Worker::parseRequest(Connection& connection, HttpRequest& request)
+{
+	const std::string_view input(connection.input);
+	const auto headerEnd = input.find("\r\n\r\n");
+
+	if (headerEnd == std::string_view::npos)
+	{
+		if (input.size() > c_maxRequestSize)
+		{
+			respond(connection, 431, "Request Header Fields Too Large", {}, false);
+		}
+
+		return 0;
+	}
+
+	const auto requestLineEnd = input.find("\r\n");
+	const auto requestLine = input.substr(0, requestLineEnd);
+	const auto methodEnd = requestLine.find(' ');
+	const auto targetEnd = requestLine.find(' ', methodEnd + 1);
+
+	if (methodEnd == std::string_view::npos || targetEnd == std::string_view::npos)
+	{
+		respond(connection, 400, "Bad Request", {}, false);
+		return 0;
+	}
+
+	request.method = requestLine.substr(0, methodEnd);
+	request.target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+	request.keepAlive = (requestLine.substr(targetEnd + 1) == "HTTP/1.1");
+
+	size_t contentLength = 0;
+	auto headers = input.substr(requestLineEnd + 2, headerEnd - requestLineEnd - 2);
+
+	while (!headers.empty())
+	{
+		const auto lineEnd = std::min(headers.find("\r\n"), headers.size());
+		const auto line = headers.substr(0, lineEnd);
+		const auto colon = line.find(':');
+
+		headers.remove_prefix(std::min(lineEnd + 2, headers.size()));
+
+		if (colon == std::string_view::npos)
+		{
+			continue;
+		}
+
+		const auto name = trim(line.substr(0, colon));
+		const auto value = trim(line.substr(colon + 1));
+
+		if (equalsIgnoreCase(name, "Content-Length"))
+		{
+			contentLength = std::strtoul(std::string(value).c_str(), nullptr, 10);
+		}
+		else if (equalsIgnoreCase(name, "Connection"))
+		{
+			if (equalsIgnoreCase(value, "close"))
+			{
+				request.keepAlive = false;
+			}
+			else if (equalsIgnoreCase(value, "keep-alive"))
+			{
+				request.keepAlive = true;
+			}
+		}
+		else if (equalsIgnoreCase(name, "Transfer-Encoding"))
+		{
+			respond(connection, 501, "Not Implemented", R"({"errors":[{"message":"Chunked requests are not supported"}]})", false);
+			return 0;
+		}
+	}
+
+	if (contentLength > c_maxRequestSize)
+	{
+		respond(connection, 413, "Payload Too Large", {}, false);
+		return 0;
+	}
+
+	const auto requestSize = headerEnd + 4 + contentLength;
+
+	if (input.size() < requestSize)
+	{
+		return 0;
+	}
+
+	request.body = input.substr(headerEnd + 4, contentLength);
+
+	return requestSize;
+}
+
+void Worker::respond(Connection& connection, int status, std::string_view reason, std::string&& body, bool keepAlive)
+{
+	auto& output = connection.output;
+
+	output.append("HTTP/1.1 ");
+	output.append(std::to_string(status));
+	output.push_back(' ');
+	output.append(reason);
+	output.append("\r\nContent-Type: application/json\r\nContent-Length: ");
+	output.append(std::to_string(body.size()));
+
+	if (!keepAlive)
+	{
+		output.append("\r\nConnection: close");
+		connection.closeAfterWrite = true;
+	}
+
+	output.append("\r\n\r\n");
+	output.append(body);
+}
+
+std::string Worker::execute(const HttpRequest& request)
+{
+	try
+	{
+		auto payload = response::parseJSON(std::string(request.body));
+
+		if (payload.type() != response::Type::Map)
+		{
+			throw std::runtime_error("The request body must be a JSON object");
+		}
+
+		const auto itrQuery = payload.find("query");
+
+		if (itrQuery == payload.end() || itrQuery->second.type() != response::Type::String)
+		{
+			throw std::runtime_error("The request body must have a query string");
+		}
+
+		const auto& queryString = itrQuery->second.get<const response::StringType&>();
+		auto itrCached = _queries.find(queryString);
+
+		// Clients usually send the same few queries, so keep the parsed AST for each of them.
+		if (itrCached == _queries.end())
+		{
+			if (_queries.size() >= c_maxCachedQueries)
+			{
+				_queries.clear();
+			}
+
+			itrCached = _queries.emplace(queryString, peg::parseString(queryString)).first;
+		}
+
+		std::string operationName;
+		response::Value variables(response::Type::Map);
+
+		for (auto& entry : payload.release<response::MapType>())
+		{
+			if (entry.first == "operationName" && entry.second.type() == response::Type::String)
+			{
+				operationName = entry.second.release<response::StringType>();
+			}
+			else if (entry.first == "variables" && entry.second.type() == response::Type::Map)
+			{
+				variables = std::move(entry.second);
+			}
+		}
+
+		const auto launch = (request.target.find("launch=async") == std::string_view::npos
+			? std::launch::deferred
+			: std::launch::async);
+
+		return response::toJSON(_service->resolve(launch, nullptr, itrCached->second, operationName, std::move(variables)).get());
+	}
+	catch (const std::exception& ex)
+	{
+		response::Value error(response::Type::Map);
+		response::Value errors(response::Type::List);
+		response::Value document(response::Type::Map);
+
+		error.emplace_back(std::string { service::strMessage }, response::Value(std::string(service::getErrorMessage(ex))));
+		errors.emplace_back(std::move(error));
+		document.emplace_back(std::string { service::strErrors }, std::move(errors));
+
+		return response::toJSON(std::move(document));
+	}
+}
+
+} /* namespace */
+
+int main(int argc, char** argv)
+{
+	uint16_t port = 8080;
+	size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string_view option(argv[i]);
+
+		if (option == "--port")
+		{
+			port = static_cast<uint16_t>(std::stoul(argv[i + 1]));
+		}
+		else if (option == "--threads")
+		{
+			threadCount = std::max<size_t>(1, std::stoul(argv[i + 1]));
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--port 8080] [--threads N]" << std::endl;
+			return 1;
+		}
+	}
+
+	::signal(SIGINT, stop);
+	::signal(SIGTERM, stop);
+	::signal(SIGPIPE, SIG_IGN);
+
+	try
+	{
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::vector<std::thread> threads;
+
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			workers.push_back(std::make_unique<Worker>(port));
+		}
+
+		for (auto& worker : workers)
+		{
+			threads.emplace_back([&worker]()
+			{
+				worker->run();
+			});
+		}
+
+		std::cout << "Listening on http://127.0.0.1:" << port << "/graphql with " << threadCount << " threads" << std::endl;
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
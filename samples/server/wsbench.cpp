@@ -0,0 +1,626 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// A subscription fan-out benchmark for the WebSocket sample server. It opens thousands of
+// nextAppointmentChange subscriptions spread across a few connections, then publishes completeTask
+// mutations at a fixed rate on another connection. Each event carries its sequence number as the
+// clientMutationId, so the latency of every delivery is measured from the moment the mutation was sent
+// until the subscriber reads it, including the server's serialization and socket writes. If you pass
+// --server-pid, it also reads the server's resident memory before and after subscribing to report the
+// cost of each subscription.
+
+#include "WebSocket.h"
+
+#include <graphqlservice/JSONResponse.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace graphql;
+
+namespace {
+
+constexpr auto c_subscribeQuery = R"gql(subscription Changes {
+	nextAppointmentChange {
+		subject
+	}
+})gql";
+
+constexpr auto c_publishQuery = R"gql(mutation Publish($seq: String) {
+	completeTask(input: { id: "ZmFrZVRhc2tJZA==", clientMutationId: $seq }) {
+		clientMutationId
+	}
+})gql";
+
+constexpr size_t c_maxMessageSize = 1024 * 1024;
+constexpr int c_maxEvents = 256;
+constexpr std::chrono::seconds c_drainTimeout { 10 };
+
+struct Options
+{
+	uint16_t port = 8081;
+	std::vector<size_t> subscriptionCounts { 1000, 5000, 10000 };
+	std::vector<size_t> eventRates { 1, 10, 100 };
+	size_t connectionCount = 16;
+	std::chrono::seconds duration { 5 };
+	pid_t serverPid = 0;
+};
+
+struct Connection
+{
+	int fd = -1;
+	std::string input;
+	std::string message;
+};
+
+using Clock = std::chrono::steady_clock;
+using MessageCallback = std::function<void(std::string_view)>;
+
+std::mt19937& getGenerator()
+{
+	static std::mt19937 generator { std::random_device {}() };
+
+	return generator;
+}
+
+template <typename Value, typename Parse>
+std::vector<Value> splitList(std::string_view list, Parse&& parse)
+{
+	std::vector<Value> values;
+
+	while (!list.empty())
+	{
+		const auto end = std::min(list.find(','), list.size());
+
+		values.push_back(parse(std::string(list.substr(0, end))));
+		list.remove_prefix(std::min(end + 1, list.size()));
+	}
+
+	return values;
+}
+
+// The server writes compact JSON, so look for the string values we need instead of parsing every message.
+std::string_view findString(std::string_view message, std::string_view key)
+{
+	std::string pattern;
+
+	pattern.push_back('"');
+	pattern.append(key);
+	pattern.append("\":\"");
+
+	const auto start = message.find(pattern);
+
+	if (start == std::string_view::npos)
+	{
+		return {};
+	}
+
+	const auto value = message.substr(start + pattern.size());
+
+	return value.substr(0, value.find('"'));
+}
+
+// Returns the resident set size of the process in bytes, or 0 if it's not available.
+size_t getResidentBytes(pid_t pid)
+{
+	if (pid == 0)
+	{
+		return 0;
+	}
+
+	std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+	std::string line;
+
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, 6, "VmRSS:") == 0)
+		{
+			return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+		}
+	}
+
+	return 0;
+}
+
+void sendAll(int fd, std::string_view data)
+{
+	while (!data.empty())
+	{
+		const auto sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+
+		if (sent < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (sent <= 0)
+		{
+			throw std::runtime_error(std::string("send: ") + std::strerror(errno));
+		}
+
+		data.remove_prefix(static_cast<size_t>(sent));
+	}
+}
+
+void sendMessage(Connection& connection, std::string_view message)
+{
+	uint8_t mask[4];
+	const auto bits = getGenerator()();
+
+	std::memcpy(mask, &bits, sizeof(mask));
+
+	std::string frame;
+
+	websocket::appendFrame(frame, websocket::Opcode::Text, message, mask);
+	sendAll(connection.fd, frame);
+}
+
+void sendMessage(Connection& connection, std::string_view type, std::string_view id, response::Value&& payload)
+{
+	response::Value message(response::Type::Map);
+
+	if (!id.empty())
+	{
+		message.emplace_back("id", response::Value(std::string(id)));
+	}
+
+	message.emplace_back("type", response::Value(std::string(type)));
+
+	if (payload.type() != response::Type::Null)
+	{
+		message.emplace_back("payload", std::move(payload));
+	}
+
+	sendMessage(connection, response::toJSON(std::move(message)));
+}
+
+// Read whatever is available (or block until something is if wait is true) and pass each complete
+// text message to the callback.
+void receive(Connection& connection, bool wait, const MessageCallback& callback)
+{
+	char buffer[64 * 1024];
+	int flags = (wait ? 0 : MSG_DONTWAIT);
+
+	while (true)
+	{
+		const auto received = ::recv(connection.fd, buffer, sizeof(buffer), flags);
+
+		if (received > 0)
+		{
+			connection.input.append(buffer, static_cast<size_t>(received));
+			flags = MSG_DONTWAIT;
+			continue;
+		}
+
+		if (received < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+		{
+			throw std::runtime_error("The server closed the connection");
+		}
+
+		break;
+	}
+
+	std::string_view input(connection.input);
+
+	while (true)
+	{
+		websocket::Frame frame;
+		size_t consumed = 0;
+		const auto result = websocket::parseFrame(input, c_maxMessageSize, frame, consumed);
+
+		if (result == websocket::ParseResult::TooBig)
+		{
+			throw std::runtime_error("The server sent a message which is too big");
+		}
+
+		if (result == websocket::ParseResult::Incomplete)
+		{
+			break;
+		}
+
+		input.remove_prefix(consumed);
+
+		switch (frame.opcode)
+		{
+			case websocket::Opcode::Text:
+			case websocket::Opcode::Continuation:
+				connection.message.append(frame.payload);
+
+				if (frame.final)
+				{
+					callback(connection.message);
+					connection.message.clear();
+				}
+
+				break;
+
+			case websocket::Opcode::Close:
+				throw std::runtime_error("The server closed the connection");
+
+			default:
+				break;
+		}
+	}
+
+	connection.input.erase(0, connection.input.size() - input.size());
+}
+
+Connection openConnection(uint16_t port)
+{
+	Connection connection;
+
+	connection.fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (connection.fd < 0)
+	{
+		throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+	}
+
+	sockaddr_in address {};
+
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (::connect(connection.fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+	{
+		::close(connection.fd);
+		throw std::runtime_error(std::string("connect: ") + std::strerror(errno));
+	}
+
+	const int enable = 1;
+
+	::setsockopt(connection.fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+	uint8_t nonce[16];
+
+	for (auto& byte : nonce)
+	{
+		byte = static_cast<uint8_t>(getGenerator()());
+	}
+
+	const auto key = service::Base64::toBase64(nonce, sizeof(nonce));
+	std::string request("GET /graphql HTTP/1.1\r\nHost: 127.0.0.1:");
+
+	request.append(std::to_string(port));
+	request.append("\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 13\r\nSec-WebSocket-Key: ");
+	request.append(key);
+	request.append("\r\nSec-WebSocket-Protocol: ");
+	request.append(websocket::c_subprotocol);
+	request.append("\r\n\r\n");
+	sendAll(connection.fd, request);
+
+	char buffer[4096];
+	size_t headerEnd = std::string::npos;
+
+	while (headerEnd == std::string::npos)
+	{
+		const auto received = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+
+		if (received <= 0)
+		{
+			::close(connection.fd);
+			throw std::runtime_error("The server closed the connection during the handshake");
+		}
+
+		connection.input.append(buffer, static_cast<size_t>(received));
+		headerEnd = connection.input.find("\r\n\r\n");
+	}
+
+	const std::string_view headers(connection.input.data(), headerEnd);
+
+	if (headers.substr(0, 13) != "HTTP/1.1 101 "
+		|| headers.find(websocket::getAcceptKey(key)) == std::string_view::npos)
+	{
+		::close(connection.fd);
+		throw std::runtime_error("The server rejected the WebSocket handshake");
+	}
+
+	// Anything after the headers is already part of the WebSocket stream.
+	connection.input.erase(0, headerEnd + 4);
+
+	sendMessage(connection, "connection_init", {}, {});
+
+	bool acknowledged = false;
+
+	while (!acknowledged)
+	{
+		receive(connection, true, [&acknowledged](std::string_view message) {
+			acknowledged = acknowledged || findString(message, "type") == "connection_ack";
+		});
+	}
+
+	return connection;
+}
+
+void publish(Connection& publisher, size_t sequence)
+{
+	response::Value variables(response::Type::Map);
+	response::Value payload(response::Type::Map);
+
+	variables.emplace_back("seq", response::Value(std::to_string(sequence)));
+	payload.emplace_back("query", response::Value(std::string(c_publishQuery)));
+	payload.emplace_back("variables", std::move(variables));
+
+	sendMessage(publisher, "subscribe", "p" + std::to_string(sequence), std::move(payload));
+}
+
+uint32_t getPercentile(const std::vector<uint32_t>& sorted, double percentile)
+{
+	if (sorted.empty())
+	{
+		return 0;
+	}
+
+	return sorted[std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()))];
+}
+
+class Benchmark
+{
+public:
+	Benchmark(const Options& options, size_t subscriptionCount);
+	~Benchmark();
+
+	void run(size_t eventRate);
+
+private:
+	// Wait for the next message on any connection, or until the timeout.
+	void poll(Clock::duration timeout);
+
+	const Options& _options;
+	const size_t _subscriptionCount;
+	std::vector<Connection> _connections;
+	int _epoll = -1;
+
+	size_t _residentBytesPerSubscription = 0;
+	std::vector<Clock::time_point> _sent;
+	std::vector<uint32_t> _latencies;
+	size_t _delivered = 0;
+};
+
+Benchmark::Benchmark(const Options& options, size_t subscriptionCount)
+	: _options(options)
+	, _subscriptionCount(subscriptionCount)
+{
+	_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+	if (_epoll < 0)
+	{
+		throw std::runtime_error(std::string("epoll_create1: ") + std::strerror(errno));
+	}
+
+	// The last connection publishes the events.
+	for (size_t i = 0; i <= _options.connectionCount; ++i)
+	{
+		_connections.push_back(openConnection(_options.port));
+
+		epoll_event event {};
+
+		event.events = EPOLLIN;
+		event.data.u64 = i;
+		::epoll_ctl(_epoll, EPOLL_CTL_ADD, _connections.back().fd, &event);
+	}
+
+	const auto connectedBytes = getResidentBytes(_options.serverPid);
+
+	for (size_t i = 0; i < _subscriptionCount; ++i)
+	{
+		response::Value payload(response::Type::Map);
+
+		payload.emplace_back("query", response::Value(std::string(c_subscribeQuery)));
+		sendMessage(_connections[i % _options.connectionCount], "subscribe", "s" + std::to_string(i), std::move(payload));
+	}
+
+	// There's no acknowledgement for a subscription, so publish an event and wait for every subscriber to
+	// receive it before we measure anything.
+	const auto deadline = Clock::now() + c_drainTimeout;
+
+	_sent.push_back(Clock::now());
+	publish(_connections.back(), 0);
+
+	while (_delivered < _subscriptionCount && Clock::now() < deadline)
+	{
+		poll(deadline - Clock::now());
+	}
+
+	if (_delivered < _subscriptionCount)
+	{
+		throw std::runtime_error("Timed out waiting for the subscriptions");
+	}
+
+	const auto subscribedBytes = getResidentBytes(_options.serverPid);
+
+	_residentBytesPerSubscription = (subscribedBytes > connectedBytes ? (subscribedBytes - connectedBytes) / _subscriptionCount : 0);
+}
+
+Benchmark::~Benchmark()
+{
+	for (auto& connection : _connections)
+	{
+		::close(connection.fd);
+	}
+
+	if (_epoll >= 0)
+	{
+		::close(_epoll);
+	}
+}
+
+void Benchmark::poll(Clock::duration timeout)
+{
+	epoll_event events[c_maxEvents];
+	const int count = ::epoll_wait(_epoll, events, c_maxEvents,
+		static_cast<int>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count())));
+
+	for (int i = 0; i < count; ++i)
+	{
+		receive(_connections[events[i].data.u64], false, [this](std::string_view message) {
+			const auto received = Clock::now();
+
+			// The publisher also gets the result of each mutation, which doesn't have a subject.
+			const auto subject = findString(message, "subject");
+
+			if (subject.empty() || findString(message, "type") != "next")
+			{
+				return;
+			}
+
+			const auto sequence = std::strtoull(std::string(subject).c_str(), nullptr, 10);
+
+			if (sequence < _sent.size())
+			{
+				_latencies.push_back(static_cast<uint32_t>(
+					std::chrono::duration_cast<std::chrono::microseconds>(received - _sent[sequence]).count()));
+				++_delivered;
+			}
+		});
+	}
+}
+
+void Benchmark::run(size_t eventRate)
+{
+	const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / eventRate;
+	const auto start = Clock::now();
+	const auto end = start + _options.duration;
+	auto nextEvent = start;
+	const auto firstSequence = _sent.size();
+
+	_latencies.clear();
+	_delivered = 0;
+
+	while (true)
+	{
+		const auto now = Clock::now();
+
+		if (now >= end)
+		{
+			break;
+		}
+
+		if (now >= nextEvent)
+		{
+			// Keep the same schedule if we fall behind, so the rate is still accurate.
+			nextEvent += interval;
+			_sent.push_back(Clock::now());
+			publish(_connections.back(), _sent.size() - 1);
+			continue;
+		}
+
+		poll(std::min(nextEvent, end) - now);
+	}
+
+	const auto events = _sent.size() - firstSequence;
+	const auto expected = events * _subscriptionCount;
+	const auto deadline = Clock::now() + c_drainTimeout;
+
+	while (_delivered < expected && Clock::now() < deadline)
+	{
+		poll(deadline - Clock::now());
+	}
+
+	const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::sort(_latencies.begin(), _latencies.end());
+
+	std::cout << _subscriptionCount << ',' << _options.connectionCount << ',' << eventRate << ','
+		<< events << ',' << _delivered << ',' << (expected - std::min(expected, _delivered)) << ','
+		<< static_cast<uint64_t>(_delivered / elapsed) << ','
+		<< getPercentile(_latencies, 0.5) << ','
+		<< getPercentile(_latencies, 0.99) << ','
+		<< getPercentile(_latencies, 0.999) << ','
+		<< _residentBytesPerSubscription << std::endl;
+}
+
+} /* namespace */
+
+int main(int argc, char** argv)
+{
+	Options options;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string_view option(argv[i]);
+		const std::string value(argv[i + 1]);
+
+		if (option == "--port")
+		{
+			options.port = static_cast<uint16_t>(std::stoul(value));
+		}
+		else if (option == "--subscriptions")
+		{
+			options.subscriptionCounts = splitList<size_t>(value, [](const std::string& count) {
+				return std::max<size_t>(1, std::stoul(count));
+			});
+		}
+		else if (option == "--rates")
+		{
+			options.eventRates = splitList<size_t>(value, [](const std::string& rate) {
+				return std::max<size_t>(1, std::stoul(rate));
+			});
+		}
+		else if (option == "--connections")
+		{
+			options.connectionCount = std::max<size_t>(1, std::stoul(value));
+		}
+		else if (option == "--duration")
+		{
+			options.duration = std::chrono::seconds(std::stoul(value));
+		}
+		else if (option == "--server-pid")
+		{
+			options.serverPid = static_cast<pid_t>(std::stol(value));
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0]
+				<< " [--port 8081] [--subscriptions 1000,5000,10000] [--rates 1,10,100] [--connections 16] [--duration 5] [--server-pid PID]"
+				<< std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "subscriptions,connections,events_per_second,events,deliveries,missed,deliveries_per_second,p50_us,p99_us,p999_us,server_bytes_per_subscription" << std::endl;
+
+	try
+	{
+		for (const auto subscriptionCount : options.subscriptionCounts)
+		{
+			// Reconnect for each subscription count, closing the connections unsubscribes everything.
+			Benchmark benchmark(options, subscriptionCount);
+
+			for (const auto eventRate : options.eventRates)
+			{
+				benchmark.run(eventRate);
+			}
+		}
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
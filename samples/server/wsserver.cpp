@@ -0,0 +1,869 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// A WebSocket server for the today sample which speaks the graphql-transport-ws protocol from the
+// graphql-ws library on localhost. Subscriptions are registered with Request::subscribe, and every
+// completeTask mutation delivers a nextAppointmentChange event to all of them with the clientMutationId
+// as the subject of the Appointment, so a client can drive the event rate and match up the events.
+// Request::subscribe and Request::deliver are not thread-safe, so it runs a single epoll loop.
+
+#include "SeparateToday.h"
+#include "WebSocket.h"
+
+#include <graphqlservice/JSONResponse.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace graphql;
+
+namespace {
+
+constexpr size_t c_maxHandshakeSize = 16 * 1024;
+constexpr size_t c_maxMessageSize = 1024 * 1024;
+constexpr size_t c_maxCachedQueries = 1024;
+constexpr int c_maxEvents = 256;
+
+std::atomic_bool s_stopping { false };
+
+void stop(int)
+{
+	s_stopping = true;
+}
+
+response::IdType makeId(std::string_view name)
+{
+	response::IdType id(name.size());
+
+	std::copy(name.cbegin(), name.cend(), id.begin());
+
+	return id;
+}
+
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs)
+{
+	return lhs.size() == rhs.size()
+		&& std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(),
+			[](char a, char b) noexcept
+			{
+				return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+			});
+}
+
+bool containsToken(std::string_view list, std::string_view token)
+{
+	while (!list.empty())
+	{
+		const auto end = std::min(list.find(','), list.size());
+		auto item = list.substr(0, end);
+		const auto first = item.find_first_not_of(" \t");
+
+		item = (first == std::string_view::npos ? std::string_view {} : item.substr(first, item.find_last_not_of(" \t") - first + 1));
+
+		if (equalsIgnoreCase(item, token))
+		{
+			return true;
+		}
+
+		list.remove_prefix(std::min(end + 1, list.size()));
+	}
+
+	return false;
+}
+
+std::string makeMessage(std::string_view type, std::string_view id = {}, response::Value&& payload = {})
+{
+	response::Value message(response::Type::Map);
+
+	if (!id.empty())
+	{
+		message.emplace_back("id", response::Value(std::string(id)));
+	}
+
+	message.emplace_back("type", response::Value(std::string(type)));
+
+	if (payload.type() != response::Type::Null)
+	{
+		message.emplace_back("payload", std::move(payload));
+	}
+
+	return response::toJSON(std::move(message));
+}
+
+response::Value makeErrors(const std::exception& ex)
+{
+	if (const auto schemaException = dynamic_cast<const service::schema_exception*>(&ex))
+	{
+		response::Value errors(schemaException->getErrors());
+
+		return errors;
+	}
+
+	response::Value error(response::Type::Map);
+	response::Value errors(response::Type::List);
+
+	error.emplace_back(std::string { service::strMessage }, response::Value(std::string(ex.what())));
+	errors.emplace_back(std::move(error));
+
+	return errors;
+}
+
+struct Connection
+{
+	std::string input;
+	std::string output;
+	size_t written = 0;
+	bool upgraded = false;
+	bool initialized = false;
+	bool closeAfterWrite = false;
+	bool waitingForWrite = false;
+	bool pendingWrite = false;
+
+	// A text message may be split across several continuation frames.
+	std::string message;
+
+	std::unordered_map<std::string, service::SubscriptionKey> subscriptions;
+};
+
+class Server
+{
+public:
+	explicit Server(uint16_t port);
+	~Server();
+
+	void run();
+
+private:
+	void accept();
+	void read(int fd, Connection& connection);
+	bool write(int fd, Connection& connection);
+	void close(int fd);
+
+	// Returns false if the handshake failed and the connection should be closed.
+	bool handshake(Connection& connection, size_t headerEnd);
+	void handleMessage(int fd, Connection& connection, std::string&& text);
+	void handleSubscribe(int fd, Connection& connection, std::string&& id, response::Value&& payload);
+	void closeWith(Connection& connection, websocket::CloseCode code, std::string_view reason);
+
+	void send(int fd, Connection& connection, std::string_view message);
+	void flush();
+	void publish();
+
+	std::shared_ptr<today::Operations> _service;
+	std::unordered_map<std::string, peg::ast> _queries;
+	std::unordered_map<int, Connection> _connections;
+	std::vector<int> _pendingWrites;
+	std::vector<std::string> _pendingEvents;
+	std::string _currentEvent;
+	int _listener = -1;
+	int _epoll = -1;
+};
+
+Server::Server(uint16_t port)
+{
+	auto query = std::make_shared<today::Query>(
+		[]() -> std::vector<std::shared_ptr<today::Appointment>>
+	{
+		return { std::make_shared<today::Appointment>(makeId("fakeAppointmentId"), "tomorrow", "Lunch?", false) };
+	}, []() -> std::vector<std::shared_ptr<today::Task>>
+	{
+		return { std::make_shared<today::Task>(makeId("fakeTaskId"), "Don't forget", true) };
+	}, []() -> std::vector<std::shared_ptr<today::Folder>>
+	{
+		return { std::make_shared<today::Folder>(makeId("fakeFolderId"), "\"Fake\" Inbox", 3) };
+	});
+	auto mutation = std::make_shared<today::Mutation>(
+		[this](today::CompleteTaskInput&& input) -> std::shared_ptr<today::CompleteTaskPayload>
+	{
+		// Deliver the event after the mutation has been answered.
+		_pendingEvents.push_back(input.clientMutationId ? *input.clientMutationId : std::string {});
+
+		return std::make_shared<today::CompleteTaskPayload>(
+			std::make_shared<today::Task>(std::move(input.id), "Mutated Task!", *(input.isComplete)),
+			std::move(input.clientMutationId)
+		);
+	});
+	auto subscription = std::make_shared<today::NextAppointmentChange>(
+		[this](const std::shared_ptr<service::RequestState>&) -> std::shared_ptr<today::Appointment>
+	{
+		return std::make_shared<today::Appointment>(makeId("fakeAppointmentId"), "tomorrow", std::string(_currentEvent), true);
+	});
+
+	_service = std::make_shared<today::Operations>(query, mutation, subscription);
+	_listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if (_listener < 0)
+	{
+		throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+	}
+
+	const int enable = 1;
+
+	::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+	sockaddr_in address {};
+
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (::bind(_listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+		|| ::listen(_listener, SOMAXCONN) < 0)
+	{
+		throw std::runtime_error(std::string("bind/listen: ") + std::strerror(errno));
+	}
+
+	_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+	if (_epoll < 0)
+	{
+		throw std::runtime_error(std::string("epoll_create1: ") + std::strerror(errno));
+	}
+
+	epoll_event event {};
+
+	event.events = EPOLLIN | EPOLLET;
+	event.data.fd = _listener;
+	::epoll_ctl(_epoll, EPOLL_CTL_ADD, _listener, &event);
+}
+
+Server::~Server()
+{
+	while (!_connections.empty())
+	{
+		close(_connections.begin()->first);
+	}
+
+	if (_epoll >= 0)
+	{
+		::close(_epoll);
+	}
+
+	if (_listener >= 0)
+	{
+		::close(_listener);
+	}
+}
+
+void Server::run()
+{
+	epoll_event events[c_maxEvents];
+
+	while (!s_stopping)
+	{
+		// Wake up periodically to check if we should stop.
+		const int count = ::epoll_wait(_epoll, events, c_maxEvents, 100);
+
+		for (int i = 0; i < count; ++i)
+		{
+			const int fd = events[i].data.fd;
+
+			if (fd == _listener)
+			{
+				accept();
+				continue;
+			}
+
+			auto itr = _connections.find(fd);
+
+			if (itr == _connections.end())
+			{
+				continue;
+			}
+
+			if (events[i].events & (EPOLLERR | EPOLLHUP))
+			{
+				close(fd);
+				continue;
+			}
+
+			if ((events[i].events & EPOLLOUT) && !write(fd, itr->second))
+			{
+				continue;
+			}
+
+			if (events[i].events & (EPOLLIN | EPOLLRDHUP))
+			{
+				read(fd, itr->second);
+			}
+		}
+
+		publish();
+		flush();
+	}
+}
+
+void Server::accept()
+{
+	while (true)
+	{
+		const int fd = ::accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+		if (fd < 0)
+		{
+			// EAGAIN means we accepted everything that was pending.
+			return;
+		}
+
+		const int enable = 1;
+
+		::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+		epoll_event event {};
+
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+		event.data.fd = fd;
+		::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event);
+		_connections.emplace(fd, Connection {});
+	}
+}
+
+void Server::read(int fd, Connection& connection)
+{
+	char buffer[16 * 1024];
+	bool peerClosed = false;
+
+	// The socket is edge-triggered, so read until it would block.
+	while (true)
+	{
+		const auto received = ::recv(fd, buffer, sizeof(buffer), 0);
+
+		if (received > 0)
+		{
+			connection.input.append(buffer, static_cast<size_t>(received));
+			continue;
+		}
+
+		if (received == 0)
+		{
+			peerClosed = true;
+		}
+		else if (errno == EINTR)
+		{
+			continue;
+		}
+		else if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			close(fd);
+			return;
+		}
+
+		break;
+	}
+
+	if (!connection.upgraded && !connection.closeAfterWrite)
+	{
+		const auto headerEnd = connection.input.find("\r\n\r\n");
+
+		if (headerEnd == std::string::npos)
+		{
+			if (connection.input.size() > c_maxHandshakeSize)
+			{
+				close(fd);
+				return;
+			}
+		}
+		else if (handshake(connection, headerEnd))
+		{
+			connection.input.erase(0, headerEnd + 4);
+			connection.upgraded = true;
+		}
+	}
+
+	// Handle every complete frame, the client doesn't need to wait for a response.
+	while (connection.upgraded && !connection.closeAfterWrite)
+	{
+		websocket::Frame frame;
+		size_t consumed = 0;
+		const auto result = websocket::parseFrame(connection.input, c_maxMessageSize, frame, consumed);
+
+		if (result == websocket::ParseResult::Incomplete)
+		{
+			break;
+		}
+
+		if (result == websocket::ParseResult::TooBig)
+		{
+			closeWith(connection, websocket::CloseCode::TooBig, "Message too big");
+			break;
+		}
+
+		connection.input.erase(0, consumed);
+
+		switch (frame.opcode)
+		{
+			case websocket::Opcode::Ping:
+				websocket::appendFrame(connection.output, websocket::Opcode::Pong, frame.payload);
+				break;
+
+			case websocket::Opcode::Pong:
+				break;
+
+			case websocket::Opcode::Close:
+				// Echo the status code back and close the connection once it's sent.
+				websocket::appendFrame(connection.output, websocket::Opcode::Close, std::string_view(frame.payload).substr(0, 2));
+				connection.closeAfterWrite = true;
+				break;
+
+			case websocket::Opcode::Text:
+			case websocket::Opcode::Continuation:
+				connection.message.append(frame.payload);
+
+				if (connection.message.size() > c_maxMessageSize)
+				{
+					closeWith(connection, websocket::CloseCode::TooBig, "Message too big");
+				}
+				else if (frame.final)
+				{
+					handleMessage(fd, connection, std::move(connection.message));
+					connection.message.clear();
+				}
+
+				break;
+
+			default:
+				closeWith(connection, websocket::CloseCode::BadRequest, "Only text messages are supported");
+				break;
+		}
+	}
+
+	if (!write(fd, connection))
+	{
+		return;
+	}
+
+	if (peerClosed && connection.output.empty())
+	{
+		close(fd);
+	}
+}
+
+bool Server::write(int fd, Connection& connection)
+{
+	while (connection.written < connection.output.size())
+	{
+		const auto sent = ::send(fd, connection.output.data() + connection.written,
+			connection.output.size() - connection.written, MSG_NOSIGNAL);
+
+		if (sent > 0)
+		{
+			connection.written += static_cast<size_t>(sent);
+			continue;
+		}
+
+		if (sent < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			// Slow subscribers buffer the rest of their messages until the socket drains.
+			if (!connection.waitingForWrite)
+			{
+				epoll_event event {};
+
+				event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+				event.data.fd = fd;
+				::epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &event);
+				connection.waitingForWrite = true;
+			}
+
+			return true;
+		}
+
+		close(fd);
+		return false;
+	}
+
+	connection.output.clear();
+	connection.written = 0;
+
+	if (connection.waitingForWrite)
+	{
+		epoll_event event {};
+
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+		event.data.fd = fd;
+		::epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &event);
+		connection.waitingForWrite = false;
+	}
+
+	if (connection.closeAfterWrite)
+	{
+		close(fd);
+		return false;
+	}
+
+	return true;
+}
+
+void Server::close(int fd)
+{
+	auto itr = _connections.find(fd);
+
+	if (itr != _connections.end())
+	{
+		for (const auto& entry : itr->second.subscriptions)
+		{
+			_service->unsubscribe(entry.second);
+		}
+
+		_connections.erase(itr);
+	}
+
+	::epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+	::close(fd);
+}
+
+bool Server::handshake(Connection& connection, size_t headerEnd)
+{
+	const std::string_view input(connection.input.data(), headerEnd);
+	const auto requestLineEnd = std::min(input.find("\r\n"), input.size());
+	const auto requestLine = input.substr(0, requestLineEnd);
+	std::string_view key;
+	bool upgrade = false;
+	bool version = false;
+	bool subprotocol = false;
+	auto headers = input.substr(std::min(requestLineEnd + 2, input.size()));
+
+	while (!headers.empty())
+	{
+		const auto lineEnd = std::min(headers.find("\r\n"), headers.size());
+		const auto line = headers.substr(0, lineEnd);
+		const auto colon = line.find(':');
+
+		headers.remove_prefix(std::min(lineEnd + 2, headers.size()));
+
+		if (colon == std::string_view::npos)
+		{
+			continue;
+		}
+
+		const auto name = line.substr(0, colon);
+		auto value = line.substr(colon + 1);
+
+		value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+
+		if (equalsIgnoreCase(name, "Upgrade"))
+		{
+			upgrade = containsToken(value, "websocket");
+		}
+		else if (equalsIgnoreCase(name, "Sec-WebSocket-Key"))
+		{
+			key = value;
+		}
+		else if (equalsIgnoreCase(name, "Sec-WebSocket-Version"))
+		{
+			version = (value == "13");
+		}
+		else if (equalsIgnoreCase(name, "Sec-WebSocket-Protocol"))
+		{
+			subprotocol = subprotocol || containsToken(value, websocket::c_subprotocol);
+		}
+	}
+
+	const bool validTarget = (requestLine.substr(0, 13) == "GET /graphql "
+		|| requestLine.substr(0, 13) == "GET /graphql?");
+
+	if (!validTarget || !upgrade || !version || key.empty() || !subprotocol)
+	{
+		connection.output.append("HTTP/1.1 400 Bad Request\r\nConnection: close\r\nContent-Length: 0\r\n"
+			"Sec-WebSocket-Version: 13\r\n\r\n");
+		connection.closeAfterWrite = true;
+		return false;
+	}
+
+	connection.output.append("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+		"Sec-WebSocket-Accept: ");
+	connection.output.append(websocket::getAcceptKey(key));
+	connection.output.append("\r\nSec-WebSocket-Protocol: ");
+	connection.output.append(websocket::c_subprotocol);
+	connection.output.append("\r\n\r\n");
+
+	return true;
+}
+
+void Server::handleMessage(int fd, Connection& connection, std::string&& text)
+{
+	response::Value message;
+
+	try
+	{
+		message = response::parseJSON(text);
+	}
+	catch (const std::exception&)
+	{
+	}
+
+	if (message.type() != response::Type::Map)
+	{
+		closeWith(connection, websocket::CloseCode::BadRequest, "Invalid message received");
+		return;
+	}
+
+	const auto itrType = message.find("type");
+
+	if (itrType == message.end() || itrType->second.type() != response::Type::String)
+	{
+		closeWith(connection, websocket::CloseCode::BadRequest, "Invalid message received");
+		return;
+	}
+
+	const auto type = itrType->second.get<const response::StringType&>();
+	std::string id;
+	response::Value payload;
+
+	for (auto& entry : message.release<response::MapType>())
+	{
+		if (entry.first == "id" && entry.second.type() == response::Type::String)
+		{
+			id = entry.second.release<response::StringType>();
+		}
+		else if (entry.first == "payload")
+		{
+			payload = std::move(entry.second);
+		}
+	}
+
+	if (type == "connection_init")
+	{
+		if (connection.initialized)
+		{
+			closeWith(connection, websocket::CloseCode::TooManyInitialisationRequests, "Too many initialisation requests");
+			return;
+		}
+
+		connection.initialized = true;
+		send(fd, connection, makeMessage("connection_ack"));
+	}
+	else if (type == "ping")
+	{
+		send(fd, connection, makeMessage("pong"));
+	}
+	else if (type == "pong")
+	{
+		// Nothing to do, the client is just letting us know it's still there.
+	}
+	else if (!connection.initialized)
+	{
+		closeWith(connection, websocket::CloseCode::Unauthorized, "Unauthorized");
+	}
+	else if (type == "subscribe" && !id.empty() && payload.type() == response::Type::Map)
+	{
+		handleSubscribe(fd, connection, std::move(id), std::move(payload));
+	}
+	else if (type == "complete" && !id.empty())
+	{
+		auto itr = connection.subscriptions.find(id);
+
+		if (itr != connection.subscriptions.end())
+		{
+			_service->unsubscribe(itr->second);
+			connection.subscriptions.erase(itr);
+		}
+	}
+	else
+	{
+		closeWith(connection, websocket::CloseCode::BadRequest, "Invalid message received");
+	}
+}
+
+void Server::handleSubscribe(int fd, Connection& connection, std::string&& id, response::Value&& payload)
+{
+	if (connection.subscriptions.find(id) != connection.subscriptions.end())
+	{
+		closeWith(connection, websocket::CloseCode::SubscriberAlreadyExists, "Subscriber for " + id + " already exists");
+		return;
+	}
+
+	try
+	{
+		const auto itrQuery = payload.find("query");
+
+		if (itrQuery == payload.end() || itrQuery->second.type() != response::Type::String)
+		{
+			throw std::runtime_error("The payload must have a query string");
+		}
+
+		const auto& queryString = itrQuery->second.get<const response::StringType&>();
+		auto itrCached = _queries.find(queryString);
+
+		// Every subscriber usually sends the same query, so keep the parsed AST for each of them.
+		if (itrCached == _queries.end())
+		{
+			if (_queries.size() >= c_maxCachedQueries)
+			{
+				_queries.clear();
+			}
+
+			itrCached = _queries.emplace(queryString, peg::parseString(queryString)).first;
+		}
+
+		auto ast = itrCached->second;
+		std::string operationName;
+		response::Value variables(response::Type::Map);
+
+		for (auto& entry : payload.release<response::MapType>())
+		{
+			if (entry.first == "operationName" && entry.second.type() == response::Type::String)
+			{
+				operationName = entry.second.release<response::StringType>();
+			}
+			else if (entry.first == "variables" && entry.second.type() == response::Type::Map)
+			{
+				variables = std::move(entry.second);
+			}
+		}
+
+		const auto operationType = _service->findOperationDefinition(ast, operationName).first;
+
+		if (operationType != service::strSubscription)
+		{
+			// Queries and mutations get a single result followed by complete.
+			auto result = _service->resolve(std::launch::deferred, nullptr, ast, operationName, std::move(variables)).get();
+
+			send(fd, connection, makeMessage("next", id, std::move(result)));
+			send(fd, connection, makeMessage("complete", id));
+			return;
+		}
+
+		const auto key = _service->subscribe(service::SubscriptionParams { nullptr, std::move(ast), std::move(operationName), std::move(variables) },
+			[this, fd, id](std::future<response::Value> result)
+		{
+			// We unsubscribe before closing the connection, so it's always still there.
+			auto& subscriber = _connections.at(fd);
+			response::Value value;
+
+			try
+			{
+				value = result.get();
+			}
+			catch (const std::exception& ex)
+			{
+				value = response::Value(response::Type::Map);
+				value.emplace_back(std::string { service::strErrors }, makeErrors(ex));
+			}
+
+			send(fd, subscriber, makeMessage("next", id, std::move(value)));
+		});
+
+		connection.subscriptions.emplace(std::move(id), key);
+	}
+	catch (const std::exception& ex)
+	{
+		send(fd, connection, makeMessage("error", id, makeErrors(ex)));
+	}
+}
+
+void Server::closeWith(Connection& connection, websocket::CloseCode code, std::string_view reason)
+{
+	websocket::appendClose(connection.output, code, reason);
+	connection.closeAfterWrite = true;
+}
+
+void Server::send(int fd, Connection& connection, std::string_view message)
+{
+	websocket::appendFrame(connection.output, websocket::Opcode::Text, message);
+
+	// Batch the writes for each connection until the end of the loop iteration.
+	if (!connection.pendingWrite)
+	{
+		connection.pendingWrite = true;
+		_pendingWrites.push_back(fd);
+	}
+}
+
+void Server::flush()
+{
+	auto pendingWrites = std::move(_pendingWrites);
+
+	_pendingWrites.clear();
+
+	for (const auto fd : pendingWrites)
+	{
+		auto itr = _connections.find(fd);
+
+		if (itr != _connections.end())
+		{
+			itr->second.pendingWrite = false;
+
+			if (!itr->second.waitingForWrite)
+			{
+				write(fd, itr->second);
+			}
+		}
+	}
+}
+
+void Server::publish()
+{
+	auto pendingEvents = std::move(_pendingEvents);
+
+	_pendingEvents.clear();
+
+	for (auto& event : pendingEvents)
+	{
+		_currentEvent = std::move(event);
+		_service->deliver("nextAppointmentChange", nullptr);
+	}
+}
+
+} /* namespace */
+
+int main(int argc, char** argv)
+{
+	uint16_t port = 8081;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string_view option(argv[i]);
+
+		if (option == "--port")
+		{
+			port = static_cast<uint16_t>(std::stoul(argv[i + 1]));
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--port 8081]" << std::endl;
+			return 1;
+		}
+	}
+
+	::signal(SIGINT, stop);
+	::signal(SIGTERM, stop);
+	::signal(SIGPIPE, SIG_IGN);
+
+	try
+	{
+		Server server(port);
+
+		std::cout << "Listening on ws://127.0.0.1:" << port << "/graphql (pid " << ::getpid() << ")" << std::endl;
+		server.run();
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -5,6 +5,8 @@
 
 #include "TodayObjects.h"
 
+#include <graphqlservice/GraphQLConnection.h>
+
 #include <stack>
 
 namespace graphql::today {
@@ -25,6 +27,7 @@ struct RequestState : service::RequestState
 	size_t loadAppointmentsCount = 0;
 	size_t loadTasksCount = 0;
 	size_t loadUnreadCountsCount = 0;
+	size_t loadTitlesCount = 0;
 };
 
 class Appointment;
@@ -48,6 +51,8 @@ public:
 	service::FieldResult<std::vector<std::shared_ptr<object::Task>>> getTasksById(service::FieldParams&& params, std::vector<response::IdType>&& ids) const override;
 	service::FieldResult<std::vector<std::shared_ptr<object::Folder>>> getUnreadCountsById(service::FieldParams&& params, std::vector<response::IdType>&& ids) const override;
 	service::FieldResult<std::shared_ptr<object::NestedType>> getNested(service::FieldParams&& params) const override;
+	service::FieldResult<std::vector<response::StringType>> getStringList(service::FieldParams&& params) const override;
+	service::FieldResult<std::optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>> getNestedIntList(service::FieldParams&& params) const override;
 
 private:
 	std::shared_ptr<Appointment> findAppointment(const service::FieldParams& params, const response::IdType& id) const;
@@ -66,6 +71,11 @@ private:
 	mutable std::vector<std::shared_ptr<Appointment>> _appointments;
 	mutable std::vector<std::shared_ptr<Task>> _tasks;
 	mutable std::vector<std::shared_ptr<Folder>> _unreadCounts;
+
+	// Map the ID cursors to the offsets of the elements when they are loaded.
+	mutable std::map<response::IdType, size_t> _appointmentOffsets;
+	mutable std::map<response::IdType, size_t> _taskOffsets;
+	mutable std::map<response::IdType, size_t> _unreadCountOffsets;
 };
 
 class PageInfo : public object::PageInfo
@@ -97,6 +107,11 @@ class Appointment : public object::Appointment
 public:
 	explicit Appointment(response::IdType&& id, std::string&& when, std::string&& subject, bool isNow);
 
+	const response::IdType& id() const noexcept
+	{
+		return _id;
+	}
+
 	service::FieldResult<response::IdType> getId(service::FieldParams&&) const override
 	{
 		return _id;
@@ -127,8 +142,9 @@ private:
 class AppointmentEdge : public object::AppointmentEdge
 {
 public:
-	explicit AppointmentEdge(std::shared_ptr<Appointment> appointment)
+	explicit AppointmentEdge(std::shared_ptr<Appointment> appointment, response::Value&& cursor)
 		: _appointment(std::move(appointment))
+		, _cursor(std::move(cursor))
 	{
 	}
 
@@ -137,21 +153,24 @@ public:
 		return std::static_pointer_cast<object::Appointment>(_appointment);
 	}
 
-	service::FieldResult<response::Value> getCursor(service::FieldParams&& params) const override
+	service::FieldResult<response::Value> getCursor(service::FieldParams&&) const override
 	{
-		return response::Value(service::Base64::toBase64(_appointment->getId(std::move(params)).get()));
+		return response::Value(_cursor);
 	}
 
 private:
 	std::shared_ptr<Appointment> _appointment;
+	response::Value _cursor;
 };
 
 class AppointmentConnection : public object::AppointmentConnection
 {
 public:
-	explicit AppointmentConnection(bool hasNextPage, bool hasPreviousPage, std::vector<std::shared_ptr<Appointment>> appointments)
-		: _pageInfo(std::make_shared<PageInfo>(hasNextPage, hasPreviousPage))
-		, _appointments(std::move(appointments))
+	// Only keep the elements in the page.
+	explicit AppointmentConnection(const std::vector<std::shared_ptr<Appointment>>& appointments, const service::ConnectionSlice& slice)
+		: _pageInfo(std::make_shared<PageInfo>(slice.hasNextPage, slice.hasPreviousPage))
+		, _slice(slice)
+		, _appointments(appointments.cbegin() + slice.begin, appointments.cbegin() + slice.end)
 	{
 	}
 
@@ -160,21 +179,22 @@ public:
 		return _pageInfo;
 	}
 
-	service::FieldResult<std::optional<std::vector<std::shared_ptr<object::AppointmentEdge>>>> getEdges(service::FieldParams&&) const override
+	service::FieldResult<std::optional<std::vector<std::shared_ptr<object::AppointmentEdge>>>> getEdges(service::FieldParams&& params) const override
 	{
-		auto result = std::make_optional<std::vector<std::shared_ptr<object::AppointmentEdge>>>(_appointments.size());
-
-		std::transform(_appointments.cbegin(), _appointments.cend(), result->begin(),
-			[](const std::shared_ptr<Appointment>& node)
+		// Create each of the edges as it's resolved instead of building the whole list up front. The
+		// edges are only needed until the operation is done, so they are allocated in its arena.
+		return service::makeEdges<std::shared_ptr<object::AppointmentEdge>>(_slice,
+			[appointments = _appointments, offset = _slice.begin, arena = params.arena](size_t index)
 		{
-			return std::make_shared<AppointmentEdge>(node);
-		});
+			const auto& appointment = appointments[index - offset];
 
-		return { std::move(result) };
+			return service::makeResult<AppointmentEdge>(arena, appointment, service::Cursor::fromId(appointment->id()));
+		});
 	}
 
 private:
 	std::shared_ptr<PageInfo> _pageInfo;
+	service::ConnectionSlice _slice;
 	std::vector<std::shared_ptr<Appointment>> _appointments;
 };
 
@@ -183,6 +203,11 @@ class Task : public object::Task
 public:
 	explicit Task(response::IdType&& id, std::string&& title, bool isComplete);
 
+	const response::IdType& id() const noexcept
+	{
+		return _id;
+	}
+
 	service::FieldResult<response::IdType> getId(service::FieldParams&&) const override
 	{
 		return _id;
@@ -193,6 +218,8 @@ public:
 		return std::make_optional<response::StringType>(_title);
 	}
 
+	service::FieldResult<std::vector<std::optional<response::StringType>>> getTitleBatch(service::FieldParams&& params, const std::vector<std::shared_ptr<object::Task>>& parents) const override;
+
 	service::FieldResult<bool> getIsComplete(service::FieldParams&&) const override
 	{
 		return _isComplete;
@@ -208,8 +235,9 @@ private:
 class TaskEdge : public object::TaskEdge
 {
 public:
-	explicit TaskEdge(std::shared_ptr<Task> task)
+	explicit TaskEdge(std::shared_ptr<Task> task, response::Value&& cursor)
 		: _task(std::move(task))
+		, _cursor(std::move(cursor))
 	{
 	}
 
@@ -218,21 +246,24 @@ public:
 		return std::static_pointer_cast<object::Task>(_task);
 	}
 
-	service::FieldResult<response::Value> getCursor(service::FieldParams&& params) const override
+	service::FieldResult<response::Value> getCursor(service::FieldParams&&) const override
 	{
-		return response::Value(service::Base64::toBase64(_task->getId(std::move(params)).get()));
+		return response::Value(_cursor);
 	}
 
 private:
 	std::shared_ptr<Task> _task;
+	response::Value _cursor;
 };
 
 class TaskConnection : public object::TaskConnection
 {
 public:
-	explicit TaskConnection(bool hasNextPage, bool hasPreviousPage, std::vector<std::shared_ptr<Task>> tasks)
-		: _pageInfo(std::make_shared<PageInfo>(hasNextPage, hasPreviousPage))
-		, _tasks(std::move(tasks))
+	// Only keep the elements in the page.
+	explicit TaskConnection(const std::vector<std::shared_ptr<Task>>& tasks, const service::ConnectionSlice& slice)
+		: _pageInfo(std::make_shared<PageInfo>(slice.hasNextPage, slice.hasPreviousPage))
+		, _slice(slice)
+		, _tasks(tasks.cbegin() + slice.begin, tasks.cbegin() + slice.end)
 	{
 	}
 
@@ -241,21 +272,21 @@ public:
 		return _pageInfo;
 	}
 
-	service::FieldResult<std::optional<std::vector<std::shared_ptr<object::TaskEdge>>>> getEdges(service::FieldParams&&) const override
+	service::FieldResult<std::optional<std::vector<std::shared_ptr<object::TaskEdge>>>> getEdges(service::FieldParams&& params) const override
 	{
-		auto result = std::make_optional<std::vector<std::shared_ptr<object::TaskEdge>>>(_tasks.size());
-
-		std::transform(_tasks.cbegin(), _tasks.cend(), result->begin(),
-			[](const std::shared_ptr<Task>& node)
+		// Create each of the edges as it's resolved instead of building the whole list up front.
+		return service::makeEdges<std::shared_ptr<object::TaskEdge>>(_slice,
+			[tasks = _tasks, offset = _slice.begin, arena = params.arena](size_t index)
 		{
-			return std::make_shared<TaskEdge>(node);
-		});
+			const auto& task = tasks[index - offset];
 
-		return { std::move(result) };
+			return service::makeResult<TaskEdge>(arena, task, service::Cursor::fromId(task->id()));
+		});
 	}
 
 private:
 	std::shared_ptr<PageInfo> _pageInfo;
+	service::ConnectionSlice _slice;
 	std::vector<std::shared_ptr<Task>> _tasks;
 };
 
@@ -264,6 +295,11 @@ class Folder : public object::Folder
 public:
 	explicit Folder(response::IdType&& id, std::string&& name, int unreadCount);
 
+	const response::IdType& id() const noexcept
+	{
+		return _id;
+	}
+
 	service::FieldResult<response::IdType> getId(service::FieldParams&&) const override
 	{
 		return _id;
@@ -288,8 +324,9 @@ private:
 class FolderEdge : public object::FolderEdge
 {
 public:
-	explicit FolderEdge(std::shared_ptr<Folder> folder)
+	explicit FolderEdge(std::shared_ptr<Folder> folder, response::Value&& cursor)
 		: _folder(std::move(folder))
+		, _cursor(std::move(cursor))
 	{
 	}
 
@@ -298,21 +335,24 @@ public:
 		return std::static_pointer_cast<object::Folder>(_folder);
 	}
 
-	service::FieldResult<response::Value> getCursor(service::FieldParams&& params) const override
+	service::FieldResult<response::Value> getCursor(service::FieldParams&&) const override
 	{
-		return response::Value(service::Base64::toBase64(_folder->getId(std::move(params)).get()));
+		return response::Value(_cursor);
 	}
 
 private:
 	std::shared_ptr<Folder> _folder;
+	response::Value _cursor;
 };
 
 class FolderConnection : public object::FolderConnection
 {
 public:
-	explicit FolderConnection(bool hasNextPage, bool hasPreviousPage, std::vector<std::shared_ptr<Folder>> folders)
-		: _pageInfo(std::make_shared<PageInfo>(hasNextPage, hasPreviousPage))
-		, _folders(std::move(folders))
+	// Only keep the elements in the page.
+	explicit FolderConnection(const std::vector<std::shared_ptr<Folder>>& folders, const service::ConnectionSlice& slice)
+		: _pageInfo(std::make_shared<PageInfo>(slice.hasNextPage, slice.hasPreviousPage))
+		, _slice(slice)
+		, _folders(folders.cbegin() + slice.begin, folders.cbegin() + slice.end)
 	{
 	}
 
@@ -321,21 +361,21 @@ public:
 		return _pageInfo;
 	}
 
-	service::FieldResult<std::optional<std::vector<std::shared_ptr<object::FolderEdge>>>> getEdges(service::FieldParams&&) const override
+	service::FieldResult<std::optional<std::vector<std::shared_ptr<object::FolderEdge>>>> getEdges(service::FieldParams&& params) const override
 	{
-		auto result = std::make_optional<std::vector<std::shared_ptr<object::FolderEdge>>>(_folders.size());
-
-		std::transform(_folders.cbegin(), _folders.cend(), result->begin(),
-			[](const std::shared_ptr<Folder>& node)
+		// Create each of the edges as it's resolved instead of building the whole list up front.
+		return service::makeEdges<std::shared_ptr<object::FolderEdge>>(_slice,
+			[folders = _folders, offset = _slice.begin, arena = params.arena](size_t index)
 		{
-			return std::make_shared<FolderEdge>(node);
-		});
+			const auto& folder = folders[index - offset];
 
-		return { std::move(result) };
+			return service::makeResult<FolderEdge>(arena, folder, service::Cursor::fromId(folder->id()));
+		});
 	}
 
 private:
 	std::shared_ptr<PageInfo> _pageInfo;
+	service::ConnectionSlice _slice;
 	std::vector<std::shared_ptr<Folder>> _folders;
 };
 
@@ -23,6 +23,26 @@ Task::Task(response::IdType&& id, std::string&& title, bool isComplete)
 {
 }
 
+service::FieldResult<std::vector<std::optional<response::StringType>>> Task::getTitleBatch(service::FieldParams&& params, const std::vector<std::shared_ptr<object::Task>>& parents) const
+{
+	if (params.state)
+	{
+		auto todayState = std::static_pointer_cast<RequestState>(params.state);
+
+		todayState->loadTitlesCount++;
+	}
+
+	std::vector<std::optional<response::StringType>> titles(parents.size());
+
+	std::transform(parents.cbegin(), parents.cend(), titles.begin(),
+		[](const std::shared_ptr<object::Task>& parent)
+	{
+		return std::make_optional<response::StringType>(std::static_pointer_cast<Task>(parent)->_title);
+	});
+
+	return titles;
+}
+
 Folder::Folder(response::IdType&& id, std::string&& name, int unreadCount)
 	: _id(std::move(id))
 	, _name(std::move(name))
@@ -30,6 +50,30 @@ Folder::Folder(response::IdType&& id, std::string&& name, int unreadCount)
 {
 }
 
+// Map the ID of each element to its offset, so the connections can seek to an ID cursor without
+// calling getId on each of the elements.
+template <class _Object>
+std::map<response::IdType, size_t> indexById(const std::vector<std::shared_ptr<_Object>>& objects)
+{
+	std::map<response::IdType, size_t> offsets;
+
+	for (size_t i = 0; i < objects.size(); ++i)
+	{
+		offsets.emplace(objects[i]->id(), i);
+	}
+
+	return offsets;
+}
+
+std::optional<size_t> findOffset(const std::map<response::IdType, size_t>& offsets, const response::IdType& id)
+{
+	const auto itr = offsets.find(id);
+
+	return (itr == offsets.cend()
+		? std::nullopt
+		: std::make_optional(itr->second));
+}
+
 Query::Query(appointmentsLoader&& getAppointments, tasksLoader&& getTasks, unreadCountsLoader&& getUnreadCounts)
 	: _getAppointments(std::move(getAppointments))
 	, _getTasks(std::move(getTasks))
@@ -51,6 +95,7 @@ void Query::loadAppointments(const std::shared_ptr<service::RequestState>& state
 	{
 		_appointments = _getAppointments();
 		_getAppointments = nullptr;
+		_appointmentOffsets = indexById(_appointments);
 	}
 }
 
@@ -85,6 +130,7 @@ void Query::loadTasks(const std::shared_ptr<service::RequestState>& state) const
 	{
 		_tasks = _getTasks();
 		_getTasks = nullptr;
+		_taskOffsets = indexById(_tasks);
 	}
 }
 
@@ -119,6 +165,7 @@ void Query::loadUnreadCounts(const std::shared_ptr<service::RequestState>& state
 	{
 		_unreadCounts = _getUnreadCounts();
 		_getUnreadCounts = nullptr;
+		_unreadCountOffsets = indexById(_unreadCounts);
 	}
 }
 
@@ -170,109 +217,6 @@ service::FieldResult<std::shared_ptr<service::Object>> Query::getNode(service::F
 	return promise.get_future();
 }
 
-template <class _Object, class _Connection>
-struct EdgeConstraints
-{
-	using vec_type = std::vector<std::shared_ptr<_Object>>;
-	using itr_type = typename vec_type::const_iterator;
-
-	EdgeConstraints(const std::shared_ptr<service::RequestState>& state, const vec_type& objects)
-		: _state(state)
-		, _objects(objects)
-	{
-	}
-
-	std::shared_ptr<_Connection> operator()(const std::optional<int>& first, const std::optional<response::Value>& after, const std::optional<int>& last, const std::optional<response::Value>& before) const
-	{
-		auto itrFirst = _objects.cbegin();
-		auto itrLast = _objects.cend();
-
-		const response::Value unusedDirectives;
-		const service::SelectionSetParams selectionSetParams {
-			_state,
-			unusedDirectives,
-			unusedDirectives,
-			unusedDirectives,
-			unusedDirectives,
-		};
-
-		if (after)
-		{
-			const auto& encoded = after->get<const response::StringType&>();
-			auto afterId = service::Base64::fromBase64(encoded.c_str(), encoded.size());
-			auto itrAfter = std::find_if(itrFirst, itrLast,
-				[this, &selectionSetParams, &afterId](const std::shared_ptr<_Object>& entry)
-			{
-				return entry->getId(service::FieldParams(selectionSetParams, {})).get() == afterId;
-			});
-
-			if (itrAfter != itrLast)
-			{
-				itrFirst = itrAfter;
-			}
-		}
-
-		if (before)
-		{
-			const auto& encoded = before->get<const response::StringType&>();
-			auto beforeId = service::Base64::fromBase64(encoded.c_str(), encoded.size());
-			auto itrBefore = std::find_if(itrFirst, itrLast,
-				[this, &selectionSetParams, &beforeId](const std::shared_ptr<_Object>& entry)
-			{
-				return entry->getId(service::FieldParams(selectionSetParams, {})).get() == beforeId;
-			});
-
-			if (itrBefore != itrLast)
-			{
-				itrLast = itrBefore;
-				++itrLast;
-			}
-		}
-
-		if (first)
-		{
-			if (*first < 0)
-			{
-				std::ostringstream error;
-
-				error << "Invalid argument: first value: " << *first;
-				throw service::schema_exception({ error.str() });
-			}
-
-			if (itrLast - itrFirst > *first)
-			{
-				itrLast = itrFirst + *first;
-			}
-		}
-
-		if (last)
-		{
-			if (*last < 0)
-			{
-				std::ostringstream error;
-
-				error << "Invalid argument: last value: " << *last;
-				throw service::schema_exception({ error.str() });
-			}
-
-			if (itrLast - itrFirst > *last)
-			{
-				itrFirst = itrLast - *last;
-			}
-		}
-
-		std::vector<std::shared_ptr<_Object>> edges(itrLast - itrFirst);
-
-		std::copy(itrFirst, itrLast, edges.begin());
-
-		return std::make_shared<_Connection>(itrLast < _objects.cend(), itrFirst > _objects.cbegin(), std::move(edges));
-	}
-
-private:
-	const std::shared_ptr<service::RequestState>& _state;
-	const vec_type& _objects;
-};
-
 service::FieldResult<std::shared_ptr<object::AppointmentConnection>> Query::getAppointments(service::FieldParams&& params, std::optional<int>&& first, std::optional<response::Value>&& after, std::optional<int>&& last, std::optional<response::Value>&& before) const
 {
 	auto spThis = shared_from_this();
@@ -282,8 +226,13 @@ service::FieldResult<std::shared_ptr<object::AppointmentConnection>> Query::getA
 	{
 		loadAppointments(state);
 
-		EdgeConstraints<Appointment, AppointmentConnection> constraints(state, _appointments);
-		auto connection = constraints(firstWrapped, afterWrapped, lastWrapped, beforeWrapped);
+		const auto slice = service::sliceById(_appointments.size(),
+			[this](const response::IdType& id)
+			{
+				return findOffset(_appointmentOffsets, id);
+			},
+			{ std::move(firstWrapped), std::move(afterWrapped), std::move(lastWrapped), std::move(beforeWrapped) });
+		auto connection = std::make_shared<AppointmentConnection>(_appointments, slice);
 
 		return std::static_pointer_cast<object::AppointmentConnection>(connection);
 	}, std::move(first), std::move(after), std::move(last), std::move(before));
@@ -298,8 +247,13 @@ service::FieldResult<std::shared_ptr<object::TaskConnection>> Query::getTasks(se
 	{
 		loadTasks(state);
 
-		EdgeConstraints<Task, TaskConnection> constraints(state, _tasks);
-		auto connection = constraints(firstWrapped, afterWrapped, lastWrapped, beforeWrapped);
+		const auto slice = service::sliceById(_tasks.size(),
+			[this](const response::IdType& id)
+			{
+				return findOffset(_taskOffsets, id);
+			},
+			{ std::move(firstWrapped), std::move(afterWrapped), std::move(lastWrapped), std::move(beforeWrapped) });
+		auto connection = std::make_shared<TaskConnection>(_tasks, slice);
 
 		return std::static_pointer_cast<object::TaskConnection>(connection);
 	}, std::move(first), std::move(after), std::move(last), std::move(before));
@@ -314,8 +268,13 @@ service::FieldResult<std::shared_ptr<object::FolderConnection>> Query::getUnread
 	{
 		loadUnreadCounts(state);
 
-		EdgeConstraints<Folder, FolderConnection> constraints(state, _unreadCounts);
-		auto connection = constraints(firstWrapped, afterWrapped, lastWrapped, beforeWrapped);
+		const auto slice = service::sliceById(_unreadCounts.size(),
+			[this](const response::IdType& id)
+			{
+				return findOffset(_unreadCountOffsets, id);
+			},
+			{ std::move(firstWrapped), std::move(afterWrapped), std::move(lastWrapped), std::move(beforeWrapped) });
+		auto connection = std::make_shared<FolderConnection>(_unreadCounts, slice);
 
 		return std::static_pointer_cast<object::FolderConnection>(connection);
 	}, std::move(first), std::move(after), std::move(last), std::move(before));
@@ -375,6 +334,20 @@ service::FieldResult<std::shared_ptr<object::NestedType>> Query::getNested(servi
 	return promise.get_future();
 }
 
+service::FieldResult<std::vector<response::StringType>> Query::getStringList(service::FieldParams&&) const
+{
+	return std::vector<response::StringType> { "first", "second", "third" };
+}
+
+service::FieldResult<std::optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>> Query::getNestedIntList(service::FieldParams&&) const
+{
+	return std::make_optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>({
+		std::make_optional<std::vector<std::optional<response::IntType>>>({ 1, std::nullopt, 3 }),
+		std::nullopt,
+		std::make_optional<std::vector<std::optional<response::IntType>>>({})
+	});
+}
+
 Mutation::Mutation(completeTaskMutation&& mutateCompleteTask)
 	: _mutateCompleteTask(std::move(mutateCompleteTask))
 {
@@ -0,0 +1,560 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodayClient.h"
+
+#include <algorithm>
+#include <array>
+
+namespace graphql {
+namespace client {
+
+constexpr std::string_view s_requestText = R"gql(# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+query Appointments {
+    appointments {
+        edges {
+            node {
+                id
+                subject
+                when
+                isNow
+                __typename
+            }
+        }
+    }
+}
+
+query Tasks($first: Int) {
+    tasks(first: $first) {
+        edges {
+            node {
+                ...TaskFields
+            }
+        }
+    }
+}
+
+mutation CompleteTask($input: CompleteTaskInput!) {
+    completedTask: completeTask(input: $input) {
+        completedTask: task {
+            ...TaskFields
+        }
+        clientMutationId
+    }
+}
+
+fragment TaskFields on Task {
+    id
+    title
+    isComplete
+}
+)gql";
+
+template <>
+struct Variable<today::CompleteTaskInput>
+{
+	static response::Value serialize(today::CompleteTaskInput&& value)
+	{
+		response::Value result(response::Type::Map);
+
+		result.reserve(3);
+		result.emplace_back("id", Variable<response::IdType>::serialize(std::move(value.id)));
+
+		if (value.isComplete)
+		{
+			result.emplace_back("isComplete", Variable<std::optional<response::BooleanType>>::serialize(std::move(value.isComplete)));
+		}
+
+		result.emplace_back("clientMutationId", Variable<std::optional<response::StringType>>::serialize(std::move(value.clientMutationId)));
+
+		return result;
+	}
+};
+
+template <>
+struct ResponseMembers<query::Appointments::Response::appointments_AppointmentConnection::edges_AppointmentEdge::node_Appointment>
+{
+	static constexpr std::array<std::string_view, 5> keys = {
+		"__typename",
+		"id",
+		"isNow",
+		"subject",
+		"when"
+	};
+
+	static constexpr std::array<bool, 5> required = {
+		true,
+		true,
+		true,
+		false,
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(query::Appointments::Response::appointments_AppointmentConnection::edges_AppointmentEdge::node_Appointment& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value._typename);
+				break;
+
+			case 1:
+				visitor(value.id);
+				break;
+
+			case 2:
+				visitor(value.isNow);
+				break;
+
+			case 3:
+				visitor(value.subject);
+				break;
+
+			case 4:
+				visitor(value.when);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<query::Appointments::Response::appointments_AppointmentConnection::edges_AppointmentEdge>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"node"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(query::Appointments::Response::appointments_AppointmentConnection::edges_AppointmentEdge& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.node);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<query::Appointments::Response::appointments_AppointmentConnection>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"edges"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(query::Appointments::Response::appointments_AppointmentConnection& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.edges);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<query::Appointments::Response>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"appointments"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		true
+	};
+
+	template <typename Visitor>
+	static void visit(query::Appointments::Response& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.appointments);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+namespace query::Appointments {
+
+std::string_view GetRequestText() noexcept
+{
+	return s_requestText;
+}
+
+std::string_view GetOperationName() noexcept
+{
+	return "Appointments";
+}
+
+response::Value buildRequest()
+{
+	return client::buildRequest(GetRequestText(), GetOperationName(), response::Value(response::Type::Map));
+}
+
+ResponseReader getResponseReader(Response& response)
+{
+	return ResponseReader { std::make_unique<ObjectReader<Response>>(response) };
+}
+
+Response parseResponse(response::Value&& response)
+{
+	Response result {};
+	auto reader = getResponseReader(result);
+
+	reader.add_value(std::move(response));
+
+	auto errors = reader.getErrors();
+
+	if (errors.type() != response::Type::Null)
+	{
+		throw service::schema_exception::fromErrors(std::move(errors));
+	}
+
+	return result;
+}
+
+} /* namespace query::Appointments */
+
+template <>
+struct ResponseMembers<query::Tasks::Response::tasks_TaskConnection::edges_TaskEdge::node_Task>
+{
+	static constexpr std::array<std::string_view, 3> keys = {
+		"id",
+		"isComplete",
+		"title"
+	};
+
+	static constexpr std::array<bool, 3> required = {
+		true,
+		true,
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(query::Tasks::Response::tasks_TaskConnection::edges_TaskEdge::node_Task& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.id);
+				break;
+
+			case 1:
+				visitor(value.isComplete);
+				break;
+
+			case 2:
+				visitor(value.title);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<query::Tasks::Response::tasks_TaskConnection::edges_TaskEdge>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"node"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(query::Tasks::Response::tasks_TaskConnection::edges_TaskEdge& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.node);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<query::Tasks::Response::tasks_TaskConnection>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"edges"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(query::Tasks::Response::tasks_TaskConnection& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.edges);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<query::Tasks::Response>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"tasks"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		true
+	};
+
+	template <typename Visitor>
+	static void visit(query::Tasks::Response& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.tasks);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+namespace query::Tasks {
+
+std::string_view GetRequestText() noexcept
+{
+	return s_requestText;
+}
+
+std::string_view GetOperationName() noexcept
+{
+	return "Tasks";
+}
+
+response::Value serializeVariables(Variables&& variables)
+{
+	response::Value result(response::Type::Map);
+
+	result.reserve(1);
+	result.emplace_back("first", Variable<std::optional<response::IntType>>::serialize(std::move(variables.first)));
+
+	return result;
+}
+
+response::Value buildRequest(Variables&& variables)
+{
+	return client::buildRequest(GetRequestText(), GetOperationName(), serializeVariables(std::move(variables)));
+}
+
+ResponseReader getResponseReader(Response& response)
+{
+	return ResponseReader { std::make_unique<ObjectReader<Response>>(response) };
+}
+
+Response parseResponse(response::Value&& response)
+{
+	Response result {};
+	auto reader = getResponseReader(result);
+
+	reader.add_value(std::move(response));
+
+	auto errors = reader.getErrors();
+
+	if (errors.type() != response::Type::Null)
+	{
+		throw service::schema_exception::fromErrors(std::move(errors));
+	}
+
+	return result;
+}
+
+} /* namespace query::Tasks */
+
+template <>
+struct ResponseMembers<mutation::CompleteTask::Response::completedTask_CompleteTaskPayload::completedTask_Task>
+{
+	static constexpr std::array<std::string_view, 3> keys = {
+		"id",
+		"isComplete",
+		"title"
+	};
+
+	static constexpr std::array<bool, 3> required = {
+		true,
+		true,
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(mutation::CompleteTask::Response::completedTask_CompleteTaskPayload::completedTask_Task& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.id);
+				break;
+
+			case 1:
+				visitor(value.isComplete);
+				break;
+
+			case 2:
+				visitor(value.title);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<mutation::CompleteTask::Response::completedTask_CompleteTaskPayload>
+{
+	static constexpr std::array<std::string_view, 2> keys = {
+		"clientMutationId",
+		"completedTask"
+	};
+
+	static constexpr std::array<bool, 2> required = {
+		false,
+		false
+	};
+
+	template <typename Visitor>
+	static void visit(mutation::CompleteTask::Response::completedTask_CompleteTaskPayload& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.clientMutationId);
+				break;
+
+			case 1:
+				visitor(value.completedTask);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+template <>
+struct ResponseMembers<mutation::CompleteTask::Response>
+{
+	static constexpr std::array<std::string_view, 1> keys = {
+		"completedTask"
+	};
+
+	static constexpr std::array<bool, 1> required = {
+		true
+	};
+
+	template <typename Visitor>
+	static void visit(mutation::CompleteTask::Response& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
+			case 0:
+				visitor(value.completedTask);
+				break;
+
+			default:
+				break;
+		}
+	}
+};
+
+namespace mutation::CompleteTask {
+
+std::string_view GetRequestText() noexcept
+{
+	return s_requestText;
+}
+
+std::string_view GetOperationName() noexcept
+{
+	return "CompleteTask";
+}
+
+response::Value serializeVariables(Variables&& variables)
+{
+	response::Value result(response::Type::Map);
+
+	result.reserve(1);
+	result.emplace_back("input", Variable<today::CompleteTaskInput>::serialize(std::move(variables.input)));
+
+	return result;
+}
+
+response::Value buildRequest(Variables&& variables)
+{
+	return client::buildRequest(GetRequestText(), GetOperationName(), serializeVariables(std::move(variables)));
+}
+
+ResponseReader getResponseReader(Response& response)
+{
+	return ResponseReader { std::make_unique<ObjectReader<Response>>(response) };
+}
+
+Response parseResponse(response::Value&& response)
+{
+	Response result {};
+	auto reader = getResponseReader(result);
+
+	reader.add_value(std::move(response));
+
+	auto errors = reader.getErrors();
+
+	if (errors.type() != response::Type::Null)
+	{
+		throw service::schema_exception::fromErrors(std::move(errors));
+	}
+
+	return result;
+}
+
+} /* namespace mutation::CompleteTask */
+
+} /* namespace client */
+} /* namespace graphql */
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <graphqlservice/GraphQLClient.h>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace graphql {
+namespace client {
+
+namespace today {
+
+struct CompleteTaskInput
+{
+	response::IdType id;
+	std::optional<response::BooleanType> isComplete;
+	std::optional<response::StringType> clientMutationId;
+};
+
+} /* namespace today */
+
+namespace query::Appointments {
+
+// Return the original text of the request document, which may include other operations and fragments.
+std::string_view GetRequestText() noexcept;
+
+// Return the name of this operation in the request document.
+std::string_view GetOperationName() noexcept;
+
+// Build the request object with the query, operationName, and variables members.
+response::Value buildRequest();
+
+struct Response
+{
+	struct appointments_AppointmentConnection
+	{
+		struct edges_AppointmentEdge
+		{
+			struct node_Appointment
+			{
+				response::IdType id;
+				std::optional<response::StringType> subject;
+				std::optional<response::Value> when;
+				response::BooleanType isNow;
+				response::StringType _typename;
+			};
+
+			std::optional<node_Appointment> node;
+		};
+
+		std::optional<std::vector<std::optional<edges_AppointmentEdge>>> edges;
+	};
+
+	appointments_AppointmentConnection appointments;
+};
+
+// Read the response directly into the typed Response, e.g. with response::parseJSON.
+ResponseReader getResponseReader(Response& response);
+
+// Read a response which was already parsed into a response::Value. If the response has any errors,
+// this throws a schema_exception with them instead.
+Response parseResponse(response::Value&& response);
+
+} /* namespace query::Appointments */
+
+namespace query::Tasks {
+
+// Return the original text of the request document, which may include other operations and fragments.
+std::string_view GetRequestText() noexcept;
+
+// Return the name of this operation in the request document.
+std::string_view GetOperationName() noexcept;
+
+struct Variables
+{
+	std::optional<response::IntType> first;
+};
+
+response::Value serializeVariables(Variables&& variables);
+
+// Build the request object with the query, operationName, and variables members.
+response::Value buildRequest(Variables&& variables);
+
+struct Response
+{
+	struct tasks_TaskConnection
+	{
+		struct edges_TaskEdge
+		{
+			struct node_Task
+			{
+				response::IdType id;
+				std::optional<response::StringType> title;
+				response::BooleanType isComplete;
+			};
+
+			std::optional<node_Task> node;
+		};
+
+		std::optional<std::vector<std::optional<edges_TaskEdge>>> edges;
+	};
+
+	tasks_TaskConnection tasks;
+};
+
+// Read the response directly into the typed Response, e.g. with response::parseJSON.
+ResponseReader getResponseReader(Response& response);
+
+// Read a response which was already parsed into a response::Value. If the response has any errors,
+// this throws a schema_exception with them instead.
+Response parseResponse(response::Value&& response);
+
+} /* namespace query::Tasks */
+
+namespace mutation::CompleteTask {
+
+// Return the original text of the request document, which may include other operations and fragments.
+std::string_view GetRequestText() noexcept;
+
+// Return the name of this operation in the request document.
+std::string_view GetOperationName() noexcept;
+
+struct Variables
+{
+	today::CompleteTaskInput input;
+};
+
+response::Value serializeVariables(Variables&& variables);
+
+// Build the request object with the query, operationName, and variables members.
+response::Value buildRequest(Variables&& variables);
+
+struct Response
+{
+	struct completedTask_CompleteTaskPayload
+	{
+		struct completedTask_Task
+		{
+			response::IdType id;
+			std::optional<response::StringType> title;
+			response::BooleanType isComplete;
+		};
+
+		std::optional<completedTask_Task> completedTask;
+		std::optional<response::StringType> clientMutationId;
+	};
+
+	completedTask_CompleteTaskPayload completedTask;
+};
+
+// Read the response directly into the typed Response, e.g. with response::parseJSON.
+ResponseReader getResponseReader(Response& response);
+
+// Read a response which was already parsed into a response::Value. If the response has any errors,
+// this throws a schema_exception with them instead.
+Response parseResponse(response::Value&& response);
+
+} /* namespace mutation::CompleteTask */
+
+} /* namespace client */
+} /* namespace graphql */
@@ -76,21 +76,28 @@ public:
 	virtual service::FieldResult<std::vector<std::shared_ptr<Folder>>> getUnreadCountsById(service::FieldParams&& params, std::vector<response::IdType>&& idsArg) const;
 	virtual service::FieldResult<std::shared_ptr<NestedType>> getNested(service::FieldParams&& params) const;
 	virtual service::FieldResult<response::StringType> getUnimplemented(service::FieldParams&& params) const;
+	virtual service::FieldResult<std::vector<response::StringType>> getStringList(service::FieldParams&& params) const;
+	virtual service::FieldResult<std::optional<std::vector<std::optional<std::vector<std::optional<response::IntType>>>>>> getNestedIntList(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveNode(service::ResolverParams&& params);
-	std::future<response::Value> resolveAppointments(service::ResolverParams&& params);
-	std::future<response::Value> resolveTasks(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnreadCounts(service::ResolverParams&& params);
-	std::future<response::Value> resolveAppointmentsById(service::ResolverParams&& params);
-	std::future<response::Value> resolveTasksById(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnreadCountsById(service::ResolverParams&& params);
-	std::future<response::Value> resolveNested(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnimplemented(service::ResolverParams&& params);
-
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
-	std::future<response::Value> resolve_schema(service::ResolverParams&& params);
-	std::future<response::Value> resolve_type(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveNode(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveAppointments(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveTasks(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnreadCounts(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveAppointmentsById(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveTasksById(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnreadCountsById(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNested(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnimplemented(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveStringList(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNestedIntList(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
+	std::future<response::Value> resolve_schema(service::ResolverParams&& params) const;
+	std::future<response::Value> resolve_type(service::ResolverParams&& params) const;
 
 	std::shared_ptr<introspection::Schema> _schema;
 };
@@ -106,10 +113,13 @@ public:
 	virtual service::FieldResult<response::BooleanType> getHasPreviousPage(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveHasNextPage(service::ResolverParams&& params);
-	std::future<response::Value> resolveHasPreviousPage(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveHasNextPage(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveHasPreviousPage(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class AppointmentEdge
@@ -123,10 +133,13 @@ public:
 	virtual service::FieldResult<response::Value> getCursor(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveNode(service::ResolverParams&& params);
-	std::future<response::Value> resolveCursor(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveNode(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveCursor(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class AppointmentConnection
@@ -140,10 +153,13 @@ public:
 	virtual service::FieldResult<std::optional<std::vector<std::shared_ptr<AppointmentEdge>>>> getEdges(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params);
-	std::future<response::Value> resolveEdges(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveEdges(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class TaskEdge
@@ -157,10 +173,13 @@ public:
 	virtual service::FieldResult<response::Value> getCursor(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveNode(service::ResolverParams&& params);
-	std::future<response::Value> resolveCursor(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveNode(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveCursor(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class TaskConnection
@@ -174,10 +193,13 @@ public:
 	virtual service::FieldResult<std::optional<std::vector<std::shared_ptr<TaskEdge>>>> getEdges(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params);
-	std::future<response::Value> resolveEdges(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveEdges(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class FolderEdge
@@ -191,10 +213,13 @@ public:
 	virtual service::FieldResult<response::Value> getCursor(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveNode(service::ResolverParams&& params);
-	std::future<response::Value> resolveCursor(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveNode(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveCursor(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class FolderConnection
@@ -208,10 +233,13 @@ public:
 	virtual service::FieldResult<std::optional<std::vector<std::shared_ptr<FolderEdge>>>> getEdges(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params);
-	std::future<response::Value> resolveEdges(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveEdges(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class CompleteTaskPayload
@@ -225,10 +253,13 @@ public:
 	virtual service::FieldResult<std::optional<response::StringType>> getClientMutationId(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveTask(service::ResolverParams&& params);
-	std::future<response::Value> resolveClientMutationId(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveTask(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveClientMutationId(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Mutation
@@ -241,9 +272,12 @@ public:
 	virtual service::FieldResult<std::shared_ptr<CompleteTaskPayload>> applyCompleteTask(service::FieldParams&& params, CompleteTaskInput&& inputArg) const;
 
 private:
-	std::future<response::Value> resolveCompleteTask(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveCompleteTask(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Subscription
@@ -257,10 +291,13 @@ public:
 	virtual service::FieldResult<std::shared_ptr<service::Object>> getNodeChange(service::FieldParams&& params, response::IdType&& idArg) const;
 
 private:
-	std::future<response::Value> resolveNextAppointmentChange(service::ResolverParams&& params);
-	std::future<response::Value> resolveNodeChange(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveNextAppointmentChange(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNodeChange(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Appointment
@@ -277,12 +314,15 @@ public:
 	virtual service::FieldResult<response::BooleanType> getIsNow(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveId(service::ResolverParams&& params);
-	std::future<response::Value> resolveWhen(service::ResolverParams&& params);
-	std::future<response::Value> resolveSubject(service::ResolverParams&& params);
-	std::future<response::Value> resolveIsNow(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveId(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveWhen(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveSubject(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveIsNow(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Task
@@ -295,14 +335,20 @@ protected:
 public:
 	virtual service::FieldResult<response::IdType> getId(service::FieldParams&& params) const override;
 	virtual service::FieldResult<std::optional<response::StringType>> getTitle(service::FieldParams&& params) const;
+	virtual service::FieldResult<std::vector<std::optional<response::StringType>>> getTitleBatch(service::FieldParams&& params, const std::vector<std::shared_ptr<Task>>& parents) const;
 	virtual service::FieldResult<response::BooleanType> getIsComplete(service::FieldParams&& params) const;
 
+	static constexpr bool hasBatchResolvers = true;
+
 private:
-	std::future<response::Value> resolveId(service::ResolverParams&& params);
-	std::future<response::Value> resolveTitle(service::ResolverParams&& params);
-	std::future<response::Value> resolveIsComplete(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolveId(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveTitle(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveIsComplete(service::ResolverParams&& params) const;
+
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class Folder
@@ -318,11 +364,14 @@ public:
 	virtual service::FieldResult<response::IntType> getUnreadCount(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveId(service::ResolverParams&& params);
-	std::future<response::Value> resolveName(service::ResolverParams&& params);
-	std::future<response::Value> resolveUnreadCount(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveId(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveName(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveUnreadCount(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 class NestedType
@@ -336,10 +385,13 @@ public:
 	virtual service::FieldResult<std::shared_ptr<NestedType>> getNested(service::FieldParams&& params) const;
 
 private:
-	std::future<response::Value> resolveDepth(service::ResolverParams&& params);
-	std::future<response::Value> resolveNested(service::ResolverParams&& params);
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
+	std::future<response::Value> resolveDepth(service::ResolverParams&& params) const;
+	std::future<response::Value> resolveNested(service::ResolverParams&& params) const;
 
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace object */
@@ -0,0 +1,384 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <graphqlservice/GraphQLClient.h>
+
+namespace graphql::client {
+
+void Reader::add_member_key(std::string_view /*key*/)
+{
+	throw service::schema_exception({ "unexpected object member" });
+}
+
+std::unique_ptr<Reader> Reader::start_object()
+{
+	throw service::schema_exception({ "unexpected object value" });
+}
+
+std::unique_ptr<Reader> Reader::start_array()
+{
+	throw service::schema_exception({ "unexpected list value" });
+}
+
+void Reader::end()
+{
+}
+
+void Reader::add_null()
+{
+	throw service::schema_exception({ "unexpected null value" });
+}
+
+void Reader::add_string(std::string_view /*value*/)
+{
+	throw service::schema_exception({ "unexpected String value" });
+}
+
+void Reader::add_bool(response::BooleanType /*value*/)
+{
+	throw service::schema_exception({ "unexpected Boolean value" });
+}
+
+void Reader::add_int(response::IntType /*value*/)
+{
+	throw service::schema_exception({ "unexpected Int value" });
+}
+
+void Reader::add_float(response::FloatType /*value*/)
+{
+	throw service::schema_exception({ "unexpected Float value" });
+}
+
+void SkipReader::add_member_key(std::string_view /*key*/)
+{
+}
+
+std::unique_ptr<Reader> SkipReader::start_object()
+{
+	return std::make_unique<SkipReader>();
+}
+
+std::unique_ptr<Reader> SkipReader::start_array()
+{
+	return std::make_unique<SkipReader>();
+}
+
+void SkipReader::add_null()
+{
+}
+
+void SkipReader::add_string(std::string_view /*value*/)
+{
+}
+
+void SkipReader::add_bool(response::BooleanType /*value*/)
+{
+}
+
+void SkipReader::add_int(response::IntType /*value*/)
+{
+}
+
+void SkipReader::add_float(response::FloatType /*value*/)
+{
+}
+
+ValueBuilder::ValueBuilder(response::Value& target, response::Type type)
+	: _target(&target)
+	, _value(type)
+{
+}
+
+ValueBuilder::ValueBuilder(ValueBuilder& parent, response::Type type)
+	: _parent(&parent)
+	, _value(type)
+{
+}
+
+void ValueBuilder::add_member_key(std::string_view key)
+{
+	_key = key;
+}
+
+std::unique_ptr<Reader> ValueBuilder::start_object()
+{
+	return std::make_unique<ValueBuilder>(*this, response::Type::Map);
+}
+
+std::unique_ptr<Reader> ValueBuilder::start_array()
+{
+	return std::make_unique<ValueBuilder>(*this, response::Type::List);
+}
+
+void ValueBuilder::end()
+{
+	if (_parent)
+	{
+		_parent->addValue(std::move(_value));
+	}
+	else
+	{
+		*_target = std::move(_value);
+	}
+}
+
+void ValueBuilder::add_null()
+{
+	addValue(response::Value());
+}
+
+void ValueBuilder::add_string(std::string_view value)
+{
+	addValue(response::Value(response::StringType{ value }).from_json());
+}
+
+void ValueBuilder::add_bool(response::BooleanType value)
+{
+	addValue(response::Value(value));
+}
+
+void ValueBuilder::add_int(response::IntType value)
+{
+	addValue(response::Value(value));
+}
+
+void ValueBuilder::add_float(response::FloatType value)
+{
+	addValue(response::Value(value));
+}
+
+void ValueBuilder::addValue(response::Value&& value)
+{
+	if (_value.type() == response::Type::Map)
+	{
+		_value.emplace_back(std::move(_key), std::move(value));
+	}
+	else
+	{
+		_value.emplace_back(std::move(value));
+	}
+}
+
+// The document reader only looks at the data and errors members of the response.
+class DocumentReader : public SkipReader
+{
+public:
+	explicit DocumentReader(std::unique_ptr<Reader>&& data, response::Value& errors) noexcept
+		: _data(std::move(data))
+		, _errors(errors)
+	{
+	}
+
+	void add_member_key(std::string_view key) override
+	{
+		_key = key;
+	}
+
+	std::unique_ptr<Reader> start_object() override
+	{
+		if (_key == "data" && _data)
+		{
+			return std::move(_data);
+		}
+
+		return SkipReader::start_object();
+	}
+
+	std::unique_ptr<Reader> start_array() override
+	{
+		if (_key == "errors")
+		{
+			return std::make_unique<ValueBuilder>(_errors, response::Type::List);
+		}
+
+		return SkipReader::start_array();
+	}
+
+	void end() override
+	{
+		// A response without any errors must have the data.
+		if (_data && _errors.type() == response::Type::Null)
+		{
+			throw service::schema_exception({ "missing data in the response" });
+		}
+	}
+
+private:
+	std::unique_ptr<Reader> _data;
+	response::Value& _errors;
+
+	// The key is only valid during the call to add_member_key, so keep a copy.
+	std::string _key;
+};
+
+ResponseReader::ResponseReader(std::unique_ptr<Reader> data) noexcept
+	: _data(std::move(data))
+{
+}
+
+Reader& ResponseReader::top()
+{
+	if (_readers.empty())
+	{
+		throw service::schema_exception({ "the response must be an object" });
+	}
+
+	return *_readers.back();
+}
+
+void ResponseReader::start_object()
+{
+	if (_readers.empty())
+	{
+		_readers.push_back(std::make_unique<DocumentReader>(std::move(_data), _errors));
+	}
+	else
+	{
+		_readers.push_back(top().start_object());
+	}
+}
+
+void ResponseReader::add_member_key(std::string_view key)
+{
+	top().add_member_key(key);
+}
+
+void ResponseReader::end_object()
+{
+	top().end();
+	_readers.pop_back();
+}
+
+void ResponseReader::start_array()
+{
+	_readers.push_back(top().start_array());
+}
+
+void ResponseReader::end_array()
+{
+	top().end();
+	_readers.pop_back();
+}
+
+void ResponseReader::add_null()
+{
+	top().add_null();
+}
+
+void ResponseReader::add_string(std::string_view value)
+{
+	top().add_string(value);
+}
+
+void ResponseReader::add_enum(std::string_view value)
+{
+	top().add_string(value);
+}
+
+void ResponseReader::add_bool(response::BooleanType value)
+{
+	top().add_bool(value);
+}
+
+void ResponseReader::add_int(response::IntType value)
+{
+	top().add_int(value);
+}
+
+void ResponseReader::add_float(response::FloatType value)
+{
+	top().add_float(value);
+}
+
+void ResponseReader::add_value(response::Value&& value)
+{
+	switch (value.type())
+	{
+		case response::Type::Map:
+		{
+			auto members = value.release<response::MapType>();
+
+			start_object();
+
+			for (auto& entry : members)
+			{
+				add_member_key(entry.first);
+				add_value(std::move(entry.second));
+			}
+
+			end_object();
+			break;
+		}
+
+		case response::Type::List:
+		{
+			auto elements = value.release<response::ListType>();
+
+			start_array();
+
+			for (auto& entry : elements)
+			{
+				add_value(std::move(entry));
+			}
+
+			end_array();
+			break;
+		}
+
+		case response::Type::String:
+		case response::Type::EnumValue:
+		{
+			add_string(value.get<const response::StringType&>());
+			break;
+		}
+
+		case response::Type::Boolean:
+		{
+			add_bool(value.get<response::BooleanType>());
+			break;
+		}
+
+		case response::Type::Int:
+		{
+			add_int(value.get<response::IntType>());
+			break;
+		}
+
+		case response::Type::Float:
+		{
+			add_float(value.get<response::FloatType>());
+			break;
+		}
+
+		case response::Type::Scalar:
+		{
+			add_value(value.release<response::ScalarType>());
+			break;
+		}
+
+		default:
+		{
+			add_null();
+			break;
+		}
+	}
+}
+
+response::Value ResponseReader::getErrors() noexcept
+{
+	return std::move(_errors);
+}
+
+response::Value buildRequest(std::string_view requestText, std::string_view operationName, response::Value&& variables)
+{
+	response::Value request(response::Type::Map);
+
+	request.reserve(3);
+	request.emplace_back("query", response::Value(response::StringType{ requestText }));
+	request.emplace_back("operationName", response::Value(response::StringType{ operationName }));
+	request.emplace_back("variables", std::move(variables));
+
+	return request;
+}
+
+} /* namespace graphql::client */
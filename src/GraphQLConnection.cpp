@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <graphqlservice/GraphQLConnection.h>
+
+#include <sstream>
+
+namespace graphql::service {
+
+response::Value Cursor::fromOffset(size_t offset)
+{
+	// Store the offset in big-endian order without any leading zero bytes.
+	const auto value = static_cast<uint64_t>(offset);
+	size_t count = 1;
+
+	while (count < sizeof(value) && (value >> (count * 8)) != 0)
+	{
+		++count;
+	}
+
+	response::IdType encoded;
+
+	encoded.reserve(count + 1);
+	encoded.push_back(offsetTag);
+
+	while (count > 0)
+	{
+		encoded.push_back(static_cast<uint8_t>(value >> (--count * 8)));
+	}
+
+	return response::Value(Base64::toBase64(encoded));
+}
+
+size_t Cursor::toOffset(const response::Value& cursor)
+{
+	const auto decoded = decode(cursor, offsetTag);
+
+	if (decoded.size() < 2 || decoded.size() > sizeof(uint64_t) + 1)
+	{
+		throw schema_exception({ "invalid cursor" });
+	}
+
+	uint64_t offset = 0;
+
+	for (size_t i = 1; i < decoded.size(); ++i)
+	{
+		offset = (offset << 8) | decoded[i];
+	}
+
+	return static_cast<size_t>(offset);
+}
+
+response::Value Cursor::fromId(const response::IdType& id)
+{
+	return response::Value(Base64::toBase64(id));
+}
+
+response::IdType Cursor::toId(const response::Value& cursor)
+{
+	if (cursor.type() != response::Type::String)
+	{
+		throw schema_exception({ "invalid cursor" });
+	}
+
+	const auto& encoded = cursor.get<const response::StringType&>();
+
+	return Base64::fromBase64(encoded.c_str(), encoded.size());
+}
+
+response::Value Cursor::fromKey(const response::IdType& key)
+{
+	response::IdType encoded;
+
+	encoded.reserve(key.size() + 1);
+	encoded.push_back(keyTag);
+
+	for (const auto byte : key)
+	{
+		encoded.push_back(byte);
+	}
+
+	return response::Value(Base64::toBase64(encoded));
+}
+
+response::IdType Cursor::toKey(const response::Value& cursor)
+{
+	const auto decoded = decode(cursor, keyTag);
+
+	return response::IdType(decoded.data() + 1, decoded.size() - 1);
+}
+
+response::IdType Cursor::decode(const response::Value& cursor, uint8_t tag)
+{
+	if (cursor.type() != response::Type::String)
+	{
+		throw schema_exception({ "invalid cursor" });
+	}
+
+	const auto& encoded = cursor.get<const response::StringType&>();
+	auto decoded = Base64::fromBase64(encoded.c_str(), encoded.size());
+
+	if (decoded.empty() || decoded[0] != tag)
+	{
+		throw schema_exception({ "invalid cursor" });
+	}
+
+	return decoded;
+}
+
+ConnectionSlice ConnectionSlice::limit(size_t /*count*/, size_t begin, size_t end, const ConnectionArguments& arguments)
+{
+	bool hasPreviousPage = false;
+	bool hasNextPage = false;
+
+	if (arguments.first)
+	{
+		if (*arguments.first < 0)
+		{
+			std::ostringstream error;
+
+			error << "Invalid argument: first value: " << *arguments.first;
+			throw schema_exception({ error.str() });
+		}
+
+		if (end - begin > static_cast<size_t>(*arguments.first))
+		{
+			end = begin + static_cast<size_t>(*arguments.first);
+			hasNextPage = true;
+		}
+	}
+
+	if (arguments.last)
+	{
+		if (*arguments.last < 0)
+		{
+			std::ostringstream error;
+
+			error << "Invalid argument: last value: " << *arguments.last;
+			throw schema_exception({ error.str() });
+		}
+
+		if (end - begin > static_cast<size_t>(*arguments.last))
+		{
+			begin = end - static_cast<size_t>(*arguments.last);
+			hasPreviousPage = true;
+		}
+	}
+
+	return { begin, end, hasPreviousPage, hasNextPage };
+}
+
+ConnectionSlice sliceByOffset(size_t count, const ConnectionArguments& arguments)
+{
+	size_t begin = 0;
+	size_t end = count;
+
+	if (arguments.after)
+	{
+		const auto after = Cursor::toOffset(*arguments.after);
+
+		begin = (after < count ? after + 1 : count);
+	}
+
+	if (arguments.before)
+	{
+		end = std::max(begin, std::min(Cursor::toOffset(*arguments.before), count));
+	}
+
+	return ConnectionSlice::limit(count, begin, end, arguments);
+}
+
+} /* namespace graphql::service */
@@ -0,0 +1,517 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <graphqlservice/GraphQLMetrics.h>
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace graphql::service {
+
+size_t MetricsHistogram::getBucket(uint64_t microseconds) noexcept
+{
+	if (microseconds < subBucketCount)
+	{
+		return static_cast<size_t>(microseconds);
+	}
+
+	size_t exponent = 0;
+
+	for (auto value = microseconds; value > 1; value >>= 1)
+	{
+		++exponent;
+	}
+
+	// The first sub-bucket of each power of two starts after the linear buckets below subBucketCount.
+	const size_t bucket = (exponent - subBucketBits + 1) * subBucketCount
+		+ static_cast<size_t>((microseconds >> (exponent - subBucketBits)) & (subBucketCount - 1));
+
+	return std::min(bucket, bucketCount);
+}
+
+uint64_t MetricsHistogram::getUpperBound(size_t bucket) noexcept
+{
+	if (bucket < subBucketCount)
+	{
+		return bucket + 1;
+	}
+
+	const size_t exponent = bucket / subBucketCount + subBucketBits - 1;
+	const size_t shift = exponent - subBucketBits;
+
+	return (static_cast<uint64_t>(subBucketCount + bucket % subBucketCount) << shift) + (uint64_t(1) << shift);
+}
+
+struct Metrics::Entry
+{
+	Entry(std::string_view first, std::string_view second, size_t hash)
+		: first(first)
+		, second(second)
+		, hash(hash)
+	{
+	}
+
+	void record(std::chrono::steady_clock::duration duration, size_t errorCount) noexcept
+	{
+		const auto microseconds = static_cast<uint64_t>(std::max<std::chrono::microseconds::rep>(0,
+			std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+		const auto bucket = MetricsHistogram::getBucket(microseconds);
+
+		calls.fetch_add(1, std::memory_order_relaxed);
+
+		if (errorCount > 0)
+		{
+			errors.fetch_add(errorCount, std::memory_order_relaxed);
+		}
+
+		if (bucket < MetricsHistogram::bucketCount)
+		{
+			buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		sumMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+	}
+
+	const std::string first;
+	const std::string second;
+	const size_t hash;
+
+	// The number of calls doubles as the count for the histogram.
+	std::atomic<uint64_t> calls {};
+	std::atomic<uint64_t> errors {};
+	std::array<std::atomic<uint64_t>, MetricsHistogram::bucketCount> buckets {};
+	std::atomic<uint64_t> sumMicroseconds {};
+};
+
+namespace {
+
+// An open addressing hash table which only grows until it's destroyed, so a slot can be claimed with a
+// single compare-exchange and a lookup never needs to take a lock.
+template <typename Entry>
+class MetricsTable
+{
+public:
+	explicit MetricsTable(size_t capacity)
+		: _capacity(capacity)
+		, _slots(std::make_unique<std::atomic<Entry*>[]>(capacity))
+	{
+	}
+
+	~MetricsTable()
+	{
+		for (size_t i = 0; i < _capacity; ++i)
+		{
+			delete _slots[i].load(std::memory_order_acquire);
+		}
+	}
+
+	// Find or add the entry for these labels, or return nullptr if the table is full.
+	Entry* find(std::string_view first, std::string_view second)
+	{
+		const size_t hash = std::hash<std::string_view>()(first) * 31 + std::hash<std::string_view>()(second);
+
+		for (size_t probe = 0; probe < _capacity; ++probe)
+		{
+			auto& slot = _slots[(hash + probe) & (_capacity - 1)];
+			auto entry = slot.load(std::memory_order_acquire);
+
+			if (!entry)
+			{
+				auto created = std::make_unique<Entry>(first, second, hash);
+
+				if (slot.compare_exchange_strong(entry, created.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					return created.release();
+				}
+
+				// Another thread on the same shard claimed this slot first, so entry is the one it added.
+			}
+
+			if (entry->hash == hash && entry->first == first && entry->second == second)
+			{
+				return entry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void collect(std::map<std::pair<std::string_view, std::string_view>, MetricsSeries>& series, bool reset) const
+	{
+		const auto read = [reset](std::atomic<uint64_t>& counter) noexcept {
+			return (reset
+				? counter.exchange(0, std::memory_order_relaxed)
+				: counter.load(std::memory_order_relaxed));
+		};
+
+		for (size_t i = 0; i < _capacity; ++i)
+		{
+			const auto entry = _slots[i].load(std::memory_order_acquire);
+
+			if (!entry)
+			{
+				continue;
+			}
+
+			auto& merged = series[{ entry->first, entry->second }];
+
+			merged.calls += read(entry->calls);
+			merged.errors += read(entry->errors);
+			merged.latency.sumMicroseconds += read(entry->sumMicroseconds);
+
+			for (size_t bucket = 0; bucket < MetricsHistogram::bucketCount; ++bucket)
+			{
+				merged.latency.buckets[bucket] += read(entry->buckets[bucket]);
+			}
+		}
+	}
+
+private:
+	const size_t _capacity;
+	const std::unique_ptr<std::atomic<Entry*>[]> _slots;
+};
+
+size_t getCapacity(size_t capacity)
+{
+	size_t result = 1;
+
+	while (result < capacity)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
+std::vector<MetricsSeries> getSeries(std::map<std::pair<std::string_view, std::string_view>, MetricsSeries>&& series)
+{
+	std::vector<MetricsSeries> result;
+
+	result.reserve(series.size());
+
+	for (auto& entry : series)
+	{
+		entry.second.first = std::string(entry.first.first);
+		entry.second.second = std::string(entry.first.second);
+
+		// The counters are read one at a time, so make sure the total is consistent with the buckets.
+		uint64_t count = 0;
+
+		for (const auto bucket : entry.second.latency.buckets)
+		{
+			count += bucket;
+		}
+
+		entry.second.latency.count = std::max(count, entry.second.calls);
+		result.push_back(std::move(entry.second));
+	}
+
+	return result;
+}
+
+} /* namespace */
+
+struct Metrics::Shard
+{
+	explicit Shard(size_t capacity)
+		: fields(capacity)
+		, operations(capacity)
+	{
+	}
+
+	MetricsTable<Entry> fields;
+	MetricsTable<Entry> operations;
+};
+
+Metrics::Metrics(size_t shardCount, size_t capacity)
+	: _shards([shardCount, capacity]() {
+		std::vector<std::unique_ptr<Shard>> shards(std::max<size_t>(1, shardCount ? shardCount : std::thread::hardware_concurrency()));
+
+		for (auto& shard : shards)
+		{
+			shard = std::make_unique<Shard>(getCapacity(capacity));
+		}
+
+		return shards;
+	}())
+{
+}
+
+Metrics::~Metrics() = default;
+
+Metrics::Shard& Metrics::getShard() const noexcept
+{
+	// Spread the threads across the shards in the order they first record anything.
+	static std::atomic<size_t> nextThread = 0;
+	thread_local const size_t threadIndex = nextThread.fetch_add(1, std::memory_order_relaxed);
+
+	return *_shards[threadIndex % _shards.size()];
+}
+
+void Metrics::recordField(std::string_view parentType, std::string_view fieldName,
+	std::chrono::steady_clock::duration duration, bool error)
+{
+	const auto entry = getShard().fields.find(parentType, fieldName);
+
+	if (!entry)
+	{
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	entry->record(duration, error ? 1 : 0);
+}
+
+void Metrics::recordOperation(std::string_view operationType, std::string_view operationName,
+	std::chrono::steady_clock::duration duration, size_t errors)
+{
+	const auto entry = getShard().operations.find(operationType, operationName);
+
+	if (!entry)
+	{
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	entry->record(duration, errors);
+}
+
+MetricsSnapshot Metrics::snapshot(bool reset)
+{
+	std::map<std::pair<std::string_view, std::string_view>, MetricsSeries> fields;
+	std::map<std::pair<std::string_view, std::string_view>, MetricsSeries> operations;
+
+	for (const auto& shard : _shards)
+	{
+		shard->fields.collect(fields, reset);
+		shard->operations.collect(operations, reset);
+	}
+
+	MetricsSnapshot result;
+
+	result.fields = getSeries(std::move(fields));
+	result.operations = getSeries(std::move(operations));
+	result.dropped = (reset
+		? _dropped.exchange(0, std::memory_order_relaxed)
+		: _dropped.load(std::memory_order_relaxed));
+
+	return result;
+}
+
+namespace {
+
+// Only count the fields and the total time of the operation, the paths aren't needed for aggregates.
+class MetricsListener : public OperationListener
+{
+public:
+	MetricsListener(Metrics& metrics, std::string_view operationType, std::string_view operationName)
+		: OperationListener(false)
+		, _metrics(metrics)
+		, _operationType(operationType)
+		, _operationName(operationName)
+		, _start(std::chrono::steady_clock::now())
+	{
+	}
+
+	void endField(const ResponsePath& /*path*/, std::string_view parentType, std::string_view fieldName,
+		std::chrono::steady_clock::duration duration, bool error) override
+	{
+		_metrics.recordField(parentType, fieldName, duration, error);
+
+		if (error)
+		{
+			_errors.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void endOperation(response::Value& /*extensions*/) override
+	{
+		_metrics.recordOperation(_operationType, _operationName, std::chrono::steady_clock::now() - _start,
+			_errors.load(std::memory_order_relaxed));
+	}
+
+private:
+	// The Request holds onto the Instrumentation until the operation is done.
+	Metrics& _metrics;
+	const std::string _operationType;
+	const std::string _operationName;
+	const std::chrono::steady_clock::time_point _start;
+	std::atomic<size_t> _errors = 0;
+};
+
+void writeLabelValue(std::ostringstream& output, std::string_view value)
+{
+	output << '"';
+
+	for (const auto c : value)
+	{
+		switch (c)
+		{
+			case '\\':
+				output << R"(\\)";
+				break;
+
+			case '"':
+				output << R"(\")";
+				break;
+
+			case '\n':
+				output << R"(\n)";
+				break;
+
+			default:
+				output << c;
+				break;
+		}
+	}
+
+	output << '"';
+}
+
+// Write a whole number of microseconds as seconds without losing any precision.
+void writeSeconds(std::ostringstream& output, uint64_t microseconds)
+{
+	output << (microseconds / 1000000);
+
+	auto fraction = microseconds % 1000000;
+
+	if (fraction == 0)
+	{
+		return;
+	}
+
+	int digits = 6;
+
+	while (fraction % 10 == 0)
+	{
+		fraction /= 10;
+		--digits;
+	}
+
+	output << '.' << std::setw(digits) << std::setfill('0') << fraction;
+}
+
+struct MetricsFamily
+{
+	std::string_view name;
+	std::string_view firstLabel;
+	std::string_view secondLabel;
+	std::string_view calls;
+	std::string_view errors;
+	std::string_view duration;
+};
+
+void writeFamily(std::ostringstream& output, std::string_view prefix, const MetricsFamily& family,
+	const std::vector<MetricsSeries>& series)
+{
+	const auto writeLabels = [&output, &family](const MetricsSeries& entry) {
+		output << '{' << family.firstLabel << '=';
+		writeLabelValue(output, entry.first);
+		output << ',' << family.secondLabel << '=';
+		writeLabelValue(output, entry.second);
+	};
+
+	output << "# HELP " << prefix << '_' << family.name << "_calls_total " << family.calls << '\n'
+		<< "# TYPE " << prefix << '_' << family.name << "_calls_total counter\n";
+
+	for (const auto& entry : series)
+	{
+		output << prefix << '_' << family.name << "_calls_total";
+		writeLabels(entry);
+		output << "} " << entry.calls << '\n';
+	}
+
+	output << "# HELP " << prefix << '_' << family.name << "_errors_total " << family.errors << '\n'
+		<< "# TYPE " << prefix << '_' << family.name << "_errors_total counter\n";
+
+	for (const auto& entry : series)
+	{
+		output << prefix << '_' << family.name << "_errors_total";
+		writeLabels(entry);
+		output << "} " << entry.errors << '\n';
+	}
+
+	output << "# HELP " << prefix << '_' << family.name << "_duration_seconds " << family.duration << '\n'
+		<< "# TYPE " << prefix << '_' << family.name << "_duration_seconds histogram\n";
+
+	for (const auto& entry : series)
+	{
+		uint64_t cumulative = 0;
+
+		for (size_t bucket = 0; bucket < MetricsHistogram::bucketCount; ++bucket)
+		{
+			cumulative += entry.latency.buckets[bucket];
+			output << prefix << '_' << family.name << "_duration_seconds_bucket";
+			writeLabels(entry);
+			output << ",le=\"";
+			writeSeconds(output, MetricsHistogram::getUpperBound(bucket));
+			output << "\"} " << cumulative << '\n';
+		}
+
+		output << prefix << '_' << family.name << "_duration_seconds_bucket";
+		writeLabels(entry);
+		output << ",le=\"+Inf\"} " << entry.latency.count << '\n';
+
+		output << prefix << '_' << family.name << "_duration_seconds_sum";
+		writeLabels(entry);
+		output << "} ";
+		writeSeconds(output, entry.latency.sumMicroseconds);
+		output << '\n';
+
+		output << prefix << '_' << family.name << "_duration_seconds_count";
+		writeLabels(entry);
+		output << "} " << entry.latency.count << '\n';
+	}
+}
+
+} /* namespace */
+
+std::shared_ptr<OperationListener> Metrics::beginOperation(const std::shared_ptr<RequestState>& /*state*/,
+	std::string_view operationType, std::string_view operationName, const peg::QuerySignature* signature)
+{
+	if (!signature)
+	{
+		return std::make_shared<MetricsListener>(*this, operationType, operationName);
+	}
+
+	std::string label(operationName);
+
+	label.push_back('#');
+	label.append(signature->hash.toString());
+
+	return std::make_shared<MetricsListener>(*this, operationType, label);
+}
+
+std::string toPrometheus(const MetricsSnapshot& snapshot, std::string_view prefix)
+{
+	std::ostringstream output;
+
+	writeFamily(output, prefix, {
+			"field",
+			"type",
+			"field",
+			"The number of times each field was resolved.",
+			"The number of times each field threw an exception.",
+			"The time from calling each resolver until its value was resolved.",
+		}, snapshot.fields);
+	writeFamily(output, prefix, {
+			"operation",
+			"operation",
+			"name",
+			"The number of times each named operation was executed.",
+			"The number of fields which threw an exception in each named operation.",
+			"The time to execute each named operation.",
+		}, snapshot.operations);
+
+	output << "# HELP " << prefix << "_metrics_dropped_total The number of calls which were not counted because a shard was full.\n"
+		<< "# TYPE " << prefix << "_metrics_dropped_total counter\n"
+		<< prefix << "_metrics_dropped_total " << snapshot.dropped << '\n';
+
+	return output.str();
+}
+
+} /* namespace graphql::service */
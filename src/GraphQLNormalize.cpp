@@ -0,0 +1,661 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <graphqlservice/GraphQLNormalize.h>
+#include <graphqlservice/GraphQLGrammar.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace graphql::peg {
+
+namespace {
+
+// Prints the canonical form of the executable definitions in a document. Lists which don't affect
+// the meaning of the query are printed into separate strings and sorted before they're joined.
+class QueryPrinter
+{
+public:
+	explicit QueryPrinter(bool hideLiterals);
+
+	std::string print(const ast_node& root, std::string_view operationName);
+
+private:
+	void printOperation(const ast_node& operation, std::string& output);
+	void printFragment(const ast_node& fragment, std::string& output);
+	void printVariable(const ast_node& variable, std::string& output);
+	void printType(const ast_node& type, std::string& output);
+	void printDirectives(const ast_node& directives, std::string& output);
+	void printArguments(const ast_node& arguments, std::string& output);
+	void printValue(const ast_node& value, std::string& output);
+	void printString(std::string_view value, std::string& output);
+	void printSelectionSet(const ast_node& selectionSet, std::string& output);
+
+	static void appendSorted(std::vector<std::string>& items, std::string_view separator, std::string& output);
+
+	const bool _hideLiterals;
+	std::set<std::string_view> _fragmentSpreads;
+};
+
+QueryPrinter::QueryPrinter(bool hideLiterals)
+	: _hideLiterals(hideLiterals)
+{
+}
+
+std::string QueryPrinter::print(const ast_node& root, std::string_view operationName)
+{
+	std::vector<std::string> operations;
+	std::map<std::string_view, const ast_node*> fragmentDefinitions;
+
+	for (const auto& child : root.children)
+	{
+		if (child->is_type<operation_definition>())
+		{
+			std::string_view name;
+
+			on_first_child<operation_name>(*child,
+				[&name](const ast_node& operationName)
+				{
+					name = operationName.string_view();
+				});
+
+			if (operationName.empty() || name == operationName)
+			{
+				operations.emplace_back();
+				printOperation(*child, operations.back());
+			}
+		}
+		else if (child->is_type<fragment_definition>())
+		{
+			on_first_child<fragment_name>(*child,
+				[&fragmentDefinitions, &child](const ast_node& name)
+				{
+					fragmentDefinitions.emplace(name.string_view(), child.get());
+				});
+		}
+	}
+
+	std::string result;
+
+	appendSorted(operations, " ", result);
+
+	// Printing a fragment may add more spreads, so keep going until all of them have been printed.
+	std::map<std::string_view, std::string> fragments;
+
+	while (fragments.size() < _fragmentSpreads.size())
+	{
+		const auto spreads = _fragmentSpreads;
+
+		for (const auto name : spreads)
+		{
+			if (fragments.find(name) != fragments.end())
+			{
+				continue;
+			}
+
+			auto& output = fragments[name];
+			const auto itr = fragmentDefinitions.find(name);
+
+			if (itr != fragmentDefinitions.end())
+			{
+				printFragment(*itr->second, output);
+			}
+		}
+	}
+
+	for (const auto& fragment : fragments)
+	{
+		if (!fragment.second.empty())
+		{
+			result.push_back(' ');
+			result.append(fragment.second);
+		}
+	}
+
+	return result;
+}
+
+void QueryPrinter::printOperation(const ast_node& operation, std::string& output)
+{
+	std::string_view operationType = "query";
+	std::vector<std::string> variables;
+
+	on_first_child<operation_type>(operation,
+		[&operationType](const ast_node& child)
+		{
+			operationType = child.string_view();
+		});
+
+	output.append(operationType);
+
+	on_first_child<operation_name>(operation,
+		[&output](const ast_node& child)
+		{
+			output.push_back(' ');
+			output.append(child.string_view());
+		});
+
+	for_each_child<variable>(operation,
+		[this, &variables](const ast_node& child)
+		{
+			variables.emplace_back();
+			printVariable(child, variables.back());
+		});
+
+	if (!variables.empty())
+	{
+		output.push_back('(');
+		appendSorted(variables, ",", output);
+		output.push_back(')');
+	}
+
+	on_first_child<directives>(operation,
+		[this, &output](const ast_node& child)
+		{
+			printDirectives(child, output);
+		});
+
+	on_first_child<selection_set>(operation,
+		[this, &output](const ast_node& child)
+		{
+			printSelectionSet(child, output);
+		});
+}
+
+void QueryPrinter::printFragment(const ast_node& fragment, std::string& output)
+{
+	output.append("fragment ");
+
+	on_first_child<fragment_name>(fragment,
+		[&output](const ast_node& child)
+		{
+			output.append(child.string_view());
+		});
+
+	on_first_child<type_condition>(fragment,
+		[&output](const ast_node& child)
+		{
+			output.append(" on ");
+			output.append(child.children.front()->string_view());
+		});
+
+	on_first_child<directives>(fragment,
+		[this, &output](const ast_node& child)
+		{
+			printDirectives(child, output);
+		});
+
+	on_first_child<selection_set>(fragment,
+		[this, &output](const ast_node& child)
+		{
+			printSelectionSet(child, output);
+		});
+}
+
+void QueryPrinter::printVariable(const ast_node& variable, std::string& output)
+{
+	for (const auto& child : variable.children)
+	{
+		if (child->is_type<variable_name>())
+		{
+			output.append(child->string_view());
+			output.push_back(':');
+		}
+		else if (child->is_type<default_value>())
+		{
+			output.push_back('=');
+			printValue(*child->children.front(), output);
+		}
+		else
+		{
+			printType(*child, output);
+		}
+	}
+}
+
+void QueryPrinter::printType(const ast_node& type, std::string& output)
+{
+	if (type.is_type<list_type>())
+	{
+		output.push_back('[');
+		printType(*type.children.front(), output);
+		output.push_back(']');
+	}
+	else if (type.is_type<nonnull_type>())
+	{
+		printType(*type.children.front(), output);
+		output.push_back('!');
+	}
+	else
+	{
+		output.append(type.string_view());
+	}
+}
+
+void QueryPrinter::printDirectives(const ast_node& directives, std::string& output)
+{
+	std::vector<std::string> items;
+
+	for (const auto& directive : directives.children)
+	{
+		auto& item = items.emplace_back("@");
+
+		for (const auto& child : directive->children)
+		{
+			if (child->is_type<directive_name>())
+			{
+				item.append(child->string_view());
+			}
+			else if (child->is_type<arguments>())
+			{
+				printArguments(*child, item);
+			}
+		}
+	}
+
+	appendSorted(items, "", output);
+}
+
+void QueryPrinter::printArguments(const ast_node& arguments, std::string& output)
+{
+	std::vector<std::string> items;
+
+	for (const auto& argument : arguments.children)
+	{
+		auto& item = items.emplace_back(argument->children.front()->string_view());
+
+		item.push_back(':');
+		printValue(*argument->children.back(), item);
+	}
+
+	output.push_back('(');
+	appendSorted(items, ",", output);
+	output.push_back(')');
+}
+
+void QueryPrinter::printValue(const ast_node& value, std::string& output)
+{
+	if (value.is_type<variable_value>()
+		|| value.is_type<enum_value>())
+	{
+		output.append(value.string_view());
+	}
+	else if (value.is_type<integer_value>()
+		|| value.is_type<float_value>())
+	{
+		if (_hideLiterals)
+		{
+			output.push_back('0');
+		}
+		else
+		{
+			output.append(value.string_view());
+		}
+	}
+	else if (value.is_type<string_value>())
+	{
+		if (_hideLiterals)
+		{
+			output.append(R"("")");
+		}
+		else
+		{
+			printString(value.unescaped, output);
+		}
+	}
+	else if (value.is_type<true_keyword>())
+	{
+		output.append("true");
+	}
+	else if (value.is_type<false_keyword>())
+	{
+		output.append("false");
+	}
+	else if (value.is_type<null_keyword>())
+	{
+		output.append("null");
+	}
+	else if (value.is_type<list_value>())
+	{
+		output.push_back('[');
+
+		if (!_hideLiterals)
+		{
+			bool firstValue = true;
+
+			for (const auto& child : value.children)
+			{
+				if (!firstValue)
+				{
+					output.push_back(',');
+				}
+
+				printValue(*child, output);
+				firstValue = false;
+			}
+		}
+
+		output.push_back(']');
+	}
+	else if (value.is_type<object_value>())
+	{
+		output.push_back('{');
+
+		if (!_hideLiterals)
+		{
+			std::vector<std::string> fields;
+
+			for (const auto& field : value.children)
+			{
+				auto& item = fields.emplace_back(field->children.front()->string_view());
+
+				item.push_back(':');
+				printValue(*field->children.back(), item);
+			}
+
+			appendSorted(fields, ",", output);
+		}
+
+		output.push_back('}');
+	}
+}
+
+// Print block strings and strings with escape sequences the same way, using the shortest escapes.
+void QueryPrinter::printString(std::string_view value, std::string& output)
+{
+	constexpr char hexDigits[] = "0123456789ABCDEF";
+
+	output.push_back('"');
+
+	for (const auto c : value)
+	{
+		switch (c)
+		{
+			case '"':
+				output.append(R"(\")");
+				break;
+
+			case '\\':
+				output.append(R"(\\)");
+				break;
+
+			case '\b':
+				output.append(R"(\b)");
+				break;
+
+			case '\f':
+				output.append(R"(\f)");
+				break;
+
+			case '\n':
+				output.append(R"(\n)");
+				break;
+
+			case '\r':
+				output.append(R"(\r)");
+				break;
+
+			case '\t':
+				output.append(R"(\t)");
+				break;
+
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					output.append(R"(\u00)");
+					output.push_back(hexDigits[(c >> 4) & 0xF]);
+					output.push_back(hexDigits[c & 0xF]);
+				}
+				else
+				{
+					output.push_back(c);
+				}
+				break;
+		}
+	}
+
+	output.push_back('"');
+}
+
+void QueryPrinter::printSelectionSet(const ast_node& selectionSet, std::string& output)
+{
+	bool firstSelection = true;
+
+	output.push_back('{');
+
+	for (const auto& selection : selectionSet.children)
+	{
+		if (!firstSelection)
+		{
+			output.push_back(' ');
+		}
+
+		firstSelection = false;
+
+		if (selection->is_type<field>())
+		{
+			for (const auto& child : selection->children)
+			{
+				if (child->is_type<alias>())
+				{
+					output.append(child->children.front()->string_view());
+					output.push_back(':');
+				}
+				else if (child->is_type<field_name>())
+				{
+					output.append(child->string_view());
+				}
+				else if (child->is_type<arguments>())
+				{
+					printArguments(*child, output);
+				}
+				else if (child->is_type<directives>())
+				{
+					printDirectives(*child, output);
+				}
+				else if (child->is_type<selection_set>())
+				{
+					printSelectionSet(*child, output);
+				}
+			}
+		}
+		else if (selection->is_type<fragment_spread>())
+		{
+			output.append("...");
+
+			for (const auto& child : selection->children)
+			{
+				if (child->is_type<fragment_name>())
+				{
+					output.append(child->string_view());
+					_fragmentSpreads.insert(child->string_view());
+				}
+				else if (child->is_type<directives>())
+				{
+					printDirectives(*child, output);
+				}
+			}
+		}
+		else if (selection->is_type<inline_fragment>())
+		{
+			output.append("...");
+
+			for (const auto& child : selection->children)
+			{
+				if (child->is_type<type_condition>())
+				{
+					output.append(" on ");
+					output.append(child->children.front()->string_view());
+				}
+				else if (child->is_type<directives>())
+				{
+					printDirectives(*child, output);
+				}
+				else if (child->is_type<selection_set>())
+				{
+					printSelectionSet(*child, output);
+				}
+			}
+		}
+	}
+
+	output.push_back('}');
+}
+
+void QueryPrinter::appendSorted(std::vector<std::string>& items, std::string_view separator, std::string& output)
+{
+	std::sort(items.begin(), items.end());
+
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		if (i > 0)
+		{
+			output.append(separator);
+		}
+
+		output.append(items[i]);
+	}
+}
+
+uint64_t rotateLeft(uint64_t value, int bits) noexcept
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t finalMix(uint64_t value) noexcept
+{
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+
+	return value;
+}
+
+uint64_t readBlock(const char* data) noexcept
+{
+	uint64_t block = 0;
+
+	// Read the bytes in little-endian order so the hash is the same on every platform.
+	for (int i = 7; i >= 0; --i)
+	{
+		block = (block << 8) | static_cast<uint8_t>(data[i]);
+	}
+
+	return block;
+}
+
+} /* namespace */
+
+std::string QueryHash::toString() const
+{
+	constexpr char hexDigits[] = "0123456789abcdef";
+	std::string result(32, '0');
+
+	for (size_t i = 0; i < 16; ++i)
+	{
+		result[15 - i] = hexDigits[(high >> (i * 4)) & 0xF];
+		result[31 - i] = hexDigits[(low >> (i * 4)) & 0xF];
+	}
+
+	return result;
+}
+
+std::string normalizeQuery(const ast_node& root, std::string_view operationName, bool hideLiterals)
+{
+	return QueryPrinter(hideLiterals).print(root, operationName);
+}
+
+// MurmurHash3_x64_128 by Austin Appleby, which is in the public domain, with a seed of 0.
+QueryHash hashQuery(std::string_view text) noexcept
+{
+	constexpr uint64_t c1 = 0x87c37b91114253d5ULL;
+	constexpr uint64_t c2 = 0x4cf5ad432745937fULL;
+	const size_t blockCount = text.size() / 16;
+	uint64_t h1 = 0;
+	uint64_t h2 = 0;
+
+	for (size_t i = 0; i < blockCount; ++i)
+	{
+		uint64_t k1 = readBlock(text.data() + i * 16);
+		uint64_t k2 = readBlock(text.data() + i * 16 + 8);
+
+		k1 *= c1;
+		k1 = rotateLeft(k1, 31);
+		k1 *= c2;
+		h1 ^= k1;
+
+		h1 = rotateLeft(h1, 27);
+		h1 += h2;
+		h1 = h1 * 5 + 0x52dce729;
+
+		k2 *= c2;
+		k2 = rotateLeft(k2, 33);
+		k2 *= c1;
+		h2 ^= k2;
+
+		h2 = rotateLeft(h2, 31);
+		h2 += h1;
+		h2 = h2 * 5 + 0x38495ab5;
+	}
+
+	const auto tail = text.data() + blockCount * 16;
+	const size_t tailSize = text.size() & 15;
+	uint64_t k1 = 0;
+	uint64_t k2 = 0;
+
+	for (size_t i = tailSize; i > 8; --i)
+	{
+		k2 ^= uint64_t(static_cast<uint8_t>(tail[i - 1])) << ((i - 9) * 8);
+	}
+
+	if (tailSize > 8)
+	{
+		k2 *= c2;
+		k2 = rotateLeft(k2, 33);
+		k2 *= c1;
+		h2 ^= k2;
+	}
+
+	for (size_t i = std::min<size_t>(tailSize, 8); i > 0; --i)
+	{
+		k1 ^= uint64_t(static_cast<uint8_t>(tail[i - 1])) << ((i - 1) * 8);
+	}
+
+	if (tailSize > 0)
+	{
+		k1 *= c1;
+		k1 = rotateLeft(k1, 31);
+		k1 *= c2;
+		h1 ^= k1;
+	}
+
+	h1 ^= text.size();
+	h2 ^= text.size();
+
+	h1 += h2;
+	h2 += h1;
+
+	h1 = finalMix(h1);
+	h2 = finalMix(h2);
+
+	h1 += h2;
+	h2 += h1;
+
+	return { h1, h2 };
+}
+
+QuerySignature getQuerySignature(const ast_node& root, std::string_view operationName, bool hideLiterals)
+{
+	QuerySignature signature { normalizeQuery(root, operationName, hideLiterals), {} };
+
+	signature.hash = hashQuery(signature.text);
+
+	return signature;
+}
+
+} /* namespace graphql::peg */
@@ -3,12 +3,166 @@
 
 #include <graphqlservice/GraphQLResponse.h>
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <variant>
 #include <optional>
 
 namespace graphql::response {
 
+IdType::IdType(size_t count, uint8_t value /*= 0*/)
+{
+	resize(count, value);
+}
+
+IdType::IdType(std::initializer_list<uint8_t> values)
+	: IdType(values.begin(), values.size())
+{
+}
+
+IdType::IdType(const uint8_t* data, size_t count)
+{
+	reserve(count);
+
+	if (count > 0)
+	{
+		std::memcpy(this->data(), data, count);
+	}
+
+	_size = count;
+}
+
+IdType::IdType(const IdType& other)
+	: IdType(other.data(), other._size)
+{
+}
+
+IdType::IdType(IdType&& other) noexcept
+	: _size(other._size)
+	, _allocated(other._allocated)
+{
+	if (_allocated)
+	{
+		_heap = other._heap;
+		other._allocated = false;
+	}
+	else if (_size > 0)
+	{
+		std::memcpy(_inline, other._inline, _size);
+	}
+
+	other._size = 0;
+}
+
+IdType::~IdType()
+{
+	release();
+}
+
+IdType& IdType::operator=(const IdType& rhs)
+{
+	if (this != &rhs)
+	{
+		clear();
+		reserve(rhs._size);
+
+		if (rhs._size > 0)
+		{
+			std::memcpy(data(), rhs.data(), rhs._size);
+		}
+
+		_size = rhs._size;
+	}
+
+	return *this;
+}
+
+IdType& IdType::operator=(IdType&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		release();
+		_size = rhs._size;
+		_allocated = rhs._allocated;
+
+		if (_allocated)
+		{
+			_heap = rhs._heap;
+			rhs._allocated = false;
+		}
+		else if (_size > 0)
+		{
+			std::memcpy(_inline, rhs._inline, _size);
+		}
+
+		rhs._size = 0;
+	}
+
+	return *this;
+}
+
+void IdType::reserve(size_t count)
+{
+	if (count <= capacity())
+	{
+		return;
+	}
+
+	HeapData heap { new uint8_t[count], count };
+
+	if (_size > 0)
+	{
+		std::memcpy(heap.data, data(), _size);
+	}
+
+	release();
+	_heap = heap;
+	_allocated = true;
+}
+
+void IdType::resize(size_t count, uint8_t value /*= 0*/)
+{
+	reserve(count);
+
+	if (count > _size)
+	{
+		std::memset(data() + _size, value, count - _size);
+	}
+
+	_size = count;
+}
+
+void IdType::clear() noexcept
+{
+	_size = 0;
+}
+
+void IdType::release() noexcept
+{
+	if (_allocated)
+	{
+		delete[] _heap.data;
+		_allocated = false;
+	}
+}
+
+bool IdType::operator==(const IdType& rhs) const noexcept
+{
+	return _size == rhs._size
+		&& (_size == 0 || std::memcmp(data(), rhs.data(), _size) == 0);
+}
+
+bool IdType::operator!=(const IdType& rhs) const noexcept
+{
+	return !(*this == rhs);
+}
+
+bool IdType::operator<(const IdType& rhs) const noexcept
+{
+	return std::lexicographical_compare(cbegin(), cend(), rhs.cbegin(), rhs.cend());
+}
+
 // Type::Map
 struct MapData
 {
@@ -69,7 +223,7 @@ struct TypedData : std::variant<
 	
 Value::Value(Type type /*= Type::Null*/)
 	: _type(type)
-	, _data(std::make_unique<TypedData>())
+	, _data(std::make_shared<TypedData>())
 {
 	switch (type)
 	{
@@ -116,31 +270,31 @@ Value::~Value()
 
 Value::Value(const char* value)
 	: _type(Type::String)
-	, _data(std::make_unique<TypedData>(TypedData{ StringOrEnumData{ StringType{ value }, false } }))
+	, _data(std::make_shared<TypedData>(TypedData{ StringOrEnumData{ StringType{ value }, false } }))
 {
 }
 
 Value::Value(StringType&& value)
 	: _type(Type::String)
-	, _data(std::make_unique<TypedData>(TypedData{ StringOrEnumData{ std::move(value), false } }))
+	, _data(std::make_shared<TypedData>(TypedData{ StringOrEnumData{ std::move(value), false } }))
 {
 }
 
 Value::Value(BooleanType value)
 	: _type(Type::Boolean)
-	, _data(std::make_unique<TypedData>(TypedData{ value }))
+	, _data(std::make_shared<TypedData>(TypedData{ value }))
 {
 }
 
 Value::Value(IntType value)
 	: _type(Type::Int)
-	, _data(std::make_unique<TypedData>(TypedData{ value }))
+	, _data(std::make_shared<TypedData>(TypedData{ value }))
 {
 }
 
 Value::Value(FloatType value)
 	: _type(Type::Float)
-	, _data(std::make_unique<TypedData>(TypedData{ value }))
+	, _data(std::make_shared<TypedData>(TypedData{ value }))
 {
 }
 
@@ -150,9 +304,11 @@ Value::Value(Value&& other) noexcept
 {
 }
 
+// Copies share the same data until one of them is modified, so copying a value from a static
+// table (like the generated enum values) doesn't allocate anything.
 Value::Value(const Value& other)
 	: _type(other.type())
-	, _data(std::make_unique<TypedData>(other._data ? *other._data : TypedData{}))
+	, _data(other._data)
 {
 }
 
@@ -170,7 +326,7 @@ bool Value::operator==(const Value& rhs) const noexcept
 		return false;
 	}
 
-	return !_data || *_data == *rhs._data;
+	return !_data || _data == rhs._data || *_data == *rhs._data;
 }
 
 bool Value::operator!=(const Value& rhs) const noexcept
@@ -183,9 +339,20 @@ Type Value::type() const noexcept
 	return _data ? _type : Type::Null;
 }
 
+TypedData& Value::mutableData()
+{
+	// Make a private copy before modifying data which is shared with another value.
+	if (_data.use_count() > 1)
+	{
+		_data = std::make_shared<TypedData>(*_data);
+	}
+
+	return *_data;
+}
+
 Value&& Value::from_json() noexcept
 {
-	std::get<std::optional<StringOrEnumData>>(*_data)->from_json = true;
+	std::get<std::optional<StringOrEnumData>>(mutableData())->from_json = true;
 
 	return std::move(*this);
 }
@@ -203,7 +370,7 @@ void Value::reserve(size_t count)
 	{
 		case Type::Map:
 		{
-			auto& mapData = std::get<std::optional<MapData>>(*_data);
+			auto& mapData = std::get<std::optional<MapData>>(mutableData());
 
 			mapData->members.reserve(count);
 			mapData->map.reserve(count);
@@ -212,7 +379,7 @@ void Value::reserve(size_t count)
 
 		case Type::List:
 		{
-			auto& listData = std::get<std::optional<ListData>>(*_data);
+			auto& listData = std::get<std::optional<ListData>>(mutableData());
 
 			listData->list.reserve(count);
 			break;
@@ -253,7 +420,7 @@ void Value::emplace_back(std::string&& name, Value&& value)
 		throw std::logic_error("Invalid call to Value::emplace_back for MapType");
 	}
 
-	auto& mapData = std::get<std::optional<MapData>>(*_data);
+	auto& mapData = std::get<std::optional<MapData>>(mutableData());
 
 	if (mapData->members.find(name) != mapData->members.cend())
 	{
@@ -321,7 +488,7 @@ void Value::emplace_back(Value&& value)
 		throw std::logic_error("Invalid call to Value::emplace_back for ListType");
 	}
 
-	std::get<std::optional<ListData>>(*_data)->list.emplace_back(std::move(value));
+	std::get<std::optional<ListData>>(mutableData())->list.emplace_back(std::move(value));
 }
 
 const Value& Value::operator[](size_t index) const
@@ -343,7 +510,7 @@ void Value::set<StringType>(StringType&& value)
 		throw std::logic_error("Invalid call to Value::set for StringType");
 	}
 
-	std::get<std::optional<StringOrEnumData>>(*_data)->string = std::move(value);
+	std::get<std::optional<StringOrEnumData>>(mutableData())->string = std::move(value);
 }
 
 template <>
@@ -354,7 +521,7 @@ void Value::set<BooleanType>(BooleanType&& value)
 		throw std::logic_error("Invalid call to Value::set for BooleanType");
 	}
 
-	*_data = { value };
+	mutableData() = { value };
 }
 
 template <>
@@ -365,7 +532,7 @@ void Value::set<IntType>(IntType&& value)
 		throw std::logic_error("Invalid call to Value::set for IntType");
 	}
 
-	*_data = { value };
+	mutableData() = { value };
 }
 
 template <>
@@ -376,7 +543,7 @@ void Value::set<FloatType>(FloatType&& value)
 		throw std::logic_error("Invalid call to Value::set for FloatType");
 	}
 
-	*_data = { value };
+	mutableData() = { value };
 }
 
 template <>
@@ -387,7 +554,7 @@ void Value::set<ScalarType>(ScalarType&& value)
 		throw std::logic_error("Invalid call to Value::set for ScalarType");
 	}
 
-	*_data = { ScalarData{ std::move(value) } };
+	mutableData() = { ScalarData{ std::move(value) } };
 }
 
 template <>
@@ -476,7 +643,7 @@ MapType Value::release<MapType>()
 		throw std::logic_error("Invalid call to Value::release for MapType");
 	}
 
-	auto& mapData = std::get<std::optional<MapData>>(*_data);
+	auto& mapData = std::get<std::optional<MapData>>(mutableData());
 	MapType result = std::move(mapData->map);
 
 	mapData->members.clear();
@@ -492,7 +659,7 @@ ListType Value::release<ListType>()
 		throw std::logic_error("Invalid call to Value::release for ListType");
 	}
 
-	ListType result = std::move(std::get<std::optional<ListData>>(*_data)->list);
+	ListType result = std::move(std::get<std::optional<ListData>>(mutableData())->list);
 
 	return result;
 }
@@ -506,7 +673,7 @@ StringType Value::release<StringType>()
 		throw std::logic_error("Invalid call to Value::release for StringType");
 	}
 
-	auto& stringData = std::get<std::optional<StringOrEnumData>>(*_data);
+	auto& stringData = std::get<std::optional<StringOrEnumData>>(mutableData());
 	StringType result = std::move(stringData->string);
 
 	stringData->from_json = false;
@@ -522,7 +689,7 @@ ScalarType Value::release<ScalarType>()
 		throw std::logic_error("Invalid call to Value::release for ScalarType");
 	}
 
-	ScalarType result = std::move(std::get<std::optional<ScalarData>>(*_data)->scalar);
+	ScalarType result = std::move(std::get<std::optional<ScalarData>>(mutableData())->scalar);
 
 	return result;
 }
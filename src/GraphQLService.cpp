@@ -44,6 +44,232 @@ response::Value schema_exception::getErrors() noexcept
 	return errors;
 }
 
+schema_exception schema_exception::fromErrors(response::Value&& errors) noexcept
+{
+	schema_exception result;
+
+	result._errors = std::move(errors);
+
+	return result;
+}
+
+const char* getErrorMessage(const std::exception& ex) noexcept
+{
+	const auto schemaException = dynamic_cast<const schema_exception*>(&ex);
+
+	if (!schemaException)
+	{
+		return ex.what();
+	}
+
+	const auto& errors = schemaException->getErrors();
+
+	if (errors.type() == response::Type::List
+		&& errors.size() > 0
+		&& errors[0].type() == response::Type::Map)
+	{
+		const auto itr = errors[0].find(std::string{ strMessage });
+
+		if (itr != errors[0].get<const response::MapType&>().cend()
+			&& itr->second.type() == response::Type::String)
+		{
+			return itr->second.get<const response::StringType&>().c_str();
+		}
+	}
+
+	return schemaException->what();
+}
+
+MemoryBudget::MemoryBudget(size_t limit) noexcept
+	: _limit(limit)
+{
+}
+
+void MemoryBudget::charge(Category category, size_t bytes, size_t allocations) noexcept
+{
+	const auto index = static_cast<size_t>(category);
+
+	_bytes[index].fetch_add(bytes, std::memory_order_relaxed);
+	_allocations[index].fetch_add(allocations, std::memory_order_relaxed);
+	_total.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryBudget::chargeParseTree(const peg::ast_node& root) noexcept
+{
+	// The tree can be as deep as the query is nested, so walk it with an explicit stack.
+	std::vector<const peg::ast_node*> nodes { &root };
+	size_t bytes = 0;
+	size_t allocations = 0;
+
+	while (!nodes.empty())
+	{
+		const auto node = nodes.back();
+
+		nodes.pop_back();
+		bytes += sizeof(peg::ast_node) + node->children.capacity() * sizeof(node->children.front());
+		allocations += (node->children.empty() ? 1 : 2);
+
+		if (node->unescaped.capacity() > std::string().capacity())
+		{
+			bytes += node->unescaped.capacity();
+			++allocations;
+		}
+
+		for (const auto& child : node->children)
+		{
+			nodes.push_back(child.get());
+		}
+	}
+
+	charge(Category::Parse, bytes, allocations);
+}
+
+void MemoryBudget::chargeField(bool trackPath) noexcept
+{
+	// Each field copies its ResolverParams and shares a future with its parent, and it may extend the path.
+	charge(Category::Execution,
+		sizeof(ResolverParams) + sizeof(std::promise<response::Value>) + (trackPath ? sizeof(PathSegment) : 0),
+		(trackPath ? 3 : 2));
+}
+
+void MemoryBudget::chargeResult(std::string_view name, const response::Value& value) noexcept
+{
+	// Nested objects are charged for each of their own members as they're resolved, so only count the
+	// storage which belongs to this member. Lists of scalars and strings are only counted here.
+	std::vector<const response::Value*> values { &value };
+	size_t bytes = sizeof(response::MapType::value_type) + name.size();
+	size_t allocations = 0;
+
+	while (!values.empty())
+	{
+		const auto current = values.back();
+
+		values.pop_back();
+
+		switch (current->type())
+		{
+			case response::Type::List:
+			{
+				const auto& elements = current->get<const response::ListType&>();
+
+				bytes += elements.size() * sizeof(response::Value);
+				allocations += (elements.empty() ? 0 : 1);
+
+				for (const auto& element : elements)
+				{
+					if (element.type() != response::Type::Map)
+					{
+						values.push_back(&element);
+					}
+				}
+
+				break;
+			}
+
+			case response::Type::String:
+			case response::Type::EnumValue:
+				bytes += current->get<const response::StringType&>().size();
+				++allocations;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	charge(Category::Result, bytes, allocations);
+}
+
+void MemoryBudget::check() const
+{
+	if (exceeded())
+	{
+		std::ostringstream message;
+
+		message << "Memory budget exceeded limit: " << _limit
+			<< " bytes: " << getBytes();
+
+		throw schema_exception({ message.str() });
+	}
+}
+
+bool MemoryBudget::exceeded() const noexcept
+{
+	return _limit > 0 && getBytes() > _limit;
+}
+
+size_t MemoryBudget::getLimit() const noexcept
+{
+	return _limit;
+}
+
+size_t MemoryBudget::getBytes() const noexcept
+{
+	return _total.load(std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::getBytes(Category category) const noexcept
+{
+	return _bytes[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::getAllocations(Category category) const noexcept
+{
+	return _allocations[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+CancellationToken::CancellationToken() noexcept
+{
+}
+
+CancellationToken::CancellationToken(std::chrono::steady_clock::time_point deadline) noexcept
+	: _deadline(deadline)
+{
+}
+
+CancellationToken::CancellationToken(std::chrono::steady_clock::duration timeout) noexcept
+	: _deadline(std::chrono::steady_clock::now() + timeout)
+{
+}
+
+void CancellationToken::cancel() noexcept
+{
+	_cancelled.store(true, std::memory_order_release);
+}
+
+bool CancellationToken::isCancelled() const noexcept
+{
+	if (_cancelled.load(std::memory_order_acquire) || _expired.load(std::memory_order_relaxed))
+	{
+		return true;
+	}
+
+	if (_deadline && std::chrono::steady_clock::now() >= *_deadline)
+	{
+		_expired.store(true, std::memory_order_relaxed);
+		return true;
+	}
+
+	return false;
+}
+
+const std::optional<std::chrono::steady_clock::time_point>& CancellationToken::getDeadline() const noexcept
+{
+	return _deadline;
+}
+
+void CancellationToken::check() const
+{
+	if (!isCancelled())
+	{
+		return;
+	}
+
+	throw schema_exception({ _cancelled.load(std::memory_order_acquire)
+		? "Request cancelled"
+		: "Request deadline exceeded" });
+}
+
 FieldParams::FieldParams(const SelectionSetParams & selectionSetParams, response::Value && directives)
 	: SelectionSetParams(selectionSetParams)
 	, fieldDirectives(std::move(directives))
@@ -393,118 +619,244 @@ ResolverParams::ResolverParams(const SelectionSetParams & selectionSetParams, st
 {
 }
 
-uint8_t Base64::verifyFromBase64(char ch)
+response::Value getPathValue(const ResponsePath& path)
 {
-	uint8_t result = fromBase64(ch);
+	std::vector<const PathSegment*> segments;
+
+	for (auto segment = path.get(); segment != nullptr; segment = segment->parent.get())
+	{
+		segments.push_back(segment);
+	}
 
-	if (result > 63)
+	response::Value result(response::Type::List);
+
+	result.reserve(segments.size());
+
+	for (auto itr = segments.crbegin(); itr != segments.crend(); ++itr)
 	{
-		throw schema_exception({ "invalid character in base64 encoded string" });
+		const auto& key = (*itr)->key;
+
+		if (std::holds_alternative<std::string>(key))
+		{
+			result.emplace_back(response::Value(std::string(std::get<std::string>(key))));
+		}
+		else
+		{
+			result.emplace_back(response::Value(static_cast<response::IntType>(std::get<size_t>(key))));
+		}
 	}
 
 	return result;
 }
 
-std::vector<uint8_t> Base64::fromBase64(const char* encoded, size_t count)
+OperationListener::OperationListener(bool trackPath) noexcept
+	: _trackPath(trackPath)
+{
+}
+
+bool OperationListener::trackPath() const noexcept
+{
+	return _trackPath;
+}
+
+void OperationListener::beginField(const ResponsePath& /*path*/, std::string_view /*parentType*/, std::string_view /*fieldName*/)
+{
+}
+
+void OperationListener::endField(const ResponsePath& /*path*/, std::string_view /*parentType*/, std::string_view /*fieldName*/,
+	std::chrono::steady_clock::duration /*duration*/, bool /*error*/)
+{
+}
+
+void OperationListener::beginList(const ResponsePath& /*path*/)
+{
+}
+
+void OperationListener::endList(const ResponsePath& /*path*/, size_t /*count*/)
+{
+}
+
+void OperationListener::endOperation(response::Value& /*extensions*/)
+{
+}
+
+ResultArena::ResultArena(size_t blockSize) noexcept
+	: _blockSize(blockSize)
 {
-	std::vector<uint8_t> result;
+}
 
-	if (!count)
+ResultArena::~ResultArena()
+{
+	// Destroy the objects in the reverse order they were constructed, the blocks are freed afterwards.
+	while (_last)
 	{
-		return result;
+		auto destructor = _last;
+
+		_last = destructor->previous;
+		destructor->destroy(destructor->object);
 	}
+}
 
-	result.reserve((count + (count % 4)) * 3 / 4);
+std::pair<ResultArena::Destructor*, void*> ResultArena::allocate(size_t size, size_t alignment)
+{
+	std::lock_guard lock(_mutex);
+	auto destructor = new (reserve(sizeof(Destructor), alignof(Destructor))) Destructor {};
+	auto memory = reserve(size, alignment);
 
-	// First decode all of the full unpadded segments 24 bits at a time
-	while (count >= 4
-		&& encoded[3] != padding)
-	{
-		const uint32_t segment = (static_cast<uint32_t>(verifyFromBase64(encoded[0])) << 18)
-			| (static_cast<uint32_t>(verifyFromBase64(encoded[1])) << 12)
-			| (static_cast<uint32_t>(verifyFromBase64(encoded[2])) << 6)
-			| static_cast<uint32_t>(verifyFromBase64(encoded[3]));
+	return { destructor, memory };
+}
 
-		result.emplace_back(static_cast<uint8_t>((segment & 0xFF0000) >> 16));
-		result.emplace_back(static_cast<uint8_t>((segment & 0xFF00) >> 8));
-		result.emplace_back(static_cast<uint8_t>(segment & 0xFF));
+void* ResultArena::reserve(size_t size, size_t alignment)
+{
+	void* memory = _next;
 
-		encoded += 4;
-		count -= 4;
+	if (!std::align(alignment, size, memory, _remaining))
+	{
+		// Anything larger than a block gets a block of its own.
+		const auto blockSize = std::max(_blockSize, size + alignment);
+
+		_blocks.push_back(std::unique_ptr<std::byte[]>(new std::byte[blockSize]));
+		memory = _blocks.back().get();
+		_remaining = blockSize;
+		std::align(alignment, size, memory, _remaining);
 	}
 
-	// Get any leftover partial segment with 2 or 3 non-padding characters
-	if (count > 1)
-	{
-		const bool triplet = (count > 2 && padding != encoded[2]);
-		const uint8_t tail = (triplet ? verifyFromBase64(encoded[2]) : 0);
-		const uint16_t segment = (static_cast<uint16_t>(verifyFromBase64(encoded[0])) << 10)
-			| (static_cast<uint16_t>(verifyFromBase64(encoded[1])) << 4)
-			| (static_cast<uint16_t>(tail) >> 2);
+	_next = static_cast<std::byte*>(memory) + size;
+	_remaining -= size;
 
-		if (triplet)
-		{
-			if (tail & 0x3)
-			{
-				throw schema_exception({ "invalid padding at the end of a base64 encoded string" });
-			}
+	return memory;
+}
+
+void ResultArena::addDestructor(Destructor* destructor, void* object, void (*destroy)(void* object) noexcept) noexcept
+{
+	std::lock_guard lock(_mutex);
 
-			result.emplace_back(static_cast<uint8_t>((segment & 0xFF00) >> 8));
-			result.emplace_back(static_cast<uint8_t>(segment & 0xFF));
+	destructor->previous = _last;
+	destructor->object = object;
+	destructor->destroy = destroy;
+	_last = destructor;
+}
 
-			encoded += 3;
-			count -= 3;
-		}
-		else
-		{
-			if (segment & 0xFF)
-			{
-				throw schema_exception({ "invalid padding at the end of a base64 encoded string" });
-			}
+BatchScope::BatchScope(std::vector<std::shared_ptr<Object>>&& siblings)
+	: _siblings(std::move(siblings))
+{
+}
 
-			result.emplace_back(static_cast<uint8_t>((segment & 0xFF00) >> 8));
+BatchScope::BatchEntry::BatchEntry(const response::Value& arguments)
+	: arguments(arguments)
+{
+}
 
-			encoded += 2;
-			count -= 2;
-		}
-	}
+std::shared_ptr<BatchScope::BatchEntry> BatchScope::getEntry(const std::string& responseKey, const response::Value& arguments) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& entries = _entries[responseKey];
+	auto itr = std::find_if(entries.cbegin(), entries.cend(),
+		[&arguments](const std::shared_ptr<BatchEntry>& entry) noexcept
+		{
+			return entry->arguments == arguments;
+		});
 
-	// Make sure anything that's left is 0 - 2 characters of padding
-	if ((count > 0 && padding != encoded[0])
-		|| (count > 1 && padding != encoded[1])
-		|| count > 2)
+	if (itr != entries.cend())
 	{
-		throw schema_exception({ "invalid padding at the end of a base64 encoded string" });
+		return *itr;
 	}
 
-	return result;
+	entries.push_back(std::make_shared<BatchEntry>(arguments));
+
+	return entries.back();
 }
 
-char Base64::verifyToBase64(uint8_t i)
+response::IdType Base64::fromBase64(const char* encoded, size_t count)
 {
-	unsigned char result = toBase64(i);
+	// Trim up to 2 characters of padding, anything else must be in the alphabet.
+	const size_t paddedCount = count;
 
-	if (result == padding)
+	if (count > 0 && encoded[count - 1] == padding)
 	{
-		throw schema_exception({ "invalid 6-bit value" });
+		--count;
+
+		if (count > 0 && encoded[count - 1] == padding)
+		{
+			--count;
+		}
 	}
 
-	return result;
-}
+	// Padding is optional, but if it's there it must complete the last partial segment.
+	if (count % 4 == 1
+		|| (paddedCount != count && (paddedCount % 4 != 0 || count % 4 == 0)))
+	{
+		throw schema_exception({ "invalid padding at the end of a base64 encoded string" });
+	}
 
-std::string Base64::toBase64(const std::vector<uint8_t> & bytes)
-{
-	std::string result;
+	response::IdType result((count / 4) * 3 + (count % 4 ? count % 4 - 1 : 0));
+	uint8_t* output = result.data();
+
+	// First decode all of the full segments 24 bits at a time
+	while (count >= 4)
+	{
+		const uint8_t a = fromBase64(encoded[0]);
+		const uint8_t b = fromBase64(encoded[1]);
+		const uint8_t c = fromBase64(encoded[2]);
+		const uint8_t d = fromBase64(encoded[3]);
+
+		if ((a | b | c | d) & 0xC0)
+		{
+			throw schema_exception({ "invalid character in base64 encoded string" });
+		}
+
+		const uint32_t segment = (static_cast<uint32_t>(a) << 18)
+			| (static_cast<uint32_t>(b) << 12)
+			| (static_cast<uint32_t>(c) << 6)
+			| static_cast<uint32_t>(d);
+
+		output[0] = static_cast<uint8_t>(segment >> 16);
+		output[1] = static_cast<uint8_t>(segment >> 8);
+		output[2] = static_cast<uint8_t>(segment);
+
+		encoded += 4;
+		output += 3;
+		count -= 4;
+	}
 
-	if (bytes.empty())
+	// Get any leftover partial segment with 2 or 3 characters
+	if (count > 0)
 	{
-		return result;
+		const bool triplet = (count > 2);
+		const uint8_t a = fromBase64(encoded[0]);
+		const uint8_t b = fromBase64(encoded[1]);
+		const uint8_t c = (triplet ? fromBase64(encoded[2]) : 0);
+
+		if ((a | b | c) & 0xC0)
+		{
+			throw schema_exception({ "invalid character in base64 encoded string" });
+		}
+
+		const uint32_t segment = (static_cast<uint32_t>(a) << 18)
+			| (static_cast<uint32_t>(b) << 12)
+			| (static_cast<uint32_t>(c) << 6);
+
+		// The bits which don't fit in the output bytes must be 0.
+		if (segment & (triplet ? 0xFF : 0xFFFF))
+		{
+			throw schema_exception({ "invalid padding at the end of a base64 encoded string" });
+		}
+
+		output[0] = static_cast<uint8_t>(segment >> 16);
+
+		if (triplet)
+		{
+			output[1] = static_cast<uint8_t>(segment >> 8);
+		}
 	}
 
-	size_t count = bytes.size();
-	const uint8_t* data = bytes.data();
+	return result;
+}
 
-	result.reserve((count + (count % 3)) * 4 / 3);
+std::string Base64::toBase64(const uint8_t* data, size_t count)
+{
+	std::string result(((count + 2) / 3) * 4, padding);
+	char* output = result.data();
 
 	// First encode all of the full unpadded segments 24 bits at a time
 	while (count >= 3)
@@ -513,36 +865,40 @@ std::string Base64::toBase64(const std::vector<uint8_t> & bytes)
 			| (static_cast<uint32_t>(data[1]) << 8)
 			| static_cast<uint32_t>(data[2]);
 
-		result.append({
-			verifyToBase64(static_cast<uint8_t>((segment & 0xFC0000) >> 18)),
-			verifyToBase64(static_cast<uint8_t>((segment & 0x3F000) >> 12)),
-			verifyToBase64(static_cast<uint8_t>((segment & 0xFC0) >> 6)),
-			verifyToBase64(static_cast<uint8_t>(segment & 0x3F))
-			});
+		output[0] = s_encode[(segment >> 18) & 0x3F];
+		output[1] = s_encode[(segment >> 12) & 0x3F];
+		output[2] = s_encode[(segment >> 6) & 0x3F];
+		output[3] = s_encode[segment & 0x3F];
 
 		data += 3;
+		output += 4;
 		count -= 3;
 	}
 
-	// Get any leftover partial segment with 1 or 2 bytes
+	// Get any leftover partial segment with 1 or 2 bytes, the rest is already padding
 	if (count > 0)
 	{
 		const bool pair = (count > 1);
-		const uint16_t segment = (static_cast<uint16_t>(data[0]) << 8)
-			| (pair ? static_cast<uint16_t>(data[1]) : 0);
-		const std::array<char, 4> remainder {
-			verifyToBase64(static_cast<uint8_t>((segment & 0xFC00) >> 10)),
-			verifyToBase64(static_cast<uint8_t>((segment & 0x3F0) >> 4)),
-			(pair ? verifyToBase64(static_cast<uint8_t>((segment & 0xF) << 2)) : padding),
-			padding
-		};
+		const uint32_t segment = (static_cast<uint32_t>(data[0]) << 16)
+			| (pair ? static_cast<uint32_t>(data[1]) << 8 : 0);
 
-		result.append(remainder.data(), remainder.size());
+		output[0] = s_encode[(segment >> 18) & 0x3F];
+		output[1] = s_encode[(segment >> 12) & 0x3F];
+
+		if (pair)
+		{
+			output[2] = s_encode[(segment >> 6) & 0x3F];
+		}
 	}
 
 	return result;
 }
 
+std::string Base64::toBase64(const response::IdType& bytes)
+{
+	return toBase64(bytes.data(), bytes.size());
+}
+
 template <>
 response::IntType ModifiedArgument<response::IntType>::convert(const response::Value & value)
 {
@@ -612,62 +968,158 @@ response::IdType ModifiedArgument<response::IdType>::convert(const response::Val
 }
 
 template <>
-std::future<response::Value> ModifiedResult<response::IntType>::convert(FieldResult<response::IntType> && result, ResolverParams && params)
+response::Value ModifiedResult<response::IntType>::convertValue(response::IntType && value)
 {
-	return resolve(std::move(result), std::move(params),
-		[](response::IntType && value, const ResolverParams&)
-		{
-			return response::Value(value);
-		});
+	return response::Value(value);
 }
 
 template <>
-std::future<response::Value> ModifiedResult<response::FloatType>::convert(FieldResult<response::FloatType> && result, ResolverParams && params)
+void ModifiedResult<response::IntType>::writeValue(response::IntType && value, response::Writer & writer)
 {
-	return resolve(std::move(result), std::move(params),
-		[](response::FloatType && value, const ResolverParams&)
-		{
-			return response::Value(value);
-		});
+	writer.add_int(value);
 }
 
 template <>
-std::future<response::Value> ModifiedResult<response::StringType>::convert(FieldResult<response::StringType> && result, ResolverParams && params)
+std::future<response::Value> ModifiedResult<response::IntType>::convert(FieldResult<response::IntType> && result, ResolverParams && params)
 {
 	return resolve(std::move(result), std::move(params),
-		[](response::StringType && value, const ResolverParams&)
+		[](response::IntType && value, const ResolverParams&)
+		{
+			return convertValue(std::move(value));
+		},
+		[](response::IntType && value, const ResolverParams&, response::Writer & writer)
 		{
-			return response::Value(std::move(value));
+			writeValue(std::move(value), writer);
 		});
 }
 
+template <>
+response::Value ModifiedResult<response::FloatType>::convertValue(response::FloatType && value)
+{
+	return response::Value(value);
+}
+
+template <>
+void ModifiedResult<response::FloatType>::writeValue(response::FloatType && value, response::Writer & writer)
+{
+	writer.add_float(value);
+}
+
+template <>
+std::future<response::Value> ModifiedResult<response::FloatType>::convert(FieldResult<response::FloatType> && result, ResolverParams && params)
+{
+	return resolve(std::move(result), std::move(params),
+		[](response::FloatType && value, const ResolverParams&)
+		{
+			return convertValue(std::move(value));
+		},
+		[](response::FloatType && value, const ResolverParams&, response::Writer & writer)
+		{
+			writeValue(std::move(value), writer);
+		});
+}
+
+template <>
+response::Value ModifiedResult<response::StringType>::convertValue(response::StringType && value)
+{
+	return response::Value(std::move(value));
+}
+
+template <>
+void ModifiedResult<response::StringType>::writeValue(response::StringType && value, response::Writer & writer)
+{
+	writer.add_string(value);
+}
+
+template <>
+std::future<response::Value> ModifiedResult<response::StringType>::convert(FieldResult<response::StringType> && result, ResolverParams && params)
+{
+	return resolve(std::move(result), std::move(params),
+		[](response::StringType && value, const ResolverParams&)
+		{
+			return convertValue(std::move(value));
+		},
+		[](response::StringType && value, const ResolverParams&, response::Writer & writer)
+		{
+			writeValue(std::move(value), writer);
+		});
+}
+
+template <>
+response::Value ModifiedResult<response::BooleanType>::convertValue(response::BooleanType && value)
+{
+	return response::Value(value);
+}
+
+template <>
+void ModifiedResult<response::BooleanType>::writeValue(response::BooleanType && value, response::Writer & writer)
+{
+	writer.add_bool(value);
+}
+
 template <>
 std::future<response::Value> ModifiedResult<response::BooleanType>::convert(FieldResult<response::BooleanType> && result, ResolverParams && params)
 {
 	return resolve(std::move(result), std::move(params),
 		[](response::BooleanType && value, const ResolverParams&)
 		{
-			return response::Value(value);
+			return convertValue(std::move(value));
+		},
+		[](response::BooleanType && value, const ResolverParams&, response::Writer & writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
+template <>
+response::Value ModifiedResult<response::Value>::convertValue(response::Value && value)
+{
+	return response::Value(std::move(value));
+}
+
+template <>
+void ModifiedResult<response::Value>::writeValue(response::Value && value, response::Writer & writer)
+{
+	writer.add_value(std::move(value));
+}
+
 template <>
 std::future<response::Value> ModifiedResult<response::Value>::convert(FieldResult<response::Value> && result, ResolverParams && params)
 {
 	return resolve(std::move(result), std::move(params),
 		[](response::Value && value, const ResolverParams&)
 		{
-			return response::Value(std::move(value));
+			return convertValue(std::move(value));
+		},
+		[](response::Value && value, const ResolverParams&, response::Writer & writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
+template <>
+response::Value ModifiedResult<response::IdType>::convertValue(response::IdType && value)
+{
+	return response::Value(Base64::toBase64(value));
+}
+
+template <>
+void ModifiedResult<response::IdType>::writeValue(response::IdType && value, response::Writer & writer)
+{
+	writer.add_string(Base64::toBase64(value));
+}
+
 template <>
 std::future<response::Value> ModifiedResult<response::IdType>::convert(FieldResult<response::IdType> && result, ResolverParams && params)
 {
 	return resolve(std::move(result), std::move(params),
 		[](response::IdType && value, const ResolverParams&)
 		{
-			return response::Value(Base64::toBase64(value));
+			return convertValue(std::move(value));
+		},
+		[](response::IdType && value, const ResolverParams&, response::Writer & writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
@@ -683,17 +1135,160 @@ std::future<response::Value> ModifiedResult<Object>::convert(FieldResult<std::sh
 			{
 				response::Value document(response::Type::Map);
 
-				document.emplace_back(std::string{ strData }, response::Value(!wrappedResult
-					? response::Type::Null
-					: response::Type::Map));
+				if (!paramsFuture.writer)
+				{
+					document.emplace_back(std::string{ strData }, response::Value(!wrappedResult
+						? response::Type::Null
+						: response::Type::Map));
+				}
+				else if (!wrappedResult)
+				{
+					paramsFuture.writer->add_null();
+				}
+				else
+				{
+					paramsFuture.writer->start_object();
+					paramsFuture.writer->end_object();
+				}
 
 				return document;
 			}
 
+			// A single child object does not share the BatchScope of its parent.
+			paramsFuture.batch = nullptr;
+			paramsFuture.batchIndex = 0;
+
 			return wrappedResult->resolve(paramsFuture, *paramsFuture.selection, paramsFuture.fragments, paramsFuture.variables).get();
 		}, std::move(result), std::move(params));
 }
 
+// Explicit instantiations for the extern template declarations in GraphQLService.h.
+template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::List>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IntType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IntType>::ResultTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::List>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::FloatType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::FloatType>::ResultTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::List>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::StringType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::StringType>::ResultTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::BooleanType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::BooleanType>::ResultTraits<response::BooleanType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::BooleanType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::BooleanType>::ResultTraits<response::BooleanType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::BooleanType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::BooleanType>::ResultTraits<response::BooleanType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::List>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::IdType>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::IdType>::ResultTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::Nullable>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::List>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<response::Value>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<response::Value>::ResultTraits<response::Value, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::List>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::Nullable, TypeModifier::List>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::Nullable, TypeModifier::List>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+template std::future<response::Value> ModifiedResult<Object>::convert<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	ModifiedResult<Object>::ResultTraits<Object, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::future_type, ResolverParams&&);
+
+template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::Nullable>::type ModifiedArgument<response::IntType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::List>::type ModifiedArgument<response::IntType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::IntType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IntType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IntType>::ArgumentTraits<response::IntType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IntType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::Nullable>::type ModifiedArgument<response::FloatType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::List>::type ModifiedArgument<response::FloatType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::FloatType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::FloatType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::FloatType>::ArgumentTraits<response::FloatType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::FloatType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::Nullable>::type ModifiedArgument<response::StringType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::List>::type ModifiedArgument<response::StringType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::StringType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::StringType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::StringType>::ArgumentTraits<response::StringType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::StringType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::Nullable>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::List>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::BooleanType>::ArgumentTraits<response::BooleanType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::BooleanType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::Nullable>::type ModifiedArgument<response::IdType>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::List>::type ModifiedArgument<response::IdType>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::IdType>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IdType>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::IdType>::ArgumentTraits<response::IdType, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::IdType>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::Nullable>::type ModifiedArgument<response::Value>::require<TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::List>::type ModifiedArgument<response::Value>::require<TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::Nullable, TypeModifier::List>::type ModifiedArgument<response::Value>::require<TypeModifier::Nullable, TypeModifier::List>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::Value>::require<TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+template ModifiedArgument<response::Value>::ArgumentTraits<response::Value, TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>::type ModifiedArgument<response::Value>::require<TypeModifier::Nullable, TypeModifier::List, TypeModifier::Nullable>(
+	const std::string&, const response::Value&);
+
 // As we recursively expand fragment spreads and inline fragments, we want to accumulate the directives
 // at each location and merge them with any directives included in outer fragments to build the complete
 // set of directives for nested fragments. Directives with the same name at the same location will be
@@ -711,7 +1306,7 @@ class SelectionVisitor
 {
 public:
 	explicit SelectionVisitor(const SelectionSetParams& selectionSetParams, const FragmentMap& fragments, const response::Value& variables,
-		const TypeNames& typeNames, const ResolverMap& resolvers);
+		const Object& object, std::string_view typeName, const TypeNames& typeNames, const ObjectResolverMap* objectResolvers, const ResolverMap* resolvers);
 
 	void visit(const peg::ast_node& selection);
 
@@ -719,27 +1314,48 @@ public:
 
 private:
 	void visitField(const peg::ast_node& field);
-	void visitFragmentSpread(const peg::ast_node& fragmentSpread);
-	void visitInlineFragment(const peg::ast_node& inlineFragment);
+	const peg::ast_node* visitFragmentSpread(const peg::ast_node& fragmentSpread);
+	const peg::ast_node* visitInlineFragment(const peg::ast_node& inlineFragment);
 
 	const std::shared_ptr<RequestState>& _state;
 	const response::Value& _operationDirectives;
+	const BatchScope* _batch;
+	const size_t _batchIndex;
+	response::Writer* const _writer;
+	const CancellationToken* const _cancellation;
+	OperationListener* const _listener;
+	const ResponsePath& _path;
+	ResultArena* const _arena;
 	const FragmentMap& _fragments;
 	const response::Value& _variables;
+	const Object& _object;
+	const std::string_view _typeName;
 	const TypeNames& _typeNames;
-	const ResolverMap& _resolvers;
+	const ObjectResolverMap* const _objectResolvers;
+	const ResolverMap* const _resolvers;
 
 	std::stack<FragmentDirectives> _fragmentDirectives;
+	std::vector<const peg::ast_node*> _selections;
 	std::queue<std::pair<std::string, std::future<response::Value>>> _values;
 };
 
 SelectionVisitor::SelectionVisitor(const SelectionSetParams & selectionSetParams, const FragmentMap & fragments, const response::Value & variables,
-	const TypeNames & typeNames, const ResolverMap & resolvers)
+	const Object & object, std::string_view typeName, const TypeNames & typeNames, const ObjectResolverMap * objectResolvers, const ResolverMap * resolvers)
 	: _state(selectionSetParams.state)
 	, _operationDirectives(selectionSetParams.operationDirectives)
+	, _batch(selectionSetParams.batch)
+	, _batchIndex(selectionSetParams.batchIndex)
+	, _writer(selectionSetParams.writer)
+	, _cancellation(selectionSetParams.cancellation)
+	, _listener(selectionSetParams.listener)
+	, _path(selectionSetParams.path)
+	, _arena(selectionSetParams.arena)
 	, _fragments(fragments)
 	, _variables(variables)
+	, _object(object)
+	, _typeName(typeName)
 	, _typeNames(typeNames)
+	, _objectResolvers(objectResolvers)
 	, _resolvers(resolvers)
 {
 	_fragmentDirectives.push({
@@ -758,17 +1374,46 @@ std::queue<std::pair<std::string, std::future<response::Value>>> SelectionVisito
 
 void SelectionVisitor::visit(const peg::ast_node & selection)
 {
-	if (selection.is_type<peg::field>())
-	{
-		visitField(selection);
-	}
-	else if (selection.is_type<peg::fragment_spread>())
-	{
-		visitFragmentSpread(selection);
-	}
-	else if (selection.is_type<peg::inline_fragment>())
+	// Fragments can be nested as deeply as the query, so expand them with an explicit stack. A nullptr
+	// marks the end of a fragment's selections and pops the directives which it pushed.
+	_selections.push_back(&selection);
+
+	while (!_selections.empty())
 	{
-		visitInlineFragment(selection);
+		const auto current = _selections.back();
+
+		_selections.pop_back();
+
+		if (!current)
+		{
+			_fragmentDirectives.pop();
+			continue;
+		}
+
+		const peg::ast_node* fragmentSelection = nullptr;
+
+		if (current->is_type<peg::field>())
+		{
+			visitField(*current);
+		}
+		else if (current->is_type<peg::fragment_spread>())
+		{
+			fragmentSelection = visitFragmentSpread(*current);
+		}
+		else if (current->is_type<peg::inline_fragment>())
+		{
+			fragmentSelection = visitInlineFragment(*current);
+		}
+
+		if (fragmentSelection)
+		{
+			_selections.push_back(nullptr);
+
+			for (auto itr = fragmentSelection->children.crbegin(); itr != fragmentSelection->children.crend(); ++itr)
+			{
+				_selections.push_back(itr->get());
+			}
+		}
 	}
 }
 
@@ -795,9 +1440,29 @@ void SelectionVisitor::visitField(const peg::ast_node & field)
 		alias = name;
 	}
 
-	const auto itr = _resolvers.find(name);
+	ObjectResolver objectResolver = nullptr;
+	const Resolver* resolver = nullptr;
+
+	if (_objectResolvers)
+	{
+		const auto itr = _objectResolvers->find(name);
+
+		if (itr != _objectResolvers->cend())
+		{
+			objectResolver = itr->second;
+		}
+	}
+	else
+	{
+		const auto itr = _resolvers->find(name);
+
+		if (itr != _resolvers->cend())
+		{
+			resolver = &itr->second;
+		}
+	}
 
-	if (itr == _resolvers.cend())
+	if (!objectResolver && !resolver)
 	{
 		auto position = field.begin();
 		std::ostringstream error;
@@ -850,12 +1515,68 @@ void SelectionVisitor::visitField(const peg::ast_node & field)
 		_operationDirectives,
 		_fragmentDirectives.top().fragmentDefinitionDirectives,
 		_fragmentDirectives.top().fragmentSpreadDirectives,
-		_fragmentDirectives.top().inlineFragmentDirectives
+		_fragmentDirectives.top().inlineFragmentDirectives,
+		_batch,
+		_batchIndex,
+		_writer,
+		_cancellation,
+		_listener,
+		ResponsePath(),
+		_arena
 	};
 
+	std::chrono::steady_clock::time_point start;
+
+	if (_listener)
+	{
+		if (_listener->trackPath())
+		{
+			selectionSetParams.path = std::make_shared<const PathSegment>(PathSegment { _path, alias });
+		}
+
+		_listener->beginField(selectionSetParams.path, _typeName, name);
+		start = std::chrono::steady_clock::now();
+	}
+
 	try
 	{
-		auto result = itr->second(ResolverParams(selectionSetParams, std::string(alias), std::move(arguments), directiveVisitor.getDirectives(), selection, _fragments, _variables));
+		if (_cancellation)
+		{
+			_cancellation->check();
+		}
+
+		if (_state && _state->memory)
+		{
+			_state->memory->chargeField(selectionSetParams.path != nullptr);
+			_state->memory->check();
+		}
+
+		ResolverParams resolverParams(selectionSetParams, std::string(alias), std::move(arguments), directiveVisitor.getDirectives(), selection, _fragments, _variables);
+		auto result = (objectResolver
+			? objectResolver(_object, std::move(resolverParams))
+			: (*resolver)(std::move(resolverParams)));
+
+		if (_listener)
+		{
+			// End the field once the value is resolved, including any deferred work in the future.
+			result = std::async(std::launch::deferred,
+				[listener = _listener, path = selectionSetParams.path, typeName = _typeName, name, start](std::future<response::Value>&& fieldResult)
+				{
+					try
+					{
+						auto value = fieldResult.get();
+
+						listener->endField(path, typeName, name, std::chrono::steady_clock::now() - start, false);
+
+						return value;
+					}
+					catch (const std::exception&)
+					{
+						listener->endField(path, typeName, name, std::chrono::steady_clock::now() - start, true);
+						throw;
+					}
+				}, std::move(result));
+		}
 
 		_values.push({
 			std::move(alias),
@@ -866,6 +1587,11 @@ void SelectionVisitor::visitField(const peg::ast_node & field)
 	{
 		std::promise<response::Value> promise;
 
+		if (_listener)
+		{
+			_listener->endField(selectionSetParams.path, _typeName, name, std::chrono::steady_clock::now() - start, true);
+		}
+
 		promise.set_exception(std::current_exception());
 
 		_values.push({
@@ -875,7 +1601,8 @@ void SelectionVisitor::visitField(const peg::ast_node & field)
 	}
 }
 
-void SelectionVisitor::visitFragmentSpread(const peg::ast_node & fragmentSpread)
+// Push the directives for the fragment and return its selection set, or nullptr if it's skipped.
+const peg::ast_node* SelectionVisitor::visitFragmentSpread(const peg::ast_node & fragmentSpread)
 {
 	const std::string name(fragmentSpread.children.front()->string_view());
 	auto itr = _fragments.find(name);
@@ -909,7 +1636,7 @@ void SelectionVisitor::visitFragmentSpread(const peg::ast_node & fragmentSpread)
 
 	if (skip)
 	{
-		return;
+		return nullptr;
 	}
 
 	auto fragmentSpreadDirectives = directiveVisitor.getDirectives();
@@ -940,15 +1667,11 @@ void SelectionVisitor::visitFragmentSpread(const peg::ast_node & fragmentSpread)
 		response::Value(_fragmentDirectives.top().inlineFragmentDirectives)
 		});
 
-	for (const auto& selection : itr->second.getSelection().children)
-	{
-		visit(*selection);
-	}
-
-	_fragmentDirectives.pop();
+	return &itr->second.getSelection();
 }
 
-void SelectionVisitor::visitInlineFragment(const peg::ast_node & inlineFragment)
+// Push the directives for the inline fragment and return its selection set, or nullptr if it's skipped.
+const peg::ast_node* SelectionVisitor::visitInlineFragment(const peg::ast_node & inlineFragment)
 {
 	DirectiveVisitor directiveVisitor(_variables);
 
@@ -960,7 +1683,7 @@ void SelectionVisitor::visitInlineFragment(const peg::ast_node & inlineFragment)
 
 	if (directiveVisitor.shouldSkip())
 	{
-		return;
+		return nullptr;
 	}
 
 	const peg::ast_node* typeCondition = nullptr;
@@ -971,42 +1694,287 @@ void SelectionVisitor::visitInlineFragment(const peg::ast_node & inlineFragment)
 			typeCondition = &child;
 		});
 
-	if (typeCondition == nullptr
-		|| _typeNames.count(typeCondition->children.front()->string()) > 0)
+	if (typeCondition != nullptr
+		&& _typeNames.count(typeCondition->children.front()->string()) == 0)
 	{
-		peg::on_first_child<peg::selection_set>(inlineFragment,
-			[this, &directiveVisitor](const peg::ast_node & child)
+		return nullptr;
+	}
+
+	const peg::ast_node* selection = nullptr;
+
+	peg::on_first_child<peg::selection_set>(inlineFragment,
+		[&selection](const peg::ast_node & child)
+		{
+			selection = &child;
+		});
+
+	if (!selection)
+	{
+		return nullptr;
+	}
+
+	auto inlineFragmentDirectives = directiveVisitor.getDirectives();
+
+	// Merge outer inline fragment directives as long as they don't conflict.
+	for (const auto& entry : _fragmentDirectives.top().inlineFragmentDirectives)
+	{
+		if (inlineFragmentDirectives.find(entry.first) == inlineFragmentDirectives.end())
+		{
+			inlineFragmentDirectives.emplace_back(std::string{ entry.first }, response::Value(entry.second));
+		}
+	}
+
+	_fragmentDirectives.push({
+		response::Value(_fragmentDirectives.top().fragmentDefinitionDirectives),
+		response::Value(_fragmentDirectives.top().fragmentSpreadDirectives),
+		std::move(inlineFragmentDirectives)
+		});
+
+	return selection;
+}
+
+void addDuplicateFieldError(const std::string& name, response::Value& errors)
+{
+	std::ostringstream message;
+
+	message << "Field error name: " << name
+		<< " error: duplicate field";
+
+	response::Value error(response::Type::Map);
+
+	error.emplace_back(std::string{ strMessage }, response::Value(message.str()));
+	errors.emplace_back(std::move(error));
+}
+
+// FieldWriter streams the fields of one object to the response::Writer. The member key is only written
+// along with the first part of the value, so a field which fails before it writes anything is left out of
+// the object just like it is in a response::Value. A duplicate field is still resolved for its errors, but
+// its value is discarded.
+class FieldWriter : public response::Writer
+{
+public:
+	explicit FieldWriter(response::Writer& writer) noexcept;
+
+	void beginField(std::string_view name, bool discard);
+
+	// Close anything which a failed field left open, so the rest of the response is still valid JSON.
+	// Returns true if the field wrote a value.
+	bool endField(bool failed);
+
+	void start_object() override;
+	void add_member_key(std::string_view key) override;
+	void end_object() override;
+
+	void start_array() override;
+	void end_array() override;
+
+	void add_null() override;
+	void add_string(std::string_view value) override;
+	void add_enum(std::string_view value) override;
+	void add_bool(response::BooleanType value) override;
+	void add_int(response::IntType value) override;
+	void add_float(response::FloatType value) override;
+
+	void add_value(response::Value&& value) override;
+
+private:
+	bool beginValue();
+	void endValue() noexcept;
+
+	response::Writer& _writer;
+	std::string _name;
+	bool _discard = false;
+	bool _written = false;
+
+	// The nested objects (true) and lists (false) which are still open in the current field, and whether
+	// the innermost object has a member key without a value.
+	std::vector<bool> _open;
+	bool _memberKey = false;
+};
+
+FieldWriter::FieldWriter(response::Writer& writer) noexcept
+	: _writer(writer)
+{
+}
+
+void FieldWriter::beginField(std::string_view name, bool discard)
+{
+	_name = name;
+	_discard = discard;
+	_written = false;
+	_open.clear();
+	_memberKey = false;
+}
+
+bool FieldWriter::endField(bool failed)
+{
+	if (failed && _written && !_discard)
+	{
+		if (_memberKey)
+		{
+			_writer.add_null();
+		}
+
+		while (!_open.empty())
+		{
+			if (_open.back())
+			{
+				_writer.end_object();
+			}
+			else
 			{
-				auto inlineFragmentDirectives = directiveVisitor.getDirectives();
+				_writer.end_array();
+			}
 
-				// Merge outer inline fragment directives as long as they don't conflict.
-				for (const auto& entry : _fragmentDirectives.top().inlineFragmentDirectives)
-				{
-					if (inlineFragmentDirectives.find(entry.first) == inlineFragmentDirectives.end())
-					{
-						inlineFragmentDirectives.emplace_back(std::string{ entry.first }, response::Value(entry.second));
-					}
-				}
+			_open.pop_back();
+		}
+	}
 
-				_fragmentDirectives.push({
-					response::Value(_fragmentDirectives.top().fragmentDefinitionDirectives),
-					response::Value(_fragmentDirectives.top().fragmentSpreadDirectives),
-					std::move(inlineFragmentDirectives)
-					});
+	return _written;
+}
 
-				for (const auto& selection : child.children)
-				{
-					visit(*selection);
-				}
+bool FieldWriter::beginValue()
+{
+	if (!_written)
+	{
+		_written = true;
 
-				_fragmentDirectives.pop();
-			});
+		if (!_discard)
+		{
+			_writer.add_member_key(_name);
+		}
+	}
+
+	_memberKey = false;
+
+	return !_discard;
+}
+
+void FieldWriter::endValue() noexcept
+{
+	if (!_open.empty())
+	{
+		_open.pop_back();
+	}
+}
+
+void FieldWriter::start_object()
+{
+	if (beginValue())
+	{
+		_writer.start_object();
+	}
+
+	_open.push_back(true);
+}
+
+void FieldWriter::add_member_key(std::string_view key)
+{
+	if (!_discard)
+	{
+		_writer.add_member_key(key);
+	}
+
+	_memberKey = true;
+}
+
+void FieldWriter::end_object()
+{
+	if (!_discard)
+	{
+		_writer.end_object();
+	}
+
+	endValue();
+}
+
+void FieldWriter::start_array()
+{
+	if (beginValue())
+	{
+		_writer.start_array();
+	}
+
+	_open.push_back(false);
+}
+
+void FieldWriter::end_array()
+{
+	if (!_discard)
+	{
+		_writer.end_array();
+	}
+
+	endValue();
+}
+
+void FieldWriter::add_null()
+{
+	if (beginValue())
+	{
+		_writer.add_null();
+	}
+}
+
+void FieldWriter::add_string(std::string_view value)
+{
+	if (beginValue())
+	{
+		_writer.add_string(value);
+	}
+}
+
+void FieldWriter::add_enum(std::string_view value)
+{
+	if (beginValue())
+	{
+		_writer.add_enum(value);
+	}
+}
+
+void FieldWriter::add_bool(response::BooleanType value)
+{
+	if (beginValue())
+	{
+		_writer.add_bool(value);
+	}
+}
+
+void FieldWriter::add_int(response::IntType value)
+{
+	if (beginValue())
+	{
+		_writer.add_int(value);
+	}
+}
+
+void FieldWriter::add_float(response::FloatType value)
+{
+	if (beginValue())
+	{
+		_writer.add_float(value);
+	}
+}
+
+void FieldWriter::add_value(response::Value&& value)
+{
+	if (beginValue())
+	{
+		_writer.add_value(std::move(value));
 	}
 }
 
 Object::Object(TypeNames && typeNames, ResolverMap && resolvers)
-	: _typeNames(std::move(typeNames))
-	, _resolvers(std::move(resolvers))
+	: _ownedTables(std::make_unique<const OwnedTables>(OwnedTables { std::move(typeNames), std::move(resolvers) }))
+	, _typeNames(_ownedTables->typeNames)
+	, _resolvers(&_ownedTables->resolvers)
+{
+}
+
+Object::Object(std::string_view typeName, const TypeNames & typeNames, const ObjectResolverMap & resolvers) noexcept
+	: _typeName(typeName)
+	, _typeNames(typeNames)
+	, _objectResolvers(&resolvers)
 {
 }
 
@@ -1014,11 +1982,19 @@ std::future<response::Value> Object::resolve(const SelectionSetParams & selectio
 {
 	std::queue<std::pair<std::string, std::future<response::Value>>> selections;
 
+	// The fields write to the FieldWriter instead of the streamed response, so it can write their keys.
+	auto fieldWriter = (selectionSetParams.writer
+		? std::make_unique<FieldWriter>(*selectionSetParams.writer)
+		: nullptr);
+	SelectionSetParams fieldParams(selectionSetParams);
+
+	fieldParams.writer = fieldWriter.get();
+
 	beginSelectionSet(selectionSetParams);
 
 	for (const auto& child : selection.children)
 	{
-		SelectionVisitor visitor(selectionSetParams, fragments, variables, _typeNames, _resolvers);
+		SelectionVisitor visitor(fieldParams, fragments, variables, *this, _typeName, _typeNames, _objectResolvers, _resolvers);
 
 		visitor.visit(*child);
 
@@ -1034,14 +2010,30 @@ std::future<response::Value> Object::resolve(const SelectionSetParams & selectio
 	endSelectionSet(selectionSetParams);
 
 	return std::async(std::launch::deferred,
-		[](std::queue<std::pair<std::string, std::future<response::Value>>> && children)
+		[writer = selectionSetParams.writer, fieldWriter = std::move(fieldWriter), memory = (selectionSetParams.state ? selectionSetParams.state->memory : nullptr)](std::queue<std::pair<std::string, std::future<response::Value>>> && children)
 		{
 			response::Value data(response::Type::Map);
 			response::Value errors(response::Type::List);
+			std::unordered_set<std::string> writtenNames;
+
+			if (writer)
+			{
+				writer->start_object();
+			}
 
 			while (!children.empty())
 			{
 				auto name = std::move(children.front().first);
+				bool failed = false;
+
+				// A streamed field is written as soon as it's resolved, so a duplicate is only resolved
+				// for its errors.
+				const bool duplicate = (writer && writtenNames.find(name) != writtenNames.end());
+
+				if (fieldWriter)
+				{
+					fieldWriter->beginField(name, duplicate);
+				}
 
 				try
 				{
@@ -1062,17 +2054,14 @@ std::future<response::Value> Object::resolve(const SelectionSetParams & selectio
 						}
 						else if (entry.first == strData)
 						{
-							if (data.find(name) != data.end())
+							if (memory)
 							{
-								std::ostringstream message;
-
-								message << "Field error name: " << name
-									<< " error: duplicate field";
-
-								response::Value error(response::Type::Map);
+								memory->chargeResult(name, entry.second);
+							}
 
-								error.emplace_back(std::string{ strMessage }, response::Value(message.str()));
-								errors.emplace_back(std::move(error));
+							if (data.find(name) != data.end())
+							{
+								addDuplicateFieldError(name, errors);
 							}
 							else
 							{
@@ -1083,10 +2072,12 @@ std::future<response::Value> Object::resolve(const SelectionSetParams & selectio
 				}
 				catch (const std::exception & ex)
 				{
+					failed = true;
+
 					std::ostringstream message;
 
 					message << "Field error name: " << name
-						<< " unknown error: " << ex.what();
+						<< " unknown error: " << getErrorMessage(ex);
 
 					response::Value error(response::Type::Map);
 
@@ -1094,12 +2085,31 @@ std::future<response::Value> Object::resolve(const SelectionSetParams & selectio
 					errors.emplace_back(std::move(error));
 				}
 
+				if (fieldWriter && fieldWriter->endField(failed))
+				{
+					if (duplicate)
+					{
+						addDuplicateFieldError(name, errors);
+					}
+					else
+					{
+						writtenNames.insert(std::move(name));
+					}
+				}
+
 				children.pop();
 			}
 
 			response::Value result(response::Type::Map);
 
-			result.emplace_back(std::string{ strData }, std::move(data));
+			if (writer)
+			{
+				writer->end_object();
+			}
+			else
+			{
+				result.emplace_back(std::string{ strData }, std::move(data));
+			}
 
 			if (errors.size() > 0)
 			{
@@ -1123,12 +2133,53 @@ void Object::endSelectionSet(const SelectionSetParams &) const
 {
 }
 
+// Get the error for a request which went over its MemoryBudget.
+response::Value getMemoryBudgetErrors(const MemoryBudget& memory)
+{
+	try
+	{
+		memory.check();
+	}
+	catch (schema_exception& ex)
+	{
+		return ex.getErrors();
+	}
+
+	return response::Value(response::Type::List);
+}
+
+// Let the OperationListener fill in the extensions at the end of the operation, and add them to the
+// document or write them to the streamed response if there are any.
+void addExtensions(OperationListener& listener, response::Value& document, response::Writer* writer)
+{
+	response::Value extensions(response::Type::Map);
+
+	listener.endOperation(extensions);
+
+	if (extensions.size() == 0)
+	{
+		return;
+	}
+
+	if (writer)
+	{
+		writer->add_member_key(strExtensions);
+		writer->add_value(std::move(extensions));
+	}
+	else
+	{
+		document.emplace_back(std::string{ strExtensions }, std::move(extensions));
+	}
+}
+
 OperationData::OperationData(std::shared_ptr<RequestState> && state, response::Value && variables,
 	response::Value && directives, FragmentMap && fragments)
 	: state(std::move(state))
 	, variables(std::move(variables))
 	, directives(std::move(directives))
 	, fragments(std::move(fragments))
+	, cancellation(this->state ? this->state->cancellation : nullptr)
+	, signature(this->state ? this->state->signature : nullptr)
 {
 }
 
@@ -1170,7 +2221,8 @@ void FragmentDefinitionVisitor::visit(const peg::ast_node & fragmentDefinition)
 class OperationDefinitionVisitor
 {
 public:
-	OperationDefinitionVisitor(std::shared_ptr<RequestState> state, const TypeMap& operations, response::Value&& variables, FragmentMap&& fragments);
+	OperationDefinitionVisitor(std::shared_ptr<RequestState> state, const TypeMap& operations, response::Value&& variables, FragmentMap&& fragments, response::Writer* writer,
+		std::shared_ptr<Instrumentation> instrumentation);
 
 	std::future<response::Value> getValue();
 
@@ -1179,16 +2231,21 @@ public:
 private:
 	std::shared_ptr<OperationData> _params;
 	const TypeMap& _operations;
+	response::Writer* const _writer;
+	std::shared_ptr<Instrumentation> _instrumentation;
 	std::future<response::Value> _result;
 };
 
-OperationDefinitionVisitor::OperationDefinitionVisitor(std::shared_ptr<RequestState> state, const TypeMap & operations, response::Value && variables, FragmentMap && fragments)
+OperationDefinitionVisitor::OperationDefinitionVisitor(std::shared_ptr<RequestState> state, const TypeMap & operations, response::Value && variables, FragmentMap && fragments, response::Writer * writer,
+	std::shared_ptr<Instrumentation> instrumentation)
 	: _params(std::make_shared<OperationData>(
 		std::move(state),
 		std::move(variables),
 		response::Value(),
 		std::move(fragments)))
 	, _operations(operations)
+	, _writer(writer)
+	, _instrumentation(std::move(instrumentation))
 {
 }
 
@@ -1255,21 +2312,110 @@ void OperationDefinitionVisitor::visit(std::launch launch, const std::string & o
 
 	_params->directives = std::move(operationDirectives);
 
+	std::string operationName;
+
+	peg::on_first_child<peg::operation_name>(operationDefinition,
+		[&operationName](const peg::ast_node & child)
+		{
+			operationName = child.string_view();
+		});
+
 	// Keep the params alive until the deferred lambda has executed
 	_result = std::async(launch,
-		[params = std::move(_params), operation = itr->second](const peg::ast_node& selection)
+		[params = std::move(_params), operation = itr->second, writer = _writer, instrumentation = std::move(_instrumentation), operationType, operationName = std::move(operationName)](const peg::ast_node& selection)
 		{
+			const auto listener = (instrumentation
+				? instrumentation->beginOperation(params->state, operationType, operationName, params->signature.get())
+				: nullptr);
+
 			// The top level object doesn't come from inside of a fragment, so all of the fragment directives are empty.
 			const response::Value emptyFragmentDirectives(response::Type::Map);
+			const auto arena = std::make_shared<ResultArena>();
 			const SelectionSetParams selectionSetParams{
 				params->state,
 				params->directives,
 				emptyFragmentDirectives,
 				emptyFragmentDirectives,
-				emptyFragmentDirectives
+				emptyFragmentDirectives,
+				nullptr,
+				0,
+				writer,
+				params->cancellation.get(),
+				listener.get(),
+				ResponsePath(),
+				arena.get()
 			};
 
-			return operation->resolve(selectionSetParams, selection, params->fragments, params->variables).get();
+			auto result = operation->resolve(selectionSetParams, selection, params->fragments, params->variables);
+			const auto memory = (params->state ? params->state->memory : nullptr);
+
+			if (!writer)
+			{
+				auto document = result.get();
+
+				// Replace the partial result with a single error.
+				if (memory && memory->exceeded())
+				{
+					document = response::Value(response::Type::Map);
+					document.emplace_back(std::string{ strData }, response::Value());
+					document.emplace_back(std::string{ strErrors }, getMemoryBudgetErrors(*memory));
+				}
+
+				if (listener)
+				{
+					addExtensions(*listener, document, nullptr);
+				}
+
+				return document;
+			}
+
+			// Nothing is written until the deferred result is resolved, so wrap it in the same
+			// document we would have returned.
+			writer->start_object();
+			writer->add_member_key(strData);
+
+			auto document = result.get();
+			auto members = document.release<response::MapType>();
+			response::Value errors;
+
+			for (auto& entry : members)
+			{
+				if (entry.first == strErrors)
+				{
+					errors = std::move(entry.second);
+				}
+			}
+
+			// The data has already been written, so all we can do is append the error.
+			if (memory && memory->exceeded())
+			{
+				if (errors.type() != response::Type::List)
+				{
+					errors = response::Value(response::Type::List);
+				}
+
+				auto budgetErrors = getMemoryBudgetErrors(*memory).release<response::ListType>();
+
+				for (auto& error : budgetErrors)
+				{
+					errors.emplace_back(std::move(error));
+				}
+			}
+
+			if (errors.type() == response::Type::List)
+			{
+				writer->add_member_key(strErrors);
+				writer->add_value(std::move(errors));
+			}
+
+			if (listener)
+			{
+				addExtensions(*listener, document, writer);
+			}
+
+			writer->end_object();
+
+			return response::Value(response::Type::Map);
 		}, std::cref(*operationDefinition.children.back()));
 }
 
@@ -1299,8 +2445,8 @@ public:
 
 private:
 	void visitField(const peg::ast_node& field);
-	void visitFragmentSpread(const peg::ast_node& fragmentSpread);
-	void visitInlineFragment(const peg::ast_node& inlineFragment);
+	const peg::ast_node* visitFragmentSpread(const peg::ast_node& fragmentSpread);
+	const peg::ast_node* visitInlineFragment(const peg::ast_node& inlineFragment);
 
 	SubscriptionParams _params;
 	SubscriptionCallback _callback;
@@ -1336,19 +2482,40 @@ void SubscriptionDefinitionVisitor::visit(const peg::ast_node & operationDefinit
 {
 	const auto& selection = *operationDefinition.children.back();
 
-	for (const auto& child : selection.children)
+	// Expand the fragments with an explicit stack, the same way SelectionVisitor does.
+	std::vector<const peg::ast_node*> selections;
+
+	for (auto itr = selection.children.crbegin(); itr != selection.children.crend(); ++itr)
+	{
+		selections.push_back(itr->get());
+	}
+
+	while (!selections.empty())
 	{
-		if (child->is_type<peg::field>())
+		const auto current = selections.back();
+		const peg::ast_node* fragmentSelection = nullptr;
+
+		selections.pop_back();
+
+		if (current->is_type<peg::field>())
+		{
+			visitField(*current);
+		}
+		else if (current->is_type<peg::fragment_spread>())
 		{
-			visitField(*child);
+			fragmentSelection = visitFragmentSpread(*current);
 		}
-		else if (child->is_type<peg::fragment_spread>())
+		else if (current->is_type<peg::inline_fragment>())
 		{
-			visitFragmentSpread(*child);
+			fragmentSelection = visitInlineFragment(*current);
 		}
-		else if (child->is_type<peg::inline_fragment>())
+
+		if (fragmentSelection)
 		{
-			visitInlineFragment(*child);
+			for (auto itr = fragmentSelection->children.crbegin(); itr != fragmentSelection->children.crend(); ++itr)
+			{
+				selections.push_back(itr->get());
+			}
 		}
 	}
 
@@ -1417,7 +2584,7 @@ void SubscriptionDefinitionVisitor::visitField(const peg::ast_node & field)
 	_fieldNamesAndArgs[std::move(name)].emplace_back(std::move(arguments));
 }
 
-void SubscriptionDefinitionVisitor::visitFragmentSpread(const peg::ast_node & fragmentSpread)
+const peg::ast_node* SubscriptionDefinitionVisitor::visitFragmentSpread(const peg::ast_node & fragmentSpread)
 {
 	const std::string name(fragmentSpread.children.front()->string_view());
 	auto itr = _fragments.find(name);
@@ -1450,16 +2617,13 @@ void SubscriptionDefinitionVisitor::visitFragmentSpread(const peg::ast_node & fr
 
 	if (skip)
 	{
-		return;
+		return nullptr;
 	}
 
-	for (const auto& selection : itr->second.getSelection().children)
-	{
-		visit(*selection);
-	}
+	return &itr->second.getSelection();
 }
 
-void SubscriptionDefinitionVisitor::visitInlineFragment(const peg::ast_node & inlineFragment)
+const peg::ast_node* SubscriptionDefinitionVisitor::visitInlineFragment(const peg::ast_node & inlineFragment)
 {
 	DirectiveVisitor directiveVisitor(_params.variables);
 
@@ -1471,7 +2635,7 @@ void SubscriptionDefinitionVisitor::visitInlineFragment(const peg::ast_node & in
 
 	if (directiveVisitor.shouldSkip())
 	{
-		return;
+		return nullptr;
 	}
 
 	const peg::ast_node* typeCondition = nullptr;
@@ -1482,18 +2646,19 @@ void SubscriptionDefinitionVisitor::visitInlineFragment(const peg::ast_node & in
 			typeCondition = &child;
 		});
 
+	const peg::ast_node* selection = nullptr;
+
 	if (typeCondition == nullptr
 		|| _subscriptionObject->matchesType(typeCondition->children.front()->string()))
 	{
 		peg::on_first_child<peg::selection_set>(inlineFragment,
-			[this](const peg::ast_node & child)
+			[&selection](const peg::ast_node & child)
 			{
-				for (const auto& selection : child.children)
-				{
-					visit(*selection);
-				}
+				selection = &child;
 			});
 	}
+
+	return selection;
 }
 
 Request::Request(TypeMap && operationTypes)
@@ -1508,7 +2673,7 @@ std::pair<std::string, const peg::ast_node*> Request::findOperationDefinition(co
 	peg::for_each_child<peg::operation_definition>(root,
 		[this, &operationName, &result](const peg::ast_node & operationDefinition)
 		{
-			std::string operationType(strQuery);
+			std::string_view operationType = strQuery;
 
 			peg::on_first_child<peg::operation_type>(operationDefinition,
 				[&operationType](const peg::ast_node & child)
@@ -1516,7 +2681,7 @@ std::pair<std::string, const peg::ast_node*> Request::findOperationDefinition(co
 					operationType = child.string_view();
 				});
 
-			std::string name;
+			std::string_view name;
 
 			peg::on_first_child<peg::operation_name>(operationDefinition,
 				[&name](const peg::ast_node & child)
@@ -1531,56 +2696,224 @@ std::pair<std::string, const peg::ast_node*> Request::findOperationDefinition(co
 				return;
 			}
 
-			std::vector<std::string> errors;
-			auto position = operationDefinition.begin();
+			validateOperation(operationName, operationType, name, operationDefinition, result.second != nullptr);
+			result = { std::string { operationType }, &operationDefinition };
+		});
+
+	return result;
+}
+
+std::pair<std::string, const peg::ast_node*> Request::findOperationDefinition(const peg::ast& query, const std::string& operationName) const
+{
+	return query.operations
+		? findOperationDefinition(*query.operations, operationName)
+		: findOperationDefinition(*query.root, operationName);
+}
+
+std::pair<std::string, const peg::ast_node*> Request::findOperationDefinition(const peg::OperationIndex& operations, const std::string& operationName) const
+{
+	std::pair<std::string, const peg::ast_node*> result = { {}, nullptr };
+	const auto select = [this, &operationName, &result](const peg::OperationIndex::Operation & operation)
+	{
+		validateOperation(operationName, operation.type, operation.name, *operation.definition, result.second != nullptr);
+		result = { std::string { operation.type }, operation.definition };
+	};
+
+	// Any match after the first one throws an exception, so this never looks at more than two of them.
+	if (operationName.empty())
+	{
+		for (const auto& operation : operations.operations)
+		{
+			select(operation);
+		}
+	}
+	else
+	{
+		auto itr = operations.names.find(operationName);
 
-			if (result.second)
+		if (itr != operations.names.cend())
+		{
+			for (auto position : itr->second)
 			{
-				std::ostringstream message;
+				select(operations.operations[position]);
+			}
+		}
+	}
+
+	return result;
+}
 
-				message << (operationName.empty()
-					? "Multiple ambigious operations"
-					: "Duplicate named operations");
+void Request::validateOperation(const std::string& operationName, std::string_view operationType, std::string_view name, const peg::ast_node& operationDefinition, bool duplicate) const
+{
+	std::vector<std::string> errors;
+	auto position = operationDefinition.begin();
 
-				if (!name.empty())
-				{
-					message << " name: " << name;
-				}
+	if (duplicate)
+	{
+		std::ostringstream message;
 
-				message << " line: " << position.line
-					<< " column: " << position.byte_in_line;
+		message << (operationName.empty()
+			? "Multiple ambigious operations"
+			: "Duplicate named operations");
+
+		if (!name.empty())
+		{
+			message << " name: " << name;
+		}
+
+		message << " line: " << position.line
+			<< " column: " << position.byte_in_line;
+
+		errors.push_back(message.str());
+	}
+
+	auto itr = _operations.find(std::string { operationType });
 
-				errors.push_back(message.str());
+	if (itr == _operations.cend())
+	{
+		std::ostringstream message;
+
+		message << "Unsupported operation type: " << operationType;
+
+		if (!name.empty())
+		{
+			message << " name: " << name;
+		}
+
+		message << " line: " << position.line
+			<< " column: " << position.byte_in_line;
+
+		errors.push_back(message.str());
+	}
+
+	if (!errors.empty())
+	{
+		throw schema_exception(std::move(errors));
+	}
+}
+
+void Request::validateDepth(const peg::ast_node& operationDefinition, const FragmentMap& fragments) const
+{
+	// Measure the depth of the fields with an explicit stack, since the whole point is to reject the
+	// queries which would use too much stack. Each fragment is measured once, and a fragment which
+	// spreads itself would make the SelectionVisitor loop forever, so that's an error too.
+	struct Frame
+	{
+		const peg::ast_node* selectionSet;
+		size_t level;
+		const std::string* fragmentName;
+		size_t nextChild;
+		size_t depth;
+	};
+
+	std::unordered_map<std::string_view, size_t> fragmentDepths;
+	std::unordered_set<std::string_view> expanding;
+	std::vector<Frame> frames { { operationDefinition.children.back().get(), 0, nullptr, 0, 0 } };
+	size_t depth = 0;
+
+	while (!frames.empty())
+	{
+		auto& frame = frames.back();
+
+		if (frame.nextChild == frame.selectionSet->children.size())
+		{
+			const auto frameDepth = frame.level + frame.depth;
+
+			if (frame.fragmentName)
+			{
+				fragmentDepths[*frame.fragmentName] = frame.depth;
+				expanding.erase(*frame.fragmentName);
 			}
 
-			auto itr = _operations.find(operationType);
+			frames.pop_back();
 
-			if (itr == _operations.cend())
+			if (frames.empty())
+			{
+				depth = frameDepth;
+			}
+			else
 			{
-				std::ostringstream message;
+				frames.back().depth = std::max(frames.back().depth, frameDepth);
+			}
+
+			continue;
+		}
 
-				message << "Unsupported operation type: " << operationType;
+		const auto& selection = *frame.selectionSet->children[frame.nextChild++];
+		const peg::ast_node* selectionSet = nullptr;
+		const std::string* fragmentName = nullptr;
+		size_t level = 0;
 
-				if (!name.empty())
+		if (selection.is_type<peg::field>())
+		{
+			frame.depth = std::max(frame.depth, size_t(1));
+			level = 1;
+
+			peg::on_first_child<peg::selection_set>(selection,
+				[&selectionSet](const peg::ast_node & child)
 				{
-					message << " name: " << name;
-				}
+					selectionSet = &child;
+				});
+		}
+		else if (selection.is_type<peg::inline_fragment>())
+		{
+			peg::on_first_child<peg::selection_set>(selection,
+				[&selectionSet](const peg::ast_node & child)
+				{
+					selectionSet = &child;
+				});
+		}
+		else if (selection.is_type<peg::fragment_spread>())
+		{
+			// The SelectionVisitor reports unknown fragments.
+			auto itr = fragments.find(selection.children.front()->string());
 
-				message << " line: " << position.line
-					<< " column: " << position.byte_in_line;
+			if (itr == fragments.cend())
+			{
+				continue;
+			}
+
+			auto itrDepth = fragmentDepths.find(itr->first);
 
-				errors.push_back(message.str());
+			if (itrDepth != fragmentDepths.cend())
+			{
+				frame.depth = std::max(frame.depth, itrDepth->second);
+				continue;
 			}
 
-			if (!errors.empty())
+			if (!expanding.insert(itr->first).second)
 			{
-				throw schema_exception(std::move(errors));
+				auto position = selection.begin();
+				std::ostringstream error;
+
+				error << "Cyclic fragment spread name: " << itr->first
+					<< " line: " << position.line
+					<< " column: " << position.byte_in_line;
+
+				throw schema_exception({ error.str() });
 			}
 
-			result = { std::move(operationType), &operationDefinition };
-		});
+			selectionSet = &itr->second.getSelection();
+			fragmentName = &itr->first;
+		}
 
-	return result;
+		if (selectionSet)
+		{
+			frames.push_back({ selectionSet, level, fragmentName, 0, 0 });
+		}
+	}
+
+	const size_t maxDepth = _maxDepth;
+
+	if (maxDepth > 0 && depth > maxDepth)
+	{
+		std::ostringstream error;
+
+		error << "Exceeded maximum depth: " << maxDepth
+			<< " depth: " << depth;
+
+		throw schema_exception({ error.str() });
+	}
 }
 
 std::future<response::Value> Request::resolve(const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const std::string& operationName, response::Value&& variables) const
@@ -1589,6 +2922,39 @@ std::future<response::Value> Request::resolve(const std::shared_ptr<RequestState
 }
 
 std::future<response::Value> Request::resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const std::string& operationName, response::Value&& variables) const
+{
+	return resolveOperation(launch, state, root, nullptr, operationName, std::move(variables), nullptr);
+}
+
+std::future<void> Request::resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const std::string& operationName, response::Value&& variables, response::Writer& writer) const
+{
+	return std::async(std::launch::deferred,
+		[](std::future<response::Value>&& result)
+		{
+			result.get();
+		}, resolveOperation(launch, state, root, nullptr, operationName, std::move(variables), &writer));
+}
+
+std::future<response::Value> Request::resolve(const std::shared_ptr<RequestState>& state, const peg::ast& query, const std::string& operationName, response::Value&& variables) const
+{
+	return resolve(std::launch::deferred, state, query, operationName, std::move(variables));
+}
+
+std::future<response::Value> Request::resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast& query, const std::string& operationName, response::Value&& variables) const
+{
+	return resolveOperation(launch, state, *query.root, query.operations.get(), operationName, std::move(variables), nullptr);
+}
+
+std::future<void> Request::resolve(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast& query, const std::string& operationName, response::Value&& variables, response::Writer& writer) const
+{
+	return std::async(std::launch::deferred,
+		[](std::future<response::Value>&& result)
+		{
+			result.get();
+		}, resolveOperation(launch, state, *query.root, query.operations.get(), operationName, std::move(variables), &writer));
+}
+
+std::future<response::Value> Request::resolveOperation(std::launch launch, const std::shared_ptr<RequestState>& state, const peg::ast_node& root, const peg::OperationIndex* operations, const std::string& operationName, response::Value&& variables, response::Writer* writer) const
 {
 	FragmentDefinitionVisitor fragmentVisitor(variables);
 
@@ -1602,7 +2968,20 @@ std::future<response::Value> Request::resolve(std::launch launch, const std::sha
 
 	try
 	{
-		auto operationDefinition = findOperationDefinition(root, operationName);
+		if (state && state->cancellation)
+		{
+			state->cancellation->check();
+		}
+
+		if (state && state->memory)
+		{
+			state->memory->chargeParseTree(root);
+			state->memory->check();
+		}
+
+		auto operationDefinition = operations
+			? findOperationDefinition(*operations, operationName)
+			: findOperationDefinition(root, operationName);
 
 		if (!operationDefinition.second)
 		{
@@ -1631,7 +3010,9 @@ std::future<response::Value> Request::resolve(std::launch launch, const std::sha
 			throw schema_exception({ message.str() });
 		}
 
-		OperationDefinitionVisitor operationVisitor(state, _operations, std::move(variables), std::move(fragments));
+		validateDepth(*operationDefinition.second, fragments);
+
+		OperationDefinitionVisitor operationVisitor(state, _operations, std::move(variables), std::move(fragments), writer, std::atomic_load(&_instrumentation));
 
 		operationVisitor.visit(launch, operationDefinition.first, *operationDefinition.second);
 
@@ -1644,6 +3025,13 @@ std::future<response::Value> Request::resolve(std::launch launch, const std::sha
 
 		document.emplace_back(std::string{ strData }, response::Value());
 		document.emplace_back(std::string{ strErrors }, ex.getErrors());
+
+		if (writer)
+		{
+			writer->add_value(std::move(document));
+			document = response::Value(response::Type::Map);
+		}
+
 		promise.set_value(std::move(document));
 
 		return promise.get_future();
@@ -1661,7 +3049,7 @@ SubscriptionKey Request::subscribe(SubscriptionParams && params, SubscriptionCal
 		});
 
 	auto fragments = fragmentVisitor.getFragments();
-	auto operationDefinition = findOperationDefinition(*params.query.root, params.operationName);
+	auto operationDefinition = findOperationDefinition(params.query, params.operationName);
 
 	if (!operationDefinition.second)
 	{
@@ -1690,6 +3078,15 @@ SubscriptionKey Request::subscribe(SubscriptionParams && params, SubscriptionCal
 		throw schema_exception({ message.str() });
 	}
 
+	validateDepth(*operationDefinition.second, fragments);
+
+	// The subscription keeps its parse tree until it's removed, and every delivery is charged to the same budget.
+	if (params.state && params.state->memory)
+	{
+		params.state->memory->chargeParseTree(*params.query.root);
+		params.state->memory->check();
+	}
+
 	auto itr = _operations.find(std::string{ strSubscription });
 	SubscriptionDefinitionVisitor subscriptionVisitor(std::move(params), std::move(callback), std::move(fragments), itr->second);
 
@@ -1775,6 +3172,8 @@ void Request::deliver(const SubscriptionName & name, const SubscriptionFilterCal
 		return;
 	}
 
+	const auto instrumentation = std::atomic_load(&_instrumentation);
+
 	for (const auto& key : itrListeners->second)
 	{
 		auto itrSubscription = _subscriptions.find(key);
@@ -1808,22 +3207,73 @@ void Request::deliver(const SubscriptionName & name, const SubscriptionFilterCal
 			continue;
 		}
 
+		// The subscription keeps its document, so the signature is only computed the first time it's delivered
+		// to an Instrumentation. The literals are hidden to group the subscriptions with different arguments.
+		if (instrumentation && !registration->data->signature)
+		{
+			registration->data->signature = std::make_shared<const peg::QuerySignature>(
+				peg::getQuerySignature(*registration->query.root, registration->operationName, true));
+		}
+
 		std::future<response::Value> result;
+		const auto memory = (registration->data->state ? registration->data->state->memory : nullptr);
+
+		// Don't resolve anything once the subscription has gone over its MemoryBudget.
+		if (memory && memory->exceeded())
+		{
+			std::promise<response::Value> promise;
+			response::Value document(response::Type::Map);
+
+			document.emplace_back(std::string{ strData }, response::Value());
+			document.emplace_back(std::string{ strErrors }, getMemoryBudgetErrors(*memory));
+			promise.set_value(std::move(document));
+
+			registration->callback(promise.get_future());
+			continue;
+		}
+
+		const auto listener = (instrumentation
+			? instrumentation->beginOperation(registration->data->state, strSubscription, registration->operationName, registration->data->signature.get())
+			: nullptr);
 		response::Value emptyFragmentDirectives(response::Type::Map);
+		auto arena = std::make_shared<ResultArena>();
 		const SelectionSetParams selectionSetParams {
 			registration->data->state,
 			registration->data->directives,
 			emptyFragmentDirectives,
 			emptyFragmentDirectives,
-			emptyFragmentDirectives
+			emptyFragmentDirectives,
+			nullptr,
+			0,
+			nullptr,
+			registration->data->cancellation.get(),
+			listener.get(),
+			ResponsePath(),
+			arena.get()
 		};
 
 		try
 		{
 			result = std::async(std::launch::deferred,
-				[registration](std::future<response::Value> document)
+				// Keep the arena alive until the deferred result has been resolved.
+				[registration, listener, memory, arena = std::move(arena)](std::future<response::Value> document)
 				{
-					return document.get();
+					auto value = document.get();
+
+					// Replace the partial result with a single error, just like Request::resolve.
+					if (memory && memory->exceeded())
+					{
+						value = response::Value(response::Type::Map);
+						value.emplace_back(std::string{ strData }, response::Value());
+						value.emplace_back(std::string{ strErrors }, getMemoryBudgetErrors(*memory));
+					}
+
+					if (listener)
+					{
+						addExtensions(*listener, value, nullptr);
+					}
+
+					return value;
 				}, optionalOrDefaultSubscription->resolve(selectionSetParams, registration->selection, registration->data->fragments, registration->data->variables));
 		}
 		catch (schema_exception & ex)
@@ -1841,4 +3291,14 @@ void Request::deliver(const SubscriptionName & name, const SubscriptionFilterCal
 	}
 }
 
+void Request::setInstrumentation(std::shared_ptr<Instrumentation> instrumentation)
+{
+	std::atomic_store(&_instrumentation, std::move(instrumentation));
+}
+
+void Request::setMaxDepth(size_t maxDepth)
+{
+	_maxDepth = maxDepth;
+}
+
 } /* namespace graphql::service */
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <graphqlservice/GraphQLTracing.h>
+
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace graphql::service {
+
+namespace {
+
+// Durations are reported in nanoseconds, which only fit in response::IntType for about 2 seconds.
+response::Value getNanoseconds(std::chrono::steady_clock::duration duration)
+{
+	const auto count = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+	if (count <= std::numeric_limits<response::IntType>::max())
+	{
+		return response::Value(static_cast<response::IntType>(count));
+	}
+
+	return response::Value(static_cast<response::FloatType>(count));
+}
+
+// Format a timestamp in RFC 3339 format with millisecond precision, e.g. 2017-07-28T14:20:32.106Z.
+response::Value getTimestamp(std::chrono::system_clock::time_point timestamp)
+{
+	const auto time = std::chrono::system_clock::to_time_t(timestamp);
+	const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count() % 1000;
+	std::tm utc {};
+
+#ifdef _WIN32
+	gmtime_s(&utc, &time);
+#else
+	gmtime_r(&time, &utc);
+#endif
+
+	std::ostringstream output;
+
+	output << std::put_time(&utc, "%Y-%m-%dT%H:%M:%S")
+		<< '.' << std::setw(3) << std::setfill('0') << milliseconds << 'Z';
+
+	return response::Value(output.str());
+}
+
+} /* namespace */
+
+std::shared_ptr<OperationListener> ApolloTracing::beginOperation(const std::shared_ptr<RequestState>& /*state*/,
+	std::string_view /*operationType*/, std::string_view /*operationName*/, const peg::QuerySignature* /*signature*/)
+{
+	return std::make_shared<ApolloTracingListener>();
+}
+
+ApolloTracingListener::ApolloTracingListener()
+	: _startTime(std::chrono::system_clock::now())
+	, _start(std::chrono::steady_clock::now())
+{
+}
+
+void ApolloTracingListener::beginField(const ResponsePath& path, std::string_view parentType, std::string_view fieldName)
+{
+	const auto startOffset = std::chrono::steady_clock::now() - _start;
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_pending[path.get()] = _resolvers.size();
+	_resolvers.push_back({ path, std::string(parentType), std::string(fieldName), startOffset, std::chrono::steady_clock::duration::zero() });
+}
+
+void ApolloTracingListener::endField(const ResponsePath& path, std::string_view /*parentType*/, std::string_view /*fieldName*/,
+	std::chrono::steady_clock::duration duration, bool /*error*/)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto itr = _pending.find(path.get());
+
+	if (itr == _pending.end())
+	{
+		return;
+	}
+
+	_resolvers[itr->second].duration = duration;
+	_pending.erase(itr);
+}
+
+void ApolloTracingListener::endOperation(response::Value& extensions)
+{
+	const auto duration = std::chrono::steady_clock::now() - _start;
+	std::lock_guard<std::mutex> lock(_mutex);
+	response::Value resolvers(response::Type::List);
+
+	resolvers.reserve(_resolvers.size());
+
+	for (const auto& timing : _resolvers)
+	{
+		response::Value resolver(response::Type::Map);
+
+		resolver.reserve(5);
+		resolver.emplace_back("path", getPathValue(timing.path));
+		resolver.emplace_back("parentType", response::Value(std::string(timing.parentType)));
+		resolver.emplace_back("fieldName", response::Value(std::string(timing.fieldName)));
+		resolver.emplace_back("startOffset", getNanoseconds(timing.startOffset));
+		resolver.emplace_back("duration", getNanoseconds(timing.duration));
+		resolvers.emplace_back(std::move(resolver));
+	}
+
+	response::Value execution(response::Type::Map);
+
+	execution.emplace_back("resolvers", std::move(resolvers));
+
+	response::Value tracing(response::Type::Map);
+
+	tracing.reserve(5);
+	tracing.emplace_back("version", response::Value(1));
+	tracing.emplace_back("startTime", getTimestamp(_startTime));
+	tracing.emplace_back("endTime", getTimestamp(_startTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(duration)));
+	tracing.emplace_back("duration", getNanoseconds(duration));
+	tracing.emplace_back("execution", std::move(execution));
+
+	extensions.emplace_back("tracing", std::move(tracing));
+}
+
+} /* namespace graphql::service */
@@ -568,12 +568,83 @@ struct ast_selector<input_object_type_extension>
 {
 };
 
+// These rules match the contents after an opening bracket, and they're the only ones which recurse.
+template <typename Rule>
+struct nested_content
+	: std::false_type
+{
+};
+
+template <>
+struct nested_content<selection_set_content>
+	: std::true_type
+{
+};
+
+template <>
+struct nested_content<list_value_content>
+	: std::true_type
+{
+};
+
+template <>
+struct nested_content<object_value_content>
+	: std::true_type
+{
+};
+
+template <>
+struct nested_content<list_type_content>
+	: std::true_type
+{
+};
+
+// Each parse runs on a single thread, and parseString/parseFile reset these before they start.
+static thread_local size_t nestingDepth = 0;
+static thread_local size_t nestingLimit = defaultDepthLimit;
+
 template <typename Rule>
 struct ast_control
 	: normal<Rule>
 {
 	static const std::string error_message;
 
+	template <typename Input, typename... State>
+	static void start(const Input& in, State&&... st)
+	{
+		if constexpr (nested_content<Rule>::value)
+		{
+			if (++nestingDepth > nestingLimit)
+			{
+				throw parse_error("Exceeded nesting depth limit: " + std::to_string(nestingLimit), in);
+			}
+		}
+
+		normal<Rule>::start(in, st...);
+	}
+
+	template <typename Input, typename... State>
+	static void success(const Input& in, State&&... st)
+	{
+		if constexpr (nested_content<Rule>::value)
+		{
+			--nestingDepth;
+		}
+
+		normal<Rule>::success(in, st...);
+	}
+
+	template <typename Input, typename... State>
+	static void failure(const Input& in, State&&... st)
+	{
+		if constexpr (nested_content<Rule>::value)
+		{
+			--nestingDepth;
+		}
+
+		normal<Rule>::failure(in, st...);
+	}
+
 	template <typename Input, typename... State>
 	static void raise(const Input& in, State&&...)
 	{
@@ -639,24 +710,70 @@ template <> const std::string ast_control<enum_type_extension_content>::error_me
 template <> const std::string ast_control<input_object_type_extension_content>::error_message = "Expected https://facebook.github.io/graphql/June2018/#InputObjectTypeExtension";
 template <> const std::string ast_control<document_content>::error_message = "Expected https://facebook.github.io/graphql/June2018/#Document";
 
-ast parseString(std::string_view input)
+std::shared_ptr<const OperationIndex> indexOperations(const ast_node& root)
+{
+	auto result = std::make_shared<OperationIndex>();
+
+	for_each_child<operation_definition>(root,
+		[&result](const ast_node & child)
+		{
+			OperationIndex::Operation operation { "query", {}, &child };
+
+			on_first_child<operation_type>(child,
+				[&operation](const ast_node & type)
+				{
+					operation.type = type.string_view();
+				});
+
+			on_first_child<operation_name>(child,
+				[&operation](const ast_node & name)
+				{
+					operation.name = name.string_view();
+				});
+
+			if (!operation.name.empty())
+			{
+				result->names[operation.name].push_back(result->operations.size());
+			}
+
+			result->operations.push_back(operation);
+		});
+
+	return result;
+}
+
+ast parseString(std::string_view input, size_t depthLimit)
 {
 	ast result{ std::make_shared<ast_input>(ast_input{ std::vector<char>{ input.cbegin(), input.cend() } }), {}};
 	const auto& data = std::get<std::vector<char>>(result.input->data);
 	memory_input<> in(data.data(), data.size(), "GraphQL");
 
+	nestingDepth = 0;
+	nestingLimit = depthLimit;
 	result.root = parse_tree::parse<document, ast_node, ast_selector, nothing, ast_control>(std::move(in));
 
+	if (result.root)
+	{
+		result.operations = indexOperations(*result.root);
+	}
+
 	return result;
 }
 
-ast parseFile(std::string_view filename)
+ast parseFile(std::string_view filename, size_t depthLimit)
 {
 	ast result{ std::make_shared<ast_input>(ast_input{ std::make_unique<file_input<>>(filename) }), {} };
 	auto& in = *std::get<std::unique_ptr<file_input<>>>(result.input->data);
 
+	nestingDepth = 0;
+	nestingLimit = depthLimit;
 	result.root = parse_tree::parse<document, ast_node, ast_selector, nothing, ast_control>(std::move(in));
 
+	if (result.root)
+	{
+		result.operations = indexOperations(*result.root);
+	}
+
 	return result;
 }
 
@@ -666,10 +783,20 @@ peg::ast operator "" _graphql(const char* text, size_t size)
 {
 	peg::memory_input<> in(text, size, "GraphQL");
 
-	return {
+	peg::nestingDepth = 0;
+	peg::nestingLimit = peg::defaultDepthLimit;
+
+	peg::ast result {
 		std::make_shared<peg::ast_input>(peg::ast_input{ { std::string_view{ text, size } } }),
 		peg::parse_tree::parse<peg::document, peg::ast_node, peg::ast_selector, peg::nothing, peg::ast_control>(std::move(in))
 	};
+
+	if (result.root)
+	{
+		result.operations = peg::indexOperations(*result.root);
+	}
+
+	return result;
 }
 
 } /* namespace graphql */
@@ -9,9 +9,11 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
 
 #include <stack>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 
 namespace graphql::response {
@@ -107,6 +109,91 @@ std::string toJSON(Value&& response)
 	return buffer.GetString();
 }
 
+struct JSONWriter::Impl
+{
+	Impl()
+		: writer(buffer)
+	{
+	}
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer;
+};
+
+JSONWriter::JSONWriter()
+	: _impl(std::make_unique<Impl>())
+{
+}
+
+JSONWriter::~JSONWriter()
+{
+}
+
+void JSONWriter::start_object()
+{
+	_impl->writer.StartObject();
+}
+
+void JSONWriter::add_member_key(std::string_view key)
+{
+	_impl->writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+}
+
+void JSONWriter::end_object()
+{
+	_impl->writer.EndObject();
+}
+
+void JSONWriter::start_array()
+{
+	_impl->writer.StartArray();
+}
+
+void JSONWriter::end_array()
+{
+	_impl->writer.EndArray();
+}
+
+void JSONWriter::add_null()
+{
+	_impl->writer.Null();
+}
+
+void JSONWriter::add_string(std::string_view value)
+{
+	_impl->writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+}
+
+void JSONWriter::add_enum(std::string_view value)
+{
+	add_string(value);
+}
+
+void JSONWriter::add_bool(BooleanType value)
+{
+	_impl->writer.Bool(value);
+}
+
+void JSONWriter::add_int(IntType value)
+{
+	_impl->writer.Int(value);
+}
+
+void JSONWriter::add_float(FloatType value)
+{
+	_impl->writer.Double(value);
+}
+
+void JSONWriter::add_value(Value&& value)
+{
+	writeResponse(_impl->writer, std::move(value));
+}
+
+std::string JSONWriter::get_json() const
+{
+	return _impl->buffer.GetString();
+}
+
 struct ResponseHandler
 	: rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ResponseHandler>
 {
@@ -250,4 +337,120 @@ Value parseJSON(const std::string& json)
 	return handler.getResponse();
 }
 
+// Forward each of the SAX events to a Writer instead of building a Value.
+struct WriterHandler
+	: rapidjson::BaseReaderHandler<rapidjson::UTF8<>, WriterHandler>
+{
+	explicit WriterHandler(Writer& writer)
+		: _writer(writer)
+	{
+	}
+
+	bool Null()
+	{
+		_writer.add_null();
+		return true;
+	}
+
+	bool Bool(bool b)
+	{
+		_writer.add_bool(b);
+		return true;
+	}
+
+	bool Int(int i)
+	{
+		// https://facebook.github.io/graphql/June2018/#sec-Int
+		static_assert(sizeof(i) == 4, "GraphQL only supports 32-bit signed integers");
+		_writer.add_int(i);
+		return true;
+	}
+
+	bool Uint(unsigned int i)
+	{
+		if (i > static_cast<unsigned int>(std::numeric_limits<int>::max()))
+		{
+			// https://facebook.github.io/graphql/June2018/#sec-Int
+			throw std::overflow_error("GraphQL only supports 32-bit signed integers");
+		}
+		return Int(static_cast<int>(i));
+	}
+
+	bool Int64(int64_t /*i*/)
+	{
+		// https://facebook.github.io/graphql/June2018/#sec-Int
+		throw std::overflow_error("GraphQL only supports 32-bit signed integers");
+	}
+
+	bool Uint64(uint64_t /*i*/)
+	{
+		// https://facebook.github.io/graphql/June2018/#sec-Int
+		throw std::overflow_error("GraphQL only supports 32-bit signed integers");
+	}
+
+	bool Double(double d)
+	{
+		_writer.add_float(d);
+		return true;
+	}
+
+	bool String(const Ch* str, rapidjson::SizeType length, bool /*copy*/)
+	{
+		_writer.add_string({ str, length });
+		return true;
+	}
+
+	bool StartObject()
+	{
+		_writer.start_object();
+		return true;
+	}
+
+	bool Key(const Ch* str, rapidjson::SizeType length, bool /*copy*/)
+	{
+		_writer.add_member_key({ str, length });
+		return true;
+	}
+
+	bool EndObject(rapidjson::SizeType /*count*/)
+	{
+		_writer.end_object();
+		return true;
+	}
+
+	bool StartArray()
+	{
+		_writer.start_array();
+		return true;
+	}
+
+	bool EndArray(rapidjson::SizeType /*count*/)
+	{
+		_writer.end_array();
+		return true;
+	}
+
+private:
+	Writer& _writer;
+};
+
+void parseJSON(const std::string& json, Writer& writer)
+{
+	WriterHandler handler(writer);
+	rapidjson::Reader reader;
+	rapidjson::StringStream ss(json.c_str());
+	const auto result = reader.Parse(ss, handler);
+
+	// The Writer has already seen part of the document, so the caller needs to discard it.
+	if (result.IsError())
+	{
+		std::ostringstream error;
+
+		error << "JSON parse error: " << rapidjson::GetParseError_En(result.Code())
+			<< " offset: " << result.Offset();
+
+		throw std::runtime_error(error.str());
+	}
+}
+
 } /* namespace graphql::response */
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "SchemaGenerator.h"
+
+#ifdef USE_BOOST_FILESYSTEM
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace graphql;
+
+namespace {
+
+constexpr size_t c_enumValueCount = 300;
+constexpr size_t c_unionMemberCount = 100;
+constexpr size_t c_interfacesPerObject = 4;
+
+// Build a synthetic schema with roughly typeCount types. Every object type implements several
+// interfaces and references other object types, and there are some large enums and unions.
+std::string makeSchema(size_t typeCount)
+{
+	const size_t interfaceCount = std::max<size_t>(typeCount / 20, 1);
+	const size_t enumCount = std::max<size_t>(typeCount / 100, 1);
+	const size_t unionCount = std::max<size_t>(typeCount / 100, 1);
+	const size_t inputCount = std::max<size_t>(typeCount / 50, 1);
+	const size_t fixedCount = interfaceCount + enumCount + unionCount + inputCount;
+	const size_t objectCount = std::max<size_t>(typeCount > fixedCount ? typeCount - fixedCount : 0, 1);
+	std::ostringstream schema;
+
+	schema << R"gql(schema {
+	query: Query
+}
+
+)gql";
+
+	for (size_t i = 0; i < interfaceCount; ++i)
+	{
+		schema << "interface Node" << i << R"gql( {
+	id: ID!
+	node)gql" << i << R"gql(Value: Int
+}
+
+)gql";
+	}
+
+	for (size_t i = 0; i < enumCount; ++i)
+	{
+		schema << "enum Enum" << i << " {\n";
+
+		for (size_t j = 0; j < c_enumValueCount; ++j)
+		{
+			schema << "\tVALUE_" << j << "\n";
+		}
+
+		schema << "}\n\n";
+	}
+
+	for (size_t i = 0; i < inputCount; ++i)
+	{
+		schema << "input Input" << i << R"gql( {
+	first: Int!
+	after: String = "start"
+	filter: Enum)gql" << (i % enumCount) << R"gql(
+}
+
+)gql";
+	}
+
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		const size_t implementsCount = std::min(c_interfacesPerObject, interfaceCount);
+
+		schema << "type Type" << i << " implements";
+
+		for (size_t j = 0; j < implementsCount; ++j)
+		{
+			schema << (j == 0 ? " " : " & ") << "Node" << ((i + j) % interfaceCount);
+		}
+
+		schema << R"gql( {
+	id: ID!
+)gql";
+
+		for (size_t j = 0; j < implementsCount; ++j)
+		{
+			schema << "\tnode" << ((i + j) % interfaceCount) << "Value: Int\n";
+		}
+
+		schema << "\tnext: Type" << ((i + 1) % objectCount) << R"gql(
+	list(input: Input)gql" << (i % inputCount) << R"gql(, status: Enum)gql" << (i % enumCount)
+			<< R"gql( = VALUE_0): [Type)gql" << ((i + 7) % objectCount) << R"gql(!]!
+	status: Enum)gql" << (i % enumCount) << R"gql(!
+	value: Float
+}
+
+)gql";
+	}
+
+	for (size_t i = 0; i < unionCount; ++i)
+	{
+		const size_t memberCount = std::min(c_unionMemberCount, objectCount);
+
+		schema << "union Union" << i << " =";
+
+		for (size_t j = 0; j < memberCount; ++j)
+		{
+			schema << (j == 0 ? " " : " | ") << "Type" << ((i * c_unionMemberCount + j) % objectCount);
+		}
+
+		schema << "\n\n";
+	}
+
+	schema << "type Query {\n";
+
+	for (size_t i = 0; i < interfaceCount; ++i)
+	{
+		schema << "\tnode" << i << "(id: ID!): Node" << i << "\n";
+	}
+
+	for (size_t i = 0; i < unionCount; ++i)
+	{
+		schema << "\tunion" << i << ": [Union" << i << "!]!\n";
+	}
+
+	schema << "}\n";
+
+	return schema.str();
+}
+
+// Generate the files for one schema size in this process, so the memory usage only covers that size.
+int generateSchema(size_t typeCount)
+{
+	const auto outputDir = fs::temp_directory_path() / "schemagen_benchmark" / std::to_string(typeCount);
+	const auto schemaPath = (outputDir / "schema.benchmark.graphql").string();
+
+	// Start from an empty directory every time, otherwise schemagen would skip writing the files which
+	// are still the same as the last run.
+	fs::remove_all(outputDir);
+	fs::create_directories(outputDir);
+
+	{
+		std::ofstream schemaFile(schemaPath, std::ios_base::trunc);
+
+		schemaFile << makeSchema(typeCount);
+	}
+
+	std::cerr << "Schema with " << typeCount << " types: " << schemaPath << std::endl;
+
+	schema::GeneratorOptions options;
+
+	options.customSchema.emplace(schema::GeneratorSchema{
+		schemaPath,
+		"Benchmark",
+		"benchmark"
+	});
+	options.paths.emplace(schema::GeneratorPaths{
+		outputDir.string(),
+		outputDir.string()
+	});
+	options.separateFiles = true;
+
+	// Each phase reports its time and the memory usage of the process when it ends.
+	options.timing = true;
+
+	try
+	{
+		schema::PhaseTimer totalTimer{ true, "total" };
+		const auto files = schema::Generator(std::move(options)).Build();
+
+		std::cerr << "Generated files: " << files.size() << std::endl;
+	}
+	catch (const std::runtime_error& ex)
+	{
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+} /* namespace */
+
+int main(int argc, char** argv)
+{
+	std::vector<size_t> typeCounts;
+
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			typeCounts.push_back(static_cast<size_t>(std::stoul(argv[i])));
+		}
+	}
+	catch (const std::logic_error&)
+	{
+		std::cerr << "Usage:\tschemagen_benchmark [<type count>...]" << std::endl;
+		return 1;
+	}
+
+	if (typeCounts.empty())
+	{
+		typeCounts = { 1000, 5000, 20000 };
+	}
+
+	if (typeCounts.size() == 1)
+	{
+		return generateSchema(typeCounts.front());
+	}
+
+	// The peak memory usage of a process never goes down, so run each schema size in a new process.
+	for (const auto typeCount : typeCounts)
+	{
+		std::ostringstream command;
+
+		command << '"' << argv[0] << "\" " << typeCount;
+
+		if (std::system(command.str().c_str()) != 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -13,12 +13,30 @@ namespace fs = boost::filesystem;
 namespace fs = std::filesystem;
 #endif
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cctype>
 #include <regex>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+#endif
 
 
 namespace graphql::schema {
@@ -72,6 +90,104 @@ bool NamespaceScope::exit() noexcept
 	return false;
 }
 
+PhaseTimer::PhaseTimer(bool enabled, std::string_view phase) noexcept
+	: _enabled(enabled)
+	, _phase(phase)
+	, _startMemoryKB(enabled ? getResidentMemoryKB() : 0)
+	, _startPeakMemoryKB(enabled ? getPeakMemoryKB() : 0)
+	, _start(std::chrono::steady_clock::now())
+{
+}
+
+PhaseTimer::~PhaseTimer() noexcept
+{
+	if (_enabled)
+	{
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _start);
+		const auto memoryKB = getResidentMemoryKB();
+		const auto peakMemoryKB = getPeakMemoryKB();
+
+		std::cerr << "Timing: " << _phase << ": " << elapsed.count() << "ms";
+
+		if (memoryKB > 0)
+		{
+			const auto growthKB = static_cast<std::ptrdiff_t>(memoryKB) - static_cast<std::ptrdiff_t>(_startMemoryKB);
+
+			std::cerr << " memory: " << memoryKB << "KB (" << (growthKB < 0 ? "" : "+") << growthKB << "KB)";
+		}
+
+		if (peakMemoryKB > _startPeakMemoryKB)
+		{
+			std::cerr << " new peak: " << peakMemoryKB << "KB";
+		}
+
+		std::cerr << std::endl;
+	}
+}
+
+size_t PhaseTimer::getResidentMemoryKB() noexcept
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters {};
+
+	if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return static_cast<size_t>(counters.WorkingSetSize / 1024);
+	}
+
+	return 0;
+#elif defined(__APPLE__)
+	mach_task_basic_info_data_t info {};
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+	{
+		return 0;
+	}
+
+	return static_cast<size_t>(info.resident_size / 1024);
+#else
+	// The second field in statm is the number of resident pages.
+	std::ifstream statm("/proc/self/statm");
+	size_t totalPages = 0;
+	size_t residentPages = 0;
+
+	if (!(statm >> totalPages >> residentPages))
+	{
+		return 0;
+	}
+
+	return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+#endif
+}
+
+size_t PhaseTimer::getPeakMemoryKB() noexcept
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters {};
+
+	if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return static_cast<size_t>(counters.PeakWorkingSetSize / 1024);
+	}
+
+	return 0;
+#else
+	struct rusage usage {};
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0;
+	}
+
+#if defined(__APPLE__)
+	// macOS reports ru_maxrss in bytes instead of kilobytes.
+	return static_cast<size_t>(usage.ru_maxrss / 1024);
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
 
 const std::string Generator::s_introspectionNamespace = "introspection";
 
@@ -158,9 +274,33 @@ Generator::Generator(GeneratorOptions&& options)
 				fullPath /= (_options.customSchema->filenamePrefix + "Schema.cpp");
 			}
 
+			return fullPath.string();
+		}())
+	, _clientHeaderPath([this]() noexcept -> std::string {
+			if (!_options.operationsFilename)
+			{
+				return {};
+			}
+
+			fs::path fullPath{ _headerDir };
+
+			fullPath /= (_options.customSchema->filenamePrefix + "Client.h");
+			return fullPath.string();
+		}())
+	, _clientSourcePath([this]() noexcept -> std::string {
+			if (!_options.operationsFilename)
+			{
+				return {};
+			}
+
+			fs::path fullPath{ _sourceDir };
+
+			fullPath /= (_options.customSchema->filenamePrefix + "Client.cpp");
 			return fullPath.string();
 		}())
 {
+	std::optional<PhaseTimer> parseTimer{ std::in_place, _options.timing, "parse schema" };
+
 	if (_isIntrospection)
 	{
 		// Introspection Schema: https://facebook.github.io/graphql/June2018/#sec-Schema-Introspection
@@ -284,7 +424,20 @@ Generator::Generator(GeneratorOptions&& options)
 		}
 	}
 
-	validateSchema();
+	parseTimer.reset();
+
+	{
+		PhaseTimer validateTimer{ _options.timing, "validate schema" };
+
+		validateSchema();
+	}
+
+	if (_options.operationsFilename)
+	{
+		PhaseTimer operationsTimer{ _options.timing, "parse client operations" };
+
+		visitClientOperations();
+	}
 }
 
 void Generator::validateSchema()
@@ -521,305 +674,682 @@ void Generator::fixupInputFieldList(InputFieldList& fields)
 	}
 }
 
-void Generator::visitDefinition(const peg::ast_node& definition)
+void Generator::visitClientOperations()
 {
-	if (definition.is_type<peg::schema_definition>())
-	{
-		visitSchemaDefinition(definition);
-	}
-	else if (definition.is_type<peg::schema_extension>())
-	{
-		visitSchemaExtension(definition);
-	}
-	else if (definition.is_type<peg::scalar_type_definition>())
-	{
-		visitScalarTypeDefinition(definition);
-	}
-	else if (definition.is_type<peg::enum_type_definition>())
-	{
-		visitEnumTypeDefinition(definition);
-	}
-	else if (definition.is_type<peg::enum_type_extension>())
-	{
-		visitEnumTypeExtension(definition);
-	}
-	else if (definition.is_type<peg::input_object_type_definition>())
-	{
-		visitInputObjectTypeDefinition(definition);
-	}
-	else if (definition.is_type<peg::input_object_type_extension>())
-	{
-		visitInputObjectTypeExtension(definition);
-	}
-	else if (definition.is_type<peg::union_type_definition>())
-	{
-		visitUnionTypeDefinition(definition);
-	}
-	else if (definition.is_type<peg::union_type_extension>())
-	{
-		visitUnionTypeExtension(definition);
-	}
-	else if (definition.is_type<peg::interface_type_definition>())
-	{
-		visitInterfaceTypeDefinition(definition);
-	}
-	else if (definition.is_type<peg::interface_type_extension>())
-	{
-		visitInterfaceTypeExtension(definition);
-	}
-	else if (definition.is_type<peg::object_type_definition>())
-	{
-		visitObjectTypeDefinition(definition);
-	}
-	else if (definition.is_type<peg::object_type_extension>())
-	{
-		visitObjectTypeExtension(definition);
-	}
-	else if (definition.is_type<peg::directive_definition>())
+	std::ifstream operationsFile(*_options.operationsFilename, std::ios_base::in | std::ios_base::binary);
+
+	if (!operationsFile)
 	{
-		visitDirectiveDefinition(definition);
+		throw std::runtime_error("Unable to read the client operations: " + *_options.operationsFilename);
 	}
-}
 
-void Generator::visitSchemaDefinition(const peg::ast_node& schemaDefinition)
-{
-	peg::for_each_child<peg::root_operation_definition>(schemaDefinition,
-		[this](const peg::ast_node & child)
-		{
-			std::string operation(child.children.front()->string_view());
-			std::string name(child.children.back()->string_view());
-			std::string cppName(getSafeCppName(name));
+	std::ostringstream requestText;
 
-			_operationTypes.push_back({ std::move(name), std::move(cppName), std::move(operation) });
-		});
-}
+	requestText << operationsFile.rdbuf();
+	_requestText = requestText.str();
 
-void Generator::visitSchemaExtension(const peg::ast_node& schemaExtension)
-{
-	peg::for_each_child<peg::operation_type_definition>(schemaExtension,
-		[this](const peg::ast_node & child)
-	{
-		std::string operation(child.children.front()->string_view());
-		std::string name(child.children.back()->string_view());
-		std::string cppName(getSafeCppName(name));
+	auto ast = peg::parseString(_requestText);
 
-		_operationTypes.push_back({ std::move(name), std::move(cppName), std::move(operation) });
-	});
-}
+	if (!ast.root)
+	{
+		throw std::logic_error("Unable to parse the client operations, but there was no error message from the parser!");
+	}
 
-void Generator::visitObjectTypeDefinition(const peg::ast_node& objectTypeDefinition)
-{
-	std::string name;
-	std::string description;
+	std::unordered_map<std::string, const peg::ast_node*> fragments;
 
-	peg::on_first_child<peg::object_name>(objectTypeDefinition,
-		[&name](const peg::ast_node & child)
+	peg::for_each_child<peg::fragment_definition>(*ast.root,
+		[&fragments](const peg::ast_node& fragmentDefinition)
 		{
-			name = child.string_view();
+			fragments[fragmentDefinition.children.front()->string()] = &fragmentDefinition;
 		});
 
-	peg::on_first_child<peg::description>(objectTypeDefinition,
-		[&description](const peg::ast_node & child)
+	peg::for_each_child<peg::operation_definition>(*ast.root,
+		[this, &fragments](const peg::ast_node& operationDefinition)
 		{
-			description = child.children.front()->unescaped;
-		});
+			ClientOperation operation;
 
-	_schemaTypes[name] = SchemaType::Object;
-	_typePositions.emplace(name, objectTypeDefinition.begin());
-	_objectNames[name] = _objectTypes.size();
-
-	auto cppName = getSafeCppName(name);
+			operation.operation = service::strQuery;
 
-	_objectTypes.push_back({ std::move(name), std::move(cppName), {}, {}, std::move(description) });
+			peg::on_first_child<peg::operation_type>(operationDefinition,
+				[&operation](const peg::ast_node& child)
+				{
+					operation.operation = child.string_view();
+				});
 
-	visitObjectTypeExtension(objectTypeDefinition);
-}
+			peg::on_first_child<peg::operation_name>(operationDefinition,
+				[&operation](const peg::ast_node& child)
+				{
+					operation.name = child.string_view();
+				});
 
-void Generator::visitObjectTypeExtension(const peg::ast_node& objectTypeExtension)
-{
-	std::string name;
+			if (operation.name.empty())
+			{
+				std::ostringstream error;
+				auto position = operationDefinition.begin();
 
-	peg::on_first_child<peg::object_name>(objectTypeExtension,
-		[&name](const peg::ast_node & child)
-		{
-			name = child.string_view();
-		});
+				error << "Client operations must be named"
+					<< " line: " << position.line
+					<< " column: " << position.byte_in_line;
 
-	const auto itrType = _objectNames.find(name);
+				throw std::runtime_error(error.str());
+			}
 
-	if (itrType != _objectNames.cend())
-	{
-		auto& objectType = _objectTypes[itrType->second];
+			auto itrOperationType = std::find_if(_operationTypes.cbegin(), _operationTypes.cend(),
+				[&operation](const OperationType& operationType) noexcept
+				{
+					return operationType.operation == operation.operation;
+				});
 
-		peg::for_each_child<peg::interface_type>(objectTypeExtension,
-			[&objectType](const peg::ast_node & child)
+			if (itrOperationType == _operationTypes.cend())
 			{
-				objectType.interfaces.push_back(child.string());
-			});
+				std::ostringstream error;
+				auto position = operationDefinition.begin();
 
-		peg::on_first_child<peg::fields_definition>(objectTypeExtension,
-			[&objectType](const peg::ast_node & child)
-			{
-				auto fields = getOutputFields(child.children);
+				error << "Unsupported operation type: " << operation.operation
+					<< " line: " << position.line
+					<< " column: " << position.byte_in_line;
 
-				objectType.fields.reserve(objectType.fields.size() + fields.size());
-				for (auto& field : fields)
-				{
-					objectType.fields.push_back(std::move(field));
-				}
-			});
-	}
-}
+				throw std::runtime_error(error.str());
+			}
 
-void Generator::visitInterfaceTypeDefinition(const peg::ast_node& interfaceTypeDefinition)
-{
-	std::string name;
-	std::string description;
+			peg::for_each_child<peg::variable>(operationDefinition,
+				[&operation](const peg::ast_node& variable)
+				{
+					InputField field;
+					TypeVisitor variableType;
 
-	peg::on_first_child<peg::interface_name>(interfaceTypeDefinition,
-		[&name](const peg::ast_node & child)
-		{
-			name = child.string_view();
-		});
+					for (const auto& child : variable.children)
+					{
+						if (child->is_type<peg::variable_name>())
+						{
+							// Skip the $ prefix
+							field.name = child->string_view().substr(1);
+							field.cppName = getSafeCppName(field.name);
+						}
+						else if (child->is_type<peg::named_type>()
+							|| child->is_type<peg::list_type>()
+							|| child->is_type<peg::nonnull_type>())
+						{
+							variableType.visit(*child);
+						}
+						else if (child->is_type<peg::default_value>())
+						{
+							field.defaultValueString = child->children.back()->string_view();
+						}
+					}
 
-	peg::on_first_child<peg::description>(interfaceTypeDefinition,
-		[&description](const peg::ast_node & child)
-		{
-			description = child.children.front()->unescaped;
-		});
+					std::tie(field.type, field.modifiers) = variableType.getType();
+					field.position = variable.begin();
+					operation.variables.push_back(std::move(field));
+				});
 
-	_schemaTypes[name] = SchemaType::Interface;
-	_typePositions.emplace(name, interfaceTypeDefinition.begin());
-	_interfaceNames[name] = _interfaceTypes.size();
+			fixupInputFieldList(operation.variables);
 
-	auto cppName = getSafeCppName(name);
+			peg::on_first_child<peg::selection_set>(operationDefinition,
+				[this, &operation, &fragments, &itrOperationType](const peg::ast_node& selectionSet)
+				{
+					std::vector<std::string> fragmentPath;
 
-	_interfaceTypes.push_back({ std::move(name), std::move(cppName), {}, std::move(description) });
+					addResponseFields(operation.responseFields, itrOperationType->type, selectionSet, fragments, fragmentPath, false);
+				});
 
-	visitInterfaceTypeExtension(interfaceTypeDefinition);
+			_clientOperations.push_back(std::move(operation));
+		});
 }
 
-void Generator::visitInterfaceTypeExtension(const peg::ast_node& interfaceTypeExtension)
+void Generator::addResponseFields(ResponseFieldList& fields, const std::string& type, const peg::ast_node& selectionSet, const std::unordered_map<std::string, const peg::ast_node*>& fragments, std::vector<std::string>& fragmentPath, bool conditional) const
 {
-	std::string name;
-
-	peg::on_first_child<peg::interface_name>(interfaceTypeExtension,
-		[&name](const peg::ast_node & child)
+	for (const auto& selection : selectionSet.children)
+	{
+		if (selection->is_type<peg::fragment_spread>())
 		{
-			name = child.string_view();
-		});
+			const auto fragmentName = selection->children.front()->string();
+			auto itrFragment = fragments.find(fragmentName);
 
-	const auto itrType = _interfaceNames.find(name);
+			if (itrFragment == fragments.cend())
+			{
+				std::ostringstream error;
+				auto position = selection->begin();
 
-	if (itrType != _interfaceNames.cend())
-	{
-		auto& interfaceType = _interfaceTypes[itrType->second];
+				error << "Unknown fragment name: " << fragmentName
+					<< " line: " << position.line
+					<< " column: " << position.byte_in_line;
 
-		peg::on_first_child<peg::fields_definition>(interfaceTypeExtension,
-			[&interfaceType](const peg::ast_node & child)
+				throw std::runtime_error(error.str());
+			}
+
+			// A fragment which spreads itself, directly or through other fragments, would never finish.
+			if (std::find(fragmentPath.cbegin(), fragmentPath.cend(), fragmentName) != fragmentPath.cend())
 			{
-				auto fields = getOutputFields(child.children);
+				std::ostringstream error;
+				auto position = selection->begin();
 
-				interfaceType.fields.reserve(interfaceType.fields.size() + fields.size());
-				for (auto& field : fields)
+				error << "Fragment cycle:";
+
+				for (const auto& name : fragmentPath)
 				{
-					interfaceType.fields.push_back(std::move(field));
+					error << " " << name << " ->";
 				}
+
+				error << " " << fragmentName
+					<< " line: " << position.line
+					<< " column: " << position.byte_in_line;
+
+				throw std::runtime_error(error.str());
+			}
+
+			const auto& fragmentDefinition = *itrFragment->second;
+			const auto typeCondition = fragmentDefinition.children[1]->children.front()->string();
+
+			fragmentPath.push_back(fragmentName);
+			addResponseFields(fields, typeCondition, *fragmentDefinition.children.back(), fragments, fragmentPath,
+				conditional || hasConditionalDirective(*selection) || !matchesTypeCondition(type, typeCondition));
+			fragmentPath.pop_back();
+			continue;
+		}
+		else if (selection->is_type<peg::inline_fragment>())
+		{
+			std::string typeCondition = type;
+			const bool conditionalFragment = conditional || hasConditionalDirective(*selection);
+
+			peg::on_first_child<peg::type_condition>(*selection,
+				[&typeCondition](const peg::ast_node& child)
+				{
+					typeCondition = child.children.front()->string();
+				});
+
+			peg::on_first_child<peg::selection_set>(*selection,
+				[this, &fields, &type, &fragments, &fragmentPath, &typeCondition, conditionalFragment](const peg::ast_node& child)
+				{
+					addResponseFields(fields, typeCondition, child, fragments, fragmentPath,
+						conditionalFragment || !matchesTypeCondition(type, typeCondition));
+				});
+			continue;
+		}
+		else if (!selection->is_type<peg::field>())
+		{
+			continue;
+		}
+
+		ResponseField field;
+		std::string fieldName;
+		const peg::ast_node* nestedSelection = nullptr;
+
+		peg::on_first_child<peg::field_name>(*selection,
+			[&fieldName](const peg::ast_node& child)
+			{
+				fieldName = child.string_view();
 			});
-	}
-}
 
-void Generator::visitInputObjectTypeDefinition(const peg::ast_node& inputObjectTypeDefinition)
-{
-	std::string name;
-	std::string description;
+		field.name = fieldName;
 
-	peg::on_first_child<peg::object_name>(inputObjectTypeDefinition,
-		[&name](const peg::ast_node & child)
+		peg::on_first_child<peg::alias_name>(*selection,
+			[&field](const peg::ast_node& child)
+			{
+				field.name = child.string_view();
+			});
+
+		peg::on_first_child<peg::selection_set>(*selection,
+			[&nestedSelection](const peg::ast_node& child)
+			{
+				nestedSelection = &child;
+			});
+
+		field.cppName = getSafeCppName(field.name);
+
+		if (fieldName == R"gql(__typename)gql")
 		{
-			name = child.string_view();
-		});
+			field.type = R"gql(String)gql";
+		}
+		else
+		{
+			// Unions only have the __typename field.
+			static const OutputFieldList noFields;
+			const OutputFieldList* outputFields = &noFields;
+			auto itrObject = _objectNames.find(type);
 
-	peg::on_first_child<peg::description>(inputObjectTypeDefinition,
-		[&description](const peg::ast_node & child)
+			if (itrObject != _objectNames.cend())
+			{
+				outputFields = &_objectTypes[itrObject->second].fields;
+			}
+			else
+			{
+				auto itrInterface = _interfaceNames.find(type);
+
+				if (itrInterface != _interfaceNames.cend())
+				{
+					outputFields = &_interfaceTypes[itrInterface->second].fields;
+				}
+			}
+
+			auto itrField = std::find_if(outputFields->cbegin(), outputFields->cend(),
+				[&fieldName](const OutputField& outputField) noexcept
+				{
+					return outputField.name == fieldName;
+				});
+
+			if (itrField == outputFields->cend())
+			{
+				std::ostringstream error;
+				auto position = selection->begin();
+
+				error << "Unknown field name: " << type << "." << fieldName
+					<< " line: " << position.line
+					<< " column: " << position.byte_in_line;
+
+				throw std::runtime_error(error.str());
+			}
+
+			field.type = itrField->type;
+			field.fieldType = itrField->fieldType;
+			field.modifiers = itrField->modifiers;
+		}
+
+		switch (field.fieldType)
 		{
-			description = child.children.front()->unescaped;
-		});
+			case OutputFieldType::Object:
+			case OutputFieldType::Interface:
+			case OutputFieldType::Union:
+				if (nestedSelection == nullptr)
+				{
+					std::ostringstream error;
+					auto position = selection->begin();
 
-	_schemaTypes[name] = SchemaType::Input;
-	_typePositions.emplace(name, inputObjectTypeDefinition.begin());
-	_inputNames[name] = _inputTypes.size();
+					error << "Missing selection set on field: " << type << "." << fieldName
+						<< " line: " << position.line
+						<< " column: " << position.byte_in_line;
 
-	auto cppName = getSafeCppName(name);
+					throw std::runtime_error(error.str());
+				}
+				break;
 
-	_inputTypes.push_back({ std::move(name), std::move(cppName), {}, std::move(description) });
+			default:
+				nestedSelection = nullptr;
+				break;
+		}
 
-	visitInputObjectTypeExtension(inputObjectTypeDefinition);
+		// Fields in a fragment with a different type condition, or which may be skipped, may be missing from
+		// the response.
+		if ((conditional || hasConditionalDirective(*selection))
+			&& (field.modifiers.empty()
+				|| field.modifiers.front() != service::TypeModifier::Nullable))
+		{
+			field.modifiers.insert(field.modifiers.begin(), service::TypeModifier::Nullable);
+		}
+
+		auto itrExisting = std::find_if(fields.begin(), fields.end(),
+			[&field](const ResponseField& existing) noexcept
+			{
+				return existing.name == field.name;
+			});
+
+		if (itrExisting == fields.end())
+		{
+			itrExisting = fields.insert(fields.end(), std::move(field));
+		}
+
+		// Merge the selection sets if the same response key is selected more than once.
+		if (nestedSelection != nullptr)
+		{
+			addResponseFields(itrExisting->children, itrExisting->type, *nestedSelection, fragments, fragmentPath, false);
+		}
+	}
 }
 
-void Generator::visitInputObjectTypeExtension(const peg::ast_node& inputObjectTypeExtension)
+bool Generator::hasConditionalDirective(const peg::ast_node& selection) noexcept
 {
-	std::string name;
+	bool result = false;
 
-	peg::on_first_child<peg::object_name>(inputObjectTypeExtension,
-		[&name](const peg::ast_node & child)
+	peg::on_first_child<peg::directives>(selection,
+		[&result](const peg::ast_node& directives)
 		{
-			name = child.string_view();
+			for (const auto& directive : directives.children)
+			{
+				peg::on_first_child<peg::directive_name>(*directive,
+					[&result](const peg::ast_node& child)
+					{
+						const auto name = child.string_view();
+
+						result = result || name == R"gql(skip)gql" || name == R"gql(include)gql";
+					});
+			}
 		});
 
-	const auto itrType = _inputNames.find(name);
+	return result;
+}
 
-	if (itrType != _inputNames.cend())
+bool Generator::matchesTypeCondition(const std::string& type, const std::string& typeCondition) const noexcept
+{
+	if (type == typeCondition)
 	{
-		auto& inputType = _inputTypes[itrType->second];
+		return true;
+	}
 
-		peg::on_first_child<peg::input_fields_definition>(inputObjectTypeExtension,
-			[&inputType](const peg::ast_node & child)
-			{
-				auto fields = getInputFields(child.children);
+	auto itrObject = _objectNames.find(type);
 
-				inputType.fields.reserve(inputType.fields.size() + fields.size());
-				for (auto& field : fields)
-				{
-					inputType.fields.push_back(std::move(field));
-				}
-			});
+	if (itrObject == _objectNames.cend())
+	{
+		return false;
+	}
+
+	const auto& interfaces = _objectTypes[itrObject->second].interfaces;
+
+	if (std::find(interfaces.cbegin(), interfaces.cend(), typeCondition) != interfaces.cend())
+	{
+		return true;
 	}
+
+	auto itrUnion = _unionNames.find(typeCondition);
+
+	if (itrUnion == _unionNames.cend())
+	{
+		return false;
+	}
+
+	const auto& options = _unionTypes[itrUnion->second].options;
+
+	return std::find(options.cbegin(), options.cend(), type) != options.cend();
 }
 
-void Generator::visitEnumTypeDefinition(const peg::ast_node& enumTypeDefinition)
+void Generator::visitDefinition(const peg::ast_node& definition)
+{
+	if (definition.is_type<peg::schema_definition>())
+	{
+		visitSchemaDefinition(definition);
+	}
+	else if (definition.is_type<peg::schema_extension>())
+	{
+		visitSchemaExtension(definition);
+	}
+	else if (definition.is_type<peg::scalar_type_definition>())
+	{
+		visitScalarTypeDefinition(definition);
+	}
+	else if (definition.is_type<peg::enum_type_definition>())
+	{
+		visitEnumTypeDefinition(definition);
+	}
+	else if (definition.is_type<peg::enum_type_extension>())
+	{
+		visitEnumTypeExtension(definition);
+	}
+	else if (definition.is_type<peg::input_object_type_definition>())
+	{
+		visitInputObjectTypeDefinition(definition);
+	}
+	else if (definition.is_type<peg::input_object_type_extension>())
+	{
+		visitInputObjectTypeExtension(definition);
+	}
+	else if (definition.is_type<peg::union_type_definition>())
+	{
+		visitUnionTypeDefinition(definition);
+	}
+	else if (definition.is_type<peg::union_type_extension>())
+	{
+		visitUnionTypeExtension(definition);
+	}
+	else if (definition.is_type<peg::interface_type_definition>())
+	{
+		visitInterfaceTypeDefinition(definition);
+	}
+	else if (definition.is_type<peg::interface_type_extension>())
+	{
+		visitInterfaceTypeExtension(definition);
+	}
+	else if (definition.is_type<peg::object_type_definition>())
+	{
+		visitObjectTypeDefinition(definition);
+	}
+	else if (definition.is_type<peg::object_type_extension>())
+	{
+		visitObjectTypeExtension(definition);
+	}
+	else if (definition.is_type<peg::directive_definition>())
+	{
+		visitDirectiveDefinition(definition);
+	}
+}
+
+void Generator::visitSchemaDefinition(const peg::ast_node& schemaDefinition)
+{
+	peg::for_each_child<peg::root_operation_definition>(schemaDefinition,
+		[this](const peg::ast_node & child)
+		{
+			std::string operation(child.children.front()->string_view());
+			std::string name(child.children.back()->string_view());
+			std::string cppName(getSafeCppName(name));
+
+			_operationTypes.push_back({ std::move(name), std::move(cppName), std::move(operation) });
+		});
+}
+
+void Generator::visitSchemaExtension(const peg::ast_node& schemaExtension)
+{
+	peg::for_each_child<peg::operation_type_definition>(schemaExtension,
+		[this](const peg::ast_node & child)
+	{
+		std::string operation(child.children.front()->string_view());
+		std::string name(child.children.back()->string_view());
+		std::string cppName(getSafeCppName(name));
+
+		_operationTypes.push_back({ std::move(name), std::move(cppName), std::move(operation) });
+	});
+}
+
+void Generator::visitObjectTypeDefinition(const peg::ast_node& objectTypeDefinition)
 {
 	std::string name;
 	std::string description;
 
-	peg::on_first_child<peg::enum_name>(enumTypeDefinition,
+	peg::on_first_child<peg::object_name>(objectTypeDefinition,
 		[&name](const peg::ast_node & child)
 		{
 			name = child.string_view();
 		});
 
-	peg::on_first_child<peg::description>(enumTypeDefinition,
+	peg::on_first_child<peg::description>(objectTypeDefinition,
 		[&description](const peg::ast_node & child)
 		{
 			description = child.children.front()->unescaped;
 		});
 
-	_schemaTypes[name] = SchemaType::Enum;
-	_typePositions.emplace(name, enumTypeDefinition.begin());
-	_enumNames[name] = _enumTypes.size();
+	_schemaTypes[name] = SchemaType::Object;
+	_typePositions.emplace(name, objectTypeDefinition.begin());
+	_objectNames[name] = _objectTypes.size();
 
 	auto cppName = getSafeCppName(name);
 
-	_enumTypes.push_back({ std::move(name), std::move(cppName), {}, std::move(description) });
+	_objectTypes.push_back({ std::move(name), std::move(cppName), {}, {}, std::move(description) });
 
-	visitEnumTypeExtension(enumTypeDefinition);
+	visitObjectTypeExtension(objectTypeDefinition);
 }
 
-void Generator::visitEnumTypeExtension(const peg::ast_node& enumTypeExtension)
+void Generator::visitObjectTypeExtension(const peg::ast_node& objectTypeExtension)
 {
 	std::string name;
 
-	peg::on_first_child<peg::enum_name>(enumTypeExtension,
+	peg::on_first_child<peg::object_name>(objectTypeExtension,
+		[&name](const peg::ast_node & child)
+		{
+			name = child.string_view();
+		});
+
+	const auto itrType = _objectNames.find(name);
+
+	if (itrType != _objectNames.cend())
+	{
+		auto& objectType = _objectTypes[itrType->second];
+
+		peg::for_each_child<peg::interface_type>(objectTypeExtension,
+			[&objectType](const peg::ast_node & child)
+			{
+				objectType.interfaces.push_back(child.string());
+			});
+
+		peg::on_first_child<peg::fields_definition>(objectTypeExtension,
+			[&objectType](const peg::ast_node & child)
+			{
+				auto fields = getOutputFields(child.children);
+
+				objectType.fields.reserve(objectType.fields.size() + fields.size());
+				for (auto& field : fields)
+				{
+					objectType.fields.push_back(std::move(field));
+				}
+			});
+	}
+}
+
+void Generator::visitInterfaceTypeDefinition(const peg::ast_node& interfaceTypeDefinition)
+{
+	std::string name;
+	std::string description;
+
+	peg::on_first_child<peg::interface_name>(interfaceTypeDefinition,
+		[&name](const peg::ast_node & child)
+		{
+			name = child.string_view();
+		});
+
+	peg::on_first_child<peg::description>(interfaceTypeDefinition,
+		[&description](const peg::ast_node & child)
+		{
+			description = child.children.front()->unescaped;
+		});
+
+	_schemaTypes[name] = SchemaType::Interface;
+	_typePositions.emplace(name, interfaceTypeDefinition.begin());
+	_interfaceNames[name] = _interfaceTypes.size();
+
+	auto cppName = getSafeCppName(name);
+
+	_interfaceTypes.push_back({ std::move(name), std::move(cppName), {}, std::move(description) });
+
+	visitInterfaceTypeExtension(interfaceTypeDefinition);
+}
+
+void Generator::visitInterfaceTypeExtension(const peg::ast_node& interfaceTypeExtension)
+{
+	std::string name;
+
+	peg::on_first_child<peg::interface_name>(interfaceTypeExtension,
+		[&name](const peg::ast_node & child)
+		{
+			name = child.string_view();
+		});
+
+	const auto itrType = _interfaceNames.find(name);
+
+	if (itrType != _interfaceNames.cend())
+	{
+		auto& interfaceType = _interfaceTypes[itrType->second];
+
+		peg::on_first_child<peg::fields_definition>(interfaceTypeExtension,
+			[&interfaceType](const peg::ast_node & child)
+			{
+				auto fields = getOutputFields(child.children);
+
+				interfaceType.fields.reserve(interfaceType.fields.size() + fields.size());
+				for (auto& field : fields)
+				{
+					interfaceType.fields.push_back(std::move(field));
+				}
+			});
+	}
+}
+
+void Generator::visitInputObjectTypeDefinition(const peg::ast_node& inputObjectTypeDefinition)
+{
+	std::string name;
+	std::string description;
+
+	peg::on_first_child<peg::object_name>(inputObjectTypeDefinition,
+		[&name](const peg::ast_node & child)
+		{
+			name = child.string_view();
+		});
+
+	peg::on_first_child<peg::description>(inputObjectTypeDefinition,
+		[&description](const peg::ast_node & child)
+		{
+			description = child.children.front()->unescaped;
+		});
+
+	_schemaTypes[name] = SchemaType::Input;
+	_typePositions.emplace(name, inputObjectTypeDefinition.begin());
+	_inputNames[name] = _inputTypes.size();
+
+	auto cppName = getSafeCppName(name);
+
+	_inputTypes.push_back({ std::move(name), std::move(cppName), {}, std::move(description) });
+
+	visitInputObjectTypeExtension(inputObjectTypeDefinition);
+}
+
+void Generator::visitInputObjectTypeExtension(const peg::ast_node& inputObjectTypeExtension)
+{
+	std::string name;
+
+	peg::on_first_child<peg::object_name>(inputObjectTypeExtension,
+		[&name](const peg::ast_node & child)
+		{
+			name = child.string_view();
+		});
+
+	const auto itrType = _inputNames.find(name);
+
+	if (itrType != _inputNames.cend())
+	{
+		auto& inputType = _inputTypes[itrType->second];
+
+		peg::on_first_child<peg::input_fields_definition>(inputObjectTypeExtension,
+			[&inputType](const peg::ast_node & child)
+			{
+				auto fields = getInputFields(child.children);
+
+				inputType.fields.reserve(inputType.fields.size() + fields.size());
+				for (auto& field : fields)
+				{
+					inputType.fields.push_back(std::move(field));
+				}
+			});
+	}
+}
+
+void Generator::visitEnumTypeDefinition(const peg::ast_node& enumTypeDefinition)
+{
+	std::string name;
+	std::string description;
+
+	peg::on_first_child<peg::enum_name>(enumTypeDefinition,
+		[&name](const peg::ast_node & child)
+		{
+			name = child.string_view();
+		});
+
+	peg::on_first_child<peg::description>(enumTypeDefinition,
+		[&description](const peg::ast_node & child)
+		{
+			description = child.children.front()->unescaped;
+		});
+
+	_schemaTypes[name] = SchemaType::Enum;
+	_typePositions.emplace(name, enumTypeDefinition.begin());
+	_enumNames[name] = _enumTypes.size();
+
+	auto cppName = getSafeCppName(name);
+
+	_enumTypes.push_back({ std::move(name), std::move(cppName), {}, std::move(description) });
+
+	visitEnumTypeExtension(enumTypeDefinition);
+}
+
+void Generator::visitEnumTypeExtension(const peg::ast_node& enumTypeExtension)
+{
+	std::string name;
+
+	peg::on_first_child<peg::enum_name>(enumTypeExtension,
 		[&name](const peg::ast_node & child)
 		{
 			name = child.string_view();
@@ -1022,19 +1552,32 @@ const std::string& Generator::getSafeCppName(const std::string& type) noexcept
 	static const std::regex multiple_(R"re(_{2,})re", std::regex::optimize | std::regex::ECMAScript);
 	static const std::regex leading_Capital(R"re(^_([A-Z]))re", std::regex::optimize | std::regex::ECMAScript);
 
-	// Cache the substitutions so we don't need to repeat a replacement.
+	// Cache the substitutions so we don't need to repeat a replacement. The separate files are
+	// written on several threads, so the cache is guarded by a mutex. Rehashing doesn't move the
+	// nodes, so the references we return stay valid after the lock is released.
+	static std::mutex safeNamesMutex;
 	static std::unordered_map<std::string, std::string> safeNames;
-	auto itr = safeNames.find(type);
 
-	if (safeNames.cend() == itr
-		&& (std::regex_search(type, leading_Capital)
-			|| std::regex_search(type, multiple_)))
 	{
-		std::tie(itr, std::ignore) = safeNames.emplace(type,
-			std::regex_replace(std::regex_replace(type, multiple_, R"re(_)re"), leading_Capital, R"re($1)re"));
+		std::lock_guard<std::mutex> lock(safeNamesMutex);
+		auto itr = safeNames.find(type);
+
+		if (safeNames.cend() != itr)
+		{
+			return itr->second;
+		}
+	}
+
+	if (!std::regex_search(type, leading_Capital)
+		&& !std::regex_search(type, multiple_))
+	{
+		return type;
 	}
 
-	return (safeNames.cend() == itr) ? type : itr->second;
+	auto safeName = std::regex_replace(std::regex_replace(type, multiple_, R"re(_)re"), leading_Capital, R"re($1)re");
+	std::lock_guard<std::mutex> lock(safeNamesMutex);
+
+	return safeNames.emplace(type, std::move(safeName)).first->second;
 }
 
 OutputFieldList Generator::getOutputFields(const std::vector<std::unique_ptr<peg::ast_node>>& fields)
@@ -1111,6 +1654,10 @@ OutputFieldList Generator::getOutputFields(const std::vector<std::unique_ptr<peg
 
 							field.deprecationReason = std::move(deprecationReason);
 						}
+						else if (directiveName == "batch")
+						{
+							field.batch = true;
+						}
 					});
 			}
 		}
@@ -1319,22 +1866,46 @@ response::Value Generator::DefaultValueVisitor::getValue()
 	return response::Value(std::move(_value));
 }
 
-std::vector<std::string> Generator::Build() const noexcept
+std::vector<std::string> Generator::Build() const
 {
 	std::vector<std::string> builtFiles;
 
-	if (outputHeader() && _options.verbose)
 	{
-		builtFiles.push_back(_headerPath);
+		PhaseTimer headerTimer{ _options.timing, "output header" };
+
+		if (outputHeader() && _options.verbose)
+		{
+			builtFiles.push_back(_headerPath);
+		}
+	}
+
+	{
+		PhaseTimer sourceTimer{ _options.timing, "output source" };
+
+		if (outputSource())
+		{
+			builtFiles.push_back(_sourcePath);
+		}
 	}
 
-	if (outputSource())
+	if (_options.operationsFilename)
 	{
-		builtFiles.push_back(_sourcePath);
+		PhaseTimer clientTimer{ _options.timing, "output client" };
+
+		if (outputClientHeader() && _options.verbose)
+		{
+			builtFiles.push_back(_clientHeaderPath);
+		}
+
+		if (outputClientSource())
+		{
+			builtFiles.push_back(_clientSourcePath);
+		}
 	}
 
 	if (_options.separateFiles)
 	{
+		PhaseTimer separateFilesTimer{ _options.timing, "output separate files" };
 		auto separateFiles = outputSeparateFiles();
 
 		for (auto& file : separateFiles)
@@ -1486,10 +2057,44 @@ std::string Generator::getOutputCppType(const OutputField & field) const noexcep
 	return outputType.str();
 }
 
+bool Generator::writeIfChanged(const std::string& path, const std::string& content) noexcept
+{
+	// Leave the file (and its timestamp) alone if the content has not changed, so only the
+	// generated files which actually changed need to be recompiled.
+	{
+		std::ifstream existingFile(path, std::ios_base::in | std::ios_base::binary);
+
+		if (existingFile)
+		{
+			std::ostringstream existingContent;
+
+			existingContent << existingFile.rdbuf();
+
+			if (existingContent.str() == content)
+			{
+				return true;
+			}
+		}
+	}
+
+	std::ofstream outputFile(path, std::ios_base::trunc | std::ios_base::binary);
+
+	outputFile << content;
+
+	return static_cast<bool>(outputFile);
+}
+
 bool Generator::outputHeader() const noexcept
 {
-	std::ofstream headerFile(_headerPath, std::ios_base::trunc);
+	std::ostringstream headerFile;
+
+	outputHeader(headerFile);
 
+	return writeIfChanged(_headerPath, headerFile.str());
+}
+
+void Generator::outputHeader(std::ostream& headerFile) const noexcept
+{
 	headerFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
@@ -1504,21 +2109,24 @@ bool Generator::outputHeader() const noexcept
 )cpp";
 
 	NamespaceScope graphqlNamespace{ headerFile, "graphql" };
-	NamespaceScope introspectionNamespace{ headerFile, s_introspectionNamespace };
+	NamespaceScope introspectionNamespace{ headerFile, s_introspectionNamespace, _options.noIntrospection };
 	NamespaceScope schemaNamespace{ headerFile, _schemaNamespace, true };
 	NamespaceScope objectNamespace{ headerFile, "object", true };
 
-	headerFile << R"cpp(
+	if (!_options.noIntrospection)
+	{
+		headerFile << R"cpp(
 class Schema;
 )cpp";
 
-	if (_options.separateFiles)
-	{
-		headerFile << R"cpp(class ObjectType;
+		if (_options.separateFiles)
+		{
+			headerFile << R"cpp(class ObjectType;
 )cpp";
-	}
+		}
 
-	headerFile << std::endl;
+		headerFile << std::endl;
+	}
 
 	std::string queryType;
 
@@ -1533,8 +2141,11 @@ class Schema;
 			}
 		}
 
-		introspectionNamespace.exit();
-		headerFile << std::endl;
+		if (introspectionNamespace.exit())
+		{
+			headerFile << std::endl;
+		}
+
 		schemaNamespace.enter();
 		headerFile << std::endl;
 	}
@@ -1710,7 +2321,7 @@ private:
 		}
 	}
 
-	if (!_objectTypes.empty() && _options.separateFiles)
+	if (!_objectTypes.empty() && _options.separateFiles && !_options.noIntrospection)
 	{
 		for (const auto& objectType : _objectTypes)
 		{
@@ -1725,11 +2336,12 @@ private:
 		headerFile << std::endl;
 	}
 
-	headerFile << R"cpp(void AddTypesToSchema(std::shared_ptr<)cpp" << s_introspectionNamespace << R"cpp(::Schema> schema);
+	if (!_options.noIntrospection)
+	{
+		headerFile << R"cpp(void AddTypesToSchema(std::shared_ptr<)cpp" << s_introspectionNamespace << R"cpp(::Schema> schema);
 
 )cpp";
-
-	return true;
+	}
 }
 
 void Generator::outputObjectDeclaration(std::ostream& headerFile, const ObjectType& objectType, bool isQueryType) const
@@ -1769,10 +2381,29 @@ public:
 			}
 
 			headerFile << getFieldDeclaration(outputField);
+
+			if (outputField.batch)
+			{
+				headerFile << getBatchFieldDeclaration(objectType, outputField);
+			}
+		}
+
+		if (std::any_of(objectType.fields.cbegin(), objectType.fields.cend(),
+			[](const OutputField& outputField) noexcept
+			{
+				return outputField.batch;
+			}))
+		{
+			headerFile << R"cpp(
+	static constexpr bool hasBatchResolvers = true;
+)cpp";
 		}
 
 		headerFile << R"cpp(
 private:
+	static const service::TypeNames& getTypeNames();
+	static const service::ObjectResolverMap& getResolvers();
+
 )cpp";
 
 		for (const auto& outputField : objectType.fields)
@@ -1781,13 +2412,13 @@ private:
 		}
 
 		headerFile << R"cpp(
-	std::future<response::Value> resolve_typename(service::ResolverParams&& params);
+	std::future<response::Value> resolve_typename(service::ResolverParams&& params) const;
 )cpp";
 
-		if (isQueryType)
+		if (isQueryType && !_options.noIntrospection)
 		{
-			headerFile << R"cpp(	std::future<response::Value> resolve_schema(service::ResolverParams&& params);
-	std::future<response::Value> resolve_type(service::ResolverParams&& params);
+			headerFile << R"cpp(	std::future<response::Value> resolve_schema(service::ResolverParams&& params) const;
+	std::future<response::Value> resolve_type(service::ResolverParams&& params) const;
 
 	std::shared_ptr<)cpp" << s_introspectionNamespace << R"cpp(::Schema> _schema;
 )cpp";
@@ -1838,14 +2469,37 @@ std::string Generator::getFieldDeclaration(const OutputField& outputField) const
 	return output.str();
 }
 
-std::string Generator::getResolverDeclaration(const OutputField & outputField) const noexcept
+std::string Generator::getBatchFieldDeclaration(const ObjectType& objectType, const OutputField& outputField) const noexcept
 {
 	std::ostringstream output;
-	std::string fieldName(outputField.cppName);
+	std::string fieldName{ outputField.cppName };
 
 	fieldName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fieldName[0])));
-	output << R"cpp(	std::future<response::Value> resolve)cpp" << fieldName
-		<< R"cpp((service::ResolverParams&& params);
+	output << R"cpp(	virtual service::FieldResult<std::vector<)cpp" << getOutputCppType(outputField)
+		<< R"cpp(>> )cpp" << outputField.accessor << fieldName
+		<< R"cpp(Batch(service::FieldParams&& params, const std::vector<std::shared_ptr<)cpp" << objectType.cppType
+		<< R"cpp(>>& parents)cpp";
+
+	for (const auto& argument : outputField.arguments)
+	{
+		output << R"cpp(, )cpp" << getInputCppType(argument)
+			<< R"cpp(&& )cpp" << argument.cppName << "Arg";
+	}
+
+	output << R"cpp() const;
+)cpp";
+
+	return output.str();
+}
+
+std::string Generator::getResolverDeclaration(const OutputField & outputField) const noexcept
+{
+	std::ostringstream output;
+	std::string fieldName(outputField.cppName);
+
+	fieldName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fieldName[0])));
+	output << R"cpp(	std::future<response::Value> resolve)cpp" << fieldName
+		<< R"cpp((service::ResolverParams&& params) const;
 )cpp";
 
 	return output.str();
@@ -1853,8 +2507,15 @@ std::string Generator::getResolverDeclaration(const OutputField & outputField) c
 
 bool Generator::outputSource() const noexcept
 {
-	std::ofstream sourceFile(_sourcePath, std::ios_base::trunc);
+	std::ostringstream sourceFile;
+
+	outputSource(sourceFile);
 
+	return writeIfChanged(_sourcePath, sourceFile.str());
+}
+
+void Generator::outputSource(std::ostream& sourceFile) const noexcept
+{
 	sourceFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
@@ -1866,9 +2527,14 @@ bool Generator::outputSource() const noexcept
 )cpp";
 	}
 
-	sourceFile << R"cpp(#include <graphqlservice/Introspection.h>
+	if (!_options.noIntrospection)
+	{
+		sourceFile << R"cpp(#include <graphqlservice/Introspection.h>
+
+)cpp";
+	}
 
-#include <algorithm>
+	sourceFile << R"cpp(#include <algorithm>
 #include <functional>
 #include <sstream>
 #include <unordered_map>
@@ -1878,8 +2544,9 @@ bool Generator::outputSource() const noexcept
 )cpp";
 
 	NamespaceScope graphqlNamespace{ sourceFile, "graphql" };
+	const auto instantiations = getExplicitInstantiations();
 
-	if (!_enumTypes.empty() || !_inputTypes.empty())
+	if (!_enumTypes.empty() || !_inputTypes.empty() || !instantiations.empty())
 	{
 		NamespaceScope serviceNamespace{ sourceFile, "service" };
 
@@ -1909,6 +2576,47 @@ bool Generator::outputSource() const noexcept
 			sourceFile << R"cpp(
 };
 
+static const std::array<std::pair<std::string_view, )cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+				<< R"cpp(>, )cpp" << enumType.values.size()
+				<< R"cpp(> s_sorted)cpp" << enumType.cppType
+				<< R"cpp( = { {
+)cpp";
+
+			// Sort the names so the argument conversion can use a binary search.
+			std::vector<const EnumValueType*> sortedValues(enumType.values.size());
+
+			std::transform(enumType.values.cbegin(), enumType.values.cend(), sortedValues.begin(),
+				[](const EnumValueType& value) noexcept
+			{
+				return &value;
+			});
+			std::sort(sortedValues.begin(), sortedValues.end(),
+				[](const EnumValueType* lhs, const EnumValueType* rhs) noexcept
+			{
+				return lhs->value < rhs->value;
+			});
+
+			firstValue = true;
+
+			for (const auto value : sortedValues)
+			{
+				if (!firstValue)
+				{
+					sourceFile << R"cpp(,
+)cpp";
+				}
+
+				firstValue = false;
+				sourceFile << R"cpp(	{ ")cpp" << value->value
+					<< R"cpp(", )cpp" << _schemaNamespace
+					<< R"cpp(::)cpp" << enumType.cppType
+					<< R"cpp(::)cpp" << value->cppValue
+					<< R"cpp( })cpp";
+			}
+
+			sourceFile << R"cpp(
+} };
+
 template <>
 )cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
 				<< R"cpp( ModifiedArgument<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
@@ -1919,19 +2627,56 @@ template <>
 		throw service::schema_exception({ "not a valid )cpp" << enumType.type << R"cpp( value" });
 	}
 
-	auto itr = std::find(s_names)cpp" << enumType.cppType
-				<< R"cpp(.cbegin(), s_names)cpp" << enumType.cppType
-				<< R"cpp(.cend(), value.get<const response::StringType&>());
+	const std::string_view name = value.get<const response::StringType&>();
+	auto itr = std::lower_bound(s_sorted)cpp" << enumType.cppType
+				<< R"cpp(.cbegin(), s_sorted)cpp" << enumType.cppType
+				<< R"cpp(.cend(), name,
+		[](const auto& entry, std::string_view key) noexcept
+		{
+			return entry.first < key;
+		});
 
-	if (itr == s_names)cpp" << enumType.cppType
-				<< R"cpp(.cend())
+	if (itr == s_sorted)cpp" << enumType.cppType
+				<< R"cpp(.cend() || itr->first != name)
 	{
 		throw service::schema_exception({ "not a valid )cpp" << enumType.type << R"cpp( value" });
 	}
 
-	return static_cast<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
-				<< R"cpp(>(itr - s_names)cpp" << enumType.cppType
-				<< R"cpp(.cbegin());
+	return itr->second;
+}
+
+template <>
+response::Value ModifiedResult<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+<< R"cpp(>::convertValue()cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+<< R"cpp(&& value)
+{
+	// Build each of the enum values once, copying one of them just shares its data.
+	static const auto s_values = []()
+	{
+		std::array<response::Value, )cpp" << enumType.values.size() << R"cpp(> values;
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			response::Value entry(response::Type::EnumValue);
+
+			entry.set<response::StringType>(std::string(s_names)cpp" << enumType.cppType
+				<< R"cpp([i]));
+			values[i] = std::move(entry);
+		}
+
+		return values;
+	}();
+
+	return response::Value(s_values[static_cast<size_t>(value)]);
+}
+
+template <>
+void ModifiedResult<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+<< R"cpp(>::writeValue()cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+<< R"cpp(&& value, response::Writer& writer)
+{
+	writer.add_enum(s_names)cpp" << enumType.cppType
+				<< R"cpp([static_cast<size_t>(value)]);
 }
 
 template <>
@@ -1943,12 +2688,12 @@ std::future<response::Value> ModifiedResult<)cpp" << _schemaNamespace << R"cpp(:
 		[]()cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
 				<< R"cpp(&& value, const ResolverParams&)
 		{
-			response::Value result(response::Type::EnumValue);
-
-			result.set<response::StringType>(std::string(s_names)cpp" << enumType.cppType
-				<< R"cpp([static_cast<size_t>(value)]));
-
-			return result;
+			return convertValue(std::move(value));
+		},
+		[]()cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+				<< R"cpp(&& value, const ResolverParams&, response::Writer& writer)
+		{
+			writeValue(std::move(value), writer);
 		});
 }
 
@@ -1966,6 +2711,8 @@ std::future<response::Value> ModifiedResult<)cpp" << _schemaNamespace << R"cpp(:
 {
 )cpp";
 
+			// The default values are built once in a function-local static, so converting the
+			// input type does not rebuild them on every call.
 			for (const auto& inputField : inputType.fields)
 			{
 				if (inputField.defaultValue.type() != response::Type::Null)
@@ -1973,7 +2720,7 @@ std::future<response::Value> ModifiedResult<)cpp" << _schemaNamespace << R"cpp(:
 					if (firstField)
 					{
 						firstField = false;
-						sourceFile << R"cpp(	const auto defaultValue = []()
+						sourceFile << R"cpp(	static const auto defaultValue = []()
 	{
 		response::Value values(response::Type::Map);
 		response::Value entry;
@@ -2035,6 +2782,20 @@ std::future<response::Value> ModifiedResult<)cpp" << _schemaNamespace << R"cpp(:
 )cpp";
 		}
 
+		if (!instantiations.empty())
+		{
+			sourceFile << R"cpp(// Explicit instantiations for the extern template declarations in )cpp"
+				<< fs::path(_objectHeaderPath).filename().string() << R"cpp(.
+)cpp";
+
+			for (const auto& instantiation : instantiations)
+			{
+				sourceFile << R"cpp(template )cpp" << instantiation;
+			}
+
+			sourceFile << std::endl;
+		}
+
 		serviceNamespace.exit();
 		sourceFile << std::endl;
 	}
@@ -2128,6 +2889,11 @@ Operations::Operations()cpp";
 		sourceFile << std::endl;
 	}
 
+	if (_options.noIntrospection)
+	{
+		return;
+	}
+
 	sourceFile << R"cpp(void AddTypesToSchema(std::shared_ptr<)cpp" << s_introspectionNamespace
 		<< R"cpp(::Schema> schema)
 {
@@ -2325,1008 +3091,2098 @@ Operations::Operations()cpp";
 		sourceFile << R"cpp(
 )cpp";
 
-		for (const auto& unionType : _unionTypes)
-		{
-			if (!unionType.options.empty())
-			{
-				bool firstValue = true;
+		for (const auto& unionType : _unionTypes)
+		{
+			if (!unionType.options.empty())
+			{
+				bool firstValue = true;
+
+				sourceFile << R"cpp(	type)cpp" << unionType.cppType
+					<< R"cpp(->AddPossibleTypes({
+)cpp";
+
+				for (const auto& unionOption : unionType.options)
+				{
+					if (!firstValue)
+					{
+						sourceFile << R"cpp(,
+)cpp";
+					}
+
+					firstValue = false;
+					sourceFile << R"cpp(		schema->LookupType(")cpp" << unionOption
+						<< R"cpp("))cpp";
+				}
+
+				sourceFile << R"cpp(
+	});
+)cpp";
+			}
+		}
+	}
+
+	if (!_interfaceTypes.empty())
+	{
+		sourceFile << R"cpp(
+)cpp";
+
+		for (const auto& interfaceType : _interfaceTypes)
+		{
+			if (!interfaceType.fields.empty())
+			{
+				bool firstValue = true;
+
+				sourceFile << R"cpp(	type)cpp" << interfaceType.cppType
+					<< R"cpp(->AddFields({
+)cpp";
+
+				for (const auto& interfaceField : interfaceType.fields)
+				{
+					if (!firstValue)
+					{
+						sourceFile << R"cpp(,
+)cpp";
+					}
+
+					firstValue = false;
+					sourceFile << R"cpp(		std::make_shared<)cpp" << s_introspectionNamespace
+						<< R"cpp(::Field>(")cpp" << interfaceField.name
+						<< R"cpp(", R"md()cpp" << interfaceField.description
+						<< R"cpp()md", )cpp";
+
+					if (interfaceField.deprecationReason)
+					{
+						sourceFile << R"cpp(std::make_optional<response::StringType>(R"md()cpp" << *interfaceField.deprecationReason << R"cpp()md"))cpp";
+					}
+					else
+					{
+						sourceFile << R"cpp(std::nullopt)cpp";
+					}
+
+					sourceFile << R"cpp(, std::vector<std::shared_ptr<)cpp" << s_introspectionNamespace
+						<< R"cpp(::InputValue>>()cpp";
+
+					if (!interfaceField.arguments.empty())
+					{
+						bool firstArgument = true;
+
+						sourceFile << R"cpp({
+)cpp";
+
+						for (const auto& argument : interfaceField.arguments)
+						{
+							if (!firstArgument)
+							{
+								sourceFile << R"cpp(,
+)cpp";
+							}
+
+							firstArgument = false;
+							sourceFile << R"cpp(			std::make_shared<)cpp" << s_introspectionNamespace
+								<< R"cpp(::InputValue>(")cpp" << argument.name
+								<< R"cpp(", R"md()cpp" << argument.description
+								<< R"cpp()md", )cpp" << getIntrospectionType(argument.type, argument.modifiers)
+								<< R"cpp(, R"gql()cpp" << argument.defaultValueString << R"cpp()gql"))cpp";
+						}
+
+						sourceFile << R"cpp(
+		})cpp";
+					}
+
+					sourceFile << R"cpp(), )cpp" << getIntrospectionType(interfaceField.type, interfaceField.modifiers)
+						<< R"cpp())cpp";
+				}
+
+				sourceFile << R"cpp(
+	});
+)cpp";
+			}
+		}
+	}
+
+	if (!_objectTypes.empty())
+	{
+		sourceFile << R"cpp(
+)cpp";
+
+		for (const auto& objectType : _objectTypes)
+		{
+			if (_options.separateFiles)
+			{
+				sourceFile << R"cpp(	Add)cpp" << objectType.cppType
+					<< R"cpp(Details(type)cpp" << objectType.cppType
+					<< R"cpp(, schema);
+)cpp";
+			}
+			else
+			{
+				outputObjectIntrospection(sourceFile, objectType);
+			}
+		}
+	}
+
+	if (!_directives.empty())
+	{
+		sourceFile << R"cpp(
+)cpp";
+
+		for (const auto& directive : _directives)
+		{
+			sourceFile << R"cpp(	schema->AddDirective(std::make_shared<)cpp" << s_introspectionNamespace
+				<< R"cpp(::Directive>(")cpp" << directive.name
+				<< R"cpp(", R"md()cpp" << directive.description
+				<< R"cpp()md", std::vector<response::StringType>()cpp";
+
+			if (!directive.locations.empty())
+			{
+				bool firstLocation = true;
+
+
+				sourceFile << R"cpp({
+)cpp";
+
+				for (const auto& location : directive.locations)
+				{
+					if (!firstLocation)
+					{
+						sourceFile << R"cpp(,
+)cpp";
+					}
+
+					firstLocation = false;
+					sourceFile << R"cpp(		R"gql()cpp" << location << R"cpp()gql")cpp";
+				}
+
+
+				sourceFile << R"cpp(
+	})cpp";
+			}
+
+			sourceFile << R"cpp(), std::vector<std::shared_ptr<)cpp" << s_introspectionNamespace
+				<< R"cpp(::InputValue>>()cpp";
+
+			if (!directive.arguments.empty())
+			{
+				bool firstArgument = true;
+
+				sourceFile << R"cpp({
+)cpp";
+
+				for (const auto& argument : directive.arguments)
+				{
+					if (!firstArgument)
+					{
+						sourceFile << R"cpp(,
+)cpp";
+					}
+
+					firstArgument = false;
+					sourceFile << R"cpp(		std::make_shared<)cpp" << s_introspectionNamespace
+						<< R"cpp(::InputValue>(")cpp" << argument.name
+						<< R"cpp(", R"md()cpp" << argument.description
+						<< R"cpp()md", )cpp" << getIntrospectionType(argument.type, argument.modifiers)
+						<< R"cpp(, R"gql()cpp" << argument.defaultValueString << R"cpp()gql"))cpp";
+				}
+
+				sourceFile << R"cpp(
+	})cpp";
+			}
+			sourceFile << R"cpp()));
+)cpp";
+		}
+	}
+
+	if (!_operationTypes.empty())
+	{
+		sourceFile << R"cpp(
+)cpp";
+
+		for (const auto& operationType : _operationTypes)
+		{
+			std::string operation(operationType.operation);
+
+			operation[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(operation[0])));
+			sourceFile << R"cpp(	schema->Add)cpp" << operation
+				<< R"cpp(Type(type)cpp" << operationType.cppType
+				<< R"cpp();
+)cpp";
+		}
+	}
+
+	sourceFile << R"cpp(}
+
+)cpp";
+}
+
+void Generator::outputObjectImplementation(std::ostream& sourceFile, const ObjectType& objectType, bool isQueryType) const
+{
+	// Output the protected constructor which calls through to the service::Object constructor
+	// with its type name, the static tables of the types it implements and the resolvers for its fields.
+	sourceFile << objectType.cppType << R"cpp(::)cpp" << objectType.cppType << R"cpp(()
+	: service::Object(")cpp" << objectType.type << R"cpp(", getTypeNames(), getResolvers()))cpp";
+
+	if (isQueryType && !_options.noIntrospection)
+	{
+		sourceFile << R"cpp(
+	, _schema(std::make_shared<)cpp" << s_introspectionNamespace
+			<< R"cpp(::Schema>()))cpp";
+	}
+
+	sourceFile << R"cpp(
+{
+)cpp";
+
+	if (isQueryType && !_options.noIntrospection)
+	{
+		sourceFile << R"cpp(	)cpp" << s_introspectionNamespace
+			<< R"cpp(::AddTypesToSchema(_schema);
+	)cpp" << _schemaNamespace
+			<< R"cpp(::AddTypesToSchema(_schema);
+)cpp";
+	}
+
+	sourceFile << R"cpp(}
+
+)cpp" << R"cpp(const service::TypeNames& )cpp" << objectType.cppType << R"cpp(::getTypeNames()
+{
+	static const service::TypeNames typeNames {
+)cpp";
+
+	for (const auto& interfaceName : objectType.interfaces)
+	{
+		sourceFile << R"cpp(		")cpp" << interfaceName << R"cpp(",
+)cpp";
+	}
+
+	sourceFile << R"cpp(		")cpp" << objectType.type << R"cpp("
+	};
+
+	return typeNames;
+}
+
+)cpp" << R"cpp(const service::ObjectResolverMap& )cpp" << objectType.cppType << R"cpp(::getResolvers()
+{
+	// The resolvers are shared by every instance of this type, so they take the object as a parameter.
+	static const service::ObjectResolverMap resolvers {
+)cpp";
+
+	const auto outputResolver = [&sourceFile, &objectType](std::string_view name, std::string_view resolver)
+	{
+		sourceFile << R"cpp(		{ ")cpp" << name
+			<< R"cpp(", [](const service::Object& object, service::ResolverParams&& params) { return static_cast<const )cpp" << objectType.cppType
+			<< R"cpp(&>(object).)cpp" << resolver
+			<< R"cpp((std::move(params)); } })cpp";
+	};
+
+	for (const auto& outputField : objectType.fields)
+	{
+		std::string fieldName(outputField.cppName);
+
+		fieldName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fieldName[0])));
+		outputResolver(outputField.name, "resolve" + fieldName);
+		sourceFile << R"cpp(,
+)cpp";
+	}
+
+	outputResolver("__typename", "resolve_typename");
+
+	if (isQueryType && !_options.noIntrospection)
+	{
+		sourceFile << R"cpp(,
+)cpp";
+		outputResolver("__schema", "resolve_schema");
+		sourceFile << R"cpp(,
+)cpp";
+		outputResolver("__type", "resolve_type");
+	}
+
+	sourceFile << R"cpp(
+	};
+
+	return resolvers;
+}
+)cpp";
+
+	// Output each of the resolver implementations, which call the virtual property
+	// getters that the implementer must define.
+	for (const auto& outputField : objectType.fields)
+	{
+		std::string fieldName(outputField.cppName);
+
+		fieldName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fieldName[0])));
+		if (!_isIntrospection && !_options.noStubs)
+		{
+			sourceFile << R"cpp(
+service::FieldResult<)cpp" << getOutputCppType(outputField)
+<< R"cpp(> )cpp" << objectType.cppType
+<< R"cpp(::)cpp" << outputField.accessor << fieldName
+<< R"cpp((service::FieldParams&&)cpp";
+			for (const auto& argument : outputField.arguments)
+			{
+				sourceFile << R"cpp(, )cpp" << getInputCppType(argument)
+					<< R"cpp(&&)cpp";
+			}
+
+			sourceFile << R"cpp() const
+{
+	throw std::runtime_error(R"ex()cpp" << objectType.cppType
+				<< R"cpp(::)cpp" << outputField.accessor << fieldName
+				<< R"cpp( is not implemented)ex");
+}
+)cpp";
+		}
+
+		// The default batch resolver calls the single object getter on each of the siblings.
+		if (outputField.batch)
+		{
+			const auto cppType = getOutputCppType(outputField);
+
+			sourceFile << R"cpp(
+service::FieldResult<std::vector<)cpp" << objectType.cppType
+<< R"cpp(>> )cpp" << objectType.cppType
+<< R"cpp(::)cpp" << outputField.accessor << fieldName
+<< R"cpp(Batch(service::FieldParams&& params, const std::vector<std::shared_ptr<)cpp" << objectType.cppType
+<< R"cpp(>>& parents)cpp";
+
+			for (const auto& argument : outputField.arguments)
+			{
+				sourceFile << R"cpp(, )cpp" << getInputCppType(argument)
+					<< R"cpp(&& )cpp" << argument.cppName << "Arg";
+			}
+
+			sourceFile << R"cpp() const
+{
+	std::queue<service::FieldResult<)cpp" << objectType.cppType << R"cpp(>> results;
+
+	for (const auto& parent : parents)
+	{
+		results.push(parent->)cpp" << outputField.accessor << fieldName
+				<< R"cpp((service::FieldParams(params, response::Value(params.fieldDirectives)))cpp";
+
+			for (const auto& argument : outputField.arguments)
+			{
+				sourceFile << R"cpp(, )cpp" << getInputCppType(argument)
+					<< R"cpp(()cpp" << argument.cppName << R"cpp(Arg))cpp";
+			}
+
+			sourceFile << R"cpp());
+	}
+
+	return std::async(std::launch::deferred,
+		[](std::queue<service::FieldResult<)cpp" << objectType.cppType << R"cpp(>>&& wrappedResults)
+		{
+			std::vector<)cpp" << objectType.cppType << R"cpp(> values;
+
+			values.reserve(wrappedResults.size());
+
+			while (!wrappedResults.empty())
+			{
+				values.push_back(wrappedResults.front().get());
+				wrappedResults.pop();
+			}
+
+			return values;
+		}, std::move(results));
+}
+)cpp";
+		}
+
+		sourceFile << R"cpp(
+)cpp" << R"cpp(std::future<response::Value> )cpp" << objectType.cppType
+<< R"cpp(::resolve)cpp" << fieldName
+<< R"cpp((service::ResolverParams&& params) const
+{
+)cpp";
+
+		// Output a preamble to retrieve all of the arguments from the resolver parameters. Default
+		// argument values are shared in a function-local static.
+		if (!outputField.arguments.empty())
+		{
+			bool firstArgument = true;
+
+			for (const auto& argument : outputField.arguments)
+			{
+				if (argument.defaultValue.type() != response::Type::Null)
+				{
+					if (firstArgument)
+					{
+						firstArgument = false;
+						sourceFile << R"cpp(	static const auto defaultArguments = []()
+	{
+		response::Value values(response::Type::Map);
+		response::Value entry;
+
+)cpp";
+					}
+
+					sourceFile << getArgumentDefaultValue(0, argument.defaultValue)
+						<< R"cpp(		values.emplace_back(")cpp" << argument.name
+						<< R"cpp(", std::move(entry));
+)cpp";
+				}
+			}
+
+			if (!firstArgument)
+			{
+				sourceFile << R"cpp(
+		return values;
+	}();
+
+)cpp";
+			}
+
+			for (const auto& argument : outputField.arguments)
+			{
+				sourceFile << getArgumentDeclaration(argument, "arg", "params.arguments", "defaultArguments");
+			}
+		}
+
+		// Objects in a list share a BatchScope, so the batch resolver is only called for the first sibling
+		// and the rest of them pick out their own result.
+		if (outputField.batch)
+		{
+			sourceFile << R"cpp(	if (params.batch)
+	{
+		auto result = params.batch->getResult<)cpp" << getOutputCppType(outputField)
+				<< R"cpp(>(params.batchIndex, params.fieldName, params.arguments,
+			[this, &params)cpp";
+
+			for (const auto& argument : outputField.arguments)
+			{
+				std::string argumentName(argument.cppName);
+
+				argumentName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(argumentName[0])));
+				sourceFile << R"cpp(, &arg)cpp" << argumentName;
+			}
+
+			sourceFile << R"cpp(]()
+			{
+				return )cpp" << outputField.accessor << fieldName
+				<< R"cpp(Batch(service::FieldParams(params, response::Value(params.fieldDirectives)), params.batch->getSiblings<)cpp"
+				<< objectType.cppType << R"cpp(>())cpp";
+
+			for (const auto& argument : outputField.arguments)
+			{
+				std::string argumentName(argument.cppName);
+
+				argumentName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(argumentName[0])));
+				sourceFile << R"cpp(, std::move(arg)cpp" << argumentName << R"cpp())cpp";
+			}
+
+			sourceFile << R"cpp();
+			});
+
+		return )cpp" << getResultAccessType(outputField)
+				<< R"cpp(::convert)cpp" << getTypeModifiers(outputField.modifiers)
+				<< R"cpp((std::move(result), std::move(params));
+	}
+
+)cpp";
+		}
+
+		sourceFile << R"cpp(	auto result = )cpp" << outputField.accessor << fieldName
+			<< R"cpp((service::FieldParams(params, std::move(params.fieldDirectives)))cpp";
+
+		if (!outputField.arguments.empty())
+		{
+			for (const auto& argument : outputField.arguments)
+			{
+				std::string argumentName(argument.cppName);
+
+				argumentName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(argumentName[0])));
+				sourceFile << R"cpp(, std::move(arg)cpp" << argumentName << R"cpp())cpp";
+			}
+		}
+
+		sourceFile << R"cpp();
+
+	return )cpp" << getResultAccessType(outputField)
+			<< R"cpp(::convert)cpp" << getTypeModifiers(outputField.modifiers)
+			<< R"cpp((std::move(result), std::move(params));
+}
+)cpp";
+	}
+
+	sourceFile << R"cpp(
+)cpp" << R"cpp(std::future<response::Value> )cpp" << objectType.cppType
+<< R"cpp(::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql()cpp" << objectType.type << R"cpp()gql" }, std::move(params));
+}
+)cpp";
+
+	if (isQueryType && !_options.noIntrospection)
+	{
+		sourceFile << R"cpp(
+)cpp" << R"cpp(std::future<response::Value> )cpp" << objectType.cppType
+<< R"cpp(::resolve_schema(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<service::Object>::convert(std::static_pointer_cast<service::Object>(_schema), std::move(params));
+}
+
+)cpp" << R"cpp(std::future<response::Value> )cpp" << objectType.cppType
+<< R"cpp(::resolve_type(service::ResolverParams&& params) const
+{
+	auto argName = service::ModifiedArgument<response::StringType>::require("name", params.arguments);
+
+	return service::ModifiedResult<)cpp" << s_introspectionNamespace << R"cpp(::object::Type>::convert<service::TypeModifier::Nullable>(_schema->LookupType(argName), std::move(params));
+}
+)cpp";
+	}
+}
+
+void Generator::outputObjectIntrospection(std::ostream& sourceFile, const ObjectType& objectType) const
+{
+	if (!objectType.interfaces.empty())
+	{
+		bool firstInterface = true;
+
+		sourceFile << R"cpp(	type)cpp" << objectType.cppType
+			<< R"cpp(->AddInterfaces({
+)cpp";
+
+		for (const auto& interfaceName : objectType.interfaces)
+		{
+			if (!firstInterface)
+			{
+				sourceFile << R"cpp(,
+)cpp";
+			}
+
+			firstInterface = false;
+
+			if (_options.separateFiles)
+			{
+				sourceFile << R"cpp(		std::static_pointer_cast<)cpp" << s_introspectionNamespace << R"cpp(::InterfaceType>(schema->LookupType(")cpp" << interfaceName
+					<< R"cpp(")))cpp";
+			}
+			else
+			{
+				sourceFile << R"cpp(		type)cpp" << getSafeCppName(interfaceName);
+			}
+		}
+
+		sourceFile << R"cpp(
+	});
+)cpp";
+	}
+
+	if (!objectType.fields.empty())
+	{
+		bool firstValue = true;
+
+		sourceFile << R"cpp(	type)cpp" << objectType.cppType
+			<< R"cpp(->AddFields({
+)cpp";
+
+		for (const auto& objectField : objectType.fields)
+		{
+			if (!firstValue)
+			{
+				sourceFile << R"cpp(,
+)cpp";
+			}
+
+			firstValue = false;
+			sourceFile << R"cpp(		std::make_shared<)cpp" << s_introspectionNamespace
+				<< R"cpp(::Field>(")cpp" << objectField.name
+				<< R"cpp(", R"md()cpp" << objectField.description
+				<< R"cpp()md", )cpp";
+
+			if (objectField.deprecationReason)
+			{
+				sourceFile << R"cpp(std::make_optional<response::StringType>(R"md()cpp" << *objectField.deprecationReason << R"cpp()md"))cpp";
+			}
+			else
+			{
+				sourceFile << R"cpp(std::nullopt)cpp";
+			}
+
+			sourceFile << R"cpp(, std::vector<std::shared_ptr<)cpp" << s_introspectionNamespace
+				<< R"cpp(::InputValue>>()cpp";
+
+			if (!objectField.arguments.empty())
+			{
+				bool firstArgument = true;
+
+				sourceFile << R"cpp({
+)cpp";
+
+				for (const auto& argument : objectField.arguments)
+				{
+					if (!firstArgument)
+					{
+						sourceFile << R"cpp(,
+)cpp";
+					}
+
+					firstArgument = false;
+					sourceFile << R"cpp(			std::make_shared<)cpp" << s_introspectionNamespace
+						<< R"cpp(::InputValue>(")cpp" << argument.name
+						<< R"cpp(", R"md()cpp" << argument.description
+						<< R"cpp()md", )cpp" << getIntrospectionType(argument.type, argument.modifiers)
+						<< R"cpp(, R"gql()cpp" << argument.defaultValueString << R"cpp()gql"))cpp";
+				}
+
+				sourceFile << R"cpp(
+		})cpp";
+			}
+
+			sourceFile << R"cpp(), )cpp" << getIntrospectionType(objectField.type, objectField.modifiers)
+				<< R"cpp())cpp";
+		}
+
+		sourceFile << R"cpp(
+	});
+)cpp";
+	}
+}
+
+std::string Generator::getArgumentDefaultValue(size_t level, const response::Value & defaultValue) const noexcept
+{
+	const std::string padding(level, '\t');
+	std::ostringstream argumentDefaultValue;
+
+	switch (defaultValue.type())
+	{
+		case response::Type::Map:
+		{
+			const auto& members = defaultValue.get<const response::MapType&>();
+
+			argumentDefaultValue << padding << R"cpp(		entry = []()
+)cpp" << padding << R"cpp(		{
+)cpp" << padding << R"cpp(			response::Value members(response::Type::Map);
+)cpp" << padding << R"cpp(			response::Value entry;
+
+)cpp";
+
+			for (const auto& entry : members)
+			{
+				argumentDefaultValue << getArgumentDefaultValue(level + 1, entry.second)
+					<< padding << R"cpp(			members.emplace_back(")cpp" << entry.first << R"cpp(", std::move(entry));
+)cpp";
+			}
+
+			argumentDefaultValue << padding << R"cpp(			return members;
+)cpp" << padding << R"cpp(		}();
+)cpp";
+			break;
+		}
+
+		case response::Type::List:
+		{
+			const auto& elements = defaultValue.get<const response::ListType&>();
+
+			argumentDefaultValue << padding << R"cpp(		entry = []()
+)cpp" << padding << R"cpp(		{
+)cpp" << padding << R"cpp(			response::Value elements(response::Type::List);
+)cpp" << padding << R"cpp(			response::Value entry;
+
+)cpp";
+
+			for (const auto& entry : elements)
+			{
+				argumentDefaultValue << getArgumentDefaultValue(level + 1, entry)
+					<< padding << R"cpp(			elements.emplace_back(std::move(entry));
+)cpp";
+			}
+
+			argumentDefaultValue << padding << R"cpp(			return elements;
+)cpp" << padding << R"cpp(		}();
+)cpp";
+			break;
+		}
+
+		case response::Type::String:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = response::Value(std::string(R"gql()cpp"
+				<< defaultValue.get<const response::StringType&>() << R"cpp()gql"));
+)cpp";
+			break;
+		}
+
+		case response::Type::Null:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = {};
+)cpp";
+			break;
+		}
+
+		case response::Type::Boolean:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = response::Value()cpp"
+				<< (defaultValue.get<response::BooleanType>()
+					? R"cpp(true)cpp"
+					: R"cpp(false)cpp")
+				<< R"cpp();
+)cpp";
+			break;
+		}
+
+		case response::Type::Int:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = response::Value(static_cast<response::IntType>()cpp"
+				<< defaultValue.get<response::IntType>() << R"cpp());
+)cpp";
+			break;
+		}
+
+		case response::Type::Float:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = response::Value(static_cast<response::FloatType>()cpp"
+				<< defaultValue.get<response::FloatType>() << R"cpp());
+)cpp";
+			break;
+		}
+
+		case response::Type::EnumValue:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = response::Value(response::Type::EnumValue);
+		entry.set<response::StringType>(R"gql()cpp" << defaultValue.get<const response::StringType&>() << R"cpp()gql");
+)cpp";
+			break;
+		}
+
+		case response::Type::Scalar:
+		{
+			argumentDefaultValue << padding << R"cpp(		entry = []()
+)cpp" << padding << R"cpp(		{
+)cpp" << padding << R"cpp(			response::Value scalar(response::Type::Scalar);
+)cpp" << padding << R"cpp(			response::Value entry;
+
+)cpp";
+			argumentDefaultValue << padding << R"cpp(	)cpp" << getArgumentDefaultValue(level + 1, defaultValue.get<const response::ScalarType&>())
+				<< padding << R"cpp(			scalar.set<response::ScalarType>(std::move(entry));
+
+)cpp" << padding << R"cpp(			return scalar;
+)cpp" << padding << R"cpp(		}();
+)cpp";
+			break;
+		}
+	}
+
+	return argumentDefaultValue.str();
+}
+
+std::string Generator::getArgumentDeclaration(const InputField & argument, const char* prefixToken, const char* argumentsToken, const char* defaultToken) const noexcept
+{
+	std::ostringstream argumentDeclaration;
+	std::string argumentName(argument.cppName);
+
+	argumentName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(argumentName[0])));
+	if (argument.defaultValue.type() == response::Type::Null)
+	{
+		argumentDeclaration << R"cpp(	auto )cpp" << prefixToken << argumentName
+			<< R"cpp( = )cpp" << getArgumentAccessType(argument)
+			<< R"cpp(::require)cpp" << getTypeModifiers(argument.modifiers)
+			<< R"cpp((")cpp" << argument.name
+			<< R"cpp(", )cpp" << argumentsToken
+			<< R"cpp();
+)cpp";
+	}
+	else
+	{
+		argumentDeclaration << R"cpp(	auto pair)cpp" << argumentName
+			<< R"cpp( = )cpp" << getArgumentAccessType(argument)
+			<< R"cpp(::find)cpp" << getTypeModifiers(argument.modifiers)
+			<< R"cpp((")cpp" << argument.name
+			<< R"cpp(", )cpp" << argumentsToken
+			<< R"cpp();
+	auto )cpp" << prefixToken << argumentName << R"cpp( = (pair)cpp" << argumentName << R"cpp(.second
+		? std::move(pair)cpp" << argumentName << R"cpp(.first)
+		: )cpp" << getArgumentAccessType(argument)
+			<< R"cpp(::require)cpp" << getTypeModifiers(argument.modifiers)
+			<< R"cpp((")cpp" << argument.name
+			<< R"cpp(", )cpp" << defaultToken
+			<< R"cpp());
+)cpp";
+	}
+
+	return argumentDeclaration.str();
+}
+
+std::string Generator::getArgumentAccessType(const InputField & argument) const noexcept
+{
+	std::ostringstream argumentType;
+
+	argumentType << R"cpp(service::ModifiedArgument<)cpp";
+
+	switch (argument.fieldType)
+	{
+		case InputFieldType::Builtin:
+		case InputFieldType::Enum:
+		case InputFieldType::Input:
+			argumentType << getCppType(argument.type);
+			break;
+
+		case InputFieldType::Scalar:
+			argumentType << R"cpp(response::Value)cpp";
+			break;
+	}
+
+	argumentType << R"cpp(>)cpp";
+
+	return argumentType.str();
+}
+
+std::string Generator::getResultAccessType(const OutputField & result) const noexcept
+{
+	std::ostringstream resultType;
+
+	resultType << R"cpp(service::ModifiedResult<)cpp";
+
+	switch (result.fieldType)
+	{
+		case OutputFieldType::Builtin:
+		case OutputFieldType::Enum:
+		case OutputFieldType::Object:
+			resultType << getCppType(result.type);
+			break;
+
+		case OutputFieldType::Scalar:
+			resultType << R"cpp(response::Value)cpp";
+			break;
+
+		case OutputFieldType::Union:
+		case OutputFieldType::Interface:
+			resultType << R"cpp(service::Object)cpp";
+			break;
+	}
+
+	resultType << R"cpp(>)cpp";
+
+	return resultType.str();
+}
+
+std::vector<std::string> Generator::getExplicitInstantiations() const noexcept
+{
+	std::vector<std::string> instantiations;
+
+	// The generated object types only use these from separate source files.
+	if (!_options.separateFiles)
+	{
+		return instantiations;
+	}
+
+	std::unordered_set<std::string> declared;
+	const auto addInstantiation = [&instantiations, &declared](std::string&& instantiation)
+	{
+		if (declared.insert(instantiation).second)
+		{
+			instantiations.push_back(std::move(instantiation));
+		}
+	};
+
+	for (const auto& objectType : _objectTypes)
+	{
+		for (const auto& outputField : objectType.fields)
+		{
+			for (const auto& argument : outputField.arguments)
+			{
+				if (argument.fieldType != InputFieldType::Enum
+					&& argument.fieldType != InputFieldType::Input)
+				{
+					continue;
+				}
+
+				const auto typeModifiers = getTypeModifiers(argument.modifiers);
+
+				if (typeModifiers.empty())
+				{
+					continue;
+				}
+
+				const auto modifierList = typeModifiers.substr(1, typeModifiers.size() - 2);
+				std::ostringstream argumentType;
+
+				argumentType << _schemaNamespace << R"cpp(::)cpp" << getCppType(argument.type);
+
+				const auto cppType = argumentType.str();
+				std::ostringstream instantiation;
+
+				instantiation << R"cpp(ModifiedArgument<)cpp" << cppType
+					<< R"cpp(>::ArgumentTraits<)cpp" << cppType
+					<< R"cpp(, )cpp" << modifierList
+					<< R"cpp(>::type ModifiedArgument<)cpp" << cppType
+					<< R"cpp(>::require)cpp" << typeModifiers
+					<< R"cpp((
+	const std::string&, const response::Value&);
+)cpp";
+				addInstantiation(instantiation.str());
+			}
+
+			if (outputField.fieldType != OutputFieldType::Enum
+				&& outputField.fieldType != OutputFieldType::Object)
+			{
+				continue;
+			}
+
+			const auto typeModifiers = getTypeModifiers(outputField.modifiers);
+
+			if (typeModifiers.empty())
+			{
+				continue;
+			}
+
+			const auto modifierList = typeModifiers.substr(1, typeModifiers.size() - 2);
+			std::ostringstream resultType;
+
+			resultType << _schemaNamespace
+				<< (outputField.fieldType == OutputFieldType::Object
+					? R"cpp(::object::)cpp"
+					: R"cpp(::)cpp")
+				<< getCppType(outputField.type);
+
+			const auto cppType = resultType.str();
+			std::ostringstream instantiation;
+
+			instantiation << R"cpp(std::future<response::Value> ModifiedResult<)cpp" << cppType
+				<< R"cpp(>::convert)cpp" << typeModifiers
+				<< R"cpp((
+	ModifiedResult<)cpp" << cppType
+				<< R"cpp(>::ResultTraits<)cpp" << cppType
+				<< R"cpp(, )cpp" << modifierList
+				<< R"cpp(>::future_type, ResolverParams&&);
+)cpp";
+			addInstantiation(instantiation.str());
+		}
+	}
+
+	return instantiations;
+}
+
+std::string Generator::getTypeModifiers(const TypeModifierStack & modifiers) const noexcept
+{
+	bool firstValue = true;
+	std::ostringstream typeModifiers;
+
+	for (auto modifier : modifiers)
+	{
+		if (firstValue)
+		{
+			typeModifiers << R"cpp(<)cpp";
+			firstValue = false;
+		}
+		else
+		{
+			typeModifiers << R"cpp(, )cpp";
+		}
+
+		switch (modifier)
+		{
+			case service::TypeModifier::Nullable:
+				typeModifiers << R"cpp(service::TypeModifier::Nullable)cpp";
+				break;
+
+			case service::TypeModifier::List:
+				typeModifiers << R"cpp(service::TypeModifier::List)cpp";
+				break;
+
+			case service::TypeModifier::None:
+				break;
+		}
+	}
+
+	if (!firstValue)
+	{
+		typeModifiers << R"cpp(>)cpp";
+	}
+
+	return typeModifiers.str();
+}
+
+std::string Generator::getIntrospectionType(const std::string & type, const TypeModifierStack & modifiers) const noexcept
+{
+	size_t wrapperCount = 0;
+	bool nonNull = true;
+	std::ostringstream introspectionType;
+
+	for (auto modifier : modifiers)
+	{
+		if (!nonNull)
+		{
+			switch (modifier)
+			{
+				case service::TypeModifier::None:
+				case service::TypeModifier::List:
+					// If the next modifier is None or List we should treat it as non-nullable.
+					nonNull = true;
+					break;
+
+				case service::TypeModifier::Nullable:
+					break;
+			}
+		}
+
+		if (nonNull)
+		{
+			switch (modifier)
+			{
+				case service::TypeModifier::None:
+				case service::TypeModifier::List:
+				{
+					introspectionType << R"cpp(schema->WrapType()cpp" << s_introspectionNamespace
+						<< R"cpp(::TypeKind::NON_NULL, )cpp";
+					++wrapperCount;
+					break;
+				}
+
+				case service::TypeModifier::Nullable:
+					// If the next modifier is Nullable that cancels the non-nullable state.
+					nonNull = false;
+					break;
+			}
+		}
+
+		switch (modifier)
+		{
+			case service::TypeModifier::None:
+			case service::TypeModifier::Nullable:
+				break;
+
+			case service::TypeModifier::List:
+			{
+				introspectionType << R"cpp(schema->WrapType()cpp" << s_introspectionNamespace
+					<< R"cpp(::TypeKind::LIST, )cpp";
+				++wrapperCount;
+				break;
+			}
+		}
+	}
+
+	if (nonNull)
+	{
+		introspectionType << R"cpp(schema->WrapType()cpp" << s_introspectionNamespace
+			<< R"cpp(::TypeKind::NON_NULL, )cpp";
+		++wrapperCount;
+	}
+
+	introspectionType << R"cpp(schema->LookupType(")cpp" << type
+		<< R"cpp("))cpp";
+
+	for (size_t i = 0; i < wrapperCount; ++i)
+	{
+		introspectionType << R"cpp())cpp";
+	}
+
+	return introspectionType.str();
+}
+
+std::vector<std::string> Generator::outputSeparateFiles() const
+{
+	std::vector<std::string> files;
+	const fs::path headerDir(_headerDir);
+	const fs::path sourceDir(_sourceDir);
+	std::string queryType;
+
+	for (const auto& operation : _operationTypes)
+	{
+		if (operation.operation == service::strQuery)
+		{
+			queryType = operation.type;
+			break;
+		}
+	}
+
+	// Output a convenience header
+	std::ostringstream objectHeaderFile;
+
+	objectHeaderFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include ")cpp" << fs::path(_headerPath).filename().string() << R"cpp("
 
-				sourceFile << R"cpp(	type)cpp" << unionType.cppType
-					<< R"cpp(->AddPossibleTypes({
 )cpp";
 
-				for (const auto& unionOption : unionType.options)
-				{
-					if (!firstValue)
-					{
-						sourceFile << R"cpp(,
+	for (const auto& objectType : _objectTypes)
+	{
+		const auto headerFilename = std::string(objectType.cppType) + "Object.h";
+
+		objectHeaderFile << R"cpp(#include ")cpp" << headerFilename << R"cpp("
 )cpp";
-					}
+	}
 
-					firstValue = false;
-					sourceFile << R"cpp(		schema->LookupType(")cpp" << unionOption
-						<< R"cpp("))cpp";
-				}
+	const auto instantiations = getExplicitInstantiations();
 
-				sourceFile << R"cpp(
-	});
+	if (!instantiations.empty())
+	{
+		objectHeaderFile << std::endl;
+
+		NamespaceScope graphqlNamespace{ objectHeaderFile, "graphql" };
+		NamespaceScope serviceNamespace{ objectHeaderFile, "service" };
+
+		objectHeaderFile << R"cpp(
+// These are instantiated once in )cpp" << fs::path(_sourcePath).filename().string()
+			<< R"cpp( instead of in every source file which resolves them.
 )cpp";
-			}
+
+		for (const auto& instantiation : instantiations)
+		{
+			objectHeaderFile << R"cpp(extern template )cpp" << instantiation;
 		}
+
+		objectHeaderFile << std::endl;
 	}
 
-	if (!_interfaceTypes.empty())
+	if (writeIfChanged(_objectHeaderPath, objectHeaderFile.str()) && _options.verbose)
 	{
-		sourceFile << R"cpp(
-)cpp";
+		files.push_back({ _objectHeaderPath });
+	}
 
-		for (const auto& interfaceType : _interfaceTypes)
+	// Each of the object types is independent, so split them up between a few worker threads.
+	std::vector<std::pair<std::string, std::string>> objectFiles(_objectTypes.size());
+	std::atomic_size_t nextObjectType { 0 };
+	std::mutex errorMutex;
+	std::exception_ptr firstError;
+	const auto outputObjectTypes = [&]() noexcept
+	{
+		// Don't let an exception escape the worker thread, keep the first one and rethrow it
+		// after all of the workers have finished.
+		try
 		{
-			if (!interfaceType.fields.empty())
+			for (auto index = nextObjectType++; index < _objectTypes.size(); index = nextObjectType++)
 			{
-				bool firstValue = true;
+				const auto& objectType = _objectTypes[index];
+				const bool isQueryType = objectType.type == queryType;
+				const auto headerFilename = std::string(objectType.cppType) + "Object.h";
+				auto headerPath = (headerDir / headerFilename).string();
+				std::ostringstream headerFile;
 
-				sourceFile << R"cpp(	type)cpp" << interfaceType.cppType
-					<< R"cpp(->AddFields({
-)cpp";
+				outputSeparateHeader(headerFile, objectType, isQueryType);
 
-				for (const auto& interfaceField : interfaceType.fields)
+				// Leave the path empty if the file could not be written, so it's not listed.
+				if (!writeIfChanged(headerPath, headerFile.str()))
 				{
-					if (!firstValue)
-					{
-						sourceFile << R"cpp(,
-)cpp";
-					}
+					headerPath.clear();
+				}
 
-					firstValue = false;
-					sourceFile << R"cpp(		std::make_shared<)cpp" << s_introspectionNamespace
-						<< R"cpp(::Field>(")cpp" << interfaceField.name
-						<< R"cpp(", R"md()cpp" << interfaceField.description
-						<< R"cpp()md", )cpp";
+				const auto sourceFilename = std::string(objectType.cppType) + "Object.cpp";
+				auto sourcePath = (sourceDir / sourceFilename).string();
+				std::ostringstream sourceFile;
 
-					if (interfaceField.deprecationReason)
-					{
-						sourceFile << R"cpp(std::make_optional<response::StringType>(R"md()cpp" << *interfaceField.deprecationReason << R"cpp()md"))cpp";
-					}
-					else
-					{
-						sourceFile << R"cpp(std::nullopt)cpp";
-					}
+				outputSeparateSource(sourceFile, objectType, isQueryType);
 
-					sourceFile << R"cpp(, std::vector<std::shared_ptr<)cpp" << s_introspectionNamespace
-						<< R"cpp(::InputValue>>()cpp";
+				if (!writeIfChanged(sourcePath, sourceFile.str()))
+				{
+					sourcePath.clear();
+				}
 
-					if (!interfaceField.arguments.empty())
-					{
-						bool firstArgument = true;
+				objectFiles[index] = { std::move(headerPath), std::move(sourcePath) };
+			}
+		}
+		catch (...)
+		{
+			// Stop handing out object types to the other workers.
+			nextObjectType = _objectTypes.size();
 
-						sourceFile << R"cpp({
-)cpp";
+			std::lock_guard<std::mutex> lock(errorMutex);
 
-						for (const auto& argument : interfaceField.arguments)
-						{
-							if (!firstArgument)
-							{
-								sourceFile << R"cpp(,
-)cpp";
-							}
+			if (!firstError)
+			{
+				firstError = std::current_exception();
+			}
+		}
+	};
+	const size_t threadCount = std::min<size_t>(_objectTypes.size(),
+		std::max<unsigned int>(std::thread::hardware_concurrency(), 1));
+	std::vector<std::thread> workers;
 
-							firstArgument = false;
-							sourceFile << R"cpp(			std::make_shared<)cpp" << s_introspectionNamespace
-								<< R"cpp(::InputValue>(")cpp" << argument.name
-								<< R"cpp(", R"md()cpp" << argument.description
-								<< R"cpp()md", )cpp" << getIntrospectionType(argument.type, argument.modifiers)
-								<< R"cpp(, R"gql()cpp" << argument.defaultValueString << R"cpp()gql"))cpp";
-						}
+	if (threadCount > 1)
+	{
+		workers.reserve(threadCount - 1);
 
-						sourceFile << R"cpp(
-		})cpp";
-					}
+		for (size_t i = 1; i < threadCount; ++i)
+		{
+			workers.emplace_back(outputObjectTypes);
+		}
+	}
 
-					sourceFile << R"cpp(), )cpp" << getIntrospectionType(interfaceField.type, interfaceField.modifiers)
-						<< R"cpp())cpp";
-				}
+	outputObjectTypes();
 
-				sourceFile << R"cpp(
-	});
-)cpp";
-			}
-		}
+	for (auto& worker : workers)
+	{
+		worker.join();
 	}
 
-	if (!_objectTypes.empty())
+	if (firstError)
 	{
-		sourceFile << R"cpp(
-)cpp";
+		std::rethrow_exception(firstError);
+	}
 
-		for (const auto& objectType : _objectTypes)
+	for (auto& objectFile : objectFiles)
+	{
+		if (_options.verbose && !objectFile.first.empty())
 		{
-			if (_options.separateFiles)
-			{
-				sourceFile << R"cpp(	Add)cpp" << objectType.cppType
-					<< R"cpp(Details(type)cpp" << objectType.cppType
-					<< R"cpp(, schema);
-)cpp";
-			}
-			else
-			{
-				outputObjectIntrospection(sourceFile, objectType);
-			}
+			files.push_back(std::move(objectFile.first));
+		}
+
+		if (!objectFile.second.empty())
+		{
+			files.push_back(std::move(objectFile.second));
 		}
 	}
 
-	if (!_directives.empty())
-	{
-		sourceFile << R"cpp(
-)cpp";
+	return files;
+}
 
-		for (const auto& directive : _directives)
-		{
-			sourceFile << R"cpp(	schema->AddDirective(std::make_shared<)cpp" << s_introspectionNamespace
-				<< R"cpp(::Directive>(")cpp" << directive.name
-				<< R"cpp(", R"md()cpp" << directive.description
-				<< R"cpp()md", std::vector<response::StringType>()cpp";
+void Generator::outputSeparateHeader(std::ostream& headerFile, const ObjectType& objectType, bool isQueryType) const
+{
+	std::ostringstream ossNamespace;
 
-			if (!directive.locations.empty())
-			{
-				bool firstLocation = true;
+	ossNamespace << R"cpp(graphql::)cpp"
+		<< _schemaNamespace
+		<< R"cpp(::object)cpp";
 
+	const auto objectNamespace = ossNamespace.str();
 
-				sourceFile << R"cpp({
-)cpp";
+	headerFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include ")cpp" << fs::path(_headerPath).filename().string() << R"cpp("
 
-				for (const auto& location : directive.locations)
-				{
-					if (!firstLocation)
-					{
-						sourceFile << R"cpp(,
 )cpp";
-					}
 
-					firstLocation = false;
-					sourceFile << R"cpp(		R"gql()cpp" << location << R"cpp()gql")cpp";
-				}
+	NamespaceScope headerNamespace{ headerFile, objectNamespace };
 
+	// Output the full declaration
+	headerFile << std::endl;
+	outputObjectDeclaration(headerFile, objectType, isQueryType);
+	headerFile << std::endl;
+}
 
-				sourceFile << R"cpp(
-	})cpp";
-			}
+void Generator::outputSeparateSource(std::ostream& sourceFile, const ObjectType& objectType, bool isQueryType) const
+{
+	std::ostringstream ossNamespace;
 
-			sourceFile << R"cpp(), std::vector<std::shared_ptr<)cpp" << s_introspectionNamespace
-				<< R"cpp(::InputValue>>()cpp";
+	ossNamespace << R"cpp(graphql::)cpp"
+		<< _schemaNamespace;
 
-			if (!directive.arguments.empty())
-			{
-				bool firstArgument = true;
+	const auto schemaNamespace = ossNamespace.str();
 
-				sourceFile << R"cpp({
-)cpp";
+	sourceFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include ")cpp" << fs::path(_objectHeaderPath).filename().string() << R"cpp("
 
-				for (const auto& argument : directive.arguments)
-				{
-					if (!firstArgument)
-					{
-						sourceFile << R"cpp(,
 )cpp";
-					}
 
-					firstArgument = false;
-					sourceFile << R"cpp(		std::make_shared<)cpp" << s_introspectionNamespace
-						<< R"cpp(::InputValue>(")cpp" << argument.name
-						<< R"cpp(", R"md()cpp" << argument.description
-						<< R"cpp()md", )cpp" << getIntrospectionType(argument.type, argument.modifiers)
-						<< R"cpp(, R"gql()cpp" << argument.defaultValueString << R"cpp()gql"))cpp";
-				}
+	if (!_options.noIntrospection)
+	{
+		sourceFile << R"cpp(#include <graphqlservice/Introspection.h>
 
-				sourceFile << R"cpp(
-	})cpp";
-			}
-			sourceFile << R"cpp()));
 )cpp";
-		}
 	}
 
-	if (!_operationTypes.empty())
-	{
-		sourceFile << R"cpp(
+	sourceFile << R"cpp(#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
 )cpp";
 
-		for (const auto& operationType : _operationTypes)
-		{
-			std::string operation(operationType.operation);
+	NamespaceScope sourceSchemaNamespace{ sourceFile, schemaNamespace };
+	NamespaceScope sourceObjectNamespace{ sourceFile, "object" };
 
-			operation[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(operation[0])));
-			sourceFile << R"cpp(	schema->Add)cpp" << operation
-				<< R"cpp(Type(type)cpp" << operationType.cppType
-				<< R"cpp();
-)cpp";
-		}
+	sourceFile << std::endl;
+	outputObjectImplementation(sourceFile, objectType, isQueryType);
+	sourceFile << std::endl;
+
+	sourceObjectNamespace.exit();
+	sourceFile << std::endl;
+
+	if (_options.noIntrospection)
+	{
+		return;
 	}
 
+	sourceFile << R"cpp(void Add)cpp" << objectType.cppType
+		<< R"cpp(Details(std::shared_ptr<)cpp" << s_introspectionNamespace
+		<< R"cpp(::ObjectType> type)cpp" << objectType.cppType
+		<< R"cpp(, std::shared_ptr<)cpp" << s_introspectionNamespace
+		<< R"cpp(::Schema> schema)
+{
+)cpp";
+	outputObjectIntrospection(sourceFile, objectType);
 	sourceFile << R"cpp(}
 
 )cpp";
+}
 
-	return true;
+std::string Generator::getClientNamespace(const ClientOperation& operation) const noexcept
+{
+	return operation.operation + "::" + getSafeCppName(operation.name);
 }
 
-void Generator::outputObjectImplementation(std::ostream& sourceFile, const ObjectType& objectType, bool isQueryType) const
-{
-	// Output the protected constructor which calls through to the service::Object constructor
-	// with arguments that declare the set of types it implements and bind the fields to the
-	// resolver methods.
-	sourceFile << objectType.cppType << R"cpp(::)cpp" << objectType.cppType << R"cpp(()
-	: service::Object({
-)cpp";
+std::string Generator::getClientInputCppType(const InputField& field) const noexcept
+{
+	size_t templateCount = 0;
+	std::ostringstream inputType;
+
+	for (auto modifier : field.modifiers)
+	{
+		switch (modifier)
+		{
+			case service::TypeModifier::Nullable:
+				inputType << R"cpp(std::optional<)cpp";
+				++templateCount;
+				break;
+
+			case service::TypeModifier::List:
+				inputType << R"cpp(std::vector<)cpp";
+				++templateCount;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	switch (field.fieldType)
+	{
+		case InputFieldType::Enum:
+		case InputFieldType::Input:
+			inputType << _schemaNamespace << R"cpp(::)cpp";
+			break;
+
+		default:
+			break;
+	}
+
+	inputType << getCppType(field.type);
 
-	for (const auto& interfaceName : objectType.interfaces)
+	for (size_t i = 0; i < templateCount; ++i)
 	{
-		sourceFile << R"cpp(		")cpp" << interfaceName << R"cpp(",
-)cpp";
+		inputType << R"cpp(>)cpp";
 	}
 
-	sourceFile << R"cpp(		")cpp" << objectType.type << R"cpp("
-	}, {
-)cpp";
+	return inputType.str();
+}
 
-	bool firstField = true;
+std::string Generator::getResponseCppType(const ResponseField& field) const noexcept
+{
+	size_t templateCount = 0;
+	std::ostringstream responseType;
 
-	for (const auto& outputField : objectType.fields)
+	for (auto modifier : field.modifiers)
 	{
-		if (!firstField)
+		switch (modifier)
 		{
-			sourceFile << R"cpp(,
-)cpp";
-		}
-
-		firstField = false;
+			case service::TypeModifier::Nullable:
+				responseType << R"cpp(std::optional<)cpp";
+				++templateCount;
+				break;
 
-		std::string fieldName(outputField.cppName);
+			case service::TypeModifier::List:
+				responseType << R"cpp(std::vector<)cpp";
+				++templateCount;
+				break;
 
-		fieldName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fieldName[0])));
-		sourceFile << R"cpp(		{ ")cpp" << outputField.name
-			<< R"cpp(", [this](service::ResolverParams&& params) { return resolve)cpp" << fieldName
-			<< R"cpp((std::move(params)); } })cpp";
+			default:
+				break;
+		}
 	}
 
-	if (!firstField)
+	switch (field.fieldType)
 	{
-		sourceFile << R"cpp(,
-)cpp";
-	}
+		case OutputFieldType::Builtin:
+		case OutputFieldType::Scalar:
+			responseType << getCppType(field.type);
+			break;
 
-	sourceFile << R"cpp(		{ "__typename", [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } })cpp";
+		case OutputFieldType::Enum:
+			responseType << _schemaNamespace << R"cpp(::)cpp" << getCppType(field.type);
+			break;
 
-	if (isQueryType)
-	{
-		sourceFile << R"cpp(,
-		{ "__schema", [this](service::ResolverParams&& params) { return resolve_schema(std::move(params)); } },
-		{ "__type", [this](service::ResolverParams&& params) { return resolve_type(std::move(params)); } })cpp";
+		case OutputFieldType::Union:
+		case OutputFieldType::Interface:
+		case OutputFieldType::Object:
+			responseType << getResponseStructName(field);
+			break;
 	}
 
-	sourceFile << R"cpp(
-	}))cpp";
-
-	if (isQueryType)
+	for (size_t i = 0; i < templateCount; ++i)
 	{
-		sourceFile << R"cpp(
-	, _schema(std::make_shared<)cpp" << s_introspectionNamespace
-			<< R"cpp(::Schema>()))cpp";
+		responseType << R"cpp(>)cpp";
 	}
 
-	sourceFile << R"cpp(
+	return responseType.str();
+}
+
+std::string Generator::getResponseStructName(const ResponseField& field) noexcept
 {
-)cpp";
+	// Name the nested struct after the response key and the type, so it doesn't collide with the
+	// name of the member.
+	return field.cppName + "_" + getSafeCppName(field.type);
+}
 
-	if (isQueryType)
+std::unordered_set<std::string> Generator::getClientUsedTypes() const noexcept
+{
+	std::unordered_set<std::string> usedTypes;
+	std::vector<const ResponseFieldList*> responseFields;
+	std::vector<const InputFieldList*> inputFields;
+
+	for (const auto& operation : _clientOperations)
 	{
-		sourceFile << R"cpp(	)cpp" << s_introspectionNamespace
-			<< R"cpp(::AddTypesToSchema(_schema);
-	)cpp" << _schemaNamespace
-			<< R"cpp(::AddTypesToSchema(_schema);
-)cpp";
+		responseFields.push_back(&operation.responseFields);
+		inputFields.push_back(&operation.variables);
 	}
 
-	sourceFile << R"cpp(}
-)cpp";
-
-	// Output each of the resolver implementations, which call the virtual property
-	// getters that the implementer must define.
-	for (const auto& outputField : objectType.fields)
+	while (!responseFields.empty())
 	{
-		std::string fieldName(outputField.cppName);
+		const auto fields = responseFields.back();
 
-		fieldName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fieldName[0])));
-		if (!_isIntrospection && !_options.noStubs)
+		responseFields.pop_back();
+
+		for (const auto& field : *fields)
 		{
-			sourceFile << R"cpp(
-service::FieldResult<)cpp" << getOutputCppType(outputField)
-<< R"cpp(> )cpp" << objectType.cppType
-<< R"cpp(::)cpp" << outputField.accessor << fieldName
-<< R"cpp((service::FieldParams&&)cpp";
-			for (const auto& argument : outputField.arguments)
+			if (field.fieldType == OutputFieldType::Enum)
 			{
-				sourceFile << R"cpp(, )cpp" << getInputCppType(argument)
-					<< R"cpp(&&)cpp";
+				usedTypes.insert(field.type);
 			}
 
-			sourceFile << R"cpp() const
-{
-	throw std::runtime_error(R"ex()cpp" << objectType.cppType
-				<< R"cpp(::)cpp" << outputField.accessor << fieldName
-				<< R"cpp( is not implemented)ex");
-}
-)cpp";
+			responseFields.push_back(&field.children);
 		}
+	}
 
-		sourceFile << R"cpp(
-std::future<response::Value> )cpp" << objectType.cppType
-<< R"cpp(::resolve)cpp" << fieldName
-<< R"cpp((service::ResolverParams&& params)
-{
-)cpp";
-
-		// Output a preamble to retrieve all of the arguments from the resolver parameters.
-		if (!outputField.arguments.empty())
-		{
-			bool firstArgument = true;
-
-			for (const auto& argument : outputField.arguments)
-			{
-				if (argument.defaultValue.type() != response::Type::Null)
-				{
-					if (firstArgument)
-					{
-						firstArgument = false;
-						sourceFile << R"cpp(	const auto defaultArguments = []()
+	while (!inputFields.empty())
 	{
-		response::Value values(response::Type::Map);
-		response::Value entry;
-
-)cpp";
-					}
-
-					sourceFile << getArgumentDefaultValue(0, argument.defaultValue)
-						<< R"cpp(		values.emplace_back(")cpp" << argument.name
-						<< R"cpp(", std::move(entry));
-)cpp";
-				}
-			}
-
-			if (!firstArgument)
-			{
-				sourceFile << R"cpp(
-		return values;
-	}();
+		const auto fields = inputFields.back();
 
-)cpp";
-			}
+		inputFields.pop_back();
 
-			for (const auto& argument : outputField.arguments)
+		for (const auto& field : *fields)
+		{
+			if (field.fieldType == InputFieldType::Enum)
 			{
-				sourceFile << getArgumentDeclaration(argument, "arg", "params.arguments", "defaultArguments");
+				usedTypes.insert(field.type);
 			}
-		}
-
-		sourceFile << R"cpp(	auto result = )cpp" << outputField.accessor << fieldName
-			<< R"cpp((service::FieldParams(params, std::move(params.fieldDirectives)))cpp";
-
-		if (!outputField.arguments.empty())
-		{
-			for (const auto& argument : outputField.arguments)
+			else if (field.fieldType == InputFieldType::Input
+				&& usedTypes.insert(field.type).second)
 			{
-				std::string argumentName(argument.cppName);
-
-				argumentName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(argumentName[0])));
-				sourceFile << R"cpp(, std::move(arg)cpp" << argumentName << R"cpp())cpp";
+				inputFields.push_back(&_inputTypes[_inputNames.at(field.type)].fields);
 			}
 		}
-
-		sourceFile << R"cpp();
-
-	return )cpp" << getResultAccessType(outputField)
-			<< R"cpp(::convert)cpp" << getTypeModifiers(outputField.modifiers)
-			<< R"cpp((std::move(result), std::move(params));
-}
-)cpp";
 	}
 
-	sourceFile << R"cpp(
-std::future<response::Value> )cpp" << objectType.cppType
-<< R"cpp(::resolve_typename(service::ResolverParams&& params)
-{
-	return service::ModifiedResult<response::StringType>::convert(response::StringType{ R"gql()cpp" << objectType.type << R"cpp()gql" }, std::move(params));
+	return usedTypes;
 }
-)cpp";
 
-	if (isQueryType)
-	{
-		sourceFile << R"cpp(
-std::future<response::Value> )cpp" << objectType.cppType
-<< R"cpp(::resolve_schema(service::ResolverParams&& params)
+bool Generator::outputClientHeader() const noexcept
 {
-	return service::ModifiedResult<service::Object>::convert(std::static_pointer_cast<service::Object>(_schema), std::move(params));
-}
+	std::ostringstream headerFile;
 
-std::future<response::Value> )cpp" << objectType.cppType
-<< R"cpp(::resolve_type(service::ResolverParams&& params)
-{
-	auto argName = service::ModifiedArgument<response::StringType>::require("name", params.arguments);
+	outputClientHeader(headerFile);
 
-	return service::ModifiedResult<)cpp" << s_introspectionNamespace << R"cpp(::object::Type>::convert<service::TypeModifier::Nullable>(_schema->LookupType(argName), std::move(params));
-}
-)cpp";
-	}
+	return writeIfChanged(_clientHeaderPath, headerFile.str());
 }
 
-void Generator::outputObjectIntrospection(std::ostream& sourceFile, const ObjectType& objectType) const
+void Generator::outputClientHeader(std::ostream& headerFile) const noexcept
 {
-	if (!objectType.interfaces.empty())
-	{
-		bool firstInterface = true;
-
-		sourceFile << R"cpp(	type)cpp" << objectType.cppType
-			<< R"cpp(->AddInterfaces({
-)cpp";
+	headerFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
 
-		for (const auto& interfaceName : objectType.interfaces)
-		{
-			if (!firstInterface)
-			{
-				sourceFile << R"cpp(,
-)cpp";
-			}
+#pragma once
 
-			firstInterface = false;
+#include <graphqlservice/GraphQLClient.h>
 
-			if (_options.separateFiles)
-			{
-				sourceFile << R"cpp(		std::static_pointer_cast<)cpp" << s_introspectionNamespace << R"cpp(::InterfaceType>(schema->LookupType(")cpp" << interfaceName
-					<< R"cpp(")))cpp";
-			}
-			else
-			{
-				sourceFile << R"cpp(		type)cpp" << getSafeCppName(interfaceName);
-			}
-		}
+#include <optional>
+#include <string_view>
+#include <vector>
 
-		sourceFile << R"cpp(
-	});
 )cpp";
-	}
 
-	if (!objectType.fields.empty())
+	NamespaceScope graphqlNamespace{ headerFile, "graphql" };
+	NamespaceScope clientNamespace{ headerFile, "client" };
+
+	// Declare the enum and input types which the operations use, so the client doesn't depend on the
+	// service schema header.
+	const auto usedTypes = getClientUsedTypes();
+
+	if (!usedTypes.empty())
 	{
-		bool firstValue = true;
+		headerFile << std::endl;
 
-		sourceFile << R"cpp(	type)cpp" << objectType.cppType
-			<< R"cpp(->AddFields({
-)cpp";
+		NamespaceScope schemaNamespace{ headerFile, _schemaNamespace };
 
-		for (const auto& objectField : objectType.fields)
+		headerFile << std::endl;
+
+		for (const auto& enumType : _enumTypes)
 		{
-			if (!firstValue)
+			if (usedTypes.find(enumType.type) == usedTypes.cend())
 			{
-				sourceFile << R"cpp(,
-)cpp";
+				continue;
 			}
 
-			firstValue = false;
-			sourceFile << R"cpp(		std::make_shared<)cpp" << s_introspectionNamespace
-				<< R"cpp(::Field>(")cpp" << objectField.name
-				<< R"cpp(", R"md()cpp" << objectField.description
-				<< R"cpp()md", )cpp";
-
-			if (objectField.deprecationReason)
-			{
-				sourceFile << R"cpp(std::make_optional<response::StringType>(R"md()cpp" << *objectField.deprecationReason << R"cpp()md"))cpp";
-			}
-			else
-			{
-				sourceFile << R"cpp(std::nullopt)cpp";
-			}
+			headerFile << R"cpp(enum class )cpp" << enumType.cppType << R"cpp(
+{
+)cpp";
 
-			sourceFile << R"cpp(, std::vector<std::shared_ptr<)cpp" << s_introspectionNamespace
-				<< R"cpp(::InputValue>>()cpp";
+			bool firstValue = true;
 
-			if (!objectField.arguments.empty())
+			for (const auto& value : enumType.values)
 			{
-				bool firstArgument = true;
-
-				sourceFile << R"cpp({
-)cpp";
-
-				for (const auto& argument : objectField.arguments)
-				{
-					if (!firstArgument)
-					{
-						sourceFile << R"cpp(,
+				if (!firstValue)
+				{
+					headerFile << R"cpp(,
 )cpp";
-					}
-
-					firstArgument = false;
-					sourceFile << R"cpp(			std::make_shared<)cpp" << s_introspectionNamespace
-						<< R"cpp(::InputValue>(")cpp" << argument.name
-						<< R"cpp(", R"md()cpp" << argument.description
-						<< R"cpp()md", )cpp" << getIntrospectionType(argument.type, argument.modifiers)
-						<< R"cpp(, R"gql()cpp" << argument.defaultValueString << R"cpp()gql"))cpp";
 				}
 
-				sourceFile << R"cpp(
-		})cpp";
+				firstValue = false;
+				headerFile << R"cpp(	)cpp" << value.cppValue;
 			}
 
-			sourceFile << R"cpp(), )cpp" << getIntrospectionType(objectField.type, objectField.modifiers)
-				<< R"cpp())cpp";
-		}
+			headerFile << R"cpp(
+};
 
-		sourceFile << R"cpp(
-	});
 )cpp";
-	}
-}
+		}
 
-std::string Generator::getArgumentDefaultValue(size_t level, const response::Value & defaultValue) const noexcept
-{
-	const std::string padding(level, '\t');
-	std::ostringstream argumentDefaultValue;
+		std::vector<const InputType*> inputTypes;
 
-	switch (defaultValue.type())
-	{
-		case response::Type::Map:
+		for (const auto& inputType : _inputTypes)
 		{
-			const auto& members = defaultValue.get<const response::MapType&>();
-
-			argumentDefaultValue << padding << R"cpp(		entry = []()
-)cpp" << padding << R"cpp(		{
-)cpp" << padding << R"cpp(			response::Value members(response::Type::Map);
-)cpp" << padding << R"cpp(			response::Value entry;
-
-)cpp";
+			if (usedTypes.find(inputType.type) != usedTypes.cend())
+			{
+				inputTypes.push_back(&inputType);
+			}
+		}
 
-			for (const auto& entry : members)
+		// Forward declare all of the input types
+		if (inputTypes.size() > 1)
+		{
+			for (const auto inputType : inputTypes)
 			{
-				argumentDefaultValue << getArgumentDefaultValue(level + 1, entry.second)
-					<< padding << R"cpp(			members.emplace_back(")cpp" << entry.first << R"cpp(", std::move(entry));
+				headerFile << R"cpp(struct )cpp" << inputType->cppType << R"cpp(;
 )cpp";
 			}
 
-			argumentDefaultValue << padding << R"cpp(			return members;
-)cpp" << padding << R"cpp(		}();
-)cpp";
-			break;
+			headerFile << std::endl;
 		}
 
-		case response::Type::List:
+		for (const auto inputType : inputTypes)
 		{
-			const auto& elements = defaultValue.get<const response::ListType&>();
-
-			argumentDefaultValue << padding << R"cpp(		entry = []()
-)cpp" << padding << R"cpp(		{
-)cpp" << padding << R"cpp(			response::Value elements(response::Type::List);
-)cpp" << padding << R"cpp(			response::Value entry;
-
+			headerFile << R"cpp(struct )cpp" << inputType->cppType << R"cpp(
+{
 )cpp";
 
-			for (const auto& entry : elements)
+			for (const auto& inputField : inputType->fields)
 			{
-				argumentDefaultValue << getArgumentDefaultValue(level + 1, entry)
-					<< padding << R"cpp(			elements.emplace_back(std::move(entry));
+				headerFile << R"cpp(	)cpp" << getFieldDeclaration(inputField) << R"cpp(;
 )cpp";
 			}
 
-			argumentDefaultValue << padding << R"cpp(			return elements;
-)cpp" << padding << R"cpp(		}();
+			headerFile << R"cpp(};
+
 )cpp";
-			break;
 		}
+	}
+
+	for (const auto& operation : _clientOperations)
+	{
+		const auto operationNamespace = getClientNamespace(operation);
+
+		headerFile << std::endl;
+
+		NamespaceScope operationScope{ headerFile, operationNamespace };
+
+		headerFile << R"cpp(
+// Return the original text of the request document, which may include other operations and fragments.
+std::string_view GetRequestText() noexcept;
+
+// Return the name of this operation in the request document.
+std::string_view GetOperationName() noexcept;
 
-		case response::Type::String:
-		{
-			argumentDefaultValue << padding << R"cpp(		entry = response::Value(std::string(R"gql()cpp"
-				<< defaultValue.get<const response::StringType&>() << R"cpp()gql"));
 )cpp";
-			break;
-		}
 
-		case response::Type::Null:
+		if (operation.variables.empty())
 		{
-			argumentDefaultValue << padding << R"cpp(		entry = {};
+			headerFile << R"cpp(// Build the request object with the query, operationName, and variables members.
+response::Value buildRequest();
 )cpp";
-			break;
 		}
-
-		case response::Type::Boolean:
+		else
 		{
-			argumentDefaultValue << padding << R"cpp(		entry = response::Value()cpp"
-				<< (defaultValue.get<response::BooleanType>()
-					? R"cpp(true)cpp"
-					: R"cpp(false)cpp")
-				<< R"cpp();
+			headerFile << R"cpp(struct Variables
+{
 )cpp";
-			break;
-		}
 
-		case response::Type::Int:
-		{
-			argumentDefaultValue << padding << R"cpp(		entry = response::Value(static_cast<response::IntType>()cpp"
-				<< defaultValue.get<response::IntType>() << R"cpp());
+			for (const auto& variable : operation.variables)
+			{
+				headerFile << R"cpp(	)cpp" << getClientInputCppType(variable)
+					<< R"cpp( )cpp" << variable.cppName
+					<< R"cpp(;
 )cpp";
-			break;
-		}
+			}
 
-		case response::Type::Float:
-		{
-			argumentDefaultValue << padding << R"cpp(		entry = response::Value(static_cast<response::FloatType>()cpp"
-				<< defaultValue.get<response::FloatType>() << R"cpp());
+			headerFile << R"cpp(};
+
+response::Value serializeVariables(Variables&& variables);
+
+// Build the request object with the query, operationName, and variables members.
+response::Value buildRequest(Variables&& variables);
 )cpp";
-			break;
 		}
 
-		case response::Type::EnumValue:
-		{
-			argumentDefaultValue << padding << R"cpp(		entry = response::Value(response::Type::EnumValue);
-		entry.set<response::StringType>(R"gql()cpp" << defaultValue.get<const response::StringType&>() << R"cpp()gql");
+		headerFile << R"cpp(
+struct Response
+{
 )cpp";
-			break;
-		}
 
-		case response::Type::Scalar:
-		{
-			argumentDefaultValue << padding << R"cpp(		entry = []()
-)cpp" << padding << R"cpp(		{
-)cpp" << padding << R"cpp(			response::Value scalar(response::Type::Scalar);
-)cpp" << padding << R"cpp(			response::Value entry;
+		outputResponseFields(headerFile, operation.responseFields, R"cpp(	)cpp");
 
-)cpp";
-			argumentDefaultValue << padding << R"cpp(	)cpp" << getArgumentDefaultValue(level + 1, defaultValue.get<const response::ScalarType&>())
-				<< padding << R"cpp(			scalar.set<response::ScalarType>(std::move(entry));
+		headerFile << R"cpp(};
+
+// Read the response directly into the typed Response, e.g. with response::parseJSON.
+ResponseReader getResponseReader(Response& response);
+
+// Read a response which was already parsed into a response::Value. If the response has any errors,
+// this throws a schema_exception with them instead.
+Response parseResponse(response::Value&& response);
 
-)cpp" << padding << R"cpp(			return scalar;
-)cpp" << padding << R"cpp(		}();
 )cpp";
-			break;
-		}
 	}
 
-	return argumentDefaultValue.str();
+	headerFile << std::endl;
 }
 
-std::string Generator::getArgumentDeclaration(const InputField & argument, const char* prefixToken, const char* argumentsToken, const char* defaultToken) const noexcept
+void Generator::outputResponseFields(std::ostream& headerFile, const ResponseFieldList& fields, const std::string& indent) const noexcept
 {
-	std::ostringstream argumentDeclaration;
-	std::string argumentName(argument.cppName);
-
-	argumentName[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(argumentName[0])));
-	if (argument.defaultValue.type() == response::Type::Null)
+	for (const auto& field : fields)
 	{
-		argumentDeclaration << R"cpp(	auto )cpp" << prefixToken << argumentName
-			<< R"cpp( = )cpp" << getArgumentAccessType(argument)
-			<< R"cpp(::require)cpp" << getTypeModifiers(argument.modifiers)
-			<< R"cpp((")cpp" << argument.name
-			<< R"cpp(", )cpp" << argumentsToken
-			<< R"cpp();
+		if (field.children.empty())
+		{
+			continue;
+		}
+
+		headerFile << indent << R"cpp(struct )cpp" << getResponseStructName(field) << R"cpp(
+)cpp" << indent << R"cpp({
+)cpp";
+
+		outputResponseFields(headerFile, field.children, indent + R"cpp(	)cpp");
+
+		headerFile << indent << R"cpp(};
+
 )cpp";
 	}
-	else
+
+	for (const auto& field : fields)
 	{
-		argumentDeclaration << R"cpp(	auto pair)cpp" << argumentName
-			<< R"cpp( = )cpp" << getArgumentAccessType(argument)
-			<< R"cpp(::find)cpp" << getTypeModifiers(argument.modifiers)
-			<< R"cpp((")cpp" << argument.name
-			<< R"cpp(", )cpp" << argumentsToken
-			<< R"cpp();
-	auto )cpp" << prefixToken << argumentName << R"cpp( = (pair)cpp" << argumentName << R"cpp(.second
-		? std::move(pair)cpp" << argumentName << R"cpp(.first)
-		: )cpp" << getArgumentAccessType(argument)
-			<< R"cpp(::require)cpp" << getTypeModifiers(argument.modifiers)
-			<< R"cpp((")cpp" << argument.name
-			<< R"cpp(", )cpp" << defaultToken
-			<< R"cpp());
+		headerFile << indent << getResponseCppType(field)
+			<< R"cpp( )cpp" << field.cppName
+			<< R"cpp(;
 )cpp";
 	}
-
-	return argumentDeclaration.str();
 }
 
-std::string Generator::getArgumentAccessType(const InputField & argument) const noexcept
+bool Generator::outputClientSource() const noexcept
 {
-	std::ostringstream argumentType;
+	std::ostringstream sourceFile;
 
-	argumentType << R"cpp(service::ModifiedArgument<)cpp";
+	outputClientSource(sourceFile);
 
-	switch (argument.fieldType)
-	{
-		case InputFieldType::Builtin:
-		case InputFieldType::Enum:
-		case InputFieldType::Input:
-			argumentType << getCppType(argument.type);
-			break;
+	return writeIfChanged(_clientSourcePath, sourceFile.str());
+}
 
-		case InputFieldType::Scalar:
-			argumentType << R"cpp(response::Value)cpp";
-			break;
-	}
+void Generator::outputClientSource(std::ostream& sourceFile) const noexcept
+{
+	// Only generate the enum and input type conversions which are used by the operations.
+	const auto usedTypes = getClientUsedTypes();
 
-	argumentType << R"cpp(>)cpp";
+	sourceFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
 
-	return argumentType.str();
-}
+#include ")cpp" << fs::path(_clientHeaderPath).filename().string() << R"cpp("
 
-std::string Generator::getResultAccessType(const OutputField & result) const noexcept
-{
-	std::ostringstream resultType;
+#include <algorithm>
+#include <array>
 
-	resultType << R"cpp(service::ModifiedResult<)cpp";
+)cpp";
 
-	switch (result.fieldType)
+	NamespaceScope graphqlNamespace{ sourceFile, "graphql" };
+	NamespaceScope clientNamespace{ sourceFile, "client" };
+
+	sourceFile << R"cpp(
+constexpr std::string_view s_requestText = R"gql()cpp" << _requestText << R"cpp()gql";
+)cpp";
+
+	for (const auto& enumType : _enumTypes)
 	{
-		case OutputFieldType::Builtin:
-		case OutputFieldType::Enum:
-		case OutputFieldType::Object:
-			resultType << getCppType(result.type);
-			break;
+		if (usedTypes.find(enumType.type) == usedTypes.cend())
+		{
+			continue;
+		}
 
-		case OutputFieldType::Scalar:
-			resultType << R"cpp(response::Value)cpp";
-			break;
+		bool firstValue = true;
 
-		case OutputFieldType::Union:
-		case OutputFieldType::Interface:
-			resultType << R"cpp(service::Object)cpp";
-			break;
-	}
+		sourceFile << R"cpp(
+static const std::array<std::string_view, )cpp" << enumType.values.size()
+			<< R"cpp(> s_names)cpp" << enumType.cppType
+			<< R"cpp( = {
+)cpp";
 
-	resultType << R"cpp(>)cpp";
+		for (const auto& value : enumType.values)
+		{
+			if (!firstValue)
+			{
+				sourceFile << R"cpp(,
+)cpp";
+			}
 
-	return resultType.str();
-}
+			firstValue = false;
+			sourceFile << R"cpp(	")cpp" << value.value << R"cpp(")cpp";
+		}
 
-std::string Generator::getTypeModifiers(const TypeModifierStack & modifiers) const noexcept
-{
-	bool firstValue = true;
-	std::ostringstream typeModifiers;
+		sourceFile << R"cpp(
+};
+
+static const std::array<std::pair<std::string_view, )cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+			<< R"cpp(>, )cpp" << enumType.values.size()
+			<< R"cpp(> s_sorted)cpp" << enumType.cppType
+			<< R"cpp( = { {
+)cpp";
+
+		std::vector<const EnumValueType*> sortedValues(enumType.values.size());
+
+		std::transform(enumType.values.cbegin(), enumType.values.cend(), sortedValues.begin(),
+			[](const EnumValueType& value) noexcept
+		{
+			return &value;
+		});
+		std::sort(sortedValues.begin(), sortedValues.end(),
+			[](const EnumValueType* lhs, const EnumValueType* rhs) noexcept
+		{
+			return lhs->value < rhs->value;
+		});
 
-	for (auto modifier : modifiers)
-	{
-		if (firstValue)
+		firstValue = true;
+
+		for (const auto value : sortedValues)
 		{
-			typeModifiers << R"cpp(<)cpp";
+			if (!firstValue)
+			{
+				sourceFile << R"cpp(,
+)cpp";
+			}
+
 			firstValue = false;
-		}
-		else
-		{
-			typeModifiers << R"cpp(, )cpp";
+			sourceFile << R"cpp(	{ ")cpp" << value->value
+				<< R"cpp(", )cpp" << _schemaNamespace
+				<< R"cpp(::)cpp" << enumType.cppType
+				<< R"cpp(::)cpp" << value->cppValue
+				<< R"cpp( })cpp";
 		}
 
-		switch (modifier)
-		{
-			case service::TypeModifier::Nullable:
-				typeModifiers << R"cpp(service::TypeModifier::Nullable)cpp";
-				break;
+		sourceFile << R"cpp(
+} };
 
-			case service::TypeModifier::List:
-				typeModifiers << R"cpp(service::TypeModifier::List)cpp";
-				break;
+template <>
+struct ValueReader<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+			<< R"cpp(> : UnexpectedValue<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+			<< R"cpp(>
+{
+	static void add_string()cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+			<< R"cpp(& value, std::string_view input)
+	{
+		auto itr = std::lower_bound(s_sorted)cpp" << enumType.cppType
+			<< R"cpp(.cbegin(), s_sorted)cpp" << enumType.cppType
+			<< R"cpp(.cend(), input,
+			[](const auto& entry, std::string_view key) noexcept
+			{
+				return entry.first < key;
+			});
 
-			case service::TypeModifier::None:
-				break;
+		if (itr == s_sorted)cpp" << enumType.cppType
+			<< R"cpp(.cend() || itr->first != input)
+		{
+			throw service::schema_exception({ "not a valid )cpp" << enumType.type << R"cpp( value" });
 		}
+
+		value = itr->second;
 	}
+};
 
-	if (!firstValue)
+template <>
+struct Variable<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+			<< R"cpp(>
+{
+	static response::Value serialize()cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.cppType
+			<< R"cpp(&& value)
 	{
-		typeModifiers << R"cpp(>)cpp";
-	}
+		response::Value result(response::Type::EnumValue);
 
-	return typeModifiers.str();
-}
+		result.set<response::StringType>(std::string(s_names)cpp" << enumType.cppType
+			<< R"cpp([static_cast<size_t>(value)]));
 
-std::string Generator::getIntrospectionType(const std::string & type, const TypeModifierStack & modifiers) const noexcept
-{
-	size_t wrapperCount = 0;
-	bool nonNull = true;
-	std::ostringstream introspectionType;
+		return result;
+	}
+};
+)cpp";
+	}
 
-	for (auto modifier : modifiers)
+	for (const auto& inputType : _inputTypes)
 	{
-		if (!nonNull)
+		if (usedTypes.find(inputType.type) == usedTypes.cend())
 		{
-			switch (modifier)
-			{
-				case service::TypeModifier::None:
-				case service::TypeModifier::List:
-					// If the next modifier is None or List we should treat it as non-nullable.
-					nonNull = true;
-					break;
-
-				case service::TypeModifier::Nullable:
-					break;
-			}
+			continue;
 		}
 
-		if (nonNull)
-		{
-			switch (modifier)
-			{
-				case service::TypeModifier::None:
-				case service::TypeModifier::List:
-				{
-					introspectionType << R"cpp(schema->WrapType()cpp" << s_introspectionNamespace
-						<< R"cpp(::TypeKind::NON_NULL, )cpp";
-					++wrapperCount;
-					break;
-				}
+		sourceFile << R"cpp(
+template <>
+struct Variable<)cpp" << _schemaNamespace << R"cpp(::)cpp" << inputType.cppType
+			<< R"cpp(>
+{
+	static response::Value serialize()cpp" << _schemaNamespace << R"cpp(::)cpp" << inputType.cppType
+			<< R"cpp(&& value)
+	{
+		response::Value result(response::Type::Map);
 
-				case service::TypeModifier::Nullable:
-					// If the next modifier is Nullable that cancels the non-nullable state.
-					nonNull = false;
-					break;
-			}
-		}
+		result.reserve()cpp" << inputType.fields.size() << R"cpp();
+)cpp";
 
-		switch (modifier)
+		for (const auto& inputField : inputType.fields)
 		{
-			case service::TypeModifier::None:
-			case service::TypeModifier::Nullable:
-				break;
+			const auto serialize = R"cpp(result.emplace_back(")cpp" + inputField.name
+				+ R"cpp(", Variable<)cpp" + getClientInputCppType(inputField)
+				+ R"cpp(>::serialize(std::move(value.)cpp" + inputField.cppName
+				+ R"cpp()));
+)cpp";
 
-			case service::TypeModifier::List:
+			// Leave out a nullable field with a default value if it's empty, so the service uses the default.
+			if (!inputField.defaultValueString.empty()
+				&& !inputField.modifiers.empty()
+				&& inputField.modifiers.front() == service::TypeModifier::Nullable)
 			{
-				introspectionType << R"cpp(schema->WrapType()cpp" << s_introspectionNamespace
-					<< R"cpp(::TypeKind::LIST, )cpp";
-				++wrapperCount;
-				break;
+				sourceFile << R"cpp(
+		if (value.)cpp" << inputField.cppName << R"cpp()
+		{
+			)cpp" << serialize << R"cpp(		}
+
+)cpp";
+			}
+			else
+			{
+				sourceFile << R"cpp(		)cpp" << serialize;
 			}
 		}
+
+		sourceFile << R"cpp(
+		return result;
+	}
+};
+)cpp";
 	}
 
-	if (nonNull)
+	for (const auto& operation : _clientOperations)
 	{
-		introspectionType << R"cpp(schema->WrapType()cpp" << s_introspectionNamespace
-			<< R"cpp(::TypeKind::NON_NULL, )cpp";
-		++wrapperCount;
-	}
+		const auto operationNamespace = getClientNamespace(operation);
 
-	introspectionType << R"cpp(schema->LookupType(")cpp" << type
-		<< R"cpp("))cpp";
+		outputResponseMembers(sourceFile, operationNamespace + R"cpp(::Response)cpp", operation.responseFields);
 
-	for (size_t i = 0; i < wrapperCount; ++i)
-	{
-		introspectionType << R"cpp())cpp";
-	}
+		sourceFile << std::endl;
 
-	return introspectionType.str();
+		NamespaceScope operationScope{ sourceFile, operationNamespace };
+
+		sourceFile << R"cpp(
+std::string_view GetRequestText() noexcept
+{
+	return s_requestText;
 }
 
-std::vector<std::string> Generator::outputSeparateFiles() const noexcept
+std::string_view GetOperationName() noexcept
 {
-	std::vector<std::string> files;
-	const fs::path headerDir(_headerDir);
-	const fs::path sourceDir(_sourceDir);
-	std::string queryType;
+	return ")cpp" << operation.name << R"cpp(";
+}
 
-	for (const auto& operation : _operationTypes)
-	{
-		if (operation.operation == service::strQuery)
+)cpp";
+
+		if (operation.variables.empty())
 		{
-			queryType = operation.type;
-			break;
+			sourceFile << R"cpp(response::Value buildRequest()
+{
+	return client::buildRequest(GetRequestText(), GetOperationName(), response::Value(response::Type::Map));
+}
+)cpp";
 		}
-	}
-
-	// Output a convenience header
-	std::ofstream objectHeaderFile(_objectHeaderPath, std::ios_base::trunc);
-
-	objectHeaderFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
-// Licensed under the MIT License.
-
-#pragma once
+		else
+		{
+			sourceFile << R"cpp(response::Value serializeVariables(Variables&& variables)
+{
+	response::Value result(response::Type::Map);
 
-#include ")cpp" << fs::path(_headerPath).filename().string() << R"cpp("
+	result.reserve()cpp" << operation.variables.size() << R"cpp();
+)cpp";
 
+			for (const auto& variable : operation.variables)
+			{
+				const auto serialize = R"cpp(result.emplace_back(")cpp" + variable.name
+					+ R"cpp(", Variable<)cpp" + getClientInputCppType(variable)
+					+ R"cpp(>::serialize(std::move(variables.)cpp" + variable.cppName
+					+ R"cpp()));
 )cpp";
 
-	for (const auto& objectType : _objectTypes)
+				// Leave out a nullable variable with a default value if it's empty, so the service uses the default.
+				if (!variable.defaultValueString.empty()
+					&& !variable.modifiers.empty()
+					&& variable.modifiers.front() == service::TypeModifier::Nullable)
+				{
+					sourceFile << R"cpp(
+	if (variables.)cpp" << variable.cppName << R"cpp()
 	{
-		const auto headerFilename = std::string(objectType.cppType) + "Object.h";
+		)cpp" << serialize << R"cpp(	}
 
-		objectHeaderFile << R"cpp(#include ")cpp" << headerFilename << R"cpp("
 )cpp";
-	}
+				}
+				else
+				{
+					sourceFile << R"cpp(	)cpp" << serialize;
+				}
+			}
 
-	if (_options.verbose)
-	{
-		files.push_back({ _objectHeaderPath });
-	}
-	
-	for (const auto& objectType : _objectTypes)
-	{
-		std::ostringstream ossNamespace;
+			sourceFile << R"cpp(
+	return result;
+}
 
-		ossNamespace << R"cpp(graphql::)cpp"
-			<< _schemaNamespace;
+response::Value buildRequest(Variables&& variables)
+{
+	return client::buildRequest(GetRequestText(), GetOperationName(), serializeVariables(std::move(variables)));
+}
+)cpp";
+		}
 
-		const auto schemaNamespace = ossNamespace.str();
+		sourceFile << R"cpp(
+ResponseReader getResponseReader(Response& response)
+{
+	return ResponseReader { std::make_unique<ObjectReader<Response>>(response) };
+}
 
-		ossNamespace << R"cpp(::object)cpp";
+Response parseResponse(response::Value&& response)
+{
+	Response result {};
+	auto reader = getResponseReader(result);
 
-		const auto objectNamespace = ossNamespace.str();
-		const bool isQueryType = objectType.type == queryType;
-		const auto headerFilename = std::string(objectType.cppType) + "Object.h";
-		const auto headerPath = (headerDir / headerFilename).string();
-		std::ofstream headerFile(headerPath, std::ios_base::trunc);
+	reader.add_value(std::move(response));
 
-		headerFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
-// Licensed under the MIT License.
+	auto errors = reader.getErrors();
 
-#pragma once
+	if (errors.type() != response::Type::Null)
+	{
+		throw service::schema_exception::fromErrors(std::move(errors));
+	}
 
-#include ")cpp" << fs::path(_headerPath).filename().string() << R"cpp("
+	return result;
+}
 
 )cpp";
+	}
 
-		NamespaceScope headerNamespace{ headerFile, objectNamespace };
-
-		// Output the full declaration
-		headerFile << std::endl;
-		outputObjectDeclaration(headerFile, objectType, isQueryType);
-		headerFile << std::endl;
+	sourceFile << std::endl;
+}
 
-		if (_options.verbose)
+void Generator::outputResponseMembers(std::ostream& sourceFile, const std::string& cppType, const ResponseFieldList& fields) const noexcept
+{
+	// The nested types need to be specialized before the ObjectReader for this type uses them.
+	for (const auto& field : fields)
+	{
+		if (!field.children.empty())
 		{
-			files.push_back(std::move(headerPath));
+			outputResponseMembers(sourceFile, cppType + R"cpp(::)cpp" + getResponseStructName(field), field.children);
 		}
+	}
 
-		const auto sourceFilename = std::string(objectType.cppType) + "Object.cpp";
-		const auto sourcePath = (sourceDir / sourceFilename).string();
-		std::ofstream sourceFile(sourcePath, std::ios_base::trunc);
-
-		sourceFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
-// Licensed under the MIT License.
+	// Sort the keys so the ObjectReader can use a binary search.
+	std::vector<const ResponseField*> sortedFields(fields.size());
 
-#include ")cpp" << fs::path(_objectHeaderPath).filename().string() << R"cpp("
+	std::transform(fields.cbegin(), fields.cend(), sortedFields.begin(),
+		[](const ResponseField& field) noexcept
+	{
+		return &field;
+	});
+	std::sort(sortedFields.begin(), sortedFields.end(),
+		[](const ResponseField* lhs, const ResponseField* rhs) noexcept
+	{
+		return lhs->name < rhs->name;
+	});
 
-#include <graphqlservice/Introspection.h>
+	bool firstField = true;
 
-#include <algorithm>
-#include <functional>
-#include <sstream>
-#include <unordered_map>
-#include <exception>
+	sourceFile << R"cpp(
+template <>
+struct ResponseMembers<)cpp" << cppType << R"cpp(>
+{
+	static constexpr std::array<std::string_view, )cpp" << sortedFields.size() << R"cpp(> keys = {
+)cpp";
 
+	for (const auto field : sortedFields)
+	{
+		if (!firstField)
+		{
+			sourceFile << R"cpp(,
 )cpp";
+		}
 
-		NamespaceScope sourceSchemaNamespace{ sourceFile, schemaNamespace };
-		NamespaceScope sourceObjectNamespace{ sourceFile, "object" };
+		firstField = false;
+		sourceFile << R"cpp(		")cpp" << field->name << R"cpp(")cpp";
+	}
 
-		sourceFile << std::endl;
-		outputObjectImplementation(sourceFile, objectType, isQueryType);
-		sourceFile << std::endl;
+	sourceFile << R"cpp(
+	};
 
-		sourceObjectNamespace.exit();
-		sourceFile << std::endl;
+	static constexpr std::array<bool, )cpp" << sortedFields.size() << R"cpp(> required = {
+)cpp";
 
-		sourceFile << R"cpp(void Add)cpp" << objectType.cppType
-			<< R"cpp(Details(std::shared_ptr<)cpp" << s_introspectionNamespace
-			<< R"cpp(::ObjectType> type)cpp" << objectType.cppType
-			<< R"cpp(, std::shared_ptr<)cpp" << s_introspectionNamespace
-			<< R"cpp(::Schema> schema)
-{
+	firstField = true;
+
+	for (const auto field : sortedFields)
+	{
+		if (!firstField)
+		{
+			sourceFile << R"cpp(,
 )cpp";
-		outputObjectIntrospection(sourceFile, objectType);
-		sourceFile << R"cpp(}
+		}
 
+		firstField = false;
+		sourceFile << R"cpp(		)cpp"
+			<< ((field->modifiers.empty() || field->modifiers.front() != service::TypeModifier::Nullable)
+				? R"cpp(true)cpp"
+				: R"cpp(false)cpp");
+	}
+
+	sourceFile << R"cpp(
+	};
+
+	template <typename Visitor>
+	static void visit()cpp" << cppType << R"cpp(& value, size_t index, Visitor&& visitor)
+	{
+		switch (index)
+		{
 )cpp";
 
-		files.push_back(std::move(sourcePath));
+	for (size_t i = 0; i < sortedFields.size(); ++i)
+	{
+		sourceFile << R"cpp(			case )cpp" << i << R"cpp(:
+				visitor(value.)cpp" << sortedFields[i]->cppName << R"cpp();
+				break;
+
+)cpp";
 	}
 
-	return files;
+	sourceFile << R"cpp(			default:
+				break;
+		}
+	}
+};
+)cpp";
 }
 
 } /* namespace graphql::schema */
 
+// The schemagen_benchmark tool links against the Generator without this entry point.
+#ifndef GRAPHQL_SCHEMAGEN_NO_MAIN
 
 namespace po = boost::program_options;
 
@@ -3348,11 +5204,14 @@ int main(int argc, char** argv)
 	bool noStubs = false;
 	bool verbose = false;
 	bool separateFiles = false;
+	bool timing = false;
+	bool noIntrospection = false;
 	std::string schemaFileName;
 	std::string filenamePrefix;
 	std::string schemaNamespace;
 	std::string sourceDir;
 	std::string headerDir;
+	std::string operationsFilename;
 
 	options.add_options()
 		("help,?", po::bool_switch(&showUsage), "Print the command line options")
@@ -3363,7 +5222,10 @@ int main(int argc, char** argv)
 		("source-dir", po::value(&sourceDir), "Target path for the <prefix>Schema.cpp source file")
 		("header-dir", po::value(&headerDir), "Target path for the <prefix>Schema.h header file")
 		("no-stubs", po::bool_switch(&noStubs), "Generate abstract classes without stub implementations")
-		("separate-files", po::bool_switch(&separateFiles), "Generate separate files for each of the types");
+		("separate-files", po::bool_switch(&separateFiles), "Generate separate files for each of the types")
+		("timing", po::bool_switch(&timing), "Report how long each phase of code generation takes and how much memory it uses")
+		("no-introspection", po::bool_switch(&noIntrospection), "Generate a service without the __schema and __type introspection fields")
+		("operations", po::value(&operationsFilename), "Client request document; generates <prefix>Client.* with typed request builders and response readers");
 	positional
 		.add("schema", 1)
 		.add("prefix", 1)
@@ -3419,11 +5281,13 @@ int main(int argc, char** argv)
 	{
 		if (buildIntrospection)
 		{
-			const auto files = graphql::schema::Generator({
-				std::nullopt,
-				std::nullopt,
-				verbose
-			}).Build();
+			graphql::schema::GeneratorOptions introspectionOptions;
+
+			introspectionOptions.verbose = verbose;
+			introspectionOptions.timing = timing;
+
+			graphql::schema::PhaseTimer totalTimer{ timing, "total" };
+			const auto files = graphql::schema::Generator(std::move(introspectionOptions)).Build();
 
 			for (const auto& file : files)
 			{
@@ -3433,6 +5297,7 @@ int main(int argc, char** argv)
 
 		if (buildCustom)
 		{
+			graphql::schema::PhaseTimer totalTimer{ timing, "total" };
 			const auto files = graphql::schema::Generator({
 				graphql::schema::GeneratorSchema{
 					std::move(schemaFileName),
@@ -3445,7 +5310,12 @@ int main(int argc, char** argv)
 				},
 				verbose,
 				separateFiles,
-				noStubs
+				noStubs,
+				timing,
+				noIntrospection,
+				operationsFilename.empty()
+					? std::nullopt
+					: std::make_optional(std::move(operationsFilename))
 			}).Build();
 
 			for (const auto& file : files)
@@ -3476,3 +5346,5 @@ int main(int argc, char** argv)
 
 	return 0;
 }
+
+#endif
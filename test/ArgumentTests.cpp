@@ -192,6 +192,29 @@ TEST(ArgumentsCase, TaskStateEnumFromString)
 	EXPECT_EQ(R"js([{"message":"Invalid argument: status error: not a valid TaskState value"}])js", exceptionWhat) << "exception should match";
 }
 
+TEST(ArgumentsCase, TaskStateEnumUnknownValue)
+{
+	response::Value response(response::Type::Map);
+	response::Value status(response::Type::EnumValue);
+	status.set<response::StringType>("Startedd");
+	response.emplace_back("status", std::move(status));
+	bool caughtException = false;
+	std::string exceptionWhat;
+
+	try
+	{
+		service::ModifiedArgument<today::TaskState>::require("status", response);
+	}
+	catch (const service::schema_exception& ex)
+	{
+		caughtException = true;
+		exceptionWhat = response::toJSON(response::Value(ex.getErrors()));
+	}
+
+	ASSERT_TRUE(caughtException);
+	EXPECT_EQ(R"js([{"message":"Invalid argument: status error: not a valid TaskState value"}])js", exceptionWhat) << "exception should match";
+}
+
 TEST(ArgumentsCase, TaskStateEnumFromJSONString)
 {
 	response::Value response(response::Type::Map);
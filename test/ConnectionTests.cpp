@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include <graphqlservice/GraphQLConnection.h>
+
+#include <algorithm>
+
+using namespace graphql;
+
+TEST(ConnectionCase, OffsetCursorRoundTrip)
+{
+	for (const size_t offset : { size_t(0), size_t(1), size_t(255), size_t(256), size_t(1) << 40 })
+	{
+		ASSERT_EQ(offset, service::Cursor::toOffset(service::Cursor::fromOffset(offset)));
+	}
+}
+
+TEST(ConnectionCase, CursorKindsAreNotInterchangeable)
+{
+	const response::IdType key { 'k', 'e', 'y' };
+	const auto keyCursor = service::Cursor::fromKey(key);
+
+	ASSERT_EQ(key, service::Cursor::toKey(keyCursor));
+	EXPECT_THROW(service::Cursor::toOffset(keyCursor), service::schema_exception);
+	EXPECT_THROW(service::Cursor::toKey(service::Cursor::fromOffset(3)), service::schema_exception);
+	EXPECT_THROW(service::Cursor::toOffset(response::Value(5)), service::schema_exception);
+}
+
+TEST(ConnectionCase, SliceByOffset)
+{
+	service::ConnectionArguments arguments;
+
+	arguments.first = 3;
+	arguments.after = service::Cursor::fromOffset(4);
+
+	auto slice = service::sliceByOffset(10, arguments);
+
+	EXPECT_EQ(size_t(5), slice.begin) << "after should not include the element at the cursor";
+	EXPECT_EQ(size_t(8), slice.end);
+	EXPECT_FALSE(slice.hasPreviousPage) << "only last sets hasPreviousPage";
+	EXPECT_TRUE(slice.hasNextPage);
+
+	arguments.first.reset();
+	arguments.after.reset();
+	arguments.last = 2;
+	arguments.before = service::Cursor::fromOffset(2);
+	slice = service::sliceByOffset(10, arguments);
+
+	EXPECT_EQ(size_t(0), slice.begin);
+	EXPECT_EQ(size_t(2), slice.end);
+	EXPECT_FALSE(slice.hasPreviousPage);
+	EXPECT_FALSE(slice.hasNextPage) << "only first sets hasNextPage";
+
+	arguments.before = service::Cursor::fromOffset(8);
+	slice = service::sliceByOffset(10, arguments);
+
+	EXPECT_EQ(size_t(6), slice.begin);
+	EXPECT_EQ(size_t(8), slice.end);
+	EXPECT_TRUE(slice.hasPreviousPage);
+	EXPECT_FALSE(slice.hasNextPage);
+
+	arguments.last.reset();
+	arguments.before = service::Cursor::fromOffset(100);
+	slice = service::sliceByOffset(10, arguments);
+
+	EXPECT_EQ(size_t(0), slice.begin);
+	EXPECT_EQ(size_t(10), slice.end);
+	EXPECT_FALSE(slice.hasNextPage);
+
+	arguments.first = -1;
+	EXPECT_THROW(service::sliceByOffset(10, arguments), service::schema_exception);
+}
+
+TEST(ConnectionCase, SliceByKey)
+{
+	const std::vector<response::IdType> keys {
+		{ 'a' },
+		{ 'c' },
+		{ 'e' },
+		{ 'g' },
+	};
+	const auto projection = [](const response::IdType& key) -> const response::IdType& {
+		return key;
+	};
+	service::ConnectionArguments arguments;
+
+	// Seek to a key which isn't in the source, it should start with the next one.
+	arguments.after = service::Cursor::fromKey({ 'b' });
+	arguments.before = service::Cursor::fromKey({ 'g' });
+
+	const auto slice = service::sliceByKey(keys.cbegin(), keys.cend(), projection, arguments);
+
+	EXPECT_EQ(size_t(1), slice.begin);
+	EXPECT_EQ(size_t(3), slice.end);
+	EXPECT_FALSE(slice.hasPreviousPage);
+	EXPECT_FALSE(slice.hasNextPage);
+}
+
+TEST(ConnectionCase, SliceById)
+{
+	const std::vector<response::IdType> ids {
+		{ 'd' },
+		{ 'b' },
+		{ 'a' },
+		{ 'c' },
+	};
+	const auto indexOf = [&ids](const response::IdType& id) -> std::optional<size_t> {
+		const auto itr = std::find(ids.cbegin(), ids.cend(), id);
+
+		return (itr == ids.cend()
+			? std::nullopt
+			: std::make_optional(static_cast<size_t>(std::distance(ids.cbegin(), itr))));
+	};
+	service::ConnectionArguments arguments;
+
+	// ID cursors are the Base64 encoded IDs without a tag.
+	EXPECT_EQ(response::Value(service::Base64::toBase64(ids[1])), service::Cursor::fromId(ids[1]));
+	ASSERT_EQ(ids[1], service::Cursor::toId(service::Cursor::fromId(ids[1])));
+
+	arguments.after = service::Cursor::fromId({ 'b' });
+	arguments.first = 1;
+
+	auto slice = service::sliceById(ids.size(), indexOf, arguments);
+
+	EXPECT_EQ(size_t(2), slice.begin) << "after should not include the element at the cursor";
+	EXPECT_EQ(size_t(3), slice.end);
+	EXPECT_FALSE(slice.hasPreviousPage);
+	EXPECT_TRUE(slice.hasNextPage);
+
+	// A cursor for an ID which isn't in the source is ignored.
+	arguments.after = service::Cursor::fromId({ 'z' });
+	arguments.first.reset();
+	arguments.before = service::Cursor::fromId({ 'c' });
+	slice = service::sliceById(ids.size(), indexOf, arguments);
+
+	EXPECT_EQ(size_t(0), slice.begin);
+	EXPECT_EQ(size_t(3), slice.end);
+}
+
+TEST(ConnectionCase, MakeEdgesOnlyVisitsThePage)
+{
+	std::vector<size_t> visited;
+	auto edges = service::makeEdges<size_t>(service::ConnectionSlice { 2, 4, true, true },
+		[&visited](size_t index) {
+			visited.push_back(index);
+			return index * 10;
+		});
+
+	EXPECT_TRUE(visited.empty()) << "edges should be built as they are resolved";
+	EXPECT_EQ(std::make_optional<size_t>(20), edges.next());
+	EXPECT_EQ(std::make_optional<size_t>(30), edges.next());
+	EXPECT_EQ(std::nullopt, edges.next());
+	EXPECT_EQ((std::vector<size_t> { 2, 3 }), visited);
+}
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include <graphqlservice/GraphQLMetrics.h>
+
+#include <thread>
+
+using namespace graphql;
+
+TEST(MetricsCase, HistogramBucketsAreContiguous)
+{
+	uint64_t lowerBound = 0;
+
+	for (size_t bucket = 0; bucket < service::MetricsHistogram::bucketCount; ++bucket)
+	{
+		const auto upperBound = service::MetricsHistogram::getUpperBound(bucket);
+
+		ASSERT_LT(lowerBound, upperBound) << "bucket: " << bucket;
+		EXPECT_EQ(bucket, service::MetricsHistogram::getBucket(lowerBound)) << "lower bound: " << lowerBound;
+		EXPECT_EQ(bucket, service::MetricsHistogram::getBucket(upperBound - 1)) << "upper bound: " << upperBound;
+		lowerBound = upperBound;
+	}
+
+	EXPECT_EQ(service::MetricsHistogram::bucketCount, service::MetricsHistogram::getBucket(lowerBound))
+		<< "values past the last bound should only be counted in the total";
+}
+
+TEST(MetricsCase, MergeShards)
+{
+	service::Metrics metrics(4, 2);
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([&metrics, i]() {
+			metrics.recordField("Query", "a", std::chrono::microseconds(3), false);
+			metrics.recordField("Query", "b", std::chrono::microseconds(5), i % 2 == 0);
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	const auto snapshot = metrics.snapshot();
+
+	ASSERT_EQ(size_t(2), snapshot.fields.size());
+	EXPECT_EQ("a", snapshot.fields[0].second);
+	EXPECT_EQ(uint64_t(8), snapshot.fields[0].calls);
+	EXPECT_EQ(uint64_t(24), snapshot.fields[0].latency.sumMicroseconds);
+	EXPECT_EQ(uint64_t(8), snapshot.fields[0].latency.buckets[service::MetricsHistogram::getBucket(3)]);
+	EXPECT_EQ("b", snapshot.fields[1].second);
+	EXPECT_EQ(uint64_t(4), snapshot.fields[1].errors);
+}
+
+TEST(MetricsCase, DropWhenFull)
+{
+	service::Metrics metrics(1, 2);
+
+	metrics.recordField("Query", "a", std::chrono::microseconds(1), false);
+	metrics.recordField("Query", "b", std::chrono::microseconds(1), false);
+	metrics.recordField("Query", "c", std::chrono::microseconds(1), false);
+
+	const auto snapshot = metrics.snapshot();
+
+	EXPECT_EQ(size_t(2), snapshot.fields.size());
+	EXPECT_EQ(uint64_t(1), snapshot.dropped) << "the third field should not fit in the shard";
+}
+
+TEST(MetricsCase, PrometheusExposition)
+{
+	service::Metrics metrics(1);
+
+	metrics.recordField("Query", "say \"hi\"", std::chrono::microseconds(1500), false);
+
+	const auto exposition = service::toPrometheus(metrics.snapshot(), "app");
+
+	EXPECT_NE(std::string::npos, exposition.find("# TYPE app_field_duration_seconds histogram\n"));
+	EXPECT_NE(std::string::npos, exposition.find(R"(app_field_calls_total{type="Query",field="say \"hi\""} 1)"))
+		<< "label values should be escaped";
+	EXPECT_NE(std::string::npos, exposition.find(R"(app_field_duration_seconds_bucket{type="Query",field="say \"hi\"",le="0.001024"} 0)"));
+	EXPECT_NE(std::string::npos, exposition.find(R"(app_field_duration_seconds_bucket{type="Query",field="say \"hi\"",le="0.001536"} 1)"));
+	EXPECT_NE(std::string::npos, exposition.find(R"(app_field_duration_seconds_bucket{type="Query",field="say \"hi\"",le="+Inf"} 1)"));
+	EXPECT_NE(std::string::npos, exposition.find(R"(app_field_duration_seconds_sum{type="Query",field="say \"hi\""} 0.0015)"));
+	EXPECT_NE(std::string::npos, exposition.find("app_metrics_dropped_total 0\n"));
+}
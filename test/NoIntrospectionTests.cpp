@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "UnifiedToday.h"
+
+#include <graphqlservice/JSONResponse.h>
+
+using namespace graphql;
+
+using namespace std::literals;
+
+// The today sample compiled against the schema generated with --no-introspection.
+class NoIntrospectionServiceCase : public ::testing::Test
+{
+public:
+	static void SetUpTestCase()
+	{
+		std::string fakeTaskId("fakeTaskId");
+		_fakeTaskId.resize(fakeTaskId.size());
+		std::copy(fakeTaskId.cbegin(), fakeTaskId.cend(), _fakeTaskId.begin());
+
+		auto query = std::make_shared<today::Query>(
+			[]() -> std::vector<std::shared_ptr<today::Appointment>>
+		{
+			return {};
+		}, []() -> std::vector<std::shared_ptr<today::Task>>
+		{
+			return { std::make_shared<today::Task>(response::IdType(_fakeTaskId), "Don't forget", true) };
+		}, []() -> std::vector<std::shared_ptr<today::Folder>>
+		{
+			return {};
+		});
+		auto mutation = std::make_shared<today::Mutation>(
+			[](today::CompleteTaskInput&& input) -> std::shared_ptr<today::CompleteTaskPayload>
+		{
+			return std::make_shared<today::CompleteTaskPayload>(
+				std::make_shared<today::Task>(std::move(input.id), "Mutated Task!", *(input.isComplete)),
+				std::move(input.clientMutationId)
+				);
+		});
+
+		_service = std::make_shared<today::Operations>(query, mutation, nullptr);
+	}
+
+	static void TearDownTestCase()
+	{
+		_fakeTaskId.clear();
+		_service.reset();
+	}
+
+protected:
+	static response::IdType _fakeTaskId;
+
+	static std::shared_ptr<today::Operations> _service;
+};
+
+response::IdType NoIntrospectionServiceCase::_fakeTaskId;
+
+std::shared_ptr<today::Operations> NoIntrospectionServiceCase::_service;
+
+TEST_F(NoIntrospectionServiceCase, QueryTasks)
+{
+	auto ast = R"({
+			__typename
+			tasks {
+				edges {
+					node {
+						id
+						title
+						isComplete
+						__typename
+					}
+				}
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(1);
+	auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+
+	try
+	{
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		auto errorsItr = result.find("errors");
+		if (errorsItr != result.get<const response::MapType&>().cend())
+		{
+			FAIL() << response::toJSON(response::Value(errorsItr->second));
+		}
+		const auto data = service::ScalarArgument::require("data", result);
+		EXPECT_EQ("Query", service::StringArgument::require("__typename", data)) << "__typename should still resolve";
+
+		const auto tasks = service::ScalarArgument::require("tasks", data);
+		const auto tasksEdges = service::ScalarArgument::require<service::TypeModifier::List>("edges", tasks);
+		ASSERT_EQ(size_t(1), tasksEdges.size());
+		const auto taskNode = service::ScalarArgument::require("node", tasksEdges[0]);
+		EXPECT_EQ(_fakeTaskId, service::IdArgument::require("id", taskNode)) << "id should match in base64 encoding";
+		EXPECT_EQ("Don't forget", service::StringArgument::require("title", taskNode)) << "title should match";
+		EXPECT_TRUE(service::BooleanArgument::require("isComplete", taskNode)) << "isComplete should match";
+		EXPECT_EQ("Task", service::StringArgument::require("__typename", taskNode)) << "__typename should match";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(NoIntrospectionServiceCase, QuerySchemaIsUnknown)
+{
+	for (const auto& query : { R"({ __schema { queryType { name } } })"s, R"({ __type(name: "Task") { name } })"s })
+	{
+		auto ast = peg::parseString(query);
+		response::Value variables(response::Type::Map);
+		auto state = std::make_shared<today::RequestState>(2);
+		std::string errorsString;
+
+		// The unknown field is rejected while visiting the selection set, so depending on where that
+		// happens the error either comes back in the document or surfaces from the future.
+		try
+		{
+			auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+
+			ASSERT_TRUE(result.type() == response::Type::Map);
+			auto errorsItr = result.find("errors");
+			ASSERT_FALSE(errorsItr == result.get<const response::MapType&>().cend()) << "query: " << query;
+			errorsString = response::toJSON(response::Value(errorsItr->second));
+		}
+		catch (const service::schema_exception & ex)
+		{
+			errorsString = response::toJSON(response::Value(ex.getErrors()));
+		}
+
+		EXPECT_NE(std::string::npos, errorsString.find("Unknown field name: __")) << errorsString;
+	}
+}
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include <graphqlservice/GraphQLNormalize.h>
+#include <graphqlservice/GraphQLParse.h>
+#include <graphqlservice/GraphQLTree.h>
+
+using namespace graphql;
+
+TEST(NormalizeCase, IgnoreFormatting)
+{
+	auto first = R"gql(
+		# Comments and unused fragments don't matter.
+		query Appointments($first: Int, $after: String) {
+			appointments(first: $first, after: $after) {
+				edges { node { ...AppointmentFields } }
+			}
+		}
+
+		fragment Unused on Appointment { id }
+
+		fragment AppointmentFields on Appointment {
+			id
+			subject @include(if: true) @skip(if: false)
+		})gql"_graphql;
+	auto second = R"gql(fragment AppointmentFields on Appointment { id, subject @skip(if: false) @include(if: true) }
+		query Appointments($after: String, $first: Int) { appointments(after: $after, first: $first) { edges { node { ...AppointmentFields } } } })gql"_graphql;
+
+	const auto firstSignature = peg::getQuerySignature(*first.root);
+	const auto secondSignature = peg::getQuerySignature(*second.root);
+
+	EXPECT_EQ("query Appointments($after:String,$first:Int){appointments(after:$after,first:$first){edges{node{...AppointmentFields}}}} "
+		"fragment AppointmentFields on Appointment{id subject@include(if:true)@skip(if:false)}", firstSignature.text);
+	EXPECT_EQ(firstSignature.text, secondSignature.text);
+	EXPECT_EQ(firstSignature.hash, secondSignature.hash);
+}
+
+TEST(NormalizeCase, HideLiterals)
+{
+	auto first = R"gql({
+			node(id: "ZmFrZUFwcG9pbnRtZW50SWQ=") {
+				... on Task { title }
+			}
+			expensive(list: [1, 2.5], object: { b: "x", a: RED }) { order }
+		})gql"_graphql;
+	auto second = R"gql(query {
+			node(id: "ZmFrZVRhc2tJZA==") {
+				... on Task { title }
+			}
+			expensive(object: { a: BLUE }, list: []) { order }
+		})gql"_graphql;
+
+	EXPECT_EQ(R"(query{node(id:""){... on Task{title}} expensive(list:[],object:{}){order}})", peg::normalizeQuery(*first.root, {}, true));
+	EXPECT_EQ(peg::getQuerySignature(*first.root, {}, true).hash, peg::getQuerySignature(*second.root, {}, true).hash);
+	EXPECT_EQ(R"(query{node(id:"ZmFrZUFwcG9pbnRtZW50SWQ="){... on Task{title}} expensive(list:[1,2.5],object:{a:RED,b:"x"}){order}})",
+		peg::normalizeQuery(*first.root));
+	EXPECT_NE(peg::getQuerySignature(*first.root).hash, peg::getQuerySignature(*second.root).hash) << "the default keeps the literals for a cache key";
+}
+
+TEST(NormalizeCase, SelectOperation)
+{
+	auto query = R"gql(query Tasks { tasks { ...TaskFields } }
+		query Folders { unreadCounts { ...FolderFields } }
+		fragment TaskFields on TaskConnection { pageInfo { hasNextPage } }
+		fragment FolderFields on FolderConnection { pageInfo { hasNextPage } })gql"_graphql;
+
+	EXPECT_EQ("query Folders{unreadCounts{...FolderFields}} fragment FolderFields on FolderConnection{pageInfo{hasNextPage}}",
+		peg::normalizeQuery(*query.root, "Folders"));
+	EXPECT_EQ("query Folders{unreadCounts{...FolderFields}} query Tasks{tasks{...TaskFields}} "
+		"fragment FolderFields on FolderConnection{pageInfo{hasNextPage}} fragment TaskFields on TaskConnection{pageInfo{hasNextPage}}",
+		peg::normalizeQuery(*query.root));
+}
+
+TEST(NormalizeCase, HashQuery)
+{
+	EXPECT_EQ("00000000000000000000000000000000", peg::hashQuery("").toString());
+	EXPECT_EQ("cbd8a7b341bd9b025b1e906a48ae1d19", peg::hashQuery("hello").toString());
+	EXPECT_EQ("e34bbc7bbc071b6c7a433ca9c49a9347", peg::hashQuery("The quick brown fox jumps over the lazy dog").toString());
+}
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include <graphqlservice/GraphQLResponse.h>
+#include <graphqlservice/GraphQLService.h>
 
 using namespace graphql;
 
@@ -16,3 +17,73 @@ TEST(ResponseCase, ValueConstructorFromStringLiteral)
 	ASSERT_TRUE(response::Type::String == actual.type());
 	ASSERT_EQ(expected, actual.release<response::StringType>());
 }
+
+TEST(ResponseCase, IdTypeInlineStorage)
+{
+	const std::string expected("fakeAppointmentId");
+	response::IdType actual(expected.cbegin(), expected.cend());
+
+	ASSERT_EQ(response::IdType::inline_capacity, actual.capacity()) << "short IDs should not allocate";
+	ASSERT_EQ(expected.size(), actual.size());
+	ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), actual.cbegin()));
+
+	actual.resize(response::IdType::inline_capacity + 1, 'x');
+	ASSERT_LT(response::IdType::inline_capacity, actual.capacity()) << "long IDs should move to the heap";
+	ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), actual.cbegin())) << "should keep the original bytes";
+	ASSERT_EQ('x', actual[response::IdType::inline_capacity]);
+
+	response::IdType moved(std::move(actual));
+	ASSERT_TRUE(actual.empty());
+	ASSERT_EQ(response::IdType::inline_capacity + 1, moved.size());
+	ASSERT_EQ(moved, response::IdType(moved));
+}
+
+TEST(ResponseCase, Base64RoundTrip)
+{
+	const response::IdType bytes { 0x00, 0x10, 0x83, 0x10, 0x51, 0x87, 0x20, 0x92, 0x8B, 0xFF };
+
+	for (size_t count = 0; count <= bytes.size(); ++count)
+	{
+		const response::IdType expected(bytes.data(), count);
+		const auto encoded = service::Base64::toBase64(expected);
+
+		ASSERT_EQ(((count + 2) / 3) * 4, encoded.size());
+		ASSERT_EQ(expected, service::Base64::fromBase64(encoded.data(), encoded.size())) << "count: " << count;
+	}
+
+	const std::string fakeId("fakeAppointmentId");
+
+	ASSERT_EQ("ZmFrZUFwcG9pbnRtZW50SWQ=", service::Base64::toBase64(response::IdType(fakeId.cbegin(), fakeId.cend())));
+}
+
+TEST(ResponseCase, Base64RejectsInvalidInput)
+{
+	for (const std::string invalid : { "A", "QU!D", "QQ==QQ==", "QR==", "QUJ=", "Q===", "QUJD=", "QUJD==", "QQ=", "QUI==", "==" })
+	{
+		EXPECT_THROW(service::Base64::fromBase64(invalid.data(), invalid.size()), service::schema_exception) << "input: " << invalid;
+	}
+}
+
+TEST(ResponseCase, ValueCopiesShareDataUntilModified)
+{
+	response::Value original(response::Type::EnumValue);
+
+	original.set<response::StringType>("Started");
+
+	const response::Value copy(original);
+	ASSERT_EQ(&original.get<const response::StringType&>(), &copy.get<const response::StringType&>()) << "copies should share the string";
+
+	original.set<response::StringType>("Complete");
+	ASSERT_EQ("Complete", original.get<const response::StringType&>());
+	ASSERT_EQ("Started", copy.get<const response::StringType&>()) << "modifying the original should not change the copy";
+
+	response::Value list(response::Type::List);
+
+	list.emplace_back(response::Value(copy));
+
+	response::Value listCopy(list);
+
+	listCopy.emplace_back(response::Value(original));
+	ASSERT_EQ(size_t(1), list.size());
+	ASSERT_EQ(size_t(2), listCopy.size());
+}
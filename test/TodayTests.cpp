@@ -4,11 +4,18 @@
 #include <gtest/gtest.h>
 
 #include "UnifiedToday.h"
+#include "TodayClient.h"
 
 #include <graphqlservice/JSONResponse.h>
+#include <graphqlservice/GraphQLTracing.h>
+#include <graphqlservice/GraphQLMetrics.h>
 
 #include <chrono>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 using namespace graphql;
 
 using namespace std::literals;
@@ -926,7 +933,7 @@ TEST_F(TodayServiceCase, SubscribeNodeChangeMismatchedId)
 	response::Value variables(response::Type::Map);
 	bool calledResolver = false;
 	auto subscriptionObject = std::make_shared<today::NodeChange>(
-		[this, &calledResolver](const std::shared_ptr<service::RequestState>& state, response::IdType&& idArg) -> std::shared_ptr<service::Object>
+		[&calledResolver](const std::shared_ptr<service::RequestState>&, response::IdType&&) -> std::shared_ptr<service::Object>
 	{
 		calledResolver = true;
 		return nullptr;
@@ -1036,7 +1043,7 @@ TEST_F(TodayServiceCase, SubscribeNodeChangeFuzzyMismatch)
 	};
 	bool calledResolver = false;
 	auto subscriptionObject = std::make_shared<today::NodeChange>(
-		[this, &calledResolver](const std::shared_ptr<service::RequestState>& state, response::IdType&& idArg) -> std::shared_ptr<service::Object>
+		[&calledResolver](const std::shared_ptr<service::RequestState>&, response::IdType&&) -> std::shared_ptr<service::Object>
 		{
 			calledResolver = true;
 			return nullptr;
@@ -1215,3 +1222,1145 @@ TEST_F(TodayServiceCase, NonBlockingQueryAppointmentsById)
 		FAIL() << response::toJSON(response::Value(ex.getErrors()));
 	}
 }
+
+TEST_F(TodayServiceCase, BatchQueryTasksById)
+{
+	auto ast = R"(query SpecificTasks($taskId: ID!) {
+			tasksById(ids: [$taskId, $taskId]) {
+				taskId: id
+				title
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	variables.emplace_back("taskId", response::Value(std::string("ZmFrZVRhc2tJZA==")));
+	auto state = std::make_shared<today::RequestState>(17);
+	auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+	EXPECT_GE(size_t(1), _getAppointmentsCount) << "today service lazy loads the appointments and caches the result";
+	EXPECT_EQ(size_t(1), _getTasksCount) << "today service lazy loads the tasks and caches the result";
+	EXPECT_GE(size_t(1), _getUnreadCountsCount) << "today service lazy loads the unreadCounts and caches the result";
+	EXPECT_EQ(size_t(17), state->tasksRequestId) << "today service passed the same RequestState";
+	EXPECT_EQ(size_t(2), state->loadTasksCount) << "today service called the loader for each id";
+	EXPECT_EQ(size_t(1), state->loadTitlesCount) << "today service loaded the titles for both tasks in one batch";
+
+	try
+	{
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		auto errorsItr = result.find("errors");
+		if (errorsItr != result.get<const response::MapType&>().cend())
+		{
+			FAIL() << response::toJSON(response::Value(errorsItr->second));
+		}
+		const auto data = service::ScalarArgument::require("data", result);
+
+		const auto tasksById = service::ScalarArgument::require<service::TypeModifier::List>("tasksById", data);
+		ASSERT_EQ(size_t(2), tasksById.size());
+		for (const auto& taskEntry : tasksById)
+		{
+			EXPECT_EQ(_fakeTaskId, service::IdArgument::require("taskId", taskEntry)) << "id should match in base64 encoding";
+			EXPECT_EQ("Don't forget", service::StringArgument::require("title", taskEntry)) << "title should match";
+		}
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(TodayServiceCase, BatchScopeKeysByArguments)
+{
+	service::BatchScope batch({
+		std::make_shared<today::Task>(response::IdType(_fakeTaskId), "first", false),
+		std::make_shared<today::Task>(response::IdType(_fakeTaskId), "second", true),
+	});
+	size_t batchCount = 0;
+	auto makeBatch = [&batchCount](std::string suffix)
+	{
+		return [&batchCount, suffix]()
+		{
+			++batchCount;
+			return service::FieldResult<std::vector<std::string>>(std::vector<std::string> { "a" + suffix, "b" + suffix });
+		};
+	};
+	response::Value firstArguments(response::Type::Map);
+	firstArguments.emplace_back("suffix", response::Value(std::string("1")));
+	response::Value secondArguments(response::Type::Map);
+	secondArguments.emplace_back("suffix", response::Value(std::string("2")));
+
+	auto first = batch.getResult<std::string>(1, "title", firstArguments, makeBatch("1"));
+	auto cached = batch.getResult<std::string>(0, "title", firstArguments, makeBatch("unexpected"));
+	auto second = batch.getResult<std::string>(0, "title", secondArguments, makeBatch("2"));
+	auto aliased = batch.getResult<std::string>(1, "otherTitle", firstArguments, makeBatch("3"));
+
+	EXPECT_EQ("b1", first.get()) << "first batch result";
+	EXPECT_EQ("a1", cached.get()) << "same response key and arguments share the batch";
+	EXPECT_EQ("a2", second.get()) << "different arguments get their own batch";
+	EXPECT_EQ("b3", aliased.get()) << "different response keys get their own batch";
+	EXPECT_EQ(size_t(3), batchCount) << "one batch per response key and arguments";
+
+	auto thrown = batch.getResult<std::string>(0, "thrown", firstArguments,
+		[]() -> service::FieldResult<std::vector<std::string>>
+		{
+			throw service::schema_exception { { "batch failed" } };
+		});
+
+	EXPECT_THROW(thrown.get(), service::schema_exception) << "batch errors are deferred to the result";
+}
+
+TEST_F(TodayServiceCase, StreamQueryToJSONWriter)
+{
+	auto ast = R"(query Everything {
+			appointments {
+				edges {
+					node {
+						id
+						subject
+						when
+						isNow
+						__typename
+					}
+				}
+			}
+			tasks {
+				edges {
+					node {
+						id
+						title
+						isComplete
+					}
+				}
+			}
+		})"_graphql;
+	response::JSONWriter writer;
+	auto state = std::make_shared<today::RequestState>(18);
+	_service->resolve(std::launch::deferred, state, *ast.root, "Everything", response::Value(response::Type::Map), writer).get();
+	auto expected = _service->resolve(std::make_shared<today::RequestState>(19), *ast.root, "Everything", response::Value(response::Type::Map)).get();
+
+	EXPECT_EQ(size_t(18), state->appointmentsRequestId) << "today service passed the same RequestState";
+	EXPECT_EQ(size_t(18), state->tasksRequestId) << "today service passed the same RequestState";
+	EXPECT_EQ(response::toJSON(std::move(expected)), writer.get_json()) << "streamed JSON should match the serialized response";
+}
+
+TEST_F(TodayServiceCase, StreamErrorsMatchValue)
+{
+	auto ast = R"(query Errors {
+			unimplemented
+			nested {
+				depth
+			}
+			appointments {
+				edges {
+					node {
+						id
+					}
+				}
+			}
+			nested: unimplemented
+			appointments: nested {
+				depth
+			}
+		})"_graphql;
+	response::JSONWriter writer;
+	_service->resolve(std::launch::deferred, std::make_shared<today::RequestState>(25), *ast.root, "Errors", response::Value(response::Type::Map), writer).get();
+	auto expected = _service->resolve(std::make_shared<today::RequestState>(26), *ast.root, "Errors", response::Value(response::Type::Map)).get();
+
+	try
+	{
+		const auto data = service::ScalarArgument::require("data", expected);
+		ASSERT_EQ(size_t(2), data.size()) << "the failed fields and the duplicate should be left out";
+		const auto nested = service::ScalarArgument::require("nested", data);
+		EXPECT_EQ(1, service::IntArgument::require("depth", nested)) << "the first nested field should be kept";
+		const auto appointments = service::ScalarArgument::require("appointments", data);
+		EXPECT_EQ(size_t(1), service::ScalarArgument::require<service::TypeModifier::List>("edges", appointments).size()) << "the first appointments field should be kept";
+		const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", expected);
+		ASSERT_EQ(size_t(3), errors.size()) << "2 unimplemented fields and 1 duplicate";
+		EXPECT_EQ("Field error name: appointments error: duplicate field", service::StringArgument::require("message", errors[2])) << "the duplicate should be resolved after the failed field";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+
+	EXPECT_EQ(response::toJSON(std::move(expected)), writer.get_json()) << "streamed JSON should match the serialized response with errors";
+}
+
+TEST_F(TodayServiceCase, QueryScalarLists)
+{
+	auto ast = R"({
+			stringList
+			nestedIntList
+		})"_graphql;
+	const auto expected = R"js({"data":{"stringList":["first","second","third"],"nestedIntList":[[1,null,3],null,[]]}})js"s;
+	auto result = _service->resolve(std::make_shared<today::RequestState>(23), *ast.root, "", response::Value(response::Type::Map)).get();
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	const auto data = service::ScalarArgument::require("data", result);
+	const auto stringList = service::StringArgument::require<service::TypeModifier::List>("stringList", data);
+	ASSERT_EQ(size_t(3), stringList.size()) << "stringList should have 3 entries";
+	EXPECT_EQ("second", stringList[1]) << "stringList should match";
+	const auto nestedIntList = service::IntArgument::require<service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>("nestedIntList", data);
+	ASSERT_TRUE(nestedIntList) << "nestedIntList should be set";
+	ASSERT_EQ(size_t(3), nestedIntList->size()) << "nestedIntList should have 3 entries";
+	ASSERT_TRUE((*nestedIntList)[0]) << "the first list should be set";
+	EXPECT_FALSE((*nestedIntList)[0]->at(1)) << "the null element should be null";
+	EXPECT_EQ(3, *(*nestedIntList)[0]->at(2)) << "the last element should match";
+	EXPECT_FALSE((*nestedIntList)[1]) << "the second list should be null";
+	ASSERT_TRUE((*nestedIntList)[2]) << "the third list should be set";
+	EXPECT_TRUE((*nestedIntList)[2]->empty()) << "the third list should be empty";
+	EXPECT_EQ(expected, response::toJSON(std::move(result))) << "serialized JSON should match";
+
+	response::JSONWriter writer;
+
+	_service->resolve(std::launch::deferred, std::make_shared<today::RequestState>(24), *ast.root, "", response::Value(response::Type::Map), writer).get();
+	EXPECT_EQ(expected, writer.get_json()) << "streamed JSON should match";
+}
+
+// Simulate a Writer which rejects one of the strings, e.g. because it's not valid UTF-8.
+class RejectStringWriter : public response::JSONWriter
+{
+public:
+	explicit RejectStringWriter(std::string_view rejected)
+		: _rejected(rejected)
+	{
+	}
+
+	void add_string(std::string_view value) override
+	{
+		if (value == _rejected)
+		{
+			throw std::runtime_error("rejected string");
+		}
+
+		response::JSONWriter::add_string(value);
+	}
+
+private:
+	const std::string_view _rejected;
+};
+
+TEST_F(TodayServiceCase, QueryStringListElementError)
+{
+	auto ast = R"({
+			stringList
+			nestedIntList
+		})"_graphql;
+	RejectStringWriter writer("second");
+
+	_service->resolve(std::launch::deferred, std::make_shared<today::RequestState>(25), *ast.root, "", response::Value(response::Type::Map), writer).get();
+
+	const auto json = writer.get_json();
+
+	EXPECT_NE(std::string::npos, json.find(R"js("stringList":["first","third"])js")) << "only the rejected element should be left out: " << json;
+	EXPECT_NE(std::string::npos, json.find(R"js("nestedIntList":[[1,null,3],null,[]])js")) << "the other field should be written: " << json;
+	EXPECT_NE(std::string::npos, json.find(R"js({"message":"Field name: stringList unknown error: rejected string"})js")) << "the element should have a field error: " << json;
+}
+
+TEST_F(TodayServiceCase, ClientQueryAppointments)
+{
+	auto ast = peg::parseString(client::query::Appointments::GetRequestText());
+	auto state = std::make_shared<today::RequestState>(20);
+	auto result = _service->resolve(state, *ast.root, std::string { client::query::Appointments::GetOperationName() }, response::Value(response::Type::Map)).get();
+
+	try
+	{
+		auto parsed = client::query::Appointments::parseResponse(std::move(result));
+
+		ASSERT_TRUE(parsed.appointments.edges) << "appointments should have edges";
+		ASSERT_EQ(size_t(1), parsed.appointments.edges->size()) << "appointments should have 1 entry";
+		const auto& appointmentEdge = parsed.appointments.edges->front();
+		ASSERT_TRUE(appointmentEdge && appointmentEdge->node) << "appointment should not be null";
+		const auto& appointment = *appointmentEdge->node;
+		EXPECT_EQ(_fakeAppointmentId, appointment.id) << "id should match in base64 encoding";
+		ASSERT_TRUE(appointment.subject) << "subject should be set";
+		EXPECT_EQ("Lunch?", *appointment.subject) << "subject should match";
+		ASSERT_TRUE(appointment.when) << "when should be set";
+		EXPECT_EQ("tomorrow", appointment.when->get<const response::StringType&>()) << "when should match";
+		EXPECT_FALSE(appointment.isNow) << "isNow should match";
+		EXPECT_EQ("Appointment", appointment._typename) << "__typename should match";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(TodayServiceCase, ClientQueryTasksFromJSON)
+{
+	auto ast = peg::parseString(client::query::Tasks::GetRequestText());
+	auto request = client::query::Tasks::buildRequest({ std::make_optional(response::IntType { 1 }) });
+	auto variables = service::ScalarArgument::require("variables", request);
+	auto state = std::make_shared<today::RequestState>(21);
+	auto result = _service->resolve(state, *ast.root, std::string { client::query::Tasks::GetOperationName() }, std::move(variables)).get();
+
+	try
+	{
+		client::query::Tasks::Response parsed;
+		auto reader = client::query::Tasks::getResponseReader(parsed);
+
+		response::parseJSON(response::toJSON(std::move(result)), reader);
+
+		EXPECT_EQ(response::Type::Null, reader.getErrors().type()) << "there should be no errors";
+		ASSERT_TRUE(parsed.tasks.edges) << "tasks should have edges";
+		ASSERT_EQ(size_t(1), parsed.tasks.edges->size()) << "tasks should have 1 entry";
+		const auto& taskEdge = parsed.tasks.edges->front();
+		ASSERT_TRUE(taskEdge && taskEdge->node) << "task should not be null";
+		const auto& task = *taskEdge->node;
+		EXPECT_EQ(_fakeTaskId, task.id) << "id should match in base64 encoding";
+		ASSERT_TRUE(task.title) << "title should be set";
+		EXPECT_EQ("Don't forget", *task.title) << "title should match";
+		EXPECT_TRUE(task.isComplete) << "isComplete should match";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(TodayServiceCase, ClientMutateCompleteTask)
+{
+	client::mutation::CompleteTask::Variables variables {};
+
+	variables.input.id = _fakeTaskId;
+	variables.input.isComplete = false;
+	variables.input.clientMutationId = "Hi There!";
+
+	auto request = client::mutation::CompleteTask::buildRequest(std::move(variables));
+
+	EXPECT_EQ("CompleteTask", service::StringArgument::require("operationName", request)) << "operationName should match";
+	EXPECT_EQ(client::mutation::CompleteTask::GetRequestText(), service::StringArgument::require("query", request)) << "query should match";
+
+	auto ast = peg::parseString(service::StringArgument::require("query", request));
+	auto state = std::make_shared<today::RequestState>(22);
+	auto result = _service->resolve(state, *ast.root, service::StringArgument::require("operationName", request),
+		response::Value(service::ScalarArgument::require("variables", request))).get();
+
+	try
+	{
+		auto parsed = client::mutation::CompleteTask::parseResponse(std::move(result));
+
+		ASSERT_TRUE(parsed.completedTask.completedTask) << "task should not be null";
+		const auto& task = *parsed.completedTask.completedTask;
+		EXPECT_EQ(_fakeTaskId, task.id) << "id should match in base64 encoding";
+		ASSERT_TRUE(task.title) << "title should be set";
+		EXPECT_EQ("Mutated Task!", *task.title) << "title should match";
+		EXPECT_FALSE(task.isComplete) << "isComplete should match";
+		ASSERT_TRUE(parsed.completedTask.clientMutationId) << "clientMutationId should be set";
+		EXPECT_EQ("Hi There!", *parsed.completedTask.clientMutationId) << "clientMutationId should match";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST(ClientCase, ClientMissingNonNullField)
+{
+	client::query::Tasks::Response parsed;
+	auto reader = client::query::Tasks::getResponseReader(parsed);
+
+	try
+	{
+		response::parseJSON(R"js({"data":{"tasks":{"edges":[{"node":{"id":"ZmFrZVRhc2tJZA==","title":"Don't forget"}}]}}})js", reader);
+		FAIL() << "missing isComplete should throw";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		EXPECT_EQ("missing non-null field: isComplete"s, service::getErrorMessage(ex)) << "the error should name the missing field";
+	}
+}
+
+TEST(ClientCase, ClientMissingData)
+{
+	client::query::Tasks::Response parsed;
+	auto reader = client::query::Tasks::getResponseReader(parsed);
+
+	EXPECT_THROW(response::parseJSON(R"js({"extensions":{}})js", reader), service::schema_exception) << "a response without data or errors should throw";
+}
+
+TEST(ClientCase, ClientResponseErrors)
+{
+	// The errors come before the data, and the keys are long enough that RapidJSON can't keep them inline.
+	const auto json = R"js({"errors":[{"message":"something went wrong","path":["tasks"]}],"unselectedMemberWithALongName":"x","data":null})js"s;
+	client::query::Tasks::Response parsed;
+	auto reader = client::query::Tasks::getResponseReader(parsed);
+
+	response::parseJSON(json, reader);
+
+	auto errors = reader.getErrors();
+
+	ASSERT_EQ(response::Type::List, errors.type()) << "errors should be a list";
+	ASSERT_EQ(size_t(1), errors.size()) << "there should be 1 error";
+	EXPECT_EQ("something went wrong", service::StringArgument::require("message", errors[0])) << "message should match";
+
+	try
+	{
+		client::query::Tasks::parseResponse(response::parseJSON(json));
+		FAIL() << "parseResponse should throw the errors";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		EXPECT_EQ("something went wrong"s, service::getErrorMessage(ex)) << "the exception should have the errors from the response";
+	}
+}
+
+TEST(ClientCase, ClientInvalidJSON)
+{
+	client::query::Tasks::Response parsed;
+	auto reader = client::query::Tasks::getResponseReader(parsed);
+
+	EXPECT_THROW(response::parseJSON(R"js({"data":{"tasks":)js", reader), std::runtime_error) << "truncated JSON should throw";
+}
+
+TEST_F(TodayServiceCase, TraceQueryAppointments)
+{
+	auto ast = R"({
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(23);
+
+	_service->setInstrumentation(std::make_shared<service::ApolloTracing>());
+	auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+	_service->setInstrumentation(nullptr);
+
+	try
+	{
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		auto errorsItr = result.find("errors");
+		if (errorsItr != result.get<const response::MapType&>().cend())
+		{
+			FAIL() << response::toJSON(response::Value(errorsItr->second));
+		}
+		const auto extensions = service::ScalarArgument::require("extensions", result);
+		const auto tracing = service::ScalarArgument::require("tracing", extensions);
+		EXPECT_EQ(1, service::IntArgument::require("version", tracing)) << "version should match";
+		EXPECT_GE(service::IntArgument::require("duration", tracing), 0) << "duration should not be negative";
+		const auto execution = service::ScalarArgument::require("execution", tracing);
+		const auto resolvers = service::ScalarArgument::require<service::TypeModifier::List>("resolvers", execution);
+		ASSERT_EQ(size_t(4), resolvers.size()) << "should trace each field";
+
+		const auto& subject = resolvers.back();
+		const auto path = service::ScalarArgument::require<service::TypeModifier::List>("path", subject);
+		ASSERT_EQ(size_t(5), path.size()) << "path should include the list index";
+		EXPECT_EQ("appointments", path[0].get<const response::StringType&>());
+		EXPECT_EQ("edges", path[1].get<const response::StringType&>());
+		EXPECT_EQ(0, path[2].get<response::IntType>());
+		EXPECT_EQ("node", path[3].get<const response::StringType&>());
+		EXPECT_EQ("subject", path[4].get<const response::StringType&>());
+		EXPECT_EQ("Appointment", service::StringArgument::require("parentType", subject)) << "parentType should match";
+		EXPECT_EQ("subject", service::StringArgument::require("fieldName", subject)) << "fieldName should match";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(TodayServiceCase, TraceQueryManyFields)
+{
+	auto ast = R"(query Everything {
+			appointments {
+				edges {
+					node {
+						id
+						subject
+						when
+						isNow
+						__typename
+					}
+				}
+			}
+			tasks {
+				edges {
+					node {
+						id
+						title
+						isComplete
+						__typename
+					}
+				}
+			}
+			unreadCounts {
+				edges {
+					node {
+						id
+						name
+						unreadCount
+						__typename
+					}
+				}
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(25);
+
+	_service->setInstrumentation(std::make_shared<service::ApolloTracing>());
+	auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+	_service->setInstrumentation(nullptr);
+
+	try
+	{
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		auto errorsItr = result.find("errors");
+		if (errorsItr != result.get<const response::MapType&>().cend())
+		{
+			FAIL() << response::toJSON(response::Value(errorsItr->second));
+		}
+		const auto extensions = service::ScalarArgument::require("extensions", result);
+		const auto tracing = service::ScalarArgument::require("tracing", extensions);
+		const auto execution = service::ScalarArgument::require("execution", tracing);
+		const auto resolvers = service::ScalarArgument::require<service::TypeModifier::List>("resolvers", execution);
+		ASSERT_EQ(size_t(22), resolvers.size()) << "should trace each field";
+
+		// None of the fields are aliased, so each fieldName should match the last segment of its path after
+		// all of the fields have been resolved.
+		for (const auto& resolver : resolvers)
+		{
+			const auto path = service::ScalarArgument::require<service::TypeModifier::List>("path", resolver);
+			ASSERT_FALSE(path.empty());
+			EXPECT_EQ(path.back().get<const response::StringType&>(), service::StringArgument::require("fieldName", resolver)) << "fieldName should match";
+		}
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(TodayServiceCase, MeasureQueryAppointments)
+{
+	auto ast = R"(query Appointments {
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(24);
+	auto metrics = std::make_shared<service::Metrics>(2);
+
+	_service->setInstrumentation(metrics);
+	auto result = _service->resolve(state, *ast.root, "Appointments", std::move(variables)).get();
+	_service->setInstrumentation(nullptr);
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	EXPECT_TRUE(result.find("extensions") == result.end()) << "metrics should not add any extensions";
+
+	const auto snapshot = metrics->snapshot(true);
+
+	ASSERT_EQ(size_t(4), snapshot.fields.size()) << "should count each field once";
+	EXPECT_EQ("Appointment", snapshot.fields[0].first);
+	EXPECT_EQ("subject", snapshot.fields[0].second);
+	EXPECT_EQ("Query", snapshot.fields[3].first);
+	EXPECT_EQ("appointments", snapshot.fields[3].second);
+	EXPECT_EQ(uint64_t(1), snapshot.fields[3].calls);
+	EXPECT_EQ(uint64_t(0), snapshot.fields[3].errors);
+	EXPECT_EQ(uint64_t(1), snapshot.fields[3].latency.count);
+	ASSERT_EQ(size_t(1), snapshot.operations.size()) << "should count the operation";
+	EXPECT_EQ("query", snapshot.operations[0].first);
+	EXPECT_EQ("Appointments", snapshot.operations[0].second);
+	EXPECT_EQ(uint64_t(1), snapshot.operations[0].calls);
+	EXPECT_EQ(uint64_t(0), snapshot.dropped);
+
+	const auto exposition = service::toPrometheus(snapshot);
+
+	EXPECT_NE(std::string::npos, exposition.find(R"(graphql_field_calls_total{type="Query",field="appointments"} 1)"));
+	EXPECT_NE(std::string::npos, exposition.find(R"(graphql_operation_duration_seconds_count{operation="query",name="Appointments"} 1)"));
+
+	const auto reset = metrics->snapshot();
+
+	ASSERT_EQ(size_t(4), reset.fields.size()) << "resetting should keep the series";
+	EXPECT_EQ(uint64_t(0), reset.fields[3].calls) << "resetting should clear the counters";
+}
+
+TEST_F(TodayServiceCase, MemoryBudgetQueryAppointments)
+{
+	auto ast = R"({
+			appointments {
+				edges {
+					node {
+						id
+						subject
+					}
+				}
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(25);
+	auto memory = std::make_shared<service::MemoryBudget>();
+
+	state->memory = memory;
+
+	auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+
+	try
+	{
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		auto errorsItr = result.find("errors");
+		if (errorsItr != result.get<const response::MapType&>().cend())
+		{
+			FAIL() << response::toJSON(response::Value(errorsItr->second));
+		}
+		EXPECT_FALSE(memory->exceeded()) << "an unlimited budget should never be exceeded";
+		EXPECT_LT(size_t(0), memory->getBytes(service::MemoryBudget::Category::Parse)) << "should count the parse tree";
+		EXPECT_LT(size_t(0), memory->getAllocations(service::MemoryBudget::Category::Execution)) << "should count each field";
+		EXPECT_LT(size_t(0), memory->getBytes(service::MemoryBudget::Category::Result)) << "should count the result";
+		EXPECT_EQ(memory->getBytes(), memory->getBytes(service::MemoryBudget::Category::Parse)
+			+ memory->getBytes(service::MemoryBudget::Category::Execution)
+			+ memory->getBytes(service::MemoryBudget::Category::Result)) << "total should match the categories";
+	}
+	catch (const service::schema_exception & ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+
+	// Only leave room for the parse tree, so the first field goes over the limit.
+	state = std::make_shared<today::RequestState>(26);
+	state->memory = std::make_shared<service::MemoryBudget>(memory->getBytes(service::MemoryBudget::Category::Parse) + 1);
+	variables = response::Value(response::Type::Map);
+	result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+
+	ASSERT_TRUE(state->memory->exceeded());
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	EXPECT_TRUE(result["data"].type() == response::Type::Null) << "should discard the partial result";
+	const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", result);
+	ASSERT_EQ(size_t(1), errors.size()) << "should replace the field errors with a single error";
+	EXPECT_EQ(0, service::StringArgument::require("message", errors.front()).find("Memory budget exceeded")) << "message should match";
+}
+
+TEST_F(TodayServiceCase, MemoryBudgetSubscription)
+{
+	auto query = R"(subscription TestSubscription {
+			nextAppointment: nextAppointmentChange {
+				nextAppointmentId: id
+				subject
+			}
+		})";
+	auto state = std::make_shared<today::RequestState>(28);
+	auto memory = std::make_shared<service::MemoryBudget>();
+	response::Value result;
+
+	state->memory = memory;
+
+	auto key = _service->subscribe(service::SubscriptionParams { state, peg::parseString(query), "TestSubscription", response::Value(response::Type::Map) },
+		[&result](std::future<response::Value> response)
+		{
+			result = response.get();
+		});
+	const auto parseBytes = memory->getBytes(service::MemoryBudget::Category::Parse);
+
+	EXPECT_LT(size_t(0), parseBytes) << "should count the parse tree when it subscribes";
+	EXPECT_EQ(size_t(0), memory->getBytes(service::MemoryBudget::Category::Result)) << "should not count a result before it's delivered";
+
+	_service->deliver("nextAppointmentChange", nullptr);
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	EXPECT_TRUE(result.find("errors") == result.get<const response::MapType&>().cend()) << "an unlimited budget should never be exceeded";
+	EXPECT_LT(size_t(0), memory->getAllocations(service::MemoryBudget::Category::Execution)) << "should count each delivered field";
+	EXPECT_LT(size_t(0), memory->getBytes(service::MemoryBudget::Category::Result)) << "should count the delivered result";
+
+	_service->unsubscribe(key);
+
+	// Only leave room for the parse tree, so the first delivery goes over the limit.
+	state = std::make_shared<today::RequestState>(29);
+	state->memory = std::make_shared<service::MemoryBudget>(parseBytes + 1);
+	result = response::Value();
+	key = _service->subscribe(service::SubscriptionParams { state, peg::parseString(query), "TestSubscription", response::Value(response::Type::Map) },
+		[&result](std::future<response::Value> response)
+		{
+			result = response.get();
+		});
+
+	for (size_t delivery = 0; delivery < 2; ++delivery)
+	{
+		_service->deliver("nextAppointmentChange", nullptr);
+
+		ASSERT_TRUE(state->memory->exceeded());
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		EXPECT_TRUE(result["data"].type() == response::Type::Null) << "should discard the partial result";
+		const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", result);
+		ASSERT_EQ(size_t(1), errors.size()) << "should replace the field errors with a single error";
+		EXPECT_EQ(0, service::StringArgument::require("message", errors.front()).find("Memory budget exceeded")) << "message should match";
+	}
+
+	_service->unsubscribe(key);
+}
+
+TEST_F(TodayServiceCase, DeadlineExceededQuery)
+{
+	auto ast = R"({
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(27);
+
+	state->cancellation = std::make_shared<service::CancellationToken>(std::chrono::steady_clock::now());
+
+	const auto appointmentsCount = _getAppointmentsCount;
+	auto result = _service->resolve(state, *ast.root, "", std::move(variables)).get();
+
+	EXPECT_EQ(appointmentsCount, _getAppointmentsCount) << "should not call any resolvers";
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	EXPECT_TRUE(result["data"].type() == response::Type::Null) << "should not have any data";
+	const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", result);
+	ASSERT_EQ(size_t(1), errors.size());
+	EXPECT_EQ("Request deadline exceeded", service::StringArgument::require("message", errors.front())) << "message should match";
+}
+
+TEST_F(TodayServiceCase, CancelSubscription)
+{
+	auto ast = peg::parseString(R"(subscription TestSubscription {
+			nextAppointmentChange {
+				subject
+			}
+		})");
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(28);
+	response::Value result;
+
+	state->cancellation = std::make_shared<service::CancellationToken>();
+
+	auto key = _service->subscribe(service::SubscriptionParams { state, std::move(ast), "TestSubscription", std::move(variables) },
+		[&result](std::future<response::Value> response)
+		{
+			result = response.get();
+		});
+
+	// Cancel the subscription after it's registered, the next delivery should skip the field.
+	state->cancellation->cancel();
+	_service->deliver("nextAppointmentChange", nullptr);
+	_service->unsubscribe(key);
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	const auto data = service::ScalarArgument::require("data", result);
+	EXPECT_TRUE(data.find("nextAppointmentChange") == data.end()) << "should skip the cancelled field";
+	const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", result);
+	ASSERT_EQ(size_t(1), errors.size());
+	EXPECT_EQ("Field error name: nextAppointmentChange unknown error: Request cancelled", service::StringArgument::require("message", errors.front())) << "message should match";
+}
+
+TEST_F(TodayServiceCase, QueryIndexedOperation)
+{
+	auto ast = R"(query Appointments {
+			appointments { edges { node { subject } } }
+		}
+		query Tasks {
+			tasks { edges { node { title } } }
+		}
+		query UnreadCounts {
+			unreadCounts { edges { node { name } } }
+		})"_graphql;
+
+	ASSERT_TRUE(ast.operations) << "parsing should index the operations";
+	EXPECT_EQ(size_t(3), ast.operations->operations.size());
+
+	const auto operationDefinition = _service->findOperationDefinition(ast, "Tasks");
+
+	EXPECT_EQ("query", operationDefinition.first);
+	EXPECT_EQ(ast.operations->operations[1].definition, operationDefinition.second) << "should find the second operation";
+
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(29);
+	auto result = _service->resolve(state, ast, "Tasks", std::move(variables)).get();
+
+	EXPECT_EQ(size_t(0), _getAppointmentsCount) << "should not resolve the other operations";
+	EXPECT_EQ(size_t(1), _getTasksCount) << "today service lazy loads the tasks and caches the result";
+
+	try
+	{
+		ASSERT_TRUE(result.type() == response::Type::Map);
+		auto errorsItr = result.find("errors");
+		if (errorsItr != result.get<const response::MapType&>().cend())
+		{
+			FAIL() << response::toJSON(response::Value(errorsItr->second));
+		}
+		const auto data = service::ScalarArgument::require("data", result);
+
+		const auto tasks = service::ScalarArgument::require("tasks", data);
+		const auto taskEdges = service::ScalarArgument::require<service::TypeModifier::List>("edges", tasks);
+		ASSERT_EQ(1, taskEdges.size()) << "tasks should have 1 entry";
+		const auto taskNode = service::ScalarArgument::require("node", taskEdges[0]);
+		EXPECT_EQ("Don't forget", service::StringArgument::require("title", taskNode)) << "title should match";
+	}
+	catch (const service::schema_exception& ex)
+	{
+		FAIL() << response::toJSON(response::Value(ex.getErrors()));
+	}
+}
+
+TEST_F(TodayServiceCase, DuplicateIndexedOperation)
+{
+	auto ast = R"(query Tasks { tasks { edges { node { title } } } }
+		query Tasks { unreadCounts { edges { node { name } } } })"_graphql;
+
+	try
+	{
+		_service->findOperationDefinition(ast, "Tasks");
+		FAIL() << "should throw on the duplicate name";
+	}
+	catch (const service::schema_exception& ex)
+	{
+		auto errors = response::Value(ex.getErrors()).release<response::ListType>();
+		ASSERT_EQ(size_t(1), errors.size());
+		const auto message = service::StringArgument::require("message", errors.front());
+		EXPECT_EQ(size_t(0), message.find("Duplicate named operations name: Tasks line: 2")) << "message should match";
+	}
+}
+
+TEST_F(TodayServiceCase, ParseNestingDepthLimit)
+{
+	std::string query;
+
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		query += "{ nested ";
+	}
+
+	query += "{ depth }";
+	query.append(10000, '}');
+
+	EXPECT_THROW(peg::parseString(query), std::runtime_error) << "should stop parsing instead of overflowing the stack";
+}
+
+TEST_F(TodayServiceCase, QueryMaxDepthExceeded)
+{
+	// Each fragment only nests one level, so this parses fine, but the fields are 10,001 levels deep.
+	std::string query = "query Deep { ...Nested0 }\nfragment Nested0 on Query { nested { ...Nested1 } }\n";
+
+	for (size_t i = 1; i < 10000; ++i)
+	{
+		query += "fragment Nested" + std::to_string(i) + " on NestedType { nested { ...Nested" + std::to_string(i + 1) + " } }\n";
+	}
+
+	query += "fragment Nested10000 on NestedType { depth }\n";
+
+	auto ast = peg::parseString(query);
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(30);
+	auto result = _service->resolve(state, ast, "Deep", std::move(variables)).get();
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	EXPECT_TRUE(result["data"].type() == response::Type::Null) << "should not have any data";
+	const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", result);
+	ASSERT_EQ(size_t(1), errors.size());
+	EXPECT_EQ("Exceeded maximum depth: 128 depth: 10001", service::StringArgument::require("message", errors.front())) << "message should match";
+}
+
+#ifndef _WIN32
+TEST_F(TodayServiceCase, QueryMaxDepthOnSmallStack)
+{
+	// A quarter of the usual 8 MiB default, like the worker threads in a pool with small stacks.
+	constexpr size_t stackSize = 2 * 1024 * 1024;
+
+	struct ThreadState
+	{
+		std::shared_ptr<today::Operations> service;
+		response::Value result;
+		std::string error;
+	} threadState { _service, response::Value(), std::string() };
+
+	const auto threadMain = [](void* arg) -> void*
+	{
+		auto& threadState = *static_cast<ThreadState*>(arg);
+
+		try
+		{
+			// The fields are nested exactly Request::defaultMaxDepth levels deep.
+			std::string query;
+
+			for (size_t i = 1; i < service::Request::defaultMaxDepth; ++i)
+			{
+				query += "{ nested ";
+			}
+
+			query += "{ depth }";
+			query.append(service::Request::defaultMaxDepth - 1, '}');
+
+			auto ast = peg::parseString(query);
+			auto state = std::make_shared<today::RequestState>(32);
+
+			threadState.result = threadState.service->resolve(state, ast, "", response::Value(response::Type::Map)).get();
+		}
+		catch (const service::schema_exception & ex)
+		{
+			threadState.error = response::toJSON(response::Value(ex.getErrors()));
+		}
+		catch (const std::exception & ex)
+		{
+			threadState.error = ex.what();
+		}
+
+		return nullptr;
+	};
+
+	pthread_attr_t attr;
+	pthread_t thread;
+
+	ASSERT_EQ(0, pthread_attr_init(&attr));
+	ASSERT_EQ(0, pthread_attr_setstacksize(&attr, stackSize));
+	ASSERT_EQ(0, pthread_create(&thread, &attr, threadMain, &threadState)) << "should start the thread";
+	pthread_attr_destroy(&attr);
+	ASSERT_EQ(0, pthread_join(thread, nullptr));
+
+	// Throw away the params captured by each of the NestedType objects.
+	today::NestedType::getCapturedParams();
+
+	ASSERT_TRUE(threadState.error.empty()) << threadState.error;
+	ASSERT_TRUE(threadState.result.type() == response::Type::Map);
+	auto errorsItr = threadState.result.find("errors");
+	if (errorsItr != threadState.result.get<const response::MapType&>().cend())
+	{
+		FAIL() << response::toJSON(response::Value(errorsItr->second));
+	}
+
+	auto nested = service::ScalarArgument::require("data", threadState.result);
+
+	for (size_t i = 1; i < service::Request::defaultMaxDepth; ++i)
+	{
+		nested = service::ScalarArgument::require("nested", nested);
+	}
+
+	EXPECT_EQ(static_cast<response::IntType>(service::Request::defaultMaxDepth - 1), service::IntArgument::require("depth", nested)) << "should resolve every level";
+}
+#endif
+
+TEST_F(TodayServiceCase, CyclicFragmentSpread)
+{
+	auto ast = R"(query Cycle {
+			nested { ...Outer }
+		}
+		fragment Outer on NestedType { nested { ...Inner } }
+		fragment Inner on NestedType { nested { ...Outer } })"_graphql;
+	response::Value variables(response::Type::Map);
+	auto state = std::make_shared<today::RequestState>(31);
+	auto result = _service->resolve(state, ast, "Cycle", std::move(variables)).get();
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	EXPECT_TRUE(result["data"].type() == response::Type::Null) << "should not have any data";
+	const auto errors = service::ScalarArgument::require<service::TypeModifier::List>("errors", result);
+	ASSERT_EQ(size_t(1), errors.size());
+	EXPECT_EQ(size_t(0), service::StringArgument::require("message", errors.front()).find("Cyclic fragment spread name: Outer")) << "message should match";
+}
+
+// Resolve a list field directly with ModifiedResult, since none of the today fields return a ListGenerator.
+class ListGeneratorCase : public ::testing::Test
+{
+protected:
+	service::ResolverParams getParams(response::Writer* writer = nullptr, const service::CancellationToken* cancellation = nullptr) const
+	{
+		const service::SelectionSetParams selectionSetParams {
+			_state,
+			_directives,
+			_directives,
+			_directives,
+			_directives,
+			nullptr,
+			0,
+			writer,
+			cancellation,
+			nullptr,
+			service::ResponsePath(),
+		};
+
+		return service::ResolverParams(selectionSetParams, "list", response::Value(response::Type::Map), response::Value(response::Type::Map),
+			nullptr, _fragments, _variables);
+	}
+
+	// Yield each of the values, and throw instead of returning the one at throwIndex.
+	static service::ListGenerator<response::StringType> getStrings(std::vector<response::StringType> values, size_t throwIndex = std::numeric_limits<size_t>::max())
+	{
+		return service::ListGenerator<response::StringType>([values = std::move(values), throwIndex, index = size_t(0)]() mutable -> std::optional<response::StringType>
+		{
+			if (index == throwIndex)
+			{
+				throw std::runtime_error("cursor failed");
+			}
+
+			if (index == values.size())
+			{
+				return std::nullopt;
+			}
+
+			return std::make_optional(values[index++]);
+		});
+	}
+
+	static response::Value getErrors(response::Value& document)
+	{
+		auto itr = document.find("errors");
+
+		return (itr == document.get<const response::MapType&>().cend()
+			? response::Value()
+			: response::Value(itr->second));
+	}
+
+private:
+	const std::shared_ptr<service::RequestState> _state;
+	const response::Value _directives { response::Type::Map };
+	const service::FragmentMap _fragments;
+	const response::Value _variables { response::Type::Map };
+};
+
+TEST_F(ListGeneratorCase, ThrowMidStream)
+{
+	auto document = service::ModifiedResult<response::StringType>::convert<service::TypeModifier::List>(
+		getStrings({ "first", "second", "third" }, 2), getParams()).get();
+	auto errors = getErrors(document);
+
+	EXPECT_EQ(R"js(["first","second"])js", response::toJSON(response::Value(document["data"]))) << "the elements before the error should be kept";
+	ASSERT_EQ(response::Type::List, errors.type()) << "the generator error should be reported";
+	ASSERT_EQ(size_t(1), errors.size());
+	const auto message = service::StringArgument::require("message", errors[0]);
+	EXPECT_NE(std::string::npos, message.find("list[2]")) << message;
+	EXPECT_NE(std::string::npos, message.find("cursor failed")) << message;
+
+	response::JSONWriter writer;
+	auto streamed = service::ModifiedResult<response::StringType>::convert<service::TypeModifier::List>(
+		getStrings({ "first", "second", "third" }, 2), getParams(&writer)).get();
+
+	EXPECT_EQ(R"js(["first","second"])js", writer.get_json()) << "the streamed list should be closed after the error";
+	EXPECT_EQ(response::toJSON(std::move(errors)), response::toJSON(getErrors(streamed))) << "the streamed errors should match";
+}
+
+TEST_F(ListGeneratorCase, Cancellation)
+{
+	service::CancellationToken cancellation;
+	size_t count = 0;
+	auto generator = service::ListGenerator<response::StringType>([&cancellation, &count]() -> std::optional<response::StringType>
+	{
+		// Cancel the request while it's reading the second element.
+		if (++count == 2)
+		{
+			cancellation.cancel();
+		}
+
+		return std::make_optional("element"s);
+	});
+	response::JSONWriter writer;
+	auto document = service::ModifiedResult<response::StringType>::convert<service::TypeModifier::List>(
+		std::move(generator), getParams(&writer, &cancellation)).get();
+	auto errors = getErrors(document);
+
+	EXPECT_EQ(size_t(2), count) << "the generator should not be called after the request is cancelled";
+	EXPECT_EQ(R"js(["element","element"])js", writer.get_json()) << "the streamed list should end at the cancellation";
+	ASSERT_EQ(response::Type::List, errors.type()) << "the cancellation should be reported";
+	ASSERT_EQ(size_t(1), errors.size());
+	EXPECT_NE(std::string::npos, service::StringArgument::require("message", errors[0]).find("Request cancelled"));
+}
+
+TEST_F(ListGeneratorCase, StreamObjects)
+{
+	std::vector<std::shared_ptr<today::object::Task>> tasks {
+		std::make_shared<today::Task>(response::IdType(), "first", false),
+		nullptr,
+		std::make_shared<today::Task>(response::IdType(), "third", true)
+	};
+	const auto getTasks = [&tasks]()
+	{
+		return service::FieldResult<std::vector<std::shared_ptr<today::object::Task>>>(
+			service::ListGenerator<std::shared_ptr<today::object::Task>>(tasks.cbegin(), tasks.cend()));
+	};
+
+	auto document = service::ModifiedResult<today::object::Task>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+		getTasks(), getParams()).get();
+
+	response::JSONWriter writer;
+	auto streamed = service::ModifiedResult<today::object::Task>::convert<service::TypeModifier::List, service::TypeModifier::Nullable>(
+		getTasks(), getParams(&writer)).get();
+
+	EXPECT_EQ(R"js([{},null,{}])js", response::toJSON(response::Value(document["data"]))) << "each element should be converted in order";
+	EXPECT_EQ(response::toJSON(response::Value(document["data"])), writer.get_json()) << "streamed JSON should match the serialized list";
+	EXPECT_EQ(response::Type::Null, getErrors(streamed).type()) << "there should be no errors";
+}
+
+// Objects which own std::function resolvers still work next to the generated types.
+class OwnedResolversQuery : public service::Object
+{
+public:
+	explicit OwnedResolversQuery(std::string&& greeting)
+		: service::Object({ "Query" }, {
+			{ "greeting", [this](service::ResolverParams&& params)
+				{
+					return service::ModifiedResult<response::StringType>::convert(response::StringType(_greeting), std::move(params));
+				} },
+			{ "__typename", [](service::ResolverParams&& params)
+				{
+					return service::ModifiedResult<response::StringType>::convert(response::StringType{ "Query" }, std::move(params));
+				} }
+		})
+		, _greeting(std::move(greeting))
+	{
+	}
+
+private:
+	const std::string _greeting;
+};
+
+TEST(ObjectCase, OwnedResolvers)
+{
+	auto query = std::make_shared<OwnedResolversQuery>("Hello");
+	service::Request request({ { "query", query } });
+	auto ast = peg::parseString(R"({ greeting __typename })");
+	response::Value variables(response::Type::Map);
+	auto result = request.resolve(nullptr, ast, "", std::move(variables)).get();
+
+	ASSERT_TRUE(result.type() == response::Type::Map);
+	const auto data = service::ScalarArgument::require("data", result);
+	EXPECT_EQ("Hello", service::StringArgument::require("greeting", data)) << "greeting should match";
+	EXPECT_EQ("Query", service::StringArgument::require("__typename", data)) << "__typename should match";
+}
+
+TEST(ObjectCase, ResultArenaLifetime)
+{
+	struct Counted
+	{
+		explicit Counted(size_t& destroyed)
+			: destroyed(destroyed)
+		{
+		}
+
+		~Counted()
+		{
+			++destroyed;
+		}
+
+		size_t& destroyed;
+		std::array<char, 100> padding {};
+	};
+
+	size_t destroyed = 0;
+	auto arena = std::make_shared<service::ResultArena>(256);
+	std::vector<std::shared_ptr<Counted>> objects;
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		objects.push_back(arena->make<Counted>(destroyed));
+	}
+
+	// The objects keep the arena alive after the last reference to the arena itself is released.
+	std::weak_ptr<service::ResultArena> weakArena = arena;
+	arena.reset();
+	EXPECT_FALSE(weakArena.expired()) << "objects should keep the arena alive";
+	EXPECT_EQ(size_t(0), destroyed) << "objects should not be destroyed yet";
+
+	objects.resize(1);
+	EXPECT_EQ(size_t(0), destroyed) << "objects are only destroyed with the arena";
+
+	objects.clear();
+	EXPECT_TRUE(weakArena.expired()) << "arena should be released with the last object";
+	EXPECT_EQ(size_t(10), destroyed) << "arena should destroy all of the objects";
+}